@@ -1,25 +1,78 @@
 #include "app.h"
+#include "app_mix.h"
 #include "ahrs.h"
+#include "blackbox.h"
 #include "bmi270.h"
 #include "cf.h"
 #include "ghf.h"
+#include "image_header.h"
 #include "motor.h"
 #include "pid.h"
 #include "rc.h"
+#include "telemetry.h"
 #include "tim.h"
 #include "timing.h"
 #include "ll_spi.h"
+#include "ll_usart.h"
+#include "ll_usart_dma.h"
 #include "vtol.h"
 #include "libopencm3/stm32/rcc.h"
 #include "libopencm3/stm32/gpio.h"
 
+#if (defined(APP_BOOT_REPORT) && (APP_BOOT_REPORT == 1))
+#include "printf.h"
+#endif  /* APP_BOOT_REPORT */
+
 #include <math.h>
 
+///
+/// \brief The control cycles per blackbox frame, selected by the APP_BLACKBOX_DIVIDER CMake option.
+///
+#ifndef APP_BLACKBOX_DIVIDER
+#define APP_BLACKBOX_DIVIDER 0
+#endif  /* APP_BLACKBOX_DIVIDER */
+
+///
+/// \brief The telemetry on the debug USART, selected by the APP_TELEMETRY CMake option.
+///
+#ifndef APP_TELEMETRY
+#define APP_TELEMETRY 0
+#endif  /* APP_TELEMETRY */
+
 ///
 /// \brief The maximum degree used to map RC normalized signal.
 ///
 static const float32_t max_degree = 30.0f;
 
+///
+/// \brief The image header checked by the apploader before the app is started. The length and the
+///        CRC-32 are filled in by scripts/image_header.py after the link.
+///
+static const image_header_t __attribute__((section(".image_header"), used)) app_image_header =
+{
+    .magic   = IMAGE_HEADER_MAGIC,
+    .version = IMAGE_HEADER_VERSION(APP_VERSION_MAJOR, APP_VERSION_MINOR, APP_VERSION_PATCH),
+    .length  = 0,
+    .crc32   = 0,
+};
+
+#if (defined(APP_BOOT_REPORT) && (APP_BOOT_REPORT == 1))
+///
+/// \brief The boot stage names of the report.
+///
+static const char *const app_boot_stage_names[TIMING_BOOT_STAGE_TOTAL_SIZE] =
+{
+    "clocks", "bootloader", "startup", "image check", "startup", "drivers", "radio", "imu", "calibration",
+};
+#endif  /* APP_BOOT_REPORT */
+
+#if (APP_TELEMETRY == 1)
+///
+/// \brief The telemetry boot statistics, filled once before the loop.
+///
+static struct telemetry_boot app_telemetry_boot;
+#endif  /* APP_TELEMETRY */
+
 ///*************************************************************************************************
 /// Private functions - declaration.
 ///*************************************************************************************************
@@ -45,6 +98,25 @@ static void led_panic(void);
 ///
 static void enter_safe_mode(struct ghf *const handle);
 
+///
+/// \brief Stops the motors and disarms on the RC link loss.
+///
+/// \param[in] handle The pointer to ghf.
+///
+static void link_lost(struct ghf *const handle);
+
+///
+/// \brief Prints the time spent in the boot stages over the debug USART.
+///
+static void boot_report(void);
+
+///
+/// \brief Starts the telemetry on the debug USART transmission ring.
+///
+/// \param[in] handle The pointer to ghf.
+///
+static void telemetry_start(const struct ghf *const handle);
+
 ///*************************************************************************************************
 /// Private functions - definition.
 ///*************************************************************************************************
@@ -75,100 +147,203 @@ static void enter_safe_mode(struct ghf *const handle)
 
     while (handle->module.rc_5->sig.norm > 0.8f)
     {
-        rc_sig_raw_gen(handle->module.rc_5);
-        rc_sig_norm(handle->module.rc_5, RC_NORM_ASYM);
+        (void)rc_update();
 
         led_panic();
     }
 }
 
+static void link_lost(struct ghf *const handle)
+{
+    if (vtol_stat_get() != VTOL_STAT_ON)
+    {
+        return;
+    }
+
+    /* The motors keep the last pulse width once disarmed, so they are stopped first. */
+    motor_update(handle->module.motor_1, 1000);
+    motor_update(handle->module.motor_2, 1000);
+    motor_update(handle->module.motor_3, 1000);
+    motor_update(handle->module.motor_4, 1000);
+
+    vtol_disarm();
+}
+
+static void boot_report(void)
+{
+#if (defined(APP_BOOT_REPORT) && (APP_BOOT_REPORT == 1))
+    uint32_t total = 0;
+
+    ll_usart_debug_init();
+
+    for (uint32_t i = 0; i < TIMING_BOOT_STAGE_TOTAL_SIZE; i++)
+    {
+        uint32_t us = timing_boot_us((timing_boot_stage_t)i);
+
+        printf("boot:   %-12s %u us\n\r", app_boot_stage_names[i], us);
+        total += us;
+    }
+
+    printf("boot:   reason %u, reset flags 0x%08x\n\r", BOOT_HANDOFF->reason, BOOT_HANDOFF->reset_cause);
+
+    /* The wait for the radio is up to the pilot. */
+    printf("boot:   armable after %u us, %u us without the radio\n\r", total,
+           total - timing_boot_us(TIMING_BOOT_STAGE_RC_READY));
+#endif  /* APP_BOOT_REPORT */
+}
+
+#if (APP_TELEMETRY == 1)
+static uint32_t telemetry_sink_space(void)
+{
+    return ll_usart_dma_tx_space(LL_USART_DMA_INST_USART3);
+}
+
+static uint32_t telemetry_sink_reserve(uint8_t **const data)
+{
+    return ll_usart_dma_tx_reserve(LL_USART_DMA_INST_USART3, data);
+}
+
+static void telemetry_sink_commit(const uint32_t len)
+{
+    ll_usart_dma_tx_commit(LL_USART_DMA_INST_USART3, len);
+}
+
+///
+/// \brief The telemetry sink, the frames share the ring with the debug output.
+///
+static const struct telemetry_sink app_telemetry_sink =
+{
+    .space   = telemetry_sink_space,
+    .reserve = telemetry_sink_reserve,
+    .commit  = telemetry_sink_commit,
+};
+#endif  /* APP_TELEMETRY */
+
+static void telemetry_start(const struct ghf *const handle)
+{
+#if (APP_TELEMETRY == 1)
+    for (uint32_t i = 0; i < TIMING_BOOT_STAGE_TOTAL_SIZE; i++)
+    {
+        app_telemetry_boot.stage_us[i] = timing_boot_us((timing_boot_stage_t)i);
+    }
+
+    app_telemetry_boot.reason      = BOOT_HANDOFF->reason;
+    app_telemetry_boot.reset_cause = BOOT_HANDOFF->reset_cause;
+
+    ll_usart_debug_init();
+
+    telemetry_init(&app_telemetry_sink, &app_telemetry_boot, (uint32_t)((1.0f / handle->config.dt) + 0.5f));
+    telemetry_rate_set(TELEMETRY_MSG_ATTITUDE, 50);
+    telemetry_rate_set(TELEMETRY_MSG_RATES,    50);
+    telemetry_rate_set(TELEMETRY_MSG_RC,       20);
+    telemetry_rate_set(TELEMETRY_MSG_MOTORS,   50);
+    telemetry_rate_set(TELEMETRY_MSG_LOOP,     10);
+    telemetry_rate_set(TELEMETRY_MSG_BOOT,     1);
+#else
+    (void)handle;
+#endif  /* APP_TELEMETRY */
+}
+
 ///*************************************************************************************************
 /// Global functions - definition.
 ///*************************************************************************************************
-void app_start(void)
+void app_init(void)
 {
     struct ghf *ghf = ghf_get();
 
+    timing_boot_stamp(TIMING_BOOT_STAGE_IMAGE);
+
     led_on();
     ghf_init(ghf);
     led_off();
 
-    /* Never return */
-    while (1)
+    boot_report();
+
+    blackbox_init(APP_BLACKBOX_DIVIDER);
+    telemetry_start(ghf);
+}
+
+void app_update(void)
+{
+    struct ghf *ghf = ghf_get();
+
+    ghf->data.time.start = timing_cnt_get();
+
+    /* One RC snapshot per loop, shared by the VTOL procedures and the controllers. */
+    if (rc_update()->lost != 0)
+    {
+        link_lost(ghf);
+    }
+    else
     {
-        ghf->data.time.start = timing_cnt_get();
         vtol_take_off_proc();
+    }
+
+    if (vtol_stat_get() == VTOL_STAT_ON)
+    {
+        bmi270_acc_read();
+        bmi270_gyr_read();
+
+        ghf->data.raw_data.ax = bmi270_acc_get_x();
+        ghf->data.raw_data.ay = bmi270_acc_get_y();
+        ghf->data.raw_data.az = bmi270_acc_get_z();
+        ghf->data.raw_data.gx = bmi270_gyr_get_x() - ghf->data.calib.gx;
+        ghf->data.raw_data.gy = bmi270_gyr_get_y() - ghf->data.calib.gy;
+        ghf->data.raw_data.gz = bmi270_gyr_get_z() - ghf->data.calib.gz;
+
+        ahrs_update(ghf->module.ahrs, &ghf->data.raw_data);
+
+        ghf->data.throttle = ghf->module.rc_3->sig.norm;
+
+        ghf->data.roll  = pid_update(ghf->module.pid_roll,  ghf->module.rc_1->sig.norm*max_degree, ghf->module.ahrs->out.roll);
+        ghf->data.pitch = pid_update(ghf->module.pid_pitch, ghf->module.rc_2->sig.norm*max_degree, ghf->module.ahrs->out.pitch);
+        ghf->data.yaw   = pid_update(ghf->module.pid_yaw,   ghf->module.rc_4->sig.norm*max_degree, ghf->module.ahrs->out.yaw);
+        //ghf->data.yaw   = ghf->module.rc_4->sig.norm * 0.66f;
 
-        if (vtol_stat_get() == VTOL_STAT_ON)
+        if (ghf->data.throttle < 0.2f)
         {
-            bmi270_acc_read();
-            bmi270_gyr_read();
-
-            ghf->data.raw_data.ax = bmi270_acc_get_x();
-            ghf->data.raw_data.ay = bmi270_acc_get_y();
-            ghf->data.raw_data.az = bmi270_acc_get_z();
-            ghf->data.raw_data.gx = bmi270_gyr_get_x() - ghf->data.calib.gx;
-            ghf->data.raw_data.gy = bmi270_gyr_get_y() - ghf->data.calib.gy;
-            ghf->data.raw_data.gz = bmi270_gyr_get_z() - ghf->data.calib.gz;
-
-            ahrs_update(ghf->module.ahrs, &ghf->data.raw_data);
-
-            rc_sig_raw_gen(ghf->module.rc_1);
-            rc_sig_raw_gen(ghf->module.rc_2);
-            rc_sig_raw_gen(ghf->module.rc_3);
-            rc_sig_raw_gen(ghf->module.rc_4);
-            rc_sig_raw_gen(ghf->module.rc_5);
-
-            rc_sig_norm(ghf->module.rc_1, RC_NORM_SYM);
-            rc_sig_norm(ghf->module.rc_2, RC_NORM_SYM);
-            rc_sig_norm(ghf->module.rc_3, RC_NORM_ASYM);
-            rc_sig_norm(ghf->module.rc_4, RC_NORM_SYM);
-            rc_sig_norm(ghf->module.rc_5, RC_NORM_ASYM);
-
-            ghf->data.throttle = ghf->module.rc_3->sig.norm;
-
-            ghf->data.roll  = pid_update(ghf->module.pid_roll,  ghf->module.rc_1->sig.norm*max_degree, ghf->module.ahrs->out.roll);
-            ghf->data.pitch = pid_update(ghf->module.pid_pitch, ghf->module.rc_2->sig.norm*max_degree, ghf->module.ahrs->out.pitch);
-            ghf->data.yaw   = pid_update(ghf->module.pid_yaw,   ghf->module.rc_4->sig.norm*max_degree, ghf->module.ahrs->out.yaw);
-            //ghf->data.yaw   = ghf->module.rc_4->sig.norm * 0.66f;
-
-            if (ghf->data.throttle < 0.2f)
-            {
-                ghf->data.roll  = 0.0f;
-                ghf->data.pitch = 0.0f;
-                ghf->data.yaw   = 0.0f;
-            }
-
-            ghf->data.pwm1 = 1000 + (1000 * (ghf->data.throttle + ghf->data.roll - ghf->data.pitch + ghf->data.yaw));
-            ghf->data.pwm2 = 1000 + (1000 * (ghf->data.throttle - ghf->data.roll - ghf->data.pitch - ghf->data.yaw));
-            ghf->data.pwm3 = 1000 + (1000 * (ghf->data.throttle + ghf->data.roll + ghf->data.pitch - ghf->data.yaw));
-            ghf->data.pwm4 = 1000 + (1000 * (ghf->data.throttle - ghf->data.roll + ghf->data.pitch + ghf->data.yaw));
-
-            ghf->data.pwm1 = (ghf->data.pwm1 > 2000) ? 2000 : ghf->data.pwm1;
-            ghf->data.pwm1 = (ghf->data.pwm1 < 1000) ? 1000 : ghf->data.pwm1;
-
-            ghf->data.pwm2 = (ghf->data.pwm2 > 2000) ? 2000 : ghf->data.pwm2;
-            ghf->data.pwm2 = (ghf->data.pwm2 < 1000) ? 1000 : ghf->data.pwm2;
-
-            ghf->data.pwm3 = (ghf->data.pwm3 > 2000) ? 2000 : ghf->data.pwm3;
-            ghf->data.pwm3 = (ghf->data.pwm3 < 1000) ? 1000 : ghf->data.pwm3;
-
-            ghf->data.pwm4 = (ghf->data.pwm4 > 2000) ? 2000 : ghf->data.pwm4;
-            ghf->data.pwm4 = (ghf->data.pwm4 < 1000) ? 1000 : ghf->data.pwm4;
-
-            motor_update(ghf->module.motor_1, ghf->data.pwm1);
-            motor_update(ghf->module.motor_2, ghf->data.pwm2);
-            motor_update(ghf->module.motor_3, ghf->data.pwm3);
-            motor_update(ghf->module.motor_4, ghf->data.pwm4);
-
-            /* Safe mode. */
-            if (ghf->module.rc_5->sig.norm > 0.8f)
-            {
-                enter_safe_mode(ghf);
-            }
+            ghf->data.roll  = 0.0f;
+            ghf->data.pitch = 0.0f;
+            ghf->data.yaw   = 0.0f;
         }
 
-        vtol_land_proc();
+        app_mix(&ghf->data);
+
+        motor_update(ghf->module.motor_1, ghf->data.pwm1);
+        motor_update(ghf->module.motor_2, ghf->data.pwm2);
+        motor_update(ghf->module.motor_3, ghf->data.pwm3);
+        motor_update(ghf->module.motor_4, ghf->data.pwm4);
+
+        /* Safe mode. */
+        if (ghf->module.rc_5->sig.norm > 0.8f)
+        {
+            enter_safe_mode(ghf);
+        }
+    }
+
+    vtol_land_proc();
+
+    /* The loop duration logged is the one of the previous cycle. */
+    blackbox_update(ghf);
+
+#if (APP_TELEMETRY == 1)
+    if (telemetry_update(ghf) > 0)
+    {
+        ll_usart_dma_tx_kick(LL_USART_DMA_INST_USART3);
+    }
+#endif  /* APP_TELEMETRY */
+}
+
+void app_start(void)
+{
+    struct ghf *ghf = ghf_get();
+
+    app_init();
+
+    /* Never return */
+    while (1)
+    {
+        app_update();
 
         do
         {
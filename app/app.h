@@ -4,7 +4,19 @@
 #include <stdint.h>
 
 ///
-/// \brief Starts the application.
+/// \brief Initializes the modules and waits until the radio is ready and the IMU is calibrated.
+///
+void app_init(void);
+
+///
+/// \brief Runs one control cycle: the RC snapshot, the arming, the attitude control and the motor mix.
+///
+/// \note The caller paces the cycles, app_start() to the control period, the simulator to its clock.
+///
+void app_update(void);
+
+///
+/// \brief Starts the application, never returns.
 ///
 void app_start(void);
 
@@ -0,0 +1,60 @@
+#ifndef _APP_MIX_H
+#define _APP_MIX_H
+
+#include <stdint.h>
+#include "ahrs.h"
+#include "ghf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+#define APP_MIX_PWM_MIN     (1000.0f)       /*!< The motor pulse width at zero thrust (us).             */
+#define APP_MIX_PWM_MAX     (2000.0f)       /*!< The motor pulse width at full thrust (us).             */
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief Turns the motor mix into the pulse width.
+///
+/// \param[in] mix The motor mix, 0 to 1.
+///
+/// \return uint32_t The pulse width, clamped before the conversion so a negative mix reads 1000 on the
+///                  host as on the target.
+///
+static inline uint32_t app_mix_pwm(const float32_t mix);
+
+///
+/// \brief Mixes the throttle and the controller outputs into the motor pulse widths of the X frame.
+///
+/// \param[in,out] data The ghf data, the throttle, roll, pitch and yaw in, pwm1 to pwm4 out.
+///
+static inline void app_mix(struct ghf_data *const data);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static inline uint32_t app_mix_pwm(const float32_t mix)
+{
+    float32_t pwm = APP_MIX_PWM_MIN + (1000.0f * mix);
+
+    pwm = (pwm > APP_MIX_PWM_MAX) ? APP_MIX_PWM_MAX : pwm;
+    pwm = (pwm < APP_MIX_PWM_MIN) ? APP_MIX_PWM_MIN : pwm;
+
+    return (uint32_t)pwm;
+}
+
+static inline void app_mix(struct ghf_data *const data)
+{
+    data->pwm1 = app_mix_pwm(data->throttle + data->roll - data->pitch + data->yaw);
+    data->pwm2 = app_mix_pwm(data->throttle - data->roll - data->pitch - data->yaw);
+    data->pwm3 = app_mix_pwm(data->throttle + data->roll + data->pitch - data->yaw);
+    data->pwm4 = app_mix_pwm(data->throttle - data->roll + data->pitch + data->yaw);
+}
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _APP_MIX_H */
@@ -5,13 +5,35 @@
 #include "printf.h"
 #endif  /* DEBUG_DUST_PROTOCOL */
 
+///
+/// \brief The crc16 engine, selected by the DUST_CRC16_ENGINE CMake option.
+///
+#define DUST_CRC16_ENGINE_HARDWARE  (0)
+#define DUST_CRC16_ENGINE_SLICE4    (4)
+#define DUST_CRC16_ENGINE_SLICE8    (8)
+
+#ifndef DUST_CRC16_ENGINE
+#define DUST_CRC16_ENGINE DUST_CRC16_ENGINE_SLICE8
+#endif  /* DUST_CRC16_ENGINE */
+
+#if (DUST_CRC16_ENGINE == DUST_CRC16_ENGINE_HARDWARE)
+#include "libopencm3/stm32/crc.h"
+#include "libopencm3/stm32/rcc.h"
+#define DUST_CRC16_SLICES           (1)     /*!< The byte-wise table of dust_crc16_get_lut_address(). */
+#else
+#define DUST_CRC16_SLICES           DUST_CRC16_ENGINE
+#endif  /* DUST_CRC16_ENGINE */
+
 ///*************************************************************************************************
 /// Private objects - definition.
 ///*************************************************************************************************
 ///
-/// \brief Dust protocol crc16 look-up table.
+/// \brief Dust protocol crc16 look-up tables.
 ///
-static uint16_t dust_crc16_lut[DUST_CRC16_LUT_SIZE];
+/// The first one is the byte-wise table, the table n holds the crc16 of the byte followed by n zero
+/// bytes, which lets the slice-by-n loop fold n bytes per iteration.
+///
+static uint16_t dust_crc16_lut[DUST_CRC16_SLICES][DUST_CRC16_LUT_SIZE];
 
 ///
 /// \brief Dust handshake ack frequency option hash table.
@@ -140,46 +162,27 @@ static void dust_deserialize_packet(dust_packet_t *const packet, const uint8_t *
 ///*************************************************************************************************
 static void dust_crc16_calculate(dust_packet_t *const packet)
 {
-    uint32_t position = 0;
     uint8_t  serialized_header[DUST_PACKET_HEADER_SIZE];
-    uint8_t  serialized_data[packet->payload.buffer_size];
-    uint8_t  serialized_header_and_data[DUST_PACKET_HEADER_SIZE + packet->payload.buffer_size];
+    uint16_t crc16 = dust_crc16_init();
 
-    /* Get serialized header and data. */
+    /* The payload is run over where it is, only the packed header needs the serialization. */
     dust_serialize_header(&packet->header, &serialized_header[0], sizeof(serialized_header));
-    dust_serialize_payload(packet, &serialized_data[0], sizeof(serialized_data));
 
-    packet->crc16 = 0;
-    memcpy(&serialized_header_and_data[0], &serialized_header[0], DUST_PACKET_HEADER_SIZE);
-    memcpy(&serialized_header_and_data[DUST_PACKET_HEADER_SIZE], &serialized_data[0],
-            packet->payload.buffer_size);
+    crc16 = dust_crc16_update(crc16, &serialized_header[0], sizeof(serialized_header));
+    crc16 = dust_crc16_update(crc16, &packet->payload.buffer[0], packet->payload.buffer_size);
 
-    for (uint32_t i = 0; i < sizeof(serialized_header_and_data); i++)
-    {
-        /* Equal to ((packet->crc16 ^ (b << 8)) >> 8) */
-        position      = ((packet->crc16 >> 8) ^ serialized_header_and_data[i]);
-        packet->crc16 = ((packet->crc16 << 8) ^ dust_crc16_lut[position]);
-    }
+    packet->crc16 = dust_crc16_final(crc16);
 }
 
 const uint16_t* dust_crc16_get_lut_address(void)
 {
-    return &dust_crc16_lut[0];
+    return &dust_crc16_lut[0][0];
 }
 
 static dust_result_t dust_crc16_check(const uint8_t *const data, const uint32_t data_size)
 {
-    uint16_t crc16    = 0;
-    uint32_t position = 0;
-
-    for (uint32_t i = 0; i < data_size; i++)
-    {
-        /* Equal to ((crc16 ^ (b << 8)) >> 8) */
-        position = ((crc16 >> 8) ^ data[i]);
-        crc16    = ((crc16 << 8) ^ dust_crc16_lut[position]);
-    }
-
-    if (crc16 != 0)
+    /* The crc16 over the packet followed by its crc16 is zero. */
+    if (dust_crc16_final(dust_crc16_update(dust_crc16_init(), data, data_size)) != 0)
     {
         return DUST_RESULT_ERROR;
     }
@@ -194,8 +197,15 @@ static dust_result_t dust_handshake_options_check(const dust_protocol_instance_t
         return DUST_RESULT_ERROR;
     }
 
-    if ((instance->packet.payload.buffer_size % 0x20 != 0x00) ||
-        (instance->packet.payload.buffer_size > 0x100))
+    if ((instance->options.arq_mode > DUST_ARQ_MODE_SELECTIVE_REPEAT) ||
+        (instance->options.compression > DUST_COMPRESSION_LZ))
+    {
+        return DUST_RESULT_ERROR;
+    }
+
+    if ((instance->options.payload_size == 0x00) ||
+        (instance->options.payload_size % 0x20 != 0x00) ||
+        (instance->options.payload_size > 0x100))
     {
         return DUST_RESULT_ERROR;
     }
@@ -276,7 +286,7 @@ static void dust_deserialize_header(dust_header_t *const header, const uint8_t *
     header->opcode        |= ((data[0] & 0xc0) >> 0x06);
     header->length        |= ((data[0] & 0x30) >> 0x04);
     header->ack           |= ((data[0] & 0x08) >> 0x03);
-    header->packet_number |= ((data[0] & 0x07) << 0x04);
+    header->packet_number |= ((data[0] & 0x07) << 0x08);
     header->packet_number |= ((data[1] & 0xff) >> 0x00);
     header->checksum      |= ((data[2] & 0xff) << 0x08);
     header->checksum      |= ((data[3] & 0xff) << 0x00);
@@ -322,8 +332,84 @@ void dust_crc16_generate_lut(const uint16_t polynomial)
             }
         }
 
-        dust_crc16_lut[byte] = crc16_value;
+        dust_crc16_lut[0][byte] = crc16_value;
     }
+
+    for (uint32_t slice = 1; slice < DUST_CRC16_SLICES; slice++)
+    {
+        for (uint32_t byte = 0; byte < DUST_CRC16_LUT_SIZE; byte++)
+        {
+            uint16_t previous = dust_crc16_lut[slice - 1][byte];
+
+            /* One more zero byte run through the byte-wise step. */
+            dust_crc16_lut[slice][byte] = (uint16_t)((previous << 8) ^ dust_crc16_lut[0][previous >> 8]);
+        }
+    }
+
+#if (DUST_CRC16_ENGINE == DUST_CRC16_ENGINE_HARDWARE)
+    rcc_periph_clock_enable(RCC_CRC);
+
+    CRC_POL = polynomial;
+    CRC_CR  = (CRC_CR_POLYSIZE_16 << CRC_CR_POLYSIZE_SHIFT);
+#endif  /* DUST_CRC16_ENGINE */
+}
+
+uint16_t dust_crc16_init(void)
+{
+    return 0x0000;
+}
+
+uint16_t dust_crc16_update(uint16_t crc16, const uint8_t *data, uint32_t size)
+{
+#if (DUST_CRC16_ENGINE == DUST_CRC16_ENGINE_HARDWARE)
+    /* The peripheral carries on from the given crc16, so the calls may split the data anywhere. */
+    CRC_INIT = crc16;
+    CRC_CR  |= CRC_CR_RESET;
+
+    for (; size >= 4; size -= 4, data += 4)
+    {
+        /* The word is fed most significant byte first, the order the bytes follow each other. */
+        CRC_DR = ((uint32_t)data[0] << 0x18) | ((uint32_t)data[1] << 0x10) |
+                 ((uint32_t)data[2] << 0x08) | ((uint32_t)data[3] << 0x00);
+    }
+
+    for (; size > 0; size--, data++)
+    {
+        MMIO8(CRC_BASE) = *data;
+    }
+
+    return (uint16_t)CRC_DR;
+#else
+#if (DUST_CRC16_SLICES == 8)
+    for (; size >= 8; size -= 8, data += 8)
+    {
+        crc16 = dust_crc16_lut[7][(crc16 >> 8) ^ data[0]] ^ dust_crc16_lut[6][(crc16 & 0xff) ^ data[1]] ^
+                dust_crc16_lut[5][data[2]] ^ dust_crc16_lut[4][data[3]] ^
+                dust_crc16_lut[3][data[4]] ^ dust_crc16_lut[2][data[5]] ^
+                dust_crc16_lut[1][data[6]] ^ dust_crc16_lut[0][data[7]];
+    }
+#endif  /* DUST_CRC16_SLICES */
+
+    for (; size >= 4; size -= 4, data += 4)
+    {
+        crc16 = dust_crc16_lut[3][(crc16 >> 8) ^ data[0]] ^ dust_crc16_lut[2][(crc16 & 0xff) ^ data[1]] ^
+                dust_crc16_lut[1][data[2]] ^ dust_crc16_lut[0][data[3]];
+    }
+
+    for (; size > 0; size--, data++)
+    {
+        /* Equal to ((crc16 ^ (b << 8)) >> 8) */
+        crc16 = (uint16_t)((crc16 << 8) ^ dust_crc16_lut[0][(crc16 >> 8) ^ *data]);
+    }
+
+    return crc16;
+#endif  /* DUST_CRC16_ENGINE */
+}
+
+uint16_t dust_crc16_final(const uint16_t crc16)
+{
+    /* There is no final XOR, the crc16 is sent as it is. */
+    return crc16;
 }
 
 uint16_t dust_get_ack_frequency(const uint8_t ack_frequency)
@@ -432,6 +518,57 @@ dust_result_t dust_deserialize(dust_packet_t *const packet, const uint8_t *const
     return DUST_RESULT_SUCCESS;
 }
 
+dust_result_t dust_view_parse(dust_view_t *const view, const uint8_t *const data, const uint32_t data_size,
+                              const uint32_t payload_size)
+{
+    if ((view == NULL) || (data == NULL))
+    {
+        return DUST_RESULT_ERROR;
+    }
+
+    if (data_size < (DUST_PACKET_HEADER_SIZE + payload_size + DUST_PACKET_CRC16_SIZE))
+    {
+        return DUST_RESULT_SIZE_ERROR;
+    }
+
+    if (dust_crc16_check(data, DUST_PACKET_HEADER_SIZE + payload_size + DUST_PACKET_CRC16_SIZE) != DUST_RESULT_SUCCESS)
+    {
+        return DUST_RESULT_ERROR;
+    }
+
+    dust_deserialize_header(&view->header, &data[DUST_PACKET_HEADER_POSITION], DUST_PACKET_HEADER_SIZE);
+
+    view->payload      = &data[DUST_PACKET_DATA_POSITION];
+    view->payload_size = payload_size;
+
+    return DUST_RESULT_SUCCESS;
+}
+
+dust_result_t dust_view_serialize(const dust_header_t *const header, uint8_t *const data, const uint32_t data_size,
+                                  const uint32_t payload_size)
+{
+    uint16_t crc16;
+
+    if ((header == NULL) || (data == NULL))
+    {
+        return DUST_RESULT_ERROR;
+    }
+
+    if (data_size < (DUST_PACKET_HEADER_SIZE + payload_size + DUST_PACKET_CRC16_SIZE))
+    {
+        return DUST_RESULT_SIZE_ERROR;
+    }
+
+    dust_serialize_header(header, &data[DUST_PACKET_HEADER_POSITION], DUST_PACKET_HEADER_SIZE);
+
+    crc16 = dust_crc16_final(dust_crc16_update(dust_crc16_init(), data, DUST_PACKET_HEADER_SIZE + payload_size));
+
+    data[DUST_PACKET_HEADER_SIZE + payload_size]     = ((crc16 & 0xff00) >> 0x08);
+    data[DUST_PACKET_HEADER_SIZE + payload_size + 1] = ((crc16 & 0x00ff) >> 0x00);
+
+    return DUST_RESULT_SUCCESS;
+}
+
 dust_result_t dust_transmit(const dust_serialized_t *const serialized, const uint32_t usart)
 {
     if (serialized == NULL)
@@ -472,9 +609,8 @@ dust_result_t dust_handshake(dust_protocol_instance_t *const instance, const uin
     }
 
     /* Handshake packet payload has fixed size equal to 32 bytes. */
-    instance->packet.payload.buffer_size = 0x20;
-    instance->serialized.buffer_size     = DUST_PACKET_HEADER_SIZE + instance->packet.payload.buffer_size +
-                                           DUST_PACKET_CRC16_SIZE;
+    instance->reply_size             = 0x20;
+    instance->serialized.buffer_size = DUST_PACKET_HEADER_SIZE + instance->reply_size + DUST_PACKET_CRC16_SIZE;
 
     /* Receive the handshake packet. */
     if (dust_receive(&instance->serialized, usart) != DUST_RESULT_SUCCESS)
@@ -482,29 +618,138 @@ dust_result_t dust_handshake(dust_protocol_instance_t *const instance, const uin
         return DUST_RESULT_ERROR;
     }
 
-    /* Deserialize the received data. */
-    if (dust_deserialize(&instance->packet, &instance->serialized.buffer[0], instance->serialized.buffer_size) != DUST_RESULT_SUCCESS)
+    return dust_handshake_process(instance, &instance->serialized.buffer[0], instance->serialized.buffer_size);
+}
+
+dust_result_t dust_handshake_process(dust_protocol_instance_t *const instance, const uint8_t *const data,
+                                     const uint32_t data_size)
+{
+    const uint8_t *payload;
+    dust_view_t    view;
+
+    if ((instance == NULL) || (data == NULL))
+    {
+        return DUST_RESULT_ERROR;
+    }
+
+    /* Handshake packet payload has fixed size equal to 32 bytes, it is read in place. */
+    if (dust_view_parse(&view, data, data_size, 0x20) != DUST_RESULT_SUCCESS)
     {
         return DUST_RESULT_ERROR;
     }
 
-    instance->options.ack_frequency      = instance->packet.payload.buffer[0];
+    payload = view.payload;
+
+    instance->options.ack_frequency      = payload[0];
 
     instance->options.number_of_packets  = 0;
-    instance->options.number_of_packets |= instance->packet.payload.buffer[1] << 0x18;
-    instance->options.number_of_packets |= instance->packet.payload.buffer[2] << 0x10;
-    instance->options.number_of_packets |= instance->packet.payload.buffer[3] << 0x08;
-    instance->options.number_of_packets |= instance->packet.payload.buffer[4] << 0x00;
+    instance->options.number_of_packets |= payload[1] << 0x18;
+    instance->options.number_of_packets |= payload[2] << 0x10;
+    instance->options.number_of_packets |= payload[3] << 0x08;
+    instance->options.number_of_packets |= payload[4] << 0x00;
 
     instance->options.payload_size       = 0;
-    instance->options.payload_size      |= instance->packet.payload.buffer[5] << 0x08;
-    instance->options.payload_size      |= instance->packet.payload.buffer[6] << 0x00;
+    instance->options.payload_size      |= payload[5] << 0x08;
+    instance->options.payload_size      |= payload[6] << 0x00;
+
+    /* The hosts not aware of the ARQ modes leave the byte zeroed, which selects go-back. */
+    instance->options.arq_mode           = payload[7];
+
+    /* The image size is the decoded one, the packets carry the compressed stream. */
+    instance->options.compression        = payload[8];
+
+    instance->options.image_size         = 0;
+    instance->options.image_size        |= payload[9]  << 0x18;
+    instance->options.image_size        |= payload[10] << 0x10;
+    instance->options.image_size        |= payload[11] << 0x08;
+    instance->options.image_size        |= payload[12] << 0x00;
+
+    /* The delta transfer exchanges the block manifest before the data packets. */
+    instance->options.delta              = payload[13];
+
+    /* The host asks for the capabilities to switch to a larger payload and a faster baud rate. */
+    instance->options.negotiate          = payload[14];
+
+    /* The interrupted transfer of the same image resumes where it was committed. */
+    instance->options.image_hash         = 0;
+    instance->options.image_hash        |= (uint32_t)payload[15] << 0x18;
+    instance->options.image_hash        |= (uint32_t)payload[16] << 0x10;
+    instance->options.image_hash        |= (uint32_t)payload[17] << 0x08;
+    instance->options.image_hash        |= (uint32_t)payload[18] << 0x00;
+
+    /* The image is linked to one of the app slots, the updater programs it there. */
+    instance->options.slot               = payload[19];
+
+    instance->header = view.header;
+
+    /* The handshake is refused before the payload size is taken over. */
+    if (dust_handshake_options_check(instance) != DUST_RESULT_SUCCESS)
+    {
+        return DUST_RESULT_ERROR;
+    }
 
     /* Update the payload size with the received one. */
-    instance->packet.payload.buffer_size = instance->options.payload_size;
+    instance->reply_size             = instance->options.payload_size;
+    instance->serialized.buffer_size = DUST_PACKET_HEADER_SIZE + instance->reply_size + DUST_PACKET_CRC16_SIZE;
+
+    return DUST_RESULT_SUCCESS;
+}
+
+dust_result_t dust_capabilities_serialize(const dust_capabilities_t *const capabilities, uint8_t *const payload,
+                                          const uint32_t payload_size)
+{
+    if ((capabilities == NULL) || (payload == NULL) || (capabilities->bauds_count > DUST_CAPABILITIES_BAUDS_MAX))
+    {
+        return DUST_RESULT_ERROR;
+    }
+
+    if (payload_size < (4 + (capabilities->bauds_count * 4)))
+    {
+        return DUST_RESULT_SIZE_ERROR;
+    }
+
+    memset(payload, 0, payload_size);
+
+    payload[DUST_EXT_OPCODE_POSITION] = DUST_EXT_OPCODE_CAPABILITIES;
+    payload[1] = ((capabilities->payload_size_max & 0xff00) >> 0x08);
+    payload[2] = ((capabilities->payload_size_max & 0x00ff) >> 0x00);
+    payload[3] = (uint8_t)capabilities->bauds_count;
+
+    for (uint32_t i = 0; i < capabilities->bauds_count; i++)
+    {
+        payload[4 + (i * 4) + 0] = ((capabilities->bauds[i] & 0xff000000) >> 0x18);
+        payload[4 + (i * 4) + 1] = ((capabilities->bauds[i] & 0x00ff0000) >> 0x10);
+        payload[4 + (i * 4) + 2] = ((capabilities->bauds[i] & 0x0000ff00) >> 0x08);
+        payload[4 + (i * 4) + 3] = ((capabilities->bauds[i] & 0x000000ff) >> 0x00);
+    }
+
+    return DUST_RESULT_SUCCESS;
+}
+
+dust_result_t dust_settings_deserialize(dust_settings_t *const settings, const uint8_t *const payload,
+                                        const uint32_t payload_size)
+{
+    if ((settings == NULL) || (payload == NULL) || (payload_size < 11) ||
+        (payload[DUST_EXT_OPCODE_POSITION] != DUST_EXT_OPCODE_SETTINGS))
+    {
+        return DUST_RESULT_ERROR;
+    }
 
-    instance->serialized.buffer_size     = DUST_PACKET_HEADER_SIZE + instance->packet.payload.buffer_size +
-                                           DUST_PACKET_CRC16_SIZE;
+    settings->payload_size       = 0;
+    settings->payload_size      |= payload[1] << 0x08;
+    settings->payload_size      |= payload[2] << 0x00;
+
+    settings->baud               = 0;
+    settings->baud              |= (uint32_t)payload[3] << 0x18;
+    settings->baud              |= (uint32_t)payload[4] << 0x10;
+    settings->baud              |= (uint32_t)payload[5] << 0x08;
+    settings->baud              |= (uint32_t)payload[6] << 0x00;
+
+    settings->number_of_packets  = 0;
+    settings->number_of_packets |= (uint32_t)payload[7]  << 0x18;
+    settings->number_of_packets |= (uint32_t)payload[8]  << 0x10;
+    settings->number_of_packets |= (uint32_t)payload[9]  << 0x08;
+    settings->number_of_packets |= (uint32_t)payload[10] << 0x00;
 
     return DUST_RESULT_SUCCESS;
 }
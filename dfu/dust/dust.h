@@ -9,11 +9,14 @@ extern "C" {
 #include <string.h>
 
 #define DUST_PACKET_PAYLOAD_BUFFER_MAX_SIZE (0x0100u)
+#define DUST_PACKET_PAYLOAD_LARGE_MAX_SIZE  (0x0800u)
 #define DUST_PACKET_HEADER_SIZE             (0x0004u)
 #define DUST_PACKET_CRC16_SIZE              (0x0002u)
 #define DUST_PACKET_HEADER_POSITION         (0x0000u)
 #define DUST_PACKET_DATA_POSITION           (0x0004u)
 #define DUST_CRC16_LUT_SIZE                 (0x0100u)
+#define DUST_EXT_OPCODE_POSITION            (0x0000u)
+#define DUST_CAPABILITIES_BAUDS_MAX         (0x0007u)
 
 ///
 /// \brief The dust result type.
@@ -37,6 +40,22 @@ typedef enum
     DUST_OPCODE_ERROR,
 } dust_opcode_t;
 
+///
+/// \brief The dust extended opcode type.
+///
+/// The header opcode field is full, so the messages setting up the transfer after the handshake
+/// are CONNECT packets carrying the extended opcode in the first payload byte.
+///
+typedef enum
+{
+    DUST_EXT_OPCODE_MANIFEST = 0x01,
+    DUST_EXT_OPCODE_BLOCKS,
+    DUST_EXT_OPCODE_CAPABILITIES,
+    DUST_EXT_OPCODE_SETTINGS,
+    DUST_EXT_OPCODE_RESUME,
+    DUST_EXT_OPCODE_SLOT,
+} dust_ext_opcode_t;
+
 ///
 /// \brief The dust length type.
 ///
@@ -73,6 +92,24 @@ typedef enum
     DUST_ACK_FREQUENCY_TOTAL_SIZE,
 } dust_ack_frequency_t;
 
+///
+/// \brief The dust ARQ mode type.
+///
+typedef enum
+{
+    DUST_ARQ_MODE_GO_BACK = 0,
+    DUST_ARQ_MODE_SELECTIVE_REPEAT,
+} dust_arq_mode_t;
+
+///
+/// \brief The dust image compression type.
+///
+typedef enum
+{
+    DUST_COMPRESSION_NONE = 0,
+    DUST_COMPRESSION_LZ,
+} dust_compression_t;
+
 ///
 /// \brief The dust header type.
 ///
@@ -112,24 +149,74 @@ typedef struct
     uint8_t  ack_frequency;
     uint32_t number_of_packets;
     uint32_t payload_size;
+    uint8_t  arq_mode;
+    uint8_t  compression;
+    uint32_t image_size;
+    uint8_t  delta;
+    uint8_t  negotiate;
+    uint32_t image_hash;                    /*!< The CRC-32 of the image to resume, 0 for none.      */
+    uint8_t  slot;                          /*!< The app slot the image is linked to.                */
 } dust_handshake_options_t;
 
+///
+/// \brief The dust link capabilities type.
+///
+/// The device answers the handshake asking for the negotiation with its capabilities, the host
+/// picks the best common setting out of them.
+///
+typedef struct
+{
+    uint32_t payload_size_max;
+    uint32_t bauds[DUST_CAPABILITIES_BAUDS_MAX];
+    uint32_t bauds_count;
+} dust_capabilities_t;
+
+///
+/// \brief The dust link settings type, picked by the host.
+///
+/// The packets longer than DUST_LENGTH_BYTES256 carry it in their length field, they are framed by
+/// the negotiated payload size.
+///
+typedef struct
+{
+    uint32_t payload_size;
+    uint32_t baud;
+    uint32_t number_of_packets;             /*!< The number of packets of the negotiated size.        */
+} dust_settings_t;
+
 ///
 /// \brief The dust serialized packet type.
 ///
 typedef struct
 {
-    uint8_t  buffer[sizeof(dust_packet_t)];
+    uint8_t  buffer[DUST_PACKET_HEADER_SIZE + DUST_PACKET_PAYLOAD_LARGE_MAX_SIZE + DUST_PACKET_CRC16_SIZE];
     uint32_t buffer_size;
 } dust_serialized_t;
 
+///
+/// \brief The dust packet view type.
+///
+/// The header is decoded, the payload is left in the serialized packet it has been received in,
+/// so it is accessed there instead of being copied into a dust_packet_t.
+///
+typedef struct
+{
+    dust_header_t  header;
+    const uint8_t *payload;                 /*!< The payload within the serialized packet.           */
+    uint32_t       payload_size;
+} dust_view_t;
+
 ///
 /// \brief The dust protocol instance type.
 ///
+/// The packets are parsed and built in the serialized buffer, only the header of the last good packet
+/// is kept out of it.
+///
 typedef struct
 {
     dust_handshake_options_t options;
-    dust_packet_t            packet;
+    dust_header_t            header;        /*!< The header of the last good packet.                 */
+    uint32_t                 reply_size;    /*!< The payload size of the replies.                    */
     dust_serialized_t        serialized;
 } dust_protocol_instance_t;
 
@@ -143,10 +230,37 @@ void dust_crc16_generate_lut(const uint16_t polynomial);
 ///
 /// \brief Gets the look-up table address.
 ///
-/// \return The look-up table address.
+/// \return The look-up table address, the byte-wise table of DUST_CRC16_LUT_SIZE entries.
 ///
 const uint16_t* dust_crc16_get_lut_address(void);
 
+///
+/// \brief Starts the incremental crc16.
+///
+/// \return uint16_t The initial crc16.
+///
+uint16_t dust_crc16_init(void);
+
+///
+/// \brief Runs the crc16 over the next part of the data, straight from its buffer.
+///
+/// \param[in] crc16 The crc16 of the data so far.
+/// \param[in] data  The next part of the data.
+/// \param[in] size  The size of the part.
+///
+/// \return uint16_t The crc16 including the part.
+///
+uint16_t dust_crc16_update(uint16_t crc16, const uint8_t *data, uint32_t size);
+
+///
+/// \brief Finishes the incremental crc16.
+///
+/// \param[in] crc16 The crc16 of the whole data.
+///
+/// \return uint16_t The crc16 to send.
+///
+uint16_t dust_crc16_final(const uint16_t crc16);
+
 ///
 /// \brief Get ack frequency from hash table.
 ///
@@ -232,6 +346,44 @@ dust_result_t dust_serialize(dust_packet_t *const packet, uint8_t *const seriali
 dust_result_t dust_deserialize(dust_packet_t *const packet, const uint8_t *const data,
                                const uint32_t data_size);
 
+///
+/// \brief Parses the serialized packet in place.
+///
+/// The crc16 is verified over the serialized packet, nothing is copied out of it. The view is
+/// valid as long as the data buffer is.
+///
+/// \param[out] view                        The packet view.
+/// \param[in]  data                        The serialized packet.
+/// \param[in]  data_size                   The data buffer size.
+/// \param[in]  payload_size                The payload size.
+///
+/// \return dust_result_t                   Result of the function.
+/// \retval DUST_RESULT_SUCCESS             On success.
+/// \retval DUST_RESULT_SIZE_ERROR          If the packet does not fit the data buffer.
+/// \retval DUST_RESULT_ERROR               Otherwise.
+///
+dust_result_t dust_view_parse(dust_view_t *const view, const uint8_t *const data, const uint32_t data_size,
+                              const uint32_t payload_size);
+
+///
+/// \brief Serializes the packet whose payload has been written in place.
+///
+/// The payload is expected at DUST_PACKET_DATA_POSITION of the data buffer already, only the header
+/// and the crc16 are written around it.
+///
+/// \param[in]     header                   The dust header.
+/// \param[in,out] data                     The serialized packet.
+/// \param[in]     data_size                The data buffer size.
+/// \param[in]     payload_size             The payload size.
+///
+/// \return dust_result_t                   Result of the function.
+/// \retval DUST_RESULT_SUCCESS             On success.
+/// \retval DUST_RESULT_SIZE_ERROR          If the packet does not fit the data buffer.
+/// \retval DUST_RESULT_ERROR               Otherwise.
+///
+dust_result_t dust_view_serialize(const dust_header_t *const header, uint8_t *const data, const uint32_t data_size,
+                                  const uint32_t payload_size);
+
 ///
 /// \brief Transmit the serialized packet.
 ///
@@ -269,6 +421,59 @@ dust_result_t dust_receive(dust_serialized_t *const serialized, const uint32_t u
 ///
 dust_result_t dust_handshake(dust_protocol_instance_t *const instance, const uint32_t usart);
 
+///
+/// \brief Process the received handshake packet.
+///
+/// Parses the handshake packet in place and applies the received options, for the packets received
+/// outside of dust_receive(). The options out of range fail the handshake, the header of the packet
+/// is kept to answer it.
+///
+/// \param[in,out] instance     The dust protocol instance.
+/// \param[in]     data         The serialized handshake packet.
+/// \param[in]     data_size    The serialized handshake packet size.
+///
+/// \return dust_result_t       Result of the function.
+/// \retval DUST_RESULT_SUCCESS On success.
+/// \retval DUST_RESULT_ERROR   Otherwise.
+///
+dust_result_t dust_handshake_process(dust_protocol_instance_t *const instance, const uint8_t *const data,
+                                     const uint32_t data_size);
+
+///
+/// \brief Serializes the capabilities answering the handshake.
+///
+/// The payload holds DUST_EXT_OPCODE_CAPABILITIES, the maximum payload size BE16, the number of
+/// baud rates and the baud rates BE32.
+///
+/// \param[in]  capabilities       The link capabilities.
+/// \param[out] payload            The payload buffer.
+/// \param[in]  payload_size       The payload size.
+///
+/// \return dust_result_t          Result of the function.
+/// \retval DUST_RESULT_SUCCESS    On success.
+/// \retval DUST_RESULT_SIZE_ERROR If the capabilities do not fit the payload.
+/// \retval DUST_RESULT_ERROR      Otherwise.
+///
+dust_result_t dust_capabilities_serialize(const dust_capabilities_t *const capabilities, uint8_t *const payload,
+                                          const uint32_t payload_size);
+
+///
+/// \brief Deserializes the settings picked by the host.
+///
+/// The payload holds DUST_EXT_OPCODE_SETTINGS, the payload size BE16, the baud rate BE32 and the
+/// number of packets BE32.
+///
+/// \param[out] settings           The link settings.
+/// \param[in]  payload            The payload buffer.
+/// \param[in]  payload_size       The payload size.
+///
+/// \return dust_result_t          Result of the function.
+/// \retval DUST_RESULT_SUCCESS    On success.
+/// \retval DUST_RESULT_ERROR      If the payload is not the settings message.
+///
+dust_result_t dust_settings_deserialize(dust_settings_t *const settings, const uint8_t *const payload,
+                                        const uint32_t payload_size);
+
 #if (defined(DEBUG_DUST_PROTOCOL) && (DEBUG_DUST_PROTOCOL == 1))
 ///
 /// \brief Print the content of the dust header.
@@ -0,0 +1,215 @@
+#include "dust_arq.h"
+
+///*************************************************************************************************
+/// Private functions - declaration.
+///*************************************************************************************************
+///
+/// \brief Gets the number of packets of the current window.
+///
+/// \param[in] arq      The selective repeat receiver.
+///
+/// \return uint32_t    The number of packets, the last window may be shorter.
+///
+static uint32_t dust_arq_window_length(const dust_arq_t *const arq);
+
+///
+/// \brief Gets the packet offset from the window base in the packet number space.
+///
+/// \param[in] arq           The selective repeat receiver.
+/// \param[in] packet_number The 11-bit packet number.
+///
+/// \return uint32_t         The offset, modulo DUST_ARQ_SEQUENCE_SIZE.
+///
+static uint32_t dust_arq_offset(const dust_arq_t *const arq, const uint32_t packet_number);
+
+///
+/// \brief Gets the header length field for the payload size.
+///
+/// \param[in] payload_size   The payload size.
+///
+/// \return dust_length_t     The header length field.
+///
+static dust_length_t dust_arq_length(const uint32_t payload_size);
+
+///*************************************************************************************************
+/// Private functions - definition.
+///*************************************************************************************************
+static uint32_t dust_arq_window_length(const dust_arq_t *const arq)
+{
+    uint32_t length = arq->total - arq->base;
+
+    return (length < arq->window) ? length : arq->window;
+}
+
+static uint32_t dust_arq_offset(const dust_arq_t *const arq, const uint32_t packet_number)
+{
+    return (packet_number - arq->base) & (DUST_ARQ_SEQUENCE_SIZE - 1);
+}
+
+static dust_length_t dust_arq_length(const uint32_t payload_size)
+{
+    return (payload_size <= 0x20) ? DUST_LENGTH_BYTES32
+         : (payload_size <= 0x40) ? DUST_LENGTH_BYTES64
+         : (payload_size <= 0x80) ? DUST_LENGTH_BYTES128
+         : DUST_LENGTH_BYTES256;
+}
+
+///*************************************************************************************************
+/// Global functions - definition.
+///*************************************************************************************************
+dust_result_t dust_arq_init(dust_arq_t *const arq, const uint32_t total, const uint32_t window)
+{
+    if ((arq == NULL) || (window == 0) || (window > DUST_ARQ_WINDOW_MAX))
+    {
+        return DUST_RESULT_ERROR;
+    }
+
+    memset(arq, 0, sizeof(dust_arq_t));
+
+    arq->total  = total;
+    arq->window = window;
+
+    return DUST_RESULT_SUCCESS;
+}
+
+dust_result_t dust_arq_resume(dust_arq_t *const arq, const uint32_t base)
+{
+    if ((arq == NULL) || (base > arq->total))
+    {
+        return DUST_RESULT_ERROR;
+    }
+
+    /* The packets before the base belong to no window the sender may poll again. */
+    arq->base     = base;
+    arq->previous = base;
+
+    return DUST_RESULT_SUCCESS;
+}
+
+uint32_t dust_arq_get_window(const uint8_t ack_frequency, const uint32_t payload_size)
+{
+    uint32_t window = dust_get_ack_frequency(ack_frequency);
+
+    if (window > (payload_size * 8))
+    {
+        window = payload_size * 8;
+    }
+
+    return (window > DUST_ARQ_WINDOW_MAX) ? DUST_ARQ_WINDOW_MAX : window;
+}
+
+dust_arq_rx_t dust_arq_receive(dust_arq_t *const arq, const dust_header_t *const header, uint32_t *const index)
+{
+    if ((arq == NULL) || (header == NULL) || (index == NULL))
+    {
+        return DUST_ARQ_RX_OUT_OF_WINDOW;
+    }
+
+    uint32_t offset = dust_arq_offset(arq, header->packet_number);
+
+    if (offset >= dust_arq_window_length(arq))
+    {
+        /* The retransmissions of the previous window are expected after a lost ACK. */
+        arq->out_of_window++;
+        return DUST_ARQ_RX_OUT_OF_WINDOW;
+    }
+
+    *index = arq->base + offset;
+
+    if (arq->bitmap[offset / 32] & (0x01u << (offset % 32)))
+    {
+        arq->duplicates++;
+        return DUST_ARQ_RX_DUPLICATE;
+    }
+
+    arq->bitmap[offset / 32] |= (0x01u << (offset % 32));
+    arq->received++;
+
+    return DUST_ARQ_RX_NEW;
+}
+
+void dust_arq_discard(dust_arq_t *const arq, const uint32_t index)
+{
+    if ((arq == NULL) || (index < arq->base) || ((index - arq->base) >= dust_arq_window_length(arq)))
+    {
+        return;
+    }
+
+    uint32_t offset = index - arq->base;
+
+    if (arq->bitmap[offset / 32] & (0x01u << (offset % 32)))
+    {
+        arq->bitmap[offset / 32] &= ~(0x01u << (offset % 32));
+        arq->received--;
+    }
+}
+
+dust_result_t dust_arq_ack_create(dust_arq_t *const arq, const dust_header_t *const poll,
+                                  dust_header_t *const header, uint8_t *const payload,
+                                  const uint32_t payload_size)
+{
+    if ((arq == NULL) || (poll == NULL) || (header == NULL) || (payload == NULL))
+    {
+        return DUST_RESULT_ERROR;
+    }
+
+    uint32_t base   = arq->base;
+    uint32_t length = dust_arq_window_length(arq);
+    uint32_t size   = payload_size;
+
+    if ((size == 0) || (size > DUST_PACKET_PAYLOAD_BUFFER_MAX_SIZE) || ((arq->window + 7) / 8 > size))
+    {
+        return DUST_RESULT_ERROR;
+    }
+
+    memset(&payload[0], 0, size);
+
+    if ((arq->base != arq->previous) &&
+        (dust_arq_offset(arq, poll->packet_number) >= (DUST_ARQ_SEQUENCE_SIZE - (arq->base - arq->previous))))
+    {
+        /* The previous window is complete, otherwise it would not have moved on. */
+        base   = arq->previous;
+        length = arq->base - arq->previous;
+
+        memset(&payload[0], 0xff, length / 8);
+
+        if (length % 8)
+        {
+            payload[length / 8] = (uint8_t)((0x01u << (length % 8)) - 1);
+        }
+    }
+    else
+    {
+        /* The bit n of the byte n / 8 names the packet base + n, LSB first. */
+        for (uint32_t i = 0; i < length; i++)
+        {
+            if (arq->bitmap[i / 32] & (0x01u << (i % 32)))
+            {
+                payload[i / 8] |= (uint8_t)(0x01u << (i % 8));
+            }
+        }
+
+        if (arq->received == length)
+        {
+            arq->previous = arq->base;
+            arq->base    += length;
+            arq->received = 0;
+            memset(&arq->bitmap[0], 0, sizeof(arq->bitmap));
+        }
+    }
+
+    (void)dust_header_create(header, DUST_OPCODE_DATA, dust_arq_length(size), DUST_ACK_SET,
+                             (uint16_t)(base & (DUST_ARQ_SEQUENCE_SIZE - 1)));
+
+    return DUST_RESULT_SUCCESS;
+}
+
+bool dust_arq_is_complete(const dust_arq_t *const arq)
+{
+    if (arq == NULL)
+    {
+        return false;
+    }
+
+    return arq->base >= arq->total;
+}
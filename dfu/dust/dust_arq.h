@@ -0,0 +1,140 @@
+#ifndef _DUST_ARQ_H
+#define _DUST_ARQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+#include "dust.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define DUST_ARQ_SEQUENCE_SIZE              (0x0800u)
+#define DUST_ARQ_WINDOW_MAX                 (0x0200u)
+#define DUST_ARQ_BITMAP_WORDS               (DUST_ARQ_WINDOW_MAX / 32u)
+
+///
+/// \brief The dust selective repeat reception result type.
+///
+typedef enum
+{
+    DUST_ARQ_RX_NEW = 0,
+    DUST_ARQ_RX_DUPLICATE,
+    DUST_ARQ_RX_OUT_OF_WINDOW,
+} dust_arq_rx_t;
+
+///
+/// \brief The dust selective repeat receiver type.
+///
+/// The sender transmits a window of packets numbered by the 11-bit header packet number and sets
+/// the ack flag of the last one to poll the receiver. The receiver answers every poll with a
+/// bitmap ACK naming the received packets of the window, the sender then retransmits the missing
+/// ones only. The window moves on once all of its packets have been received.
+///
+typedef struct
+{
+    uint32_t base;                          /*!< The index of the first packet of the window.          */
+    uint32_t previous;                      /*!< The index of the first packet of the previous window. */
+    uint32_t window;                        /*!< The window size in packets.                           */
+    uint32_t total;                         /*!< The number of packets of the transfer.                */
+    uint32_t received;                      /*!< The number of received packets of the window.         */
+    uint32_t bitmap[DUST_ARQ_BITMAP_WORDS];
+    uint32_t duplicates;
+    uint32_t out_of_window;
+} dust_arq_t;
+
+///
+/// \brief Initializes the selective repeat receiver.
+///
+/// \param[out] arq             The selective repeat receiver.
+/// \param[in]  total           The number of packets of the transfer.
+/// \param[in]  window          The window size, limited by DUST_ARQ_WINDOW_MAX.
+///
+/// \return dust_result_t       Result of the function.
+/// \retval DUST_RESULT_SUCCESS On success.
+/// \retval DUST_RESULT_ERROR   Otherwise.
+///
+dust_result_t dust_arq_init(dust_arq_t *const arq, const uint32_t total, const uint32_t window);
+
+///
+/// \brief Moves the first window to the packet an interrupted transfer resumes from.
+///
+/// \param[in,out] arq          The selective repeat receiver, initialized.
+/// \param[in]     base         The index of the first packet not received yet.
+///
+/// \return dust_result_t       Result of the function.
+/// \retval DUST_RESULT_SUCCESS On success.
+/// \retval DUST_RESULT_ERROR   Otherwise.
+///
+dust_result_t dust_arq_resume(dust_arq_t *const arq, const uint32_t base);
+
+///
+/// \brief Gets the window size both sides use for the given options.
+///
+/// The bitmap has to fit into one payload, so the window is limited by the payload size too.
+///
+/// \param[in] ack_frequency    The ack frequency from handshake options.
+/// \param[in] payload_size     The payload size from handshake options.
+///
+/// \return uint32_t            The window size in packets.
+///
+uint32_t dust_arq_get_window(const uint8_t ack_frequency, const uint32_t payload_size);
+
+///
+/// \brief Registers the received data packet.
+///
+/// \param[in,out] arq          The selective repeat receiver.
+/// \param[in]     header       The received packet header.
+/// \param[out]    index        The index of the packet within the transfer.
+///
+/// \return dust_arq_rx_t            The reception result.
+/// \retval DUST_ARQ_RX_NEW           The packet has to be stored at the given index.
+/// \retval DUST_ARQ_RX_DUPLICATE     The packet has already been received.
+/// \retval DUST_ARQ_RX_OUT_OF_WINDOW The packet does not belong to the window.
+///
+dust_arq_rx_t dust_arq_receive(dust_arq_t *const arq, const dust_header_t *const header, uint32_t *const index);
+
+///
+/// \brief Marks the received packet as missing again.
+///
+/// \note  It is meant for the packets which could not be stored, the sender retransmits them.
+///
+/// \param[in,out] arq          The selective repeat receiver.
+/// \param[in]     index        The index returned by dust_arq_receive().
+///
+void dust_arq_discard(dust_arq_t *const arq, const uint32_t index);
+
+///
+/// \brief Creates the bitmap ACK answering the poll.
+///
+/// A poll from the previous window, which happens when the sender has missed its ACK, is answered
+/// with that window fully received. The window moves on once the ACK names all of its packets.
+///
+/// \param[in,out] arq          The selective repeat receiver.
+/// \param[in]     poll         The header of the polling packet.
+/// \param[out]    header       The ACK header.
+/// \param[out]    payload      The ACK payload, the bitmap is written there in place.
+/// \param[in]     payload_size The ACK payload size.
+///
+/// \return dust_result_t       Result of the function.
+/// \retval DUST_RESULT_SUCCESS On success.
+/// \retval DUST_RESULT_ERROR   Otherwise.
+///
+dust_result_t dust_arq_ack_create(dust_arq_t *const arq, const dust_header_t *const poll,
+                                  dust_header_t *const header, uint8_t *const payload,
+                                  const uint32_t payload_size);
+
+///
+/// \brief Checks whether all packets have been received.
+///
+/// \param[in] arq              The selective repeat receiver.
+///
+/// \return bool                True if the transfer is complete, false otherwise.
+///
+bool dust_arq_is_complete(const dust_arq_t *const arq);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _DUST_ARQ_H */
@@ -0,0 +1,269 @@
+#include "dust_dma.h"
+#include <stdbool.h>
+
+///*************************************************************************************************
+/// Private objects - declaration.
+///*************************************************************************************************
+///
+/// \brief The dust DMA reception type.
+///
+/// The reception interrupts fill the buffers in turn and the receiver consumes them in the same
+/// order, a buffer is owned by the receiver while its ready flag is set.
+///
+typedef struct
+{
+    dust_serialized_t buffer[DUST_DMA_BUFFER_TOTAL];
+    volatile uint32_t ready[DUST_DMA_BUFFER_TOTAL];
+    uint32_t          fill;
+    uint32_t          position;
+    bool              drop;
+    uint32_t          next;
+    volatile uint32_t size;
+    dust_dma_stats_t  stats;
+    ll_usart_dma_inst_t inst;
+    bool              running;
+} dust_dma_t;
+
+///*************************************************************************************************
+/// Private objects - definition.
+///*************************************************************************************************
+///
+/// \brief Dust DMA reception instance.
+///
+static dust_dma_t dust_dma;
+
+///*************************************************************************************************
+/// Private functions - declaration.
+///*************************************************************************************************
+///
+/// \brief Prevents the compiler from reordering memory accesses across this point.
+///
+static inline void dust_dma_barrier(void);
+
+///
+/// \brief Completes the packet being assembled.
+///
+static void dust_dma_packet_complete(void);
+
+///
+/// \brief The USART reception callback, executed from the reception interrupts.
+///
+/// \param[in] arg  Unused.
+/// \param[in] data The received bytes.
+/// \param[in] len  The number of received bytes.
+/// \param[in] idle True if the line went idle after the received bytes.
+///
+static void dust_dma_rx_handler(void *const arg, const uint8_t *const data, const uint32_t len,
+                                const bool idle);
+
+///
+/// \brief Starts the USART reception at the given baud rate.
+///
+/// \param[in] baud             The baud rate.
+///
+/// \return dust_result_t       Result of the function.
+///
+static dust_result_t dust_dma_rx_init(const uint32_t baud);
+
+///*************************************************************************************************
+/// Private functions - definition.
+///*************************************************************************************************
+static inline void dust_dma_barrier(void)
+{
+    __asm volatile ("" ::: "memory");
+}
+
+static void dust_dma_packet_complete(void)
+{
+    if (dust_dma.drop)
+    {
+        /* Both buffers were owned by the receiver for the whole packet. */
+        dust_dma.stats.overruns++;
+    }
+    else
+    {
+        dust_dma.buffer[dust_dma.fill].buffer_size = dust_dma.size;
+        dust_dma.stats.packets++;
+        dust_dma.stats.bytes += dust_dma.size;
+
+        dust_dma_barrier();
+        dust_dma.ready[dust_dma.fill] = 1;
+        dust_dma.fill ^= 0x01;
+    }
+
+    dust_dma.position = 0;
+}
+
+static void dust_dma_rx_handler(void *const arg, const uint8_t *const data, const uint32_t len,
+                                const bool idle)
+{
+    (void)arg;
+
+    uint32_t index = 0;
+
+    while (index < len)
+    {
+        if (dust_dma.position == 0)
+        {
+            /* The packet is dropped as a whole, a buffer released in the middle stays unused. */
+            dust_dma.drop = (dust_dma.ready[dust_dma.fill] != 0);
+        }
+
+        uint32_t chunk = dust_dma.size - dust_dma.position;
+
+        if (chunk > (len - index))
+        {
+            chunk = len - index;
+        }
+
+        if (!dust_dma.drop)
+        {
+            memcpy(&dust_dma.buffer[dust_dma.fill].buffer[dust_dma.position], &data[index], chunk);
+        }
+
+        dust_dma.position += chunk;
+        index             += chunk;
+
+        if (dust_dma.position == dust_dma.size)
+        {
+            dust_dma_packet_complete();
+        }
+    }
+
+    if (idle && (dust_dma.position != 0))
+    {
+        /* A byte was lost, the host waits for the reply now, so the next packet starts aligned. */
+        dust_dma.stats.truncated++;
+        dust_dma.position = 0;
+    }
+}
+
+static dust_result_t dust_dma_rx_init(const uint32_t baud)
+{
+    const struct ll_usart_dma_conf conf =
+    {
+        .baud   = baud,
+        .parity = LL_USART_DMA_PARITY_NONE,
+        .stop   = LL_USART_DMA_STOP_1,
+        .inv    = false,
+        .tx     = true,
+    };
+
+    if (ll_usart_dma_rx_init(dust_dma.inst, &conf, &dust_dma_rx_handler, NULL) != LL_USART_DMA_RES_OK)
+    {
+        return DUST_RESULT_ERROR;
+    }
+
+    return DUST_RESULT_SUCCESS;
+}
+
+///*************************************************************************************************
+/// Global functions - definition.
+///*************************************************************************************************
+dust_result_t dust_dma_start(const ll_usart_dma_inst_t inst, const uint32_t baud, const uint32_t size)
+{
+    dust_dma_stop();
+
+    memset(&dust_dma, 0, sizeof(dust_dma));
+
+    if (dust_dma_set_size(size) != DUST_RESULT_SUCCESS)
+    {
+        return DUST_RESULT_SIZE_ERROR;
+    }
+
+    dust_dma.inst = inst;
+
+    if (dust_dma_rx_init(baud) != DUST_RESULT_SUCCESS)
+    {
+        return DUST_RESULT_ERROR;
+    }
+
+    dust_dma.running = true;
+
+    return DUST_RESULT_SUCCESS;
+}
+
+void dust_dma_stop(void)
+{
+    if (!dust_dma.running)
+    {
+        return;
+    }
+
+    ll_usart_dma_rx_deinit(dust_dma.inst);
+    dust_dma.running = false;
+}
+
+dust_result_t dust_dma_set_size(const uint32_t size)
+{
+    if ((size == 0) || (size > sizeof(dust_dma.buffer[0].buffer)))
+    {
+        return DUST_RESULT_SIZE_ERROR;
+    }
+
+    dust_dma.size = size;
+
+    return DUST_RESULT_SUCCESS;
+}
+
+dust_result_t dust_dma_set_baud(const uint32_t baud)
+{
+    if (!dust_dma.running)
+    {
+        return DUST_RESULT_ERROR;
+    }
+
+    ll_usart_dma_rx_deinit(dust_dma.inst);
+
+    /* The bytes received at the previous baud rate are discarded, the statistics are kept. */
+    for (uint32_t i = 0; i < DUST_DMA_BUFFER_TOTAL; i++)
+    {
+        dust_dma.ready[i] = 0;
+    }
+
+    dust_dma.fill     = 0;
+    dust_dma.position = 0;
+    dust_dma.drop     = false;
+    dust_dma.next     = 0;
+
+    if (dust_dma_rx_init(baud) != DUST_RESULT_SUCCESS)
+    {
+        dust_dma.running = false;
+
+        return DUST_RESULT_ERROR;
+    }
+
+    return DUST_RESULT_SUCCESS;
+}
+
+const dust_serialized_t* dust_dma_receive(void)
+{
+    while (dust_dma.ready[dust_dma.next] == 0);
+
+    dust_dma_barrier();
+
+    return &dust_dma.buffer[dust_dma.next];
+}
+
+void dust_dma_release(const dust_serialized_t *const serialized)
+{
+    if (serialized != &dust_dma.buffer[dust_dma.next])
+    {
+        return;
+    }
+
+    dust_dma_barrier();
+
+    dust_dma.ready[dust_dma.next] = 0;
+    dust_dma.next ^= 0x01;
+}
+
+void dust_dma_get_stats(dust_dma_stats_t *const stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    *stats = dust_dma.stats;
+}
@@ -0,0 +1,102 @@
+#ifndef _DUST_DMA_H
+#define _DUST_DMA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+#include "dust.h"
+#include "ll_usart_dma.h"
+#include <stdint.h>
+
+#define DUST_DMA_BUFFER_TOTAL               (0x0002u)
+
+///
+/// \brief The dust DMA reception statistics type.
+///
+typedef struct
+{
+    uint32_t packets;                       /*!< The number of packets handed over to the receiver.    */
+    uint32_t bytes;                         /*!< The number of bytes handed over to the receiver.      */
+    uint32_t overruns;                      /*!< The packets dropped while both buffers were owned.    */
+    uint32_t truncated;                     /*!< The partial packets dropped on the idle line.         */
+} dust_dma_stats_t;
+
+///
+/// \brief Starts the DMA reception.
+///
+/// The received bytes are assembled into two ping-pong packet buffers from the reception
+/// interrupts, so the next packet lands in RAM while the previous one is being processed. A
+/// partial packet is dropped when the line goes idle, which resynchronizes the framing after a
+/// lost byte.
+///
+/// \param[in] inst             The USART DMA instance.
+/// \param[in] baud             The baud rate.
+/// \param[in] size             The serialized packet size.
+///
+/// \return dust_result_t       Result of the function.
+/// \retval DUST_RESULT_SUCCESS On success.
+/// \retval DUST_RESULT_ERROR   Otherwise.
+///
+dust_result_t dust_dma_start(const ll_usart_dma_inst_t inst, const uint32_t baud, const uint32_t size);
+
+///
+/// \brief Stops the DMA reception.
+///
+void dust_dma_stop(void);
+
+///
+/// \brief Sets the serialized packet size.
+///
+/// \note  It must be called before the peer is allowed to send the packets of the new size,
+///        e.g. right before acknowledging the handshake.
+///
+/// \param[in] size             The serialized packet size.
+///
+/// \return dust_result_t       Result of the function.
+/// \retval DUST_RESULT_SUCCESS On success.
+/// \retval DUST_RESULT_SIZE_ERROR If the size does not fit the packet buffer.
+///
+dust_result_t dust_dma_set_size(const uint32_t size);
+
+///
+/// \brief Switches the reception to another baud rate.
+///
+/// The packet being assembled and the packets not released yet are discarded.
+///
+/// \note  The transmitter must be idle, e.g. the acknowledgment of the new setting sent out.
+///
+/// \param[in] baud             The baud rate.
+///
+/// \return dust_result_t       Result of the function.
+/// \retval DUST_RESULT_SUCCESS On success.
+/// \retval DUST_RESULT_ERROR   If the reception is not running or the baud rate is refused.
+///
+dust_result_t dust_dma_set_baud(const uint32_t baud);
+
+///
+/// \brief Waits for the next received packet.
+///
+/// \return const dust_serialized_t* The received packet, owned by the caller until released.
+///
+const dust_serialized_t* dust_dma_receive(void);
+
+///
+/// \brief Hands the received packet buffer back to the reception interrupts.
+///
+/// \param[in] serialized       The packet returned by dust_dma_receive().
+///
+void dust_dma_release(const dust_serialized_t *const serialized);
+
+///
+/// \brief Gets the reception statistics.
+///
+/// \param[out] stats           The reception statistics.
+///
+void dust_dma_get_stats(dust_dma_stats_t *const stats);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _DUST_DMA_H */
@@ -0,0 +1,189 @@
+#include "delta.h"
+#include "dust.h"
+#include <stddef.h>
+#include <string.h>
+
+///*************************************************************************************************
+/// Private objects - definition.
+///*************************************************************************************************
+///
+/// \brief The reflected CRC-32 look-up table of the nibbles, small enough for the updater.
+///
+static const uint32_t delta_crc32_lut[16] =
+{
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c,
+};
+
+///*************************************************************************************************
+/// Private functions - declaration.
+///*************************************************************************************************
+///
+/// \brief Gets the size of the block within the image, the last one may be shorter.
+///
+/// \param[in] delta The delta update.
+/// \param[in] block The block index.
+///
+/// \return uint32_t The block size.
+///
+static uint32_t block_size(const delta_t *const delta, const uint32_t block);
+
+///*************************************************************************************************
+/// Private functions - definition.
+///*************************************************************************************************
+static uint32_t block_size(const delta_t *const delta, const uint32_t block)
+{
+    uint32_t size = delta->image_size - (block * DELTA_BLOCK_SIZE);
+
+    return (size < DELTA_BLOCK_SIZE) ? size : DELTA_BLOCK_SIZE;
+}
+
+///*************************************************************************************************
+/// Global functions - definition.
+///*************************************************************************************************
+uint32_t delta_hash(const uint8_t *const data, const uint32_t size)
+{
+    uint32_t crc = 0xffffffff;
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        crc  = (crc >> 4) ^ delta_crc32_lut[crc & 0x0f];
+        crc  = (crc >> 4) ^ delta_crc32_lut[crc & 0x0f];
+    }
+
+    return ~crc;
+}
+
+delta_res_t delta_init(delta_t *const delta, const uint32_t image_size)
+{
+    if ((delta == NULL) || (image_size == 0) || (image_size > (DELTA_BLOCKS_MAX * DELTA_BLOCK_SIZE)))
+    {
+        return DELTA_RES_ERR;
+    }
+
+    memset(delta, 0, sizeof(delta_t));
+
+    delta->image_size = image_size;
+    delta->blocks     = (image_size + DELTA_BLOCK_SIZE - 1) / DELTA_BLOCK_SIZE;
+
+    return DELTA_RES_OK;
+}
+
+delta_res_t delta_manifest_process(delta_t *const delta, const uint8_t *const payload, const uint32_t size)
+{
+    if ((delta == NULL) || (payload == NULL) || (size < DELTA_MANIFEST_HEADER) ||
+        (payload[DUST_EXT_OPCODE_POSITION] != DUST_EXT_OPCODE_MANIFEST))
+    {
+        return DELTA_RES_ERR;
+    }
+
+    uint32_t first = ((uint32_t)payload[1] << 0x08) | payload[2];
+    uint32_t count = payload[3];
+
+    if (((first + count) > delta->blocks) || ((DELTA_MANIFEST_HEADER + (count * 4)) > size))
+    {
+        return DELTA_RES_ERR;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const uint8_t *hash  = &payload[DELTA_MANIFEST_HEADER + (i * 4)];
+        uint32_t       block = first + i;
+
+        delta->hash[block] = ((uint32_t)hash[0] << 0x18) | ((uint32_t)hash[1] << 0x10) |
+                             ((uint32_t)hash[2] << 0x08) | ((uint32_t)hash[3] << 0x00);
+
+        if ((delta->manifest[block / 8] & (0x01u << (block % 8))) == 0)
+        {
+            delta->manifest[block / 8] |= (uint8_t)(0x01u << (block % 8));
+            delta->received++;
+        }
+    }
+
+    return DELTA_RES_OK;
+}
+
+bool delta_manifest_is_complete(const delta_t *const delta)
+{
+    if (delta == NULL)
+    {
+        return false;
+    }
+
+    return delta->received == delta->blocks;
+}
+
+void delta_compare(delta_t *const delta, const uint8_t *const image)
+{
+    if ((delta == NULL) || (image == NULL))
+    {
+        return;
+    }
+
+    delta->count = 0;
+
+    for (uint32_t block = 0; block < delta->blocks; block++)
+    {
+        if (delta_hash(&image[block * DELTA_BLOCK_SIZE], block_size(delta, block)) != delta->hash[block])
+        {
+            delta->list[delta->count++] = (uint16_t)block;
+        }
+    }
+}
+
+bool delta_block_differs(const delta_t *const delta, const uint32_t block)
+{
+    if (delta == NULL)
+    {
+        return true;
+    }
+
+    for (uint32_t i = 0; i < delta->count; i++)
+    {
+        if (delta->list[i] == block)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+delta_res_t delta_blocks_create(const delta_t *const delta, uint8_t *const payload, const uint32_t size)
+{
+    if ((delta == NULL) || (payload == NULL) || ((DELTA_BLOCKS_HEADER + ((delta->blocks + 7) / 8)) > size))
+    {
+        return DELTA_RES_ERR;
+    }
+
+    memset(payload, 0, size);
+
+    payload[DUST_EXT_OPCODE_POSITION] = DUST_EXT_OPCODE_BLOCKS;
+    payload[1] = (uint8_t)(delta->count >> 0x08);
+    payload[2] = (uint8_t)(delta->count >> 0x00);
+
+    for (uint32_t i = 0; i < delta->count; i++)
+    {
+        payload[DELTA_BLOCKS_HEADER + (delta->list[i] / 8)] |= (uint8_t)(0x01u << (delta->list[i] % 8));
+    }
+
+    return DELTA_RES_OK;
+}
+
+uint32_t delta_get_packets(const delta_t *const delta, const uint32_t payload_size)
+{
+    if ((delta == NULL) || (payload_size == 0))
+    {
+        return 0;
+    }
+
+    return delta->count * (DELTA_BLOCK_SIZE / payload_size);
+}
+
+uint32_t delta_get_offset(const delta_t *const delta, const uint32_t index, const uint32_t payload_size)
+{
+    uint32_t packets = DELTA_BLOCK_SIZE / payload_size;
+
+    return (delta->list[index / packets] * DELTA_BLOCK_SIZE) + ((index % packets) * payload_size);
+}
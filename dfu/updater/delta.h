@@ -0,0 +1,137 @@
+#ifndef _DELTA_H
+#define _DELTA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define DELTA_BLOCK_SIZE        (0x0400u)   /*!< The block size, a multiple of every payload size.    */
+#define DELTA_BLOCKS_MAX        (0x0040u)   /*!< The blocks of the 64 KB app region.                  */
+#define DELTA_MANIFEST_HEADER   (0x0004u)   /*!< Extended opcode, first block BE16, number of hashes. */
+#define DELTA_BLOCKS_HEADER     (0x0003u)   /*!< Extended opcode, number of blocks BE16.              */
+
+///
+/// \brief The delta result type.
+///
+typedef enum
+{
+    DELTA_RES_OK = 0,
+    DELTA_RES_ERR,
+} delta_res_t;
+
+///
+/// \brief The delta update type.
+///
+/// The host sends the manifest holding the hash of every block of the new image, the updater
+/// compares them against the hashes of the installed image and replies with the bitmap of the
+/// blocks which differ. The data packets carry these blocks only, in the ascending order.
+///
+typedef struct
+{
+    uint32_t image_size;
+    uint32_t blocks;                        /*!< The number of blocks of the new image.                */
+    uint32_t hash[DELTA_BLOCKS_MAX];
+    uint8_t  manifest[DELTA_BLOCKS_MAX / 8];/*!< The blocks whose hash has been received.              */
+    uint32_t received;
+    uint16_t list[DELTA_BLOCKS_MAX];        /*!< The blocks to transfer.                               */
+    uint32_t count;
+} delta_t;
+
+///
+/// \brief Calculates the block hash, the CRC-32 of IEEE 802.3 as zlib.crc32() does.
+///
+/// \param[in] data The block data.
+/// \param[in] size The block size.
+///
+/// \return uint32_t The hash.
+///
+uint32_t delta_hash(const uint8_t *const data, const uint32_t size);
+
+///
+/// \brief Initializes the delta update.
+///
+/// \param[out] delta      The delta update.
+/// \param[in]  image_size The size of the new image.
+///
+/// \return delta_res_t  Result of the function.
+/// \retval DELTA_RES_OK On success.
+/// \retval DELTA_RES_ERR If the image does not fit DELTA_BLOCKS_MAX blocks.
+///
+delta_res_t delta_init(delta_t *const delta, const uint32_t image_size);
+
+///
+/// \brief Processes the manifest message.
+///
+/// The message may be received more than once, the hashes are stored by their block index.
+///
+/// \param[in,out] delta   The delta update.
+/// \param[in]     payload The DUST_EXT_OPCODE_MANIFEST payload.
+/// \param[in]     size    The payload size.
+///
+/// \return delta_res_t  Result of the function.
+/// \retval DELTA_RES_OK On success.
+/// \retval DELTA_RES_ERR Otherwise.
+///
+delta_res_t delta_manifest_process(delta_t *const delta, const uint8_t *const payload, const uint32_t size);
+
+///
+/// \brief Checks whether the hashes of all blocks have been received.
+///
+/// \param[in] delta The delta update.
+///
+/// \return bool True if the manifest is complete, false otherwise.
+///
+bool delta_manifest_is_complete(const delta_t *const delta);
+
+///
+/// \brief Compares the manifest against the installed image.
+///
+/// \param[in,out] delta The delta update.
+/// \param[in]     image The installed image.
+///
+void delta_compare(delta_t *const delta, const uint8_t *const image);
+
+///
+/// \brief Checks whether the block has to be transferred.
+///
+/// \param[in] delta The delta update.
+/// \param[in] block The block index.
+///
+/// \return bool True if the block differs, false if it is kept.
+///
+bool delta_block_differs(const delta_t *const delta, const uint32_t block);
+
+///
+/// \brief Creates the blocks message naming the blocks to transfer.
+///
+/// \param[in]  delta   The delta update.
+/// \param[out] payload The DUST_EXT_OPCODE_BLOCKS payload, bit n of byte 3 + n / 8 names the block n.
+/// \param[in]  size    The payload size.
+///
+/// \return delta_res_t  Result of the function.
+/// \retval DELTA_RES_OK On success.
+/// \retval DELTA_RES_ERR If the bitmap does not fit the payload.
+///
+delta_res_t delta_blocks_create(const delta_t *const delta, uint8_t *const payload, const uint32_t size);
+
+///
+/// \brief Gets the number of data packets carrying the blocks to transfer.
+///
+/// \param[in] delta        The delta update.
+/// \param[in] payload_size The payload size.
+///
+/// \return uint32_t The number of packets.
+///
+uint32_t delta_get_packets(const delta_t *const delta, const uint32_t payload_size);
+
+///
+/// \brief Gets the image offset of the data packet.
+///
+/// \param[in] delta        The delta update.
+/// \param[in] index        The index of the packet within the transfer.
+/// \param[in] payload_size The payload size.
+///
+/// \return uint32_t The offset from the start of the image.
+///
+uint32_t delta_get_offset(const delta_t *const delta, const uint32_t index, const uint32_t payload_size);
+
+#endif /* _DELTA_H */
@@ -0,0 +1,181 @@
+#include "flash_writer.h"
+#include "cache.h"
+#include "timing.h"
+#include "libopencm3/stm32/flash.h"
+#include <stddef.h>
+#include <string.h>
+
+///
+/// \brief The flash status errors cleared before and checked after the programming sequence.
+///
+#define FLASH_WRITER_SR_ERR     (FLASH_SR_OPERR | FLASH_SR_WRPERR | FLASH_SR_PGAERR | FLASH_SR_PGPERR | \
+                                 FLASH_SR_ERSERR)
+
+///
+/// \brief The programming parallelism.
+///
+/// The x64 parallelism needs the external VPP supply, which the board does not provide, so x32 is
+/// the widest one available at 2.7 - 3.6 V.
+///
+#define FLASH_WRITER_PSIZE      (FLASH_CR_PROGRAM_X32 << FLASH_CR_PROGRAM_SHIFT)
+
+///*************************************************************************************************
+/// Private objects - declaration.
+///*************************************************************************************************
+///
+/// \brief The flash writer type.
+///
+typedef struct
+{
+    uint32_t             addr;
+    flash_writer_stats_t stats;
+} flash_writer_t;
+
+///*************************************************************************************************
+/// Private objects - definition.
+///*************************************************************************************************
+///
+/// \brief The flash writer instance.
+///
+static flash_writer_t flash_writer;
+
+///*************************************************************************************************
+/// Private functions - declaration.
+///*************************************************************************************************
+///
+/// \brief Waits for the end of the ongoing flash operation.
+///
+static inline void wait_busy(void);
+
+///
+/// \brief Completes the outstanding memory accesses.
+///
+static inline void dsb(void);
+
+///
+/// \brief Programs the block with a single programming sequence.
+///
+/// \param[in] addr The block address.
+/// \param[in] data The block data.
+/// \param[in] size The block size.
+///
+/// \return flash_writer_res_t   The flash writer result.
+/// \retval FLASH_WRITER_RES_OK  On success.
+/// \retval FLASH_WRITER_RES_ERR Otherwise.
+///
+static flash_writer_res_t program(const uint32_t addr, const uint8_t *const data, const uint32_t size);
+
+///*************************************************************************************************
+/// Private functions - definition.
+///*************************************************************************************************
+static inline void wait_busy(void)
+{
+    while (FLASH_SR & FLASH_SR_BSY);
+}
+
+static inline void dsb(void)
+{
+    __asm volatile ("dsb" ::: "memory");
+}
+
+static flash_writer_res_t program(const uint32_t addr, const uint8_t *const data, const uint32_t size)
+{
+    uint32_t word;
+
+    wait_busy();
+
+    FLASH_SR = FLASH_WRITER_SR_ERR;
+    FLASH_CR = (FLASH_CR & ~(FLASH_CR_PROGRAM_MASK << FLASH_CR_PROGRAM_SHIFT)) | FLASH_WRITER_PSIZE | FLASH_CR_PG;
+
+    /* The interface stalls the bus on a write issued while the previous word is still being
+     * programmed, so the words are written back to back. The barrier keeps the AXI from merging
+     * two words into one wider write, which would be a parallelism error. */
+    for (uint32_t i = 0; i < size; i += FLASH_WRITER_ALIGN)
+    {
+        memcpy(&word, &data[i], sizeof(word));
+
+        *(volatile uint32_t*)(addr + i) = word;
+        dsb();
+    }
+
+    wait_busy();
+
+    FLASH_CR &= ~FLASH_CR_PG;
+
+    if (FLASH_SR & FLASH_WRITER_SR_ERR)
+    {
+        FLASH_SR = FLASH_WRITER_SR_ERR;
+        return FLASH_WRITER_RES_ERR;
+    }
+
+    return FLASH_WRITER_RES_OK;
+}
+
+///*************************************************************************************************
+/// Global functions - definition.
+///*************************************************************************************************
+void flash_writer_init(const uint32_t addr)
+{
+    memset(&flash_writer, 0, sizeof(flash_writer));
+
+    flash_writer.addr = addr;
+}
+
+void flash_writer_seek(const uint32_t addr)
+{
+    flash_writer.addr = addr;
+}
+
+flash_writer_res_t flash_writer_write(const uint8_t *const data, const uint32_t size)
+{
+    if ((data == NULL) || (size == 0) || ((size % FLASH_WRITER_ALIGN) != 0) ||
+        ((flash_writer.addr % FLASH_WRITER_ALIGN) != 0))
+    {
+        return FLASH_WRITER_RES_ERR;
+    }
+
+    flash_writer_res_t res;
+    uint32_t start = timing_cnt_get();
+
+    res = program(flash_writer.addr, data, size);
+
+    if (res == FLASH_WRITER_RES_OK)
+    {
+        /* The block may have been read before it was programmed, drop the stale cache lines. */
+        (void)cache_dcache_invalidate_range((void *)flash_writer.addr, size);
+
+        if (memcmp((const void *)flash_writer.addr, data, size) != 0)
+        {
+            res = FLASH_WRITER_RES_VERIFY_ERR;
+        }
+    }
+
+    flash_writer.stats.cycles += timing_cnt_get() - start;
+
+    if (res != FLASH_WRITER_RES_OK)
+    {
+        flash_writer.stats.errors++;
+        return res;
+    }
+
+    flash_writer.addr         += size;
+    flash_writer.stats.bytes  += size;
+    flash_writer.stats.blocks++;
+
+    return FLASH_WRITER_RES_OK;
+}
+
+uint32_t flash_writer_get_addr(void)
+{
+    return flash_writer.addr;
+}
+
+void flash_writer_get_stats(flash_writer_stats_t *const stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    *stats = flash_writer.stats;
+}
@@ -0,0 +1,79 @@
+#ifndef _FLASH_WRITER_H
+#define _FLASH_WRITER_H
+
+#include <stdint.h>
+
+#define FLASH_WRITER_ALIGN  (0x04u)     /*!< The block address and size alignment in bytes.          */
+
+///
+/// \brief The flash writer result type.
+///
+typedef enum
+{
+    FLASH_WRITER_RES_OK = 0,
+    FLASH_WRITER_RES_ERR,
+    FLASH_WRITER_RES_VERIFY_ERR,
+} flash_writer_res_t;
+
+///
+/// \brief The flash writer statistics type.
+///
+typedef struct
+{
+    uint32_t bytes;                     /*!< The number of programmed and verified bytes.           */
+    uint32_t blocks;                    /*!< The number of programmed and verified blocks.          */
+    uint32_t cycles;                    /*!< The cycles spent programming and verifying.            */
+    uint32_t errors;                    /*!< The number of failed blocks.                           */
+} flash_writer_stats_t;
+
+///
+/// \brief Initializes the flash writer.
+///
+/// \note  The flash memory has to be unlocked and the target sectors erased beforehand.
+///
+/// \param[in] addr The address of the first block, through the AXIM interface.
+///
+void flash_writer_init(const uint32_t addr);
+
+///
+/// \brief Sets the address of the next block.
+///
+/// \note  The blocks may be programmed in any order, as long as each one is programmed once.
+///
+/// \param[in] addr The address of the next block, through the AXIM interface.
+///
+void flash_writer_seek(const uint32_t addr);
+
+///
+/// \brief Programs the block at the current address and verifies it.
+///
+/// The whole block is programmed with a single programming sequence and one busy-wait at its end,
+/// then read back and compared against the source. The address advances on success only. A failed
+/// block is left partly programmed, the flash memory is not programmed twice without an erase, so
+/// the block cannot be written again before its sector is erased.
+///
+/// \param[in] data The block data.
+/// \param[in] size The block size, a multiple of FLASH_WRITER_ALIGN.
+///
+/// \return flash_writer_res_t          The flash writer result.
+/// \retval FLASH_WRITER_RES_OK         On success.
+/// \retval FLASH_WRITER_RES_VERIFY_ERR If the read back block differs from the source.
+/// \retval FLASH_WRITER_RES_ERR        Otherwise.
+///
+flash_writer_res_t flash_writer_write(const uint8_t *const data, const uint32_t size);
+
+///
+/// \brief Gets the address of the next block.
+///
+/// \return uint32_t The address.
+///
+uint32_t flash_writer_get_addr(void);
+
+///
+/// \brief Gets the flash writer statistics.
+///
+/// \param[out] stats The flash writer statistics.
+///
+void flash_writer_get_stats(flash_writer_stats_t *const stats);
+
+#endif /* _FLASH_WRITER_H */
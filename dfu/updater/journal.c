@@ -0,0 +1,147 @@
+#include "journal.h"
+#include "delta.h"
+#include <stddef.h>
+
+///*************************************************************************************************
+/// Private functions - declaration.
+///*************************************************************************************************
+///
+/// \brief Calculates the CRC-32 of the record fields.
+///
+/// \param[in] record The record.
+///
+/// \return uint32_t The CRC-32.
+///
+static uint32_t record_crc(const journal_record_t *const record);
+
+///
+/// \brief Checks whether the record slot is erased.
+///
+/// \param[in] record The record slot.
+///
+/// \return bool True if all the bytes read 0xff, false otherwise.
+///
+static bool record_is_erased(const journal_record_t *const record);
+
+///
+/// \brief Gets the newer of the valid records.
+///
+/// \param[in] shared The record in the shared SRAM.
+/// \param[in] flash  The newest record in flash, NULL if there is none.
+///
+/// \return const journal_record_t* The newer record, NULL if none is valid.
+///
+static const journal_record_t* newest(const journal_record_t *const shared, const journal_record_t *const flash);
+
+///*************************************************************************************************
+/// Private functions - definition.
+///*************************************************************************************************
+static uint32_t record_crc(const journal_record_t *const record)
+{
+    return delta_hash((const uint8_t *)record, offsetof(journal_record_t, crc));
+}
+
+static bool record_is_erased(const journal_record_t *const record)
+{
+    const uint32_t *word = (const uint32_t *)record;
+
+    for (uint32_t i = 0; i < (sizeof(journal_record_t) / sizeof(uint32_t)); i++)
+    {
+        if (word[i] != 0xffffffff)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static const journal_record_t* newest(const journal_record_t *const shared, const journal_record_t *const flash)
+{
+    const journal_record_t *record = NULL;
+
+    if ((flash != NULL) && journal_record_is_valid(flash))
+    {
+        record = flash;
+    }
+
+    /* The shared copy is written along every record in flash and in between, it is never older. */
+    if ((shared != NULL) && journal_record_is_valid(shared) &&
+        ((record == NULL) || (shared->sequence >= record->sequence)))
+    {
+        record = shared;
+    }
+
+    return record;
+}
+
+///*************************************************************************************************
+/// Global functions - definition.
+///*************************************************************************************************
+void journal_record_create(journal_record_t *const record, const uint32_t image_hash, const uint32_t image_size,
+                           const uint32_t committed, const uint32_t sequence)
+{
+    if (record == NULL)
+    {
+        return;
+    }
+
+    record->magic      = JOURNAL_MAGIC;
+    record->image_hash = image_hash;
+    record->image_size = image_size;
+    record->committed  = committed;
+    record->sequence   = sequence;
+    record->crc        = record_crc(record);
+}
+
+bool journal_record_is_valid(const journal_record_t *const record)
+{
+    return (record != NULL) && (record->magic == JOURNAL_MAGIC) && (record->crc == record_crc(record));
+}
+
+const journal_record_t* journal_find(const journal_record_t *const log, const uint32_t count, uint32_t *const free)
+{
+    const journal_record_t *record = NULL;
+    uint32_t i = 0;
+
+    if (log == NULL)
+    {
+        return NULL;
+    }
+
+    for (; (i < count) && !record_is_erased(&log[i]); i++)
+    {
+        if (journal_record_is_valid(&log[i]))
+        {
+            record = &log[i];
+        }
+    }
+
+    if (free != NULL)
+    {
+        *free = i;
+    }
+
+    return record;
+}
+
+uint32_t journal_resume(const journal_record_t *const shared, const journal_record_t *const flash,
+                        const uint32_t image_hash, const uint32_t image_size)
+{
+    const journal_record_t *record = newest(shared, flash);
+
+    if ((record == NULL) || (image_hash == 0) || (record->image_hash != image_hash) ||
+        (record->image_size != image_size) || (record->committed > image_size))
+    {
+        return 0;
+    }
+
+    return record->committed;
+}
+
+uint32_t journal_next_sequence(const journal_record_t *const shared, const journal_record_t *const flash)
+{
+    const journal_record_t *record = newest(shared, flash);
+
+    return (record == NULL) ? 0 : (record->sequence + 1);
+}
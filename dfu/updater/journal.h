@@ -0,0 +1,92 @@
+#ifndef _JOURNAL_H
+#define _JOURNAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define JOURNAL_MAGIC           (0x4c4e524au)   /*!< "JRNL", an erased record reads 0xffffffff.       */
+#define JOURNAL_INTERVAL        (0x1000u)       /*!< The progress between the records in flash.        */
+
+///
+/// \brief The progress journal record type.
+///
+/// The record names the image being transferred and the number of its bytes committed to the flash
+/// memory from the start, so a transfer of the same image can resume there. A copy in the shared
+/// SRAM survives the warm resets, the records appended to the flash sector survive the power loss.
+///
+typedef struct
+{
+    uint32_t magic;
+    uint32_t image_hash;                    /*!< The CRC-32 of the image, 0 for no transfer.           */
+    uint32_t image_size;
+    uint32_t committed;                     /*!< The bytes programmed from the start of the image.     */
+    uint32_t sequence;                      /*!< Increases with every record, the highest one wins.    */
+    uint32_t crc;                           /*!< The CRC-32 of the fields above.                       */
+} journal_record_t;
+
+///
+/// \brief The record copy the linker script places in the shared SRAM.
+///
+extern journal_record_t __journal_shared__;
+
+///
+/// \brief Creates the record.
+///
+/// \param[out] record     The record.
+/// \param[in]  image_hash The CRC-32 of the image, 0 for no transfer.
+/// \param[in]  image_size The image size.
+/// \param[in]  committed  The bytes programmed from the start of the image.
+/// \param[in]  sequence   The record sequence number.
+///
+void journal_record_create(journal_record_t *const record, const uint32_t image_hash, const uint32_t image_size,
+                           const uint32_t committed, const uint32_t sequence);
+
+///
+/// \brief Checks the record magic and CRC.
+///
+/// \param[in] record The record, possibly torn or left uninitialized.
+///
+/// \return bool True if the record is valid, false otherwise.
+///
+bool journal_record_is_valid(const journal_record_t *const record);
+
+///
+/// \brief Finds the newest record and the first erased slot of the records in flash.
+///
+/// The records are appended to the erased slots in order, a record torn by the power loss is
+/// skipped.
+///
+/// \param[in]  log   The records.
+/// \param[in]  count The number of the record slots.
+/// \param[out] free  The index of the first erased slot, count if the log is full.
+///
+/// \return const journal_record_t* The newest valid record, NULL if there is none.
+///
+const journal_record_t* journal_find(const journal_record_t *const log, const uint32_t count, uint32_t *const free);
+
+///
+/// \brief Gets the bytes of the image already committed by an interrupted transfer.
+///
+/// The newer of the valid records is taken, it has to name the same image.
+///
+/// \param[in] shared     The record in the shared SRAM.
+/// \param[in] flash      The newest record in flash, NULL if there is none.
+/// \param[in] image_hash The CRC-32 of the image, 0 never resumes.
+/// \param[in] image_size The image size.
+///
+/// \return uint32_t The committed bytes, 0 to start over.
+///
+uint32_t journal_resume(const journal_record_t *const shared, const journal_record_t *const flash,
+                        const uint32_t image_hash, const uint32_t image_size);
+
+///
+/// \brief Gets the sequence number of the next record.
+///
+/// \param[in] shared The record in the shared SRAM.
+/// \param[in] flash  The newest record in flash, NULL if there is none.
+///
+/// \return uint32_t The sequence number.
+///
+uint32_t journal_next_sequence(const journal_record_t *const shared, const journal_record_t *const flash);
+
+#endif /* _JOURNAL_H */
@@ -0,0 +1,223 @@
+#include "lz_decoder.h"
+#include <stddef.h>
+#include <string.h>
+
+#define LZ_DECODER_PAD          (0xffu)     /*!< The erased flash value.                              */
+#define LZ_DECODER_ALIGN        (0x04u)     /*!< The size alignment of the blocks handed over.        */
+
+///*************************************************************************************************
+/// Private objects - declaration.
+///*************************************************************************************************
+///
+/// \brief The LZ decoder state type.
+///
+typedef enum
+{
+    LZ_DECODER_STATE_FLAGS = 0,
+    LZ_DECODER_STATE_ITEM,
+    LZ_DECODER_STATE_MATCH,
+} lz_decoder_state_t;
+
+///
+/// \brief The LZ decoder type.
+///
+/// The decoded bytes are kept in the history window, which is also the output buffer, so the
+/// blocks are handed over to the sink straight from it.
+///
+typedef struct
+{
+    uint8_t            window[LZ_DECODER_WINDOW_SIZE];
+    uint32_t           pos;
+    uint32_t           size;
+    uint32_t           flushed;
+    uint8_t            flags;
+    uint8_t            items;
+    uint8_t            low;
+    lz_decoder_state_t state;
+    lz_decoder_res_t   res;
+    lz_decoder_sink_t  sink;
+    lz_decoder_stats_t stats;
+} lz_decoder_t;
+
+///*************************************************************************************************
+/// Private objects - definition.
+///*************************************************************************************************
+///
+/// \brief The LZ decoder instance.
+///
+static lz_decoder_t lz_decoder;
+
+///*************************************************************************************************
+/// Private functions - declaration.
+///*************************************************************************************************
+///
+/// \brief Appends the decoded byte and hands the full block over to the sink.
+///
+/// \param[in] byte The decoded byte.
+///
+/// \return lz_decoder_res_t Result of the sink.
+///
+static lz_decoder_res_t put(const uint8_t byte);
+
+///
+/// \brief Moves to the next item of the group.
+///
+static inline void next(void);
+
+///*************************************************************************************************
+/// Private functions - definition.
+///*************************************************************************************************
+static lz_decoder_res_t put(const uint8_t byte)
+{
+    lz_decoder.window[lz_decoder.pos & (LZ_DECODER_WINDOW_SIZE - 1)] = byte;
+    lz_decoder.pos++;
+
+    if ((lz_decoder.pos % LZ_DECODER_FLUSH_SIZE) != 0)
+    {
+        return LZ_DECODER_RES_OK;
+    }
+
+    /* The window is a multiple of the block, so the block never wraps around. */
+    lz_decoder.flushed = lz_decoder.pos;
+
+    return lz_decoder.sink(&lz_decoder.window[(lz_decoder.pos - LZ_DECODER_FLUSH_SIZE) & (LZ_DECODER_WINDOW_SIZE - 1)],
+                           LZ_DECODER_FLUSH_SIZE);
+}
+
+static inline void next(void)
+{
+    lz_decoder.flags >>= 1;
+    lz_decoder.items--;
+    lz_decoder.state = (lz_decoder.items != 0) ? LZ_DECODER_STATE_ITEM : LZ_DECODER_STATE_FLAGS;
+}
+
+///*************************************************************************************************
+/// Global functions - definition.
+///*************************************************************************************************
+lz_decoder_res_t lz_decoder_init(const uint32_t size, const lz_decoder_sink_t sink)
+{
+    memset(&lz_decoder, 0, sizeof(lz_decoder));
+
+    if (sink == NULL)
+    {
+        lz_decoder.res = LZ_DECODER_RES_ERR;
+        return LZ_DECODER_RES_ERR;
+    }
+
+    lz_decoder.size = size;
+    lz_decoder.sink = sink;
+
+    return LZ_DECODER_RES_OK;
+}
+
+lz_decoder_res_t lz_decoder_write(const uint8_t *const data, const uint32_t size)
+{
+    if (data == NULL)
+    {
+        return LZ_DECODER_RES_ERR;
+    }
+
+    for (uint32_t i = 0; (i < size) && (lz_decoder.res == LZ_DECODER_RES_OK) && (lz_decoder.pos < lz_decoder.size); i++)
+    {
+        uint8_t byte = data[i];
+
+        lz_decoder.stats.in++;
+
+        switch (lz_decoder.state)
+        {
+            case LZ_DECODER_STATE_FLAGS:
+                lz_decoder.flags = byte;
+                lz_decoder.items = 8;
+                lz_decoder.state = LZ_DECODER_STATE_ITEM;
+                break;
+
+            case LZ_DECODER_STATE_ITEM:
+                if (lz_decoder.flags & 0x01)
+                {
+                    lz_decoder.res = put(byte);
+                    lz_decoder.stats.literals++;
+                    next();
+                }
+                else
+                {
+                    lz_decoder.low   = byte;
+                    lz_decoder.state = LZ_DECODER_STATE_MATCH;
+                }
+                break;
+
+            case LZ_DECODER_STATE_MATCH:
+            {
+                uint32_t dist = (lz_decoder.low | ((uint32_t)(byte & 0xf0) << 4)) + 1;
+                uint32_t len  = (byte & 0x0f) + LZ_DECODER_MATCH_MIN;
+
+                if ((dist > lz_decoder.pos) || ((lz_decoder.pos + len) > lz_decoder.size))
+                {
+                    lz_decoder.res = LZ_DECODER_RES_ERR;
+                    break;
+                }
+
+                /* The match may overlap its own output, hence the bytewise copy. */
+                for (uint32_t k = 0; (k < len) && (lz_decoder.res == LZ_DECODER_RES_OK); k++)
+                {
+                    lz_decoder.res = put(lz_decoder.window[(lz_decoder.pos - dist) & (LZ_DECODER_WINDOW_SIZE - 1)]);
+                }
+
+                lz_decoder.stats.matches++;
+                next();
+                break;
+            }
+
+            default:
+                lz_decoder.res = LZ_DECODER_RES_ERR;
+                break;
+        }
+    }
+
+    lz_decoder.stats.out = lz_decoder.pos;
+
+    return lz_decoder.res;
+}
+
+lz_decoder_res_t lz_decoder_finish(void)
+{
+    if (lz_decoder.res != LZ_DECODER_RES_OK)
+    {
+        return lz_decoder.res;
+    }
+
+    if (lz_decoder.pos != lz_decoder.size)
+    {
+        lz_decoder.res = LZ_DECODER_RES_ERR;
+        return LZ_DECODER_RES_ERR;
+    }
+
+    uint32_t remaining = lz_decoder.pos - lz_decoder.flushed;
+
+    if (remaining == 0)
+    {
+        return LZ_DECODER_RES_OK;
+    }
+
+    /* The history is not needed anymore, the padding may overwrite it. */
+    while ((remaining % LZ_DECODER_ALIGN) != 0)
+    {
+        lz_decoder.window[(lz_decoder.flushed + remaining) & (LZ_DECODER_WINDOW_SIZE - 1)] = LZ_DECODER_PAD;
+        remaining++;
+    }
+
+    lz_decoder.res = lz_decoder.sink(&lz_decoder.window[lz_decoder.flushed & (LZ_DECODER_WINDOW_SIZE - 1)],
+                                     remaining);
+    lz_decoder.flushed = lz_decoder.pos;
+
+    return lz_decoder.res;
+}
+
+void lz_decoder_get_stats(lz_decoder_stats_t *const stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    *stats = lz_decoder.stats;
+}
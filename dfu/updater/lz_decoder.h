@@ -0,0 +1,92 @@
+#ifndef _LZ_DECODER_H
+#define _LZ_DECODER_H
+
+#include <stdint.h>
+
+#define LZ_DECODER_WINDOW_SIZE  (0x1000u)   /*!< The history window, the largest match distance.      */
+#define LZ_DECODER_FLUSH_SIZE   (0x0100u)   /*!< The output block handed over to the sink.            */
+#define LZ_DECODER_MATCH_MIN    (0x03u)     /*!< The shortest match length.                           */
+#define LZ_DECODER_MATCH_MAX    (0x12u)     /*!< The longest match length.                            */
+
+///
+/// \brief The LZ decoder result type.
+///
+typedef enum
+{
+    LZ_DECODER_RES_OK = 0,
+    LZ_DECODER_RES_ERR,
+    LZ_DECODER_RES_SINK_ERR,
+} lz_decoder_res_t;
+
+///
+/// \brief The LZ decoder output sink type.
+///
+/// \param[in] data The decoded block.
+/// \param[in] size The block size, a multiple of 4 bytes.
+///
+/// \return lz_decoder_res_t Result of the sink, anything but LZ_DECODER_RES_OK stops the decoding.
+///
+typedef lz_decoder_res_t (*lz_decoder_sink_t)(const uint8_t *const data, const uint32_t size);
+
+///
+/// \brief The LZ decoder statistics type.
+///
+typedef struct
+{
+    uint32_t in;                        /*!< The number of consumed compressed bytes.               */
+    uint32_t out;                       /*!< The number of decoded bytes.                           */
+    uint32_t literals;                  /*!< The number of decoded literals.                        */
+    uint32_t matches;                   /*!< The number of decoded matches.                         */
+} lz_decoder_stats_t;
+
+///
+/// \brief Initializes the LZ decoder.
+///
+/// The stream is LZSS coded, a flag byte precedes every group of eight items, its bit n, LSB
+/// first, tells whether the item n is a literal byte (1) or a match (0). A match takes two bytes,
+/// the 12-bit distance minus one, low byte first followed by its high nibble in the upper nibble of
+/// the second byte, and the length minus LZ_DECODER_MATCH_MIN in its lower nibble. The decoding
+/// ends with the image size, the padding of the last packet is ignored.
+///
+/// \param[in] size The decoded image size.
+/// \param[in] sink The output sink, called with LZ_DECODER_FLUSH_SIZE blocks.
+///
+/// \return lz_decoder_res_t     Result of the function.
+/// \retval LZ_DECODER_RES_OK    On success.
+/// \retval LZ_DECODER_RES_ERR   Otherwise.
+///
+lz_decoder_res_t lz_decoder_init(const uint32_t size, const lz_decoder_sink_t sink);
+
+///
+/// \brief Decodes the next part of the compressed stream.
+///
+/// The stream may be split at any byte, the decoder keeps its state across the calls.
+///
+/// \param[in] data The compressed bytes.
+/// \param[in] size The number of compressed bytes.
+///
+/// \return lz_decoder_res_t        Result of the function.
+/// \retval LZ_DECODER_RES_OK       On success.
+/// \retval LZ_DECODER_RES_SINK_ERR If the sink failed.
+/// \retval LZ_DECODER_RES_ERR      If the stream is corrupted.
+///
+lz_decoder_res_t lz_decoder_write(const uint8_t *const data, const uint32_t size);
+
+///
+/// \brief Flushes the last block, padded with 0xff to 4 bytes.
+///
+/// \return lz_decoder_res_t        Result of the function.
+/// \retval LZ_DECODER_RES_OK       On success.
+/// \retval LZ_DECODER_RES_SINK_ERR If the sink failed.
+/// \retval LZ_DECODER_RES_ERR      If the image has not been decoded completely.
+///
+lz_decoder_res_t lz_decoder_finish(void);
+
+///
+/// \brief Gets the LZ decoder statistics.
+///
+/// \param[out] stats The LZ decoder statistics.
+///
+void lz_decoder_get_stats(lz_decoder_stats_t *const stats);
+
+#endif /* _LZ_DECODER_H */
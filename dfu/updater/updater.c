@@ -1,6 +1,17 @@
+#include "boot_control.h"
+#include "cache.h"
+#include "delta.h"
 #include "dust.h"
+#include "dust_arq.h"
+#include "dust_dma.h"
+#include "flash_writer.h"
 #include "ghost_feather_common.h"
+#include "image_header.h"
+#include "journal.h"
+#include "lz_decoder.h"
+#include "memory_map.h"
 #include "printf.h"
+#include "timing.h"
 #include "updater.h"
 #include "ll_usart.h"
 #include "libopencm3/stm32/rcc.h"
@@ -13,6 +24,133 @@
 #define PSIZE_X32   (0x02u)
 #define PSIZE_X64   (0x03u)
 
+///
+/// \brief Gets the AXIM address of the flash memory the linker script places at the ITCM, the
+///        flash memory is programmed and read back through the AXIM.
+///
+#define UPDATER_ITCM_TO_AXIM(address) ((uint32_t)(address) - 0x00200000u + 0x08000000u)
+
+#define UPDATER_DUST_BAUDRATE       (115200u)
+#define UPDATER_DUST_HANDSHAKE_SIZE (DUST_PACKET_HEADER_SIZE + 0x20u + DUST_PACKET_CRC16_SIZE)
+#define UPDATER_BOOT_CTRL_ADDR      UPDATER_ITCM_TO_AXIM(&__boot_ctrl_start__) /*!< The sector 6.     */
+#define UPDATER_BOOT_CTRL_SECTOR    (6u)
+#define UPDATER_BOOT_CTRL_RECORDS   ((uint32_t)&__boot_ctrl_size__ / sizeof(boot_control_record_t))
+#define UPDATER_SLOT_NONE           (BOOT_CONTROL_SLOTS)
+#define UPDATER_JOURNAL_ADDR        UPDATER_ITCM_TO_AXIM(&__journal_start__)   /*!< The sector 7.     */
+#define UPDATER_JOURNAL_SECTOR      (7u)
+#define UPDATER_JOURNAL_RECORDS     ((uint32_t)&__journal_size__ / sizeof(journal_record_t))
+#define UPDATER_JOURNAL_SHARED      ((journal_record_t *)&__journal_shared__)
+
+///*************************************************************************************************
+/// Private objects - declaration.
+///*************************************************************************************************
+///
+/// \brief The update statistics type.
+///
+typedef struct
+{
+    uint32_t         bytes;
+    uint32_t         cycles;
+    uint32_t         bytes_per_second;
+    uint32_t         nacks;
+    uint32_t         image;
+    uint32_t         delta_blocks;
+    uint32_t         delta_total;
+    uint32_t         resumed;
+    lz_decoder_res_t lz_res;
+    dust_dma_stats_t rx;
+    flash_writer_stats_t flash;
+    lz_decoder_stats_t lz;
+} updater_stats_t;
+
+///
+/// \brief The app slot type.
+///
+typedef struct
+{
+    uint32_t *start;                        /*!< The linker symbol of the slot start, at the ITCM.   */
+    uint32_t  sector;
+    uint32_t *size;                         /*!< The linker symbol whose address is the slot size.   */
+} updater_slot_t;
+
+///
+/// \brief The boot-control state type.
+///
+typedef struct
+{
+    uint32_t active;                        /*!< The slot booted, UPDATER_SLOT_NONE if none is valid. */
+    uint32_t target;                        /*!< The inactive slot being programmed.                 */
+    uint32_t sequence;                      /*!< The sequence number of the next record.             */
+    uint32_t free;                          /*!< The first erased record slot in flash.              */
+    image_header_res_t result;              /*!< The check of the image programmed.                  */
+} updater_boot_t;
+
+///
+/// \brief The progress journal state type.
+///
+typedef struct
+{
+    uint32_t image_hash;                    /*!< The image being transferred, 0 if not resumable.   */
+    uint32_t image_size;
+    uint32_t committed;                     /*!< The committed bytes of the last record in flash.   */
+    uint32_t sequence;                      /*!< The sequence number of the next record.            */
+    uint32_t free;                          /*!< The first erased record slot in flash.             */
+} updater_journal_t;
+
+///*************************************************************************************************
+/// Private objects - definition.
+///*************************************************************************************************
+///
+/// \brief The statistics of the last update.
+///
+static updater_stats_t updater_stats;
+
+///
+/// \brief The selective repeat receiver of the last update.
+///
+static dust_arq_t updater_arq;
+
+///
+/// \brief The index of the next packet of the compressed stream.
+///
+static uint32_t updater_lz_next;
+
+///
+/// \brief The delta update of the last update.
+///
+static delta_t updater_delta;
+
+///
+/// \brief The progress journal of the last update.
+///
+static updater_journal_t updater_journal;
+
+///
+/// \brief The app slots, the sectors 4 and 5.
+///
+static const updater_slot_t updater_slots[BOOT_CONTROL_SLOTS] =
+{
+    { .start = &__app_start__,   .sector = 4u, .size = &__app_size__   },
+    { .start = &__app_b_start__, .sector = 5u, .size = &__app_b_size__ },
+};
+
+///
+/// \brief The boot control of the last update.
+///
+static updater_boot_t updater_boot;
+
+///
+/// \brief The link settings the host can pick from.
+///
+/// The USART is oversampled by 16 from the 54 MHz APB1 clock, the baud rates listed are within 1 %.
+///
+static const dust_capabilities_t updater_capabilities =
+{
+    .payload_size_max = DUST_PACKET_PAYLOAD_LARGE_MAX_SIZE,
+    .bauds            = { 115200u, 230400u, 460800u, 921600u, 1000000u, 2000000u, 3000000u },
+    .bauds_count      = 7,
+};
+
 ///*************************************************************************************************
 /// Private functions - declaration.
 ///*************************************************************************************************
@@ -27,10 +165,168 @@ static void led_on(void);
 static void led_off(void);
 
 ///
-/// \brief Transmits the packet.
+/// \brief Transmits the ACK or NACK answering the received packet.
+///
+/// The reply is built in place in the transmission buffer, its header mirrors the received one.
+///
+/// \param[in,out] instance The dust protocol instance.
+/// \param[in]     header   The header of the received packet.
+/// \param[in]     ack      DUST_ACK_SET for the ACK, DUST_ACK_UNSET for the NACK.
+///
+static void transmit_ack(dust_protocol_instance_t *const instance, const dust_header_t *const header,
+                         const dust_ack_t ack);
+
+///
+/// \brief Transmits the disconnect packet.
 ///
-static void transmit_ack(dust_packet_t *const packet, dust_serialized_t * serialized,
-                         dust_ack_t ack, const uint32_t usart);
+static void transmit_disconnect(dust_protocol_instance_t *const instance);
+
+///
+/// \brief Transmits the bitmap ACK answering the poll of the received packet.
+///
+static void transmit_bitmap(dust_protocol_instance_t *const instance, const dust_header_t *const poll);
+
+///
+/// \brief Transmits the blocks message naming the blocks of the delta update.
+///
+static void transmit_blocks(dust_protocol_instance_t *const instance, const dust_header_t *const header);
+
+///
+/// \brief Transmits the capabilities answering the handshake.
+///
+static void transmit_capabilities(dust_protocol_instance_t *const instance, const dust_header_t *const header);
+
+///
+/// \brief Refuses the handshake of the image linked to the active slot, the inactive one is named.
+///
+/// \param[in] instance The pointer to the dust protocol instance.
+///
+static void transmit_slot(dust_protocol_instance_t *const instance);
+
+///
+/// \brief Receives the link settings picked by the host out of the capabilities.
+///
+/// \param[in,out] instance The dust protocol instance.
+/// \param[out]    settings The link settings.
+///
+/// \return bool True if the settings are supported, false otherwise.
+///
+static bool receive_settings(dust_protocol_instance_t *const instance, dust_settings_t *const settings);
+
+///
+/// \brief Acknowledges the connection and switches to the negotiated link settings.
+///
+/// The ACK leaves at the previous settings, the host switches once it has received it. The replies
+/// are limited to DUST_PACKET_PAYLOAD_BUFFER_MAX_SIZE, the data packets take the negotiated size.
+/// The host asking to resume gets the first packet to send in the DUST_EXT_OPCODE_RESUME payload.
+///
+/// \param[in,out] instance The dust protocol instance.
+/// \param[in]     settings The link settings, NULL to keep the handshake ones.
+/// \param[in]     first    The index of the first packet to send.
+///
+/// \return bool True on success, false if the reception could not be switched.
+///
+static bool transmit_connection(dust_protocol_instance_t *const instance, const dust_settings_t *const settings,
+                                const uint32_t first);
+
+///
+/// \brief Answers the transfer setup message repeated by the host.
+///
+/// \param[in,out] instance The dust protocol instance.
+/// \param[in]     view     The received packet.
+///
+/// \return bool True if the packet was a setup message, false otherwise.
+///
+static bool control(dust_protocol_instance_t *const instance, const dust_view_t *const view);
+
+///
+/// \brief Receives the block manifest of the delta update.
+///
+/// Every message but the last one is acknowledged, the last one is answered by the blocks message
+/// once the flash memory is prepared.
+///
+/// \param[in,out] instance The dust protocol instance.
+///
+static void receive_manifest(dust_protocol_instance_t *const instance);
+
+///
+/// \brief Programs the decoded block into the app memory.
+///
+/// \param[in] data The decoded block.
+/// \param[in] size The block size.
+///
+/// \return lz_decoder_res_t Result of the programming.
+///
+static lz_decoder_res_t flash_sink(const uint8_t *const data, const uint32_t size);
+
+///
+/// \brief Stores the received payload.
+///
+/// The raw payload is programmed at the address given by its index. The compressed one is decoded
+/// in order, so a payload received ahead of the next one is refused and has to be sent again. A
+/// block that fails to program is not refused, it cannot be programmed again without an erase, the
+/// image check fails at the end and the slot is never switched to.
+///
+/// \param[in] instance The dust protocol instance.
+/// \param[in] view     The received packet, its payload still in the reception buffer.
+/// \param[in] index    The index of the packet within the transfer.
+///
+/// \return bool True if the payload has been stored, false if it has to be sent again.
+///
+static bool store(const dust_protocol_instance_t *const instance, const dust_view_t *const view,
+                  const uint32_t index);
+
+///
+/// \brief Receives the image with go-back retransmissions.
+///
+/// The window is acknowledged as a whole and received again from its first packet on a NACK. The
+/// packets already programmed before the bad one are skipped when they come again.
+///
+/// \param[in,out] instance The dust protocol instance.
+/// \param[in]     first    The index of the first packet to receive.
+///
+static void receive_go_back(dust_protocol_instance_t *const instance, const uint32_t first);
+
+///
+/// \brief Receives the image with selective repeat retransmissions.
+///
+/// Every packet is programmed at the address given by its packet number, so the sender has to
+/// retransmit the missing packets only, in any order.
+///
+/// \param[in,out] instance The dust protocol instance.
+/// \param[in]     first    The index of the first packet to receive.
+///
+static void receive_selective_repeat(dust_protocol_instance_t *const instance, const uint32_t first);
+
+///
+/// \brief Opens the progress journal of the transfer.
+///
+/// Only the raw image is resumed, the LZ decoder state and the delta staging are not journaled.
+///
+/// \param[in] instance     The dust protocol instance.
+/// \param[in] payload_size The payload size of the data packets.
+///
+/// \return uint32_t The index of the first packet not committed yet, 0 to start over.
+///
+static uint32_t journal_open(const dust_protocol_instance_t *const instance, const uint32_t payload_size);
+
+///
+/// \brief Writes the journal record.
+///
+/// \param[in] committed The bytes programmed from the start of the image.
+/// \param[in] flash     True to append the record to the flash sector too.
+///
+static void journal_write(const uint32_t committed, const bool flash);
+
+///
+/// \brief Journals the progress of the transfer.
+///
+/// The shared copy follows every acknowledged window, a record is appended to flash every
+/// JOURNAL_INTERVAL bytes.
+///
+/// \param[in] committed The bytes programmed from the start of the image.
+///
+static void journal_commit(const uint32_t committed);
 
 ///
 /// \brief Initializes the system peripherals.
@@ -44,20 +340,59 @@ static void transmit_ack(dust_packet_t *const packet, dust_serialized_t * serial
 ///
 static void init(void);
 
+///
+/// \brief Checks the header and the CRC-32 of the app image in the slot.
+///
+/// \param[in] slot The slot.
+///
+/// \return image_header_res_t The image header result.
+///
+static image_header_res_t slot_check(const uint32_t slot);
+
+///
+/// \brief Finds the slot the apploader boots, the other one is programmed.
+///
+static void boot_open(void);
+
+///
+/// \brief Switches the apploader to the programmed slot if its image is intact.
+///
+/// The old image stays in the active slot until the record is written, the switch is that write.
+///
+/// \return bool True if the slot has been switched, false otherwise.
+///
+static bool boot_switch(void);
+
 ///
 /// \brief Deinitializes system peripherals.
 ///
 static void deinit(void);
 
+///
+/// \brief Unlocks the flash erase/program functionality.
+///
+static void unlock_flash(void);
+
 ///
 /// \brief Prepares the flash memory for updates.
 ///
-/// This function unlocks the flash erase and program functionality by
-/// writing specific keys to the flash key register. It then erases the
-/// app sectors (sectors 4 and 5) to ensure a clean state for new data.
+/// This function erases the sector of the target slot to ensure a clean
+/// state for new data, the active slot is left untouched. The flash memory
+/// has to be unlocked.
 ///
 static void prepare_flash(void);
 
+///
+/// \brief Prepares the flash memory for the delta update.
+///
+/// The sectors can only be erased as a whole, so the blocks kept from the image in the target slot
+/// are staged in the app SRAM first. The sector of the target slot is erased and the kept blocks are
+/// programmed back, the transferred blocks fill the gaps.
+///
+/// \return bool True on success, false if a block could not be copied.
+///
+static bool stage_flash(void);
+
 ///
 /// \brief Initiates the update process.
 ///
@@ -67,6 +402,11 @@ static void prepare_flash(void);
 ///
 static void update(void);
 
+///
+/// \brief Reports the statistics of the last update.
+///
+static void report(void);
+
 ///*************************************************************************************************
 /// Private functions - definition.
 ///*************************************************************************************************
@@ -80,23 +420,475 @@ static void led_off(void)
     gpio_clear(GPIOA, GPIO2);
 }
 
-static void transmit_ack(dust_packet_t *const packet, dust_serialized_t *serialized,
-                         dust_ack_t ack, const uint32_t usart)
+static void transmit_ack(dust_protocol_instance_t *const instance, const dust_header_t *const header,
+                         const dust_ack_t ack)
+{
+    dust_header_t reply;
+    uint32_t      payload_size = instance->reply_size;
+
+    (void)dust_header_create(&reply, header->opcode, header->length, ack, header->packet_number);
+
+    /* Clear the payload. */
+    memset(&instance->serialized.buffer[DUST_PACKET_DATA_POSITION], 0, payload_size);
+
+    (void)dust_view_serialize(&reply, &instance->serialized.buffer[0], instance->serialized.buffer_size, payload_size);
+    (void)dust_transmit(&instance->serialized, USART3);
+}
+
+static void transmit_disconnect(dust_protocol_instance_t *const instance)
+{
+    dust_header_t header;
+    uint32_t      payload_size = instance->reply_size;
+
+    (void)dust_header_create(&header, DUST_OPCODE_DISCONNECT, DUST_LENGTH_BYTES32, DUST_ACK_UNSET, 0x00);
+
+    memset(&instance->serialized.buffer[DUST_PACKET_DATA_POSITION], 0, payload_size);
+
+    (void)dust_view_serialize(&header, &instance->serialized.buffer[0], instance->serialized.buffer_size, payload_size);
+    (void)dust_transmit(&instance->serialized, USART3);
+}
+
+static void transmit_bitmap(dust_protocol_instance_t *const instance, const dust_header_t *const poll)
 {
-    if ((packet == NULL) || (serialized == NULL))
+    dust_header_t reply;
+    uint32_t      payload_size = instance->reply_size;
+
+    if (dust_arq_ack_create(&updater_arq, poll, &reply, &instance->serialized.buffer[DUST_PACKET_DATA_POSITION],
+                            payload_size) != DUST_RESULT_SUCCESS)
     {
         return;
     }
 
-    (void)dust_header_create(&packet->header, packet->header.opcode, packet->header.length, ack, packet->header.packet_number);
+    (void)dust_view_serialize(&reply, &instance->serialized.buffer[0], instance->serialized.buffer_size, payload_size);
+    (void)dust_transmit(&instance->serialized, USART3);
+}
 
-    /* Clear the payload. */
-    memset(&packet->payload.buffer[0], 0, packet->payload.buffer_size);
+static void transmit_blocks(dust_protocol_instance_t *const instance, const dust_header_t *const header)
+{
+    dust_header_t reply;
+    uint32_t      payload_size = instance->reply_size;
+
+    (void)dust_header_create(&reply, DUST_OPCODE_CONNECT, header->length, DUST_ACK_SET, 0x00);
+
+    if (delta_blocks_create(&updater_delta, &instance->serialized.buffer[DUST_PACKET_DATA_POSITION],
+                            payload_size) != DELTA_RES_OK)
+    {
+        return;
+    }
+
+    (void)dust_view_serialize(&reply, &instance->serialized.buffer[0], instance->serialized.buffer_size, payload_size);
+    (void)dust_transmit(&instance->serialized, USART3);
+}
+
+static void transmit_capabilities(dust_protocol_instance_t *const instance, const dust_header_t *const header)
+{
+    dust_header_t reply;
+    uint32_t      payload_size = instance->reply_size;
+
+    (void)dust_header_create(&reply, DUST_OPCODE_CONNECT, header->length, DUST_ACK_SET, header->packet_number);
+
+    if (dust_capabilities_serialize(&updater_capabilities, &instance->serialized.buffer[DUST_PACKET_DATA_POSITION],
+                                    payload_size) != DUST_RESULT_SUCCESS)
+    {
+        return;
+    }
+
+    (void)dust_view_serialize(&reply, &instance->serialized.buffer[0], instance->serialized.buffer_size, payload_size);
+    (void)dust_transmit(&instance->serialized, USART3);
+}
+
+static void transmit_slot(dust_protocol_instance_t *const instance)
+{
+    dust_header_t reply;
+    uint8_t      *payload = &instance->serialized.buffer[DUST_PACKET_DATA_POSITION];
+
+    instance->reply_size             = 0x20;
+    instance->serialized.buffer_size = UPDATER_DUST_HANDSHAKE_SIZE;
+
+    (void)dust_header_create(&reply, instance->header.opcode, instance->header.length, DUST_ACK_UNSET,
+                             instance->header.packet_number);
+
+    memset(payload, 0, instance->reply_size);
+    payload[DUST_EXT_OPCODE_POSITION] = DUST_EXT_OPCODE_SLOT;
+    payload[1] = (uint8_t)updater_boot.target;
+
+    (void)dust_view_serialize(&reply, &instance->serialized.buffer[0], instance->serialized.buffer_size,
+                              instance->reply_size);
+    (void)dust_transmit(&instance->serialized, USART3);
+}
+
+static bool receive_settings(dust_protocol_instance_t *const instance, dust_settings_t *const settings)
+{
+    const dust_serialized_t *received;
+    dust_result_t result;
+    dust_view_t   view;
+    bool          baud = false;
+
+    view.header = instance->header;
+
+    received = dust_dma_receive();
+    result   = dust_view_parse(&view, &received->buffer[0], received->buffer_size, instance->options.payload_size);
+
+    if ((result == DUST_RESULT_SUCCESS) && (view.header.opcode == DUST_OPCODE_CONNECT))
+    {
+        result = dust_settings_deserialize(settings, view.payload, view.payload_size);
+    }
+
+    dust_dma_release(received);
+
+    if ((result != DUST_RESULT_SUCCESS) || (view.header.opcode != DUST_OPCODE_CONNECT))
+    {
+        return false;
+    }
+
+    instance->header = view.header;
+
+    for (uint32_t i = 0; i < updater_capabilities.bauds_count; i++)
+    {
+        baud = baud || (settings->baud == updater_capabilities.bauds[i]);
+    }
+
+    /* The delta blocks are split into whole packets. */
+    return (baud &&
+            (settings->payload_size >= 0x20) &&
+            (settings->payload_size <= updater_capabilities.payload_size_max) &&
+            ((settings->payload_size % 4) == 0) &&
+            (settings->number_of_packets != 0) &&
+            ((instance->options.delta == 0) || ((DELTA_BLOCK_SIZE % settings->payload_size) == 0)));
+}
+
+static bool transmit_connection(dust_protocol_instance_t *const instance, const dust_settings_t *const settings,
+                                const uint32_t first)
+{
+    dust_header_t reply;
+    uint32_t      payload_size = instance->reply_size;
+    uint8_t      *payload      = &instance->serialized.buffer[DUST_PACKET_DATA_POSITION];
+
+    (void)dust_header_create(&reply, instance->header.opcode, instance->header.length, DUST_ACK_SET,
+                             instance->header.packet_number);
+
+    memset(payload, 0, payload_size);
+
+    if (instance->options.image_hash != 0)
+    {
+        payload[DUST_EXT_OPCODE_POSITION] = DUST_EXT_OPCODE_RESUME;
+        payload[1] = ((first & 0xff000000) >> 0x18);
+        payload[2] = ((first & 0x00ff0000) >> 0x10);
+        payload[3] = ((first & 0x0000ff00) >> 0x08);
+        payload[4] = ((first & 0x000000ff) >> 0x00);
+    }
+
+    (void)dust_view_serialize(&reply, &instance->serialized.buffer[0], instance->serialized.buffer_size, payload_size);
+    (void)dust_transmit(&instance->serialized, USART3);
+
+    if (settings == NULL)
+    {
+        return true;
+    }
+
+    /* The last byte leaves the shift register before the baud rate changes. */
+    while ((USART_ISR(USART3) & USART_ISR_TC) == 0);
+
+    instance->options.payload_size      = settings->payload_size;
+    instance->options.number_of_packets = settings->number_of_packets;
+
+    /* The replies keep to the payloads of the handshake, the host reads them at most 256 bytes long. */
+    instance->reply_size             = (settings->payload_size > DUST_PACKET_PAYLOAD_BUFFER_MAX_SIZE) ?
+                                       DUST_PACKET_PAYLOAD_BUFFER_MAX_SIZE : settings->payload_size;
+    instance->serialized.buffer_size = DUST_PACKET_HEADER_SIZE + instance->reply_size + DUST_PACKET_CRC16_SIZE;
+
+    return ((dust_dma_set_size(DUST_PACKET_HEADER_SIZE + settings->payload_size + DUST_PACKET_CRC16_SIZE) ==
+             DUST_RESULT_SUCCESS) &&
+            (dust_dma_set_baud(settings->baud) == DUST_RESULT_SUCCESS));
+}
+
+static bool control(dust_protocol_instance_t *const instance, const dust_view_t *const view)
+{
+    if ((instance->options.delta == 0) ||
+        (view->header.opcode != DUST_OPCODE_CONNECT) ||
+        (view->payload[DUST_EXT_OPCODE_POSITION] != DUST_EXT_OPCODE_MANIFEST))
+    {
+        return false;
+    }
+
+    /* The blocks message has been lost, the host repeats the last manifest message. */
+    transmit_blocks(instance, &view->header);
+
+    return true;
+}
+
+static void receive_manifest(dust_protocol_instance_t *const instance)
+{
+    const dust_serialized_t *received;
+    dust_result_t result;
+    delta_res_t   res;
+    dust_view_t   view;
+
+    /* A corrupted packet is answered with the header of the last good one. */
+    view.header = instance->header;
+
+    while (1)
+    {
+        res      = DELTA_RES_ERR;
+        received = dust_dma_receive();
+        result   = dust_view_parse(&view, &received->buffer[0], received->buffer_size, instance->options.payload_size);
+
+        if ((result == DUST_RESULT_SUCCESS) && (view.header.opcode == DUST_OPCODE_CONNECT))
+        {
+            res = delta_manifest_process(&updater_delta, view.payload, view.payload_size);
+        }
+
+        dust_dma_release(received);
+
+        if ((result != DUST_RESULT_SUCCESS) || (view.header.opcode != DUST_OPCODE_CONNECT) || (res != DELTA_RES_OK))
+        {
+            transmit_ack(instance, &view.header, DUST_ACK_UNSET);
+            continue;
+        }
+
+        if (delta_manifest_is_complete(&updater_delta))
+        {
+            instance->header = view.header;
+            return;
+        }
+
+        transmit_ack(instance, &view.header, DUST_ACK_SET);
+    }
+}
+
+static lz_decoder_res_t flash_sink(const uint8_t *const data, const uint32_t size)
+{
+    return (flash_writer_write(data, size) == FLASH_WRITER_RES_OK) ? LZ_DECODER_RES_OK : LZ_DECODER_RES_SINK_ERR;
+}
+
+static bool store(const dust_protocol_instance_t *const instance, const dust_view_t *const view,
+                  const uint32_t index)
+{
+    if (instance->options.compression == DUST_COMPRESSION_LZ)
+    {
+        if (index != updater_lz_next)
+        {
+            return false;
+        }
+
+        /* A broken stream is reported at the end, sending the packet again would not repair it. */
+        updater_lz_next++;
+        (void)lz_decoder_write(view->payload, view->payload_size);
+
+        return true;
+    }
+
+    uint32_t addr = UPDATER_ITCM_TO_AXIM(updater_slots[updater_boot.target].start);
+
+    if (instance->options.delta)
+    {
+        flash_writer_seek(addr + delta_get_offset(&updater_delta, index, instance->options.payload_size));
+    }
+    else
+    {
+        flash_writer_seek(addr + (index * instance->options.payload_size));
+    }
+
+    /* The payload is programmed straight from the reception buffer. A failed block is left to the
+     * image check, sending it again would program the same words twice. */
+    (void)flash_writer_write(view->payload, view->payload_size);
+
+    return true;
+}
+
+static void receive_go_back(dust_protocol_instance_t *const instance, const uint32_t first)
+{
+    const dust_serialized_t *received;
+    dust_result_t result;
+    dust_view_t   view;
+
+    uint16_t ack_frequency  = dust_get_ack_frequency(instance->options.ack_frequency);
+    uint16_t number_of_nack = 0;
+    uint32_t window_start   = first;
+    uint32_t programmed     = first;
+
+    /* A corrupted packet is answered with the header of the last good one. */
+    view.header = instance->header;
+
+    /* How many packet should I receive? Handshake option. */
+    for (uint32_t i = first; i < instance->options.number_of_packets; i++)
+    {
+        received = dust_dma_receive();
+        result   = dust_view_parse(&view, &received->buffer[0], received->buffer_size, instance->options.payload_size);
+
+        if ((result == DUST_RESULT_SUCCESS) && control(instance, &view))
+        {
+            dust_dma_release(received);
+
+            /* Not a data packet, wait for the same one again. */
+            i--;
+            continue;
+        }
+
+        /* The packets are stored in order, the ones already stored are skipped when sent again. */
+        if ((i == programmed) && (number_of_nack == 0))
+        {
+            if ((result == DUST_RESULT_SUCCESS) &&
+                (view.header.packet_number == (i & (DUST_ARQ_SEQUENCE_SIZE - 1))) &&
+                store(instance, &view, i))
+            {
+                programmed++;
+            }
+            else
+            {
+                number_of_nack++;
+                updater_stats.nacks++;
+            }
+        }
+
+        /* The payload has been programmed out of the buffer, the next packet can land in it. */
+        dust_dma_release(received);
+
+        if (((i + 1 - window_start) == ack_frequency) ||
+            ((i + 1) == instance->options.number_of_packets))
+        {
+            if (number_of_nack != 0)
+            {
+                transmit_ack(instance, &view.header, DUST_ACK_UNSET);
+                number_of_nack = 0;
+
+                /* Receive the whole window again, the last one may be shorter. */
+                i = window_start - 1;
+            }
+            else
+            {
+                transmit_ack(instance, &view.header, DUST_ACK_SET);
+                window_start = i + 1;
 
-    dust_serialize(packet, &serialized->buffer[0], serialized->buffer_size);
-    dust_transmit(serialized, usart);
+                journal_commit(programmed * instance->options.payload_size);
+            }
+        }
+    }
 }
 
+static void receive_selective_repeat(dust_protocol_instance_t *const instance, const uint32_t first)
+{
+    const dust_serialized_t *received;
+    dust_result_t result;
+    dust_view_t   view;
+    uint32_t index;
+
+    (void)dust_arq_init(&updater_arq, instance->options.number_of_packets,
+                        dust_arq_get_window(instance->options.ack_frequency, instance->options.payload_size));
+    (void)dust_arq_resume(&updater_arq, first);
+
+    while (!dust_arq_is_complete(&updater_arq))
+    {
+        received = dust_dma_receive();
+        result   = dust_view_parse(&view, &received->buffer[0], received->buffer_size, instance->options.payload_size);
+
+        if ((result == DUST_RESULT_SUCCESS) && control(instance, &view))
+        {
+            dust_dma_release(received);
+            continue;
+        }
+
+        if ((result != DUST_RESULT_SUCCESS) || (view.header.opcode != DUST_OPCODE_DATA))
+        {
+            dust_dma_release(received);
+
+            /* Nothing is answered, the sender polls again when the bitmap ACK does not come. */
+            updater_stats.nacks++;
+            continue;
+        }
+
+        if ((dust_arq_receive(&updater_arq, &view.header, &index) == DUST_ARQ_RX_NEW) &&
+            (!store(instance, &view, index)))
+        {
+            dust_arq_discard(&updater_arq, index);
+            updater_stats.nacks++;
+        }
+
+        /* The payload has been programmed out of the buffer, the next packet can land in it. */
+        dust_dma_release(received);
+
+        if (view.header.ack == DUST_ACK_SET)
+        {
+            uint32_t base = updater_arq.base;
+
+            transmit_bitmap(instance, &view.header);
+
+            /* The packets before the window base are all programmed. */
+            if (updater_arq.base != base)
+            {
+                journal_commit(updater_arq.base * instance->options.payload_size);
+            }
+        }
+    }
+}
+
+static uint32_t journal_open(const dust_protocol_instance_t *const instance, const uint32_t payload_size)
+{
+    const journal_record_t *flash = journal_find((const journal_record_t *)UPDATER_JOURNAL_ADDR,
+                                                 UPDATER_JOURNAL_RECORDS, &updater_journal.free);
+    uint32_t committed = 0;
+
+    updater_journal.sequence   = journal_next_sequence(UPDATER_JOURNAL_SHARED, flash);
+    updater_journal.image_size = instance->options.image_size;
+    updater_journal.image_hash = 0;
+    updater_journal.committed  = 0;
+
+    if ((instance->options.compression == DUST_COMPRESSION_NONE) && (instance->options.delta == 0))
+    {
+        updater_journal.image_hash = instance->options.image_hash;
+        committed = journal_resume(UPDATER_JOURNAL_SHARED, flash, instance->options.image_hash,
+                                   instance->options.image_size);
+    }
+
+    updater_journal.committed = committed;
+
+    return committed / payload_size;
+}
+
+static void journal_write(const uint32_t committed, const bool flash)
+{
+    journal_record_t record;
+
+    journal_record_create(&record, updater_journal.image_hash, updater_journal.image_size, committed,
+                          updater_journal.sequence++);
+
+    *UPDATER_JOURNAL_SHARED = record;
+
+    if (!flash)
+    {
+        return;
+    }
+
+    if (updater_journal.free >= UPDATER_JOURNAL_RECORDS)
+    {
+        /* The sector is full, the shared copy bridges the erase. */
+        flash_erase_sector(UPDATER_JOURNAL_SECTOR, PSIZE_X32);
+        updater_journal.free = 0;
+    }
+
+    uint32_t addr = flash_writer_get_addr();
+
+    /* A slot failing the verification is skipped, the next record goes to the following one. */
+    flash_writer_seek(UPDATER_JOURNAL_ADDR + (updater_journal.free * sizeof(journal_record_t)));
+    (void)flash_writer_write((const uint8_t *)&record, sizeof(record));
+    flash_writer_seek(addr);
+
+    updater_journal.free++;
+    updater_journal.committed = committed;
+}
+
+static void journal_commit(const uint32_t committed)
+{
+    if (updater_journal.image_hash == 0)
+    {
+        return;
+    }
+
+    /* The last packet is padded past the image. */
+    uint32_t bytes = (committed < updater_journal.image_size) ? committed : updater_journal.image_size;
+
+    journal_write(bytes, (bytes - updater_journal.committed) >= JOURNAL_INTERVAL);
+}
 
 static void init(void)
 {
@@ -115,15 +907,129 @@ static void deinit(void)
 {
 }
 
-static void prepare_flash(void)
+static image_header_res_t slot_check(const uint32_t slot)
+{
+    const uint32_t *image = (const uint32_t *)UPDATER_ITCM_TO_AXIM(updater_slots[slot].start);
+    const image_header_t *header = image_header_get(image);
+    image_header_res_t res = image_header_check(header, (uint32_t)updater_slots[slot].size);
+
+    if (res != IMAGE_HEADER_RES_OK)
+    {
+        return res;
+    }
+
+    /* The slot may have been read before it was programmed, drop the stale cache lines. */
+    (void)cache_dcache_invalidate_range((void *)image, header->length);
+
+    return (image_header_crc32(image) == header->crc32) ? IMAGE_HEADER_RES_OK : IMAGE_HEADER_RES_ERR_CRC;
+}
+
+static void boot_open(void)
+{
+    const boot_control_record_t *record = boot_control_find((const boot_control_record_t *)UPDATER_BOOT_CTRL_ADDR,
+                                                            UPDATER_BOOT_CTRL_RECORDS, &updater_boot.free);
+    uint32_t preferred = boot_control_preferred(record);
+
+    updater_boot.sequence = boot_control_next_sequence(record);
+    updater_boot.active   = UPDATER_SLOT_NONE;
+    updater_boot.result   = IMAGE_HEADER_RES_ERR_MAGIC;
+
+    /* The same choice the apploader makes. */
+    for (uint32_t i = 0; i < BOOT_CONTROL_SLOTS; i++)
+    {
+        uint32_t slot = (preferred + i) % BOOT_CONTROL_SLOTS;
+
+        if (slot_check(slot) == IMAGE_HEADER_RES_OK)
+        {
+            updater_boot.active = slot;
+            break;
+        }
+    }
+
+    updater_boot.target = (updater_boot.active == UPDATER_SLOT_NONE) ? preferred :
+                          ((updater_boot.active + 1) % BOOT_CONTROL_SLOTS);
+}
+
+static bool boot_switch(void)
+{
+    boot_control_record_t record;
+
+    updater_boot.result = slot_check(updater_boot.target);
+
+    if (updater_boot.result != IMAGE_HEADER_RES_OK)
+    {
+        return false;
+    }
+
+    boot_control_record_create(&record, updater_boot.target, updater_boot.sequence++);
+
+    if (updater_boot.free >= UPDATER_BOOT_CTRL_RECORDS)
+    {
+        /* The sector holds thousands of records, the window without one only boots the slot A. */
+        flash_erase_sector(UPDATER_BOOT_CTRL_SECTOR, PSIZE_X32);
+        updater_boot.free = 0;
+    }
+
+    flash_writer_seek(UPDATER_BOOT_CTRL_ADDR + (updater_boot.free * sizeof(boot_control_record_t)));
+    updater_boot.free++;
+
+    if (flash_writer_write((const uint8_t *)&record, sizeof(record)) != FLASH_WRITER_RES_OK)
+    {
+        return false;
+    }
+
+    updater_boot.active = updater_boot.target;
+
+    return true;
+}
+
+static void unlock_flash(void)
 {
-    /* Unlock the flash erase/program functionality. */
     FLASH_KEYR = 0x45670123;
     FLASH_KEYR = 0xcdef89ab;
+}
+
+static void prepare_flash(void)
+{
+    /* Only the inactive slot is erased, the active one stays bootable. */
+    flash_erase_sector(updater_slots[updater_boot.target].sector, PSIZE_X32);
+}
+
+static bool stage_flash(void)
+{
+    const updater_slot_t *slot = &updater_slots[updater_boot.target];
+    uint32_t addr = UPDATER_ITCM_TO_AXIM(slot->start);
+    uint8_t *stage = (uint8_t *)&__stage_start__;
+
+    /* The inactive slot is not booted, so its kept blocks wait in the app SRAM, idle while the
+     * updater runs, rather than in a flash scratch sector. */
+    for (uint32_t block = 0; block < updater_delta.blocks; block++)
+    {
+        if (!delta_block_differs(&updater_delta, block))
+        {
+            memcpy(&stage[block * DELTA_BLOCK_SIZE], (const uint8_t *)(addr + (block * DELTA_BLOCK_SIZE)),
+                   DELTA_BLOCK_SIZE);
+        }
+    }
+
+    flash_erase_sector(slot->sector, PSIZE_X32);
+
+    for (uint32_t block = 0; block < updater_delta.blocks; block++)
+    {
+        if (delta_block_differs(&updater_delta, block))
+        {
+            continue;
+        }
+
+        flash_writer_seek(addr + (block * DELTA_BLOCK_SIZE));
 
-    /* Erase the app 4 and 5 sectors. */
-    flash_erase_sector(4, PSIZE_X32);
-    flash_erase_sector(5, PSIZE_X32);
+        if (flash_writer_write(&stage[block * DELTA_BLOCK_SIZE], DELTA_BLOCK_SIZE) != FLASH_WRITER_RES_OK)
+        {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 static void update(void)
@@ -131,93 +1037,235 @@ static void update(void)
     /* AXIM interface is used to program the memory.
      * RM0431 3.3.1 Flash memory organization:
      * Write accesses are not supported on ITCM interface. */
-    volatile uint32_t app_memory = 0x08010000;
     dust_protocol_instance_t instance = { 0 };
+    const dust_serialized_t *received;
+    dust_result_t result;
+    dust_view_t   view;
+    dust_settings_t settings;
+    uint32_t      first;
     dust_crc16_generate_lut(0x1021);
 
-    if ((dust_handshake(&instance, USART3) != DUST_RESULT_SUCCESS) ||
-        (instance.options.ack_frequency > DUST_ACK_FREQUENCY_TOTAL_SIZE))
+    instance.reply_size             = 0x20;
+    instance.serialized.buffer_size = UPDATER_DUST_HANDSHAKE_SIZE;
+
+    /* The packets are assembled by the reception interrupts while the previous one is programmed. */
+    if (dust_dma_start(LL_USART_DMA_INST_USART3, UPDATER_DUST_BAUDRATE, UPDATER_DUST_HANDSHAKE_SIZE) != DUST_RESULT_SUCCESS)
     {
-        transmit_ack(&instance.packet, &instance.serialized, DUST_ACK_UNSET, USART3);
         return;
     }
 
-    /* Transmit handshake ACK. */
-    transmit_ack(&instance.packet, &instance.serialized, DUST_ACK_SET, USART3);
+    boot_open();
 
-    uint16_t ack_frequency  = dust_get_ack_frequency(instance.options.ack_frequency);
-    uint16_t number_of_nack = 0;
+    /* The image linked to the active slot is refused, the host sends the one linked to the other. */
+    while (1)
+    {
+        received = dust_dma_receive();
+        result   = dust_handshake_process(&instance, &received->buffer[0], received->buffer_size);
+        dust_dma_release(received);
 
-    /* How many packet should I receive? Handshake option. */
-    for (uint32_t i = 0; i < instance.options.number_of_packets; i++)
+        if ((result != DUST_RESULT_SUCCESS) || (instance.options.slot != updater_boot.active))
+        {
+            break;
+        }
+
+        transmit_slot(&instance);
+    }
+
+    /* The handshake options themselves are checked by dust_handshake_process(). */
+    if ((result != DUST_RESULT_SUCCESS) ||
+        (instance.options.slot >= BOOT_CONTROL_SLOTS) ||
+        (instance.options.image_size > (uint32_t)updater_slots[instance.options.slot].size) ||
+        ((instance.options.delta != 0) &&
+         ((instance.options.compression != DUST_COMPRESSION_NONE) ||
+          (delta_init(&updater_delta, instance.options.image_size) != DELTA_RES_OK))) ||
+        (dust_dma_set_size(instance.serialized.buffer_size) != DUST_RESULT_SUCCESS))
+    {
+        instance.reply_size             = 0x20;
+        instance.serialized.buffer_size = UPDATER_DUST_HANDSHAKE_SIZE;
+
+        transmit_ack(&instance, &instance.header, DUST_ACK_UNSET);
+        return;
+    }
+
+    if (instance.options.negotiate)
     {
-        if ((dust_receive(&instance.serialized, USART3) != DUST_RESULT_SUCCESS) &&
-            (dust_deserialize(&instance.packet, &instance.serialized.buffer[0], instance.serialized.buffer_size) != DUST_RESULT_SUCCESS))
+        /* The larger payloads and the faster baud rates are picked by the host. */
+        transmit_capabilities(&instance, &instance.header);
+
+        if (!receive_settings(&instance, &settings))
         {
-            number_of_nack++;
+            transmit_ack(&instance, &instance.header, DUST_ACK_UNSET);
+            return;
         }
-        else
+    }
+
+    updater_boot.target = instance.options.slot;
+
+    unlock_flash();
+    flash_writer_init(UPDATER_ITCM_TO_AXIM(updater_slots[updater_boot.target].start));
+
+    first = journal_open(&instance, instance.options.negotiate ? settings.payload_size : instance.options.payload_size);
+    updater_stats.resumed = first;
+
+    if (first == 0)
+    {
+        /* The records of the previous transfer are superseded before the slot is erased. */
+        journal_write(0, true);
+    }
+
+    updater_lz_next = 0;
+    (void)lz_decoder_init(instance.options.image_size, &flash_sink);
+
+    if (instance.options.delta)
+    {
+        /* Transmit handshake ACK, the manifest follows. */
+        if (!transmit_connection(&instance, instance.options.negotiate ? &settings : NULL, 0))
         {
-            /* Program the app memory. */
-            for (uint32_t payload_index = 0; payload_index < instance.packet.payload.buffer_size; payload_index += 4)
-            {
-                uint32_t word = instance.packet.payload.buffer[payload_index + 0] << 0x00
-                              | instance.packet.payload.buffer[payload_index + 1] << 0x08
-                              | instance.packet.payload.buffer[payload_index + 2] << 0x10
-                              | instance.packet.payload.buffer[payload_index + 3] << 0x18;
+            return;
+        }
 
-                flash_program_word(app_memory, word);
-                app_memory += 4;
-            }
+        receive_manifest(&instance);
+
+        /* The image left in the inactive slot is compared before the slot is erased. */
+        delta_compare(&updater_delta, (const uint8_t *)UPDATER_ITCM_TO_AXIM(updater_slots[updater_boot.target].start));
+
+        if (!stage_flash())
+        {
+            transmit_ack(&instance, &instance.header, DUST_ACK_UNSET);
+            return;
         }
 
-        if ((((i + 1)  % ack_frequency) == 0) ||
-             ((i + 1) == instance.options.number_of_packets))
+        instance.options.number_of_packets = delta_get_packets(&updater_delta, instance.options.payload_size);
+        updater_stats.delta_blocks         = updater_delta.count;
+        updater_stats.delta_total          = updater_delta.blocks;
+
+        transmit_blocks(&instance, &instance.header);
+    }
+    else
+    {
+        /* The resumed transfer keeps the committed packets. */
+        if (first == 0)
         {
-            if (number_of_nack != 0)
-            {
-                transmit_ack(&instance.packet, &instance.serialized, DUST_ACK_UNSET, USART3);
-                number_of_nack = 0;
-                i -= ack_frequency;
-            }
-            else
-            {
-                transmit_ack(&instance.packet, &instance.serialized, DUST_ACK_SET, USART3);
-            }
+            prepare_flash();
+        }
+
+        /* Transmit handshake ACK. */
+        if (!transmit_connection(&instance, instance.options.negotiate ? &settings : NULL, first))
+        {
+            return;
         }
     }
 
-    //memset(&instance.serialized.buffer[0], 0, instance.serialized.buffer_size);
+    uint32_t start = timing_cnt_get();
+
+    if (instance.options.arq_mode == DUST_ARQ_MODE_SELECTIVE_REPEAT)
+    {
+        receive_selective_repeat(&instance, first);
+    }
+    else
+    {
+        receive_go_back(&instance, first);
+    }
+
+    /* The image is complete, nothing is left to resume. */
+    updater_journal.image_hash = 0;
+    journal_write(0, true);
 
-    (void)dust_header_create(&instance.packet.header, DUST_OPCODE_DISCONNECT, DUST_LENGTH_BYTES32, DUST_ACK_UNSET, 0x00);
-    (void)dust_payload_create(&instance.packet.payload, &instance.serialized.buffer[0], instance.packet.payload.buffer_size);
-    (void)dust_serialize(&instance.packet, &instance.serialized.buffer[0], instance.serialized.buffer_size);
+    updater_stats.bytes = (instance.options.number_of_packets - first) * instance.options.payload_size;
+    updater_stats.image = updater_stats.bytes;
+
+    if (instance.options.compression == DUST_COMPRESSION_LZ)
+    {
+        updater_stats.lz_res = lz_decoder_finish();
+        updater_stats.image  = instance.options.image_size;
+        lz_decoder_get_stats(&updater_stats.lz);
+    }
+
+    updater_stats.cycles = timing_cnt_get() - start;
+
+    /* The apploader boots the new image from the next reset on, a broken one is never switched to. */
+    (void)boot_switch();
+
+    if (updater_stats.cycles != 0)
+    {
+        updater_stats.bytes_per_second = (uint32_t)(((uint64_t)updater_stats.bytes * timing_sysclk_freq) /
+                                                    updater_stats.cycles);
+    }
 
     /* Send disconnect packet. */
-    (void)dust_transmit(&instance.serialized, USART3);
+    transmit_disconnect(&instance);
 
     /* Wait for the ack packet. */
+    view.header = instance.header;
+
     while (1)
     {
-        if (dust_receive(&instance.serialized, USART3) != DUST_RESULT_SUCCESS)
+        received = dust_dma_receive();
+        result   = dust_view_parse(&view, &received->buffer[0], received->buffer_size, instance.options.payload_size);
+        dust_dma_release(received);
+
+        if ((result == DUST_RESULT_SUCCESS) &&
+            (view.header.opcode == DUST_OPCODE_DISCONNECT) &&
+            (view.header.ack == DUST_ACK_SET))
+        {
+            transmit_ack(&instance, &view.header, DUST_ACK_SET);
+            break;
+        }
+        else if ((result == DUST_RESULT_SUCCESS) &&
+                 (instance.options.arq_mode == DUST_ARQ_MODE_SELECTIVE_REPEAT) &&
+                 (view.header.opcode == DUST_OPCODE_DATA) &&
+                 (view.header.ack == DUST_ACK_SET))
         {
-            transmit_ack(&instance.packet, &instance.serialized, DUST_ACK_UNSET, USART3);
+            /* The last bitmap ACK has been lost, the sender polls the last window again. */
+            transmit_bitmap(&instance, &view.header);
+            transmit_disconnect(&instance);
         }
         else
         {
-            dust_deserialize(&instance.packet, &instance.serialized.buffer[0], instance.serialized.buffer_size);
-            if ((instance.packet.header.opcode == DUST_OPCODE_DISCONNECT) &&
-                (instance.packet.header.ack == DUST_ACK_SET))
-            {
-                transmit_ack(&instance.packet, &instance.serialized, DUST_ACK_SET, USART3);
-                break;
-            }
-            else
-            {
-                transmit_ack(&instance.packet, &instance.serialized, DUST_ACK_UNSET, USART3);
-            }
+            transmit_ack(&instance, &view.header, DUST_ACK_UNSET);
         }
     }
+
+    dust_dma_get_stats(&updater_stats.rx);
+    flash_writer_get_stats(&updater_stats.flash);
+}
+
+static void report(void)
+{
+    /* The link is idle after the disconnection, the report does not disturb the host. */
+    printf("update: %u bytes in %u cycles, %u B/s\n\r", updater_stats.bytes, updater_stats.cycles,
+           updater_stats.bytes_per_second);
+    printf("rx:     %u packets, %u overruns, %u truncated, %u nacks\n\r", updater_stats.rx.packets,
+           updater_stats.rx.overruns, updater_stats.rx.truncated, updater_stats.nacks);
+
+    printf("slot:   %u programmed, check %u, %u booted next\n\r", updater_boot.target, updater_boot.result,
+           updater_boot.active);
+
+    if (updater_stats.resumed != 0)
+    {
+        printf("resume: from packet %u\n\r", updater_stats.resumed);
+    }
+
+    if (updater_stats.delta_total != 0)
+    {
+        printf("delta:  %u of %u blocks transferred\n\r", updater_stats.delta_blocks, updater_stats.delta_total);
+    }
+
+    if (updater_stats.lz.in != 0)
+    {
+        /* The ratio is the image size per received byte, in hundredths. */
+        uint32_t ratio = (uint32_t)(((uint64_t)updater_stats.image * 100u) / updater_stats.bytes);
+
+        printf("lz:     %u -> %u bytes, ratio %u.%02u, %u literals, %u matches, result %u\n\r", updater_stats.bytes,
+               updater_stats.lz.out, ratio / 100u, ratio % 100u, updater_stats.lz.literals, updater_stats.lz.matches,
+               updater_stats.lz_res);
+    }
+
+    if (updater_stats.flash.cycles != 0)
+    {
+        printf("flash:  %u blocks, %u errors, %u B/s\n\r", updater_stats.flash.blocks, updater_stats.flash.errors,
+               (uint32_t)(((uint64_t)updater_stats.flash.bytes * timing_sysclk_freq) / updater_stats.flash.cycles));
+    }
 }
 
 ///*************************************************************************************************
@@ -226,9 +1274,18 @@ static void update(void)
 
 void updater_start(void)
 {
+    timing_boot_stamp(TIMING_BOOT_STAGE_IMAGE);
+
     init();
-    prepare_flash();
+
+    timing_boot_stamp(TIMING_BOOT_STAGE_DRIVERS);
+
     update();
+    report();
+
+    /* The ART accelerator and the instruction cache may still hold the old app content. */
+    cache_flash_accel_reset();
+    cache_icache_invalidate();
 
     /* Never return */
     while (1);
@@ -0,0 +1,347 @@
+#include "ll_spi_nor.h"
+#include <stddef.h>
+#include <string.h>
+
+#define LL_SPI_NOR_CAPACITY_MIN     (16u)           /*!< The 64 KiB, one block.                         */
+#define LL_SPI_NOR_CAPACITY_MAX     (24u)           /*!< The 16 MiB, the 3 byte address limit.          */
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief Sends the command with the address, then transfers the data, within one chip select.
+///
+/// \param[in]  dev       The device.
+/// \param[in]  cmd       The command.
+/// \param[in]  addr      The address, sent if addr_size is not 0.
+/// \param[in]  addr_size The address and dummy byte count, 0, 3 or 4.
+/// \param[in]  tx        The data to send, NULL to send 0xff.
+/// \param[out] rx        The data received, NULL to drop it.
+/// \param[in]  size      The data size.
+///
+static void ll_spi_nor_cmd(const struct ll_spi_nor *const dev, const uint8_t cmd, const uint32_t addr,
+                           const uint32_t addr_size, const uint8_t *const tx, uint8_t *const rx, const uint32_t size);
+
+///
+/// \brief Erases the space after the erased one, the block if it is aligned, the sector otherwise.
+///
+/// \param[in,out] dev The device.
+///
+static void ll_spi_nor_erase_next(struct ll_spi_nor *const dev);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static void ll_spi_nor_cmd(const struct ll_spi_nor *const dev, const uint8_t cmd, const uint32_t addr,
+                           const uint32_t addr_size, const uint8_t *const tx, uint8_t *const rx, const uint32_t size)
+{
+    const uint8_t header[5] =
+    {
+        cmd,
+        (uint8_t)(addr >> 16),
+        (uint8_t)(addr >>  8),
+        (uint8_t)(addr >>  0),
+        0xff,
+    };
+
+    dev->bus->select();
+    dev->bus->xfer(&header[0], NULL, 1 + addr_size);
+
+    if (size > 0)
+    {
+        dev->bus->xfer(tx, rx, size);
+    }
+
+    dev->bus->deselect();
+}
+
+static void ll_spi_nor_erase_next(struct ll_spi_nor *const dev)
+{
+    uint32_t size = LL_SPI_NOR_SECTOR_SIZE;
+
+    /* The block erase takes a fraction of the time of its sectors, the log keeps up only with it. */
+    if (((dev->erased % LL_SPI_NOR_BLOCK_SIZE) == 0) &&
+        ((dev->erased + LL_SPI_NOR_BLOCK_SIZE) <= dev->size))
+    {
+        size = LL_SPI_NOR_BLOCK_SIZE;
+    }
+
+    if (ll_spi_nor_erase(dev, dev->erased, size) != LL_SPI_NOR_RES_OK)
+    {
+        return;
+    }
+
+    dev->erased += size;
+
+    if (size == LL_SPI_NOR_BLOCK_SIZE)
+    {
+        dev->stats.blocks++;
+    }
+    else
+    {
+        dev->stats.sectors++;
+    }
+}
+
+///***********************************************************************************************************
+/// Global functions - definition.
+///***********************************************************************************************************
+ll_spi_nor_res_t ll_spi_nor_init(struct ll_spi_nor *const dev, const struct ll_spi_nor_bus *const bus)
+{
+    if ((dev == NULL) || (bus == NULL))
+    {
+        return LL_SPI_NOR_RES_ERR;
+    }
+
+    memset(dev, 0, sizeof(struct ll_spi_nor));
+    dev->bus = bus;
+
+    if (bus->init != NULL)
+    {
+        bus->init();
+    }
+
+    ll_spi_nor_id_read(dev, &dev->id);
+
+    /* The floating or the grounded MISO reads all ones or all zeros. */
+    if ((dev->id.manufacturer == 0x00) || (dev->id.manufacturer == 0xff) ||
+        (dev->id.capacity < LL_SPI_NOR_CAPACITY_MIN) || (dev->id.capacity > LL_SPI_NOR_CAPACITY_MAX))
+    {
+        return LL_SPI_NOR_RES_ERR;
+    }
+
+    dev->size = 1u << dev->id.capacity;
+
+    return ll_spi_nor_log_start(dev, 0);
+}
+
+void ll_spi_nor_id_read(const struct ll_spi_nor *const dev, struct ll_spi_nor_id *const id)
+{
+    uint8_t data[3];
+
+    ll_spi_nor_cmd(dev, LL_SPI_NOR_CMD_JEDEC_ID, 0, 0, NULL, &data[0], sizeof(data));
+
+    id->manufacturer = data[0];
+    id->type         = data[1];
+    id->capacity     = data[2];
+}
+
+uint8_t ll_spi_nor_busy(const struct ll_spi_nor *const dev)
+{
+    uint8_t status;
+
+    ll_spi_nor_cmd(dev, LL_SPI_NOR_CMD_RDSR, 0, 0, NULL, &status, 1);
+
+    return ((status & LL_SPI_NOR_SR_WIP) != 0) ? 1 : 0;
+}
+
+void ll_spi_nor_wait(const struct ll_spi_nor *const dev)
+{
+    while (ll_spi_nor_busy(dev) == 1);
+}
+
+ll_spi_nor_res_t ll_spi_nor_read(const struct ll_spi_nor *const dev, const uint32_t addr, uint8_t *const data,
+                                 const uint32_t size)
+{
+    if ((data == NULL) || (addr > dev->size) || (size > (dev->size - addr)))
+    {
+        return LL_SPI_NOR_RES_ERR;
+    }
+
+    ll_spi_nor_wait(dev);
+
+    /* The fast read takes the dummy byte after the address and runs at the full clock. */
+    ll_spi_nor_cmd(dev, LL_SPI_NOR_CMD_FAST_READ, addr, 4, NULL, data, size);
+
+    return LL_SPI_NOR_RES_OK;
+}
+
+ll_spi_nor_res_t ll_spi_nor_page_program(const struct ll_spi_nor *const dev, const uint32_t addr,
+                                         const uint8_t *const data, const uint32_t size)
+{
+    /* The device wraps the program within the page, the data past the page end would overwrite its start. */
+    if ((data == NULL) || (size == 0) || (size > (LL_SPI_NOR_PAGE_SIZE - (addr % LL_SPI_NOR_PAGE_SIZE))) ||
+        (addr >= dev->size))
+    {
+        return LL_SPI_NOR_RES_ERR;
+    }
+
+    if (ll_spi_nor_busy(dev) == 1)
+    {
+        return LL_SPI_NOR_RES_BUSY;
+    }
+
+    ll_spi_nor_cmd(dev, LL_SPI_NOR_CMD_WREN, 0, 0, NULL, NULL, 0);
+    ll_spi_nor_cmd(dev, LL_SPI_NOR_CMD_PP, addr, 3, data, NULL, size);
+
+    return LL_SPI_NOR_RES_OK;
+}
+
+ll_spi_nor_res_t ll_spi_nor_erase(const struct ll_spi_nor *const dev, const uint32_t addr, const uint32_t size)
+{
+    uint8_t cmd;
+
+    if (size == LL_SPI_NOR_SECTOR_SIZE)
+    {
+        cmd = LL_SPI_NOR_CMD_SE;
+    }
+    else if (size == LL_SPI_NOR_BLOCK_SIZE)
+    {
+        cmd = LL_SPI_NOR_CMD_BE;
+    }
+    else
+    {
+        return LL_SPI_NOR_RES_ERR;
+    }
+
+    if (((addr % size) != 0) || (addr >= dev->size))
+    {
+        return LL_SPI_NOR_RES_ERR;
+    }
+
+    if (ll_spi_nor_busy(dev) == 1)
+    {
+        return LL_SPI_NOR_RES_BUSY;
+    }
+
+    ll_spi_nor_cmd(dev, LL_SPI_NOR_CMD_WREN, 0, 0, NULL, NULL, 0);
+    ll_spi_nor_cmd(dev, cmd, addr, 3, NULL, NULL, 0);
+
+    return LL_SPI_NOR_RES_OK;
+}
+
+ll_spi_nor_res_t ll_spi_nor_log_start(struct ll_spi_nor *const dev, const uint32_t addr)
+{
+    if (((addr % LL_SPI_NOR_SECTOR_SIZE) != 0) || (addr > dev->size))
+    {
+        return LL_SPI_NOR_RES_ERR;
+    }
+
+    memset(&dev->stats, 0, sizeof(dev->stats));
+    dev->fill    = 0;
+    dev->active  = 0;
+    dev->pending = 0;
+    dev->addr    = addr;
+    dev->erased  = addr;
+
+    return LL_SPI_NOR_RES_OK;
+}
+
+uint32_t ll_spi_nor_log_write(struct ll_spi_nor *const dev, const uint8_t *const data, const uint32_t size)
+{
+    uint32_t taken = 0;
+
+    if (data == NULL)
+    {
+        return 0;
+    }
+
+    while (taken < size)
+    {
+        uint32_t chunk = LL_SPI_NOR_PAGE_SIZE - dev->fill;
+
+        chunk = ((size - taken) < chunk) ? (size - taken) : chunk;
+
+        memcpy(&dev->page[dev->active][dev->fill], &data[taken], chunk);
+        dev->fill += chunk;
+        taken     += chunk;
+
+        if (dev->fill < LL_SPI_NOR_PAGE_SIZE)
+        {
+            break;
+        }
+
+        /* The full page is handed over and the other one is filled while it is programmed. */
+        if (dev->pending == 1)
+        {
+            (void)ll_spi_nor_log_poll(dev);
+        }
+
+        if (dev->pending == 1)
+        {
+            dev->stats.stalls += (taken < size) ? 1 : 0;
+            break;
+        }
+
+        dev->pending = 1;
+        dev->active ^= 1;
+        dev->fill    = 0;
+    }
+
+    (void)ll_spi_nor_log_poll(dev);
+
+    return taken;
+}
+
+ll_spi_nor_res_t ll_spi_nor_log_poll(struct ll_spi_nor *const dev)
+{
+    if (ll_spi_nor_busy(dev) == 1)
+    {
+        return LL_SPI_NOR_RES_BUSY;
+    }
+
+    if (dev->pending == 1)
+    {
+        if (dev->addr >= dev->size)
+        {
+            return LL_SPI_NOR_RES_FULL;
+        }
+
+        if ((dev->addr + LL_SPI_NOR_PAGE_SIZE) > dev->erased)
+        {
+            ll_spi_nor_erase_next(dev);
+            return LL_SPI_NOR_RES_BUSY;
+        }
+
+        if (ll_spi_nor_page_program(dev, dev->addr, &dev->page[dev->active ^ 1][0], LL_SPI_NOR_PAGE_SIZE) ==
+            LL_SPI_NOR_RES_OK)
+        {
+            dev->addr   += LL_SPI_NOR_PAGE_SIZE;
+            dev->pending = 0;
+            dev->stats.pages++;
+        }
+
+        return LL_SPI_NOR_RES_BUSY;
+    }
+
+    /* The device is idle, the erase now saves the wait of the page later. */
+    if ((dev->erased < dev->size) && ((dev->erased - dev->addr) < LL_SPI_NOR_ERASE_AHEAD))
+    {
+        ll_spi_nor_erase_next(dev);
+        return LL_SPI_NOR_RES_BUSY;
+    }
+
+    return LL_SPI_NOR_RES_OK;
+}
+
+ll_spi_nor_res_t ll_spi_nor_log_flush(struct ll_spi_nor *const dev)
+{
+    /* The rest of the page stays erased, the reader skips the 0xff bytes. */
+    if (dev->fill > 0)
+    {
+        while (dev->pending == 1)
+        {
+            if (ll_spi_nor_log_poll(dev) == LL_SPI_NOR_RES_FULL)
+            {
+                return LL_SPI_NOR_RES_FULL;
+            }
+        }
+
+        memset(&dev->page[dev->active][dev->fill], 0xff, LL_SPI_NOR_PAGE_SIZE - dev->fill);
+        dev->pending = 1;
+        dev->active ^= 1;
+        dev->fill    = 0;
+    }
+
+    while (dev->pending == 1)
+    {
+        if (ll_spi_nor_log_poll(dev) == LL_SPI_NOR_RES_FULL)
+        {
+            return LL_SPI_NOR_RES_FULL;
+        }
+    }
+
+    ll_spi_nor_wait(dev);
+
+    return LL_SPI_NOR_RES_OK;
+}
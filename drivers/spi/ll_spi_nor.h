@@ -0,0 +1,223 @@
+#ifndef _LL_SPI_NOR_H
+#define _LL_SPI_NOR_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+#define LL_SPI_NOR_PAGE_SIZE        (0x00000100u)   /*!< The page program size.                         */
+#define LL_SPI_NOR_SECTOR_SIZE      (0x00001000u)   /*!< The smallest erase size.                       */
+#define LL_SPI_NOR_BLOCK_SIZE       (0x00010000u)   /*!< The block erase size.                          */
+#define LL_SPI_NOR_ERASE_AHEAD      (0x00010000u)   /*!< The erased space kept ahead of the log.        */
+
+#define LL_SPI_NOR_CMD_WREN         (0x06u)         /*!< The write enable.                              */
+#define LL_SPI_NOR_CMD_RDSR         (0x05u)         /*!< The status register read.                      */
+#define LL_SPI_NOR_CMD_JEDEC_ID     (0x9fu)         /*!< The JEDEC ID read.                             */
+#define LL_SPI_NOR_CMD_FAST_READ    (0x0bu)         /*!< The read with a dummy byte after the address.  */
+#define LL_SPI_NOR_CMD_PP           (0x02u)         /*!< The page program.                              */
+#define LL_SPI_NOR_CMD_SE           (0x20u)         /*!< The 4 KiB sector erase.                        */
+#define LL_SPI_NOR_CMD_BE           (0xd8u)         /*!< The 64 KiB block erase.                        */
+#define LL_SPI_NOR_SR_WIP           (0x01u)         /*!< The write in progress status bit.              */
+
+///
+/// \brief The SPI NOR result type.
+///
+typedef enum ll_spi_nor_res
+{
+    LL_SPI_NOR_RES_OK = 0,
+    LL_SPI_NOR_RES_ERR,                             /*!< No device, or the argument is out of range.    */
+    LL_SPI_NOR_RES_BUSY,                            /*!< The device still programs or erases.           */
+    LL_SPI_NOR_RES_FULL,                            /*!< The log reached the end of the device.         */
+} ll_spi_nor_res_t;
+
+///
+/// \brief The SPI NOR bus type, the chip select and the full-duplex transfer.
+///
+struct ll_spi_nor_bus
+{
+    void (*init)(void);
+    void (*select)(void);
+    void (*deselect)(void);
+    void (*xfer)(const uint8_t *const tx, uint8_t *const rx, const uint32_t size);  /*!< NULL tx sends 0xff. */
+};
+
+///
+/// \brief The SPI1 bus shared with the BMI270, the flash on its own chip select.
+///
+extern const struct ll_spi_nor_bus ll_spi_nor_bus_spi1;
+
+///
+/// \brief The SPI NOR JEDEC ID type.
+///
+struct ll_spi_nor_id
+{
+    uint8_t manufacturer;
+    uint8_t type;
+    uint8_t capacity;                               /*!< The log2 of the size in bytes.                 */
+};
+
+///
+/// \brief The SPI NOR log statistics type.
+///
+struct ll_spi_nor_stats
+{
+    uint32_t pages;                                 /*!< The programmed pages.                          */
+    uint32_t sectors;                               /*!< The erased sectors.                            */
+    uint32_t blocks;                                /*!< The erased blocks.                             */
+    uint32_t stalls;                                /*!< The writes cut short, both pages were full.    */
+};
+
+///
+/// \brief The SPI NOR device type.
+///
+/// The log fills one page buffer while the device programs the other one, and erases ahead of the
+/// programmed pages while it is otherwise idle.
+///
+struct ll_spi_nor
+{
+    const struct ll_spi_nor_bus *bus;
+    struct ll_spi_nor_id         id;
+    uint32_t                     size;              /*!< The device size in bytes.                      */
+    uint8_t                      page[2][LL_SPI_NOR_PAGE_SIZE];
+    uint32_t                     fill;              /*!< The bytes in the page being filled.            */
+    uint8_t                      active;            /*!< The page being filled.                         */
+    uint8_t                      pending;           /*!< 1 if the other page waits for the program.     */
+    uint32_t                     addr;              /*!< The address of the next programmed page.       */
+    uint32_t                     erased;            /*!< The end of the erased space.                   */
+    struct ll_spi_nor_stats      stats;
+};
+
+///
+/// \brief Initializes the device, the JEDEC ID gives the size.
+///
+/// \param[out] dev The device.
+/// \param[in]  bus The bus.
+///
+/// \return ll_spi_nor_res_t   The SPI NOR result.
+/// \retval LL_SPI_NOR_RES_OK  On success.
+/// \retval LL_SPI_NOR_RES_ERR On no device or unknown size.
+///
+ll_spi_nor_res_t ll_spi_nor_init(struct ll_spi_nor *const dev, const struct ll_spi_nor_bus *const bus);
+
+///
+/// \brief Reads the JEDEC ID.
+///
+/// \param[in]  dev The device.
+/// \param[out] id  The JEDEC ID.
+///
+void ll_spi_nor_id_read(const struct ll_spi_nor *const dev, struct ll_spi_nor_id *const id);
+
+///
+/// \brief Checks if the device still programs or erases.
+///
+/// \param[in] dev The device.
+///
+/// \return uint8_t 1 if busy, 0 otherwise.
+///
+uint8_t ll_spi_nor_busy(const struct ll_spi_nor *const dev);
+
+///
+/// \brief Waits until the device is done with the program or the erase.
+///
+/// \param[in] dev The device.
+///
+void ll_spi_nor_wait(const struct ll_spi_nor *const dev);
+
+///
+/// \brief Reads the data with the fast read, waits for the device first.
+///
+/// \param[in]  dev  The device.
+/// \param[in]  addr The address.
+/// \param[out] data The data.
+/// \param[in]  size The data size.
+///
+/// \return ll_spi_nor_res_t   The SPI NOR result.
+/// \retval LL_SPI_NOR_RES_OK  On success.
+/// \retval LL_SPI_NOR_RES_ERR On the range past the device end.
+///
+ll_spi_nor_res_t ll_spi_nor_read(const struct ll_spi_nor *const dev, const uint32_t addr, uint8_t *const data,
+                                 const uint32_t size);
+
+///
+/// \brief Starts the program of the data within one page, does not wait for it.
+///
+/// \param[in] dev  The device.
+/// \param[in] addr The address.
+/// \param[in] data The data.
+/// \param[in] size The data size, up to the page end.
+///
+/// \return ll_spi_nor_res_t    The SPI NOR result.
+/// \retval LL_SPI_NOR_RES_OK   On started.
+/// \retval LL_SPI_NOR_RES_BUSY On busy device.
+/// \retval LL_SPI_NOR_RES_ERR  On the range crossing the page or the device end.
+///
+ll_spi_nor_res_t ll_spi_nor_page_program(const struct ll_spi_nor *const dev, const uint32_t addr,
+                                         const uint8_t *const data, const uint32_t size);
+
+///
+/// \brief Starts the erase of the sector or the block, does not wait for it.
+///
+/// \param[in] dev  The device.
+/// \param[in] addr The address aligned to the size.
+/// \param[in] size LL_SPI_NOR_SECTOR_SIZE or LL_SPI_NOR_BLOCK_SIZE.
+///
+/// \return ll_spi_nor_res_t    The SPI NOR result.
+/// \retval LL_SPI_NOR_RES_OK   On started.
+/// \retval LL_SPI_NOR_RES_BUSY On busy device.
+/// \retval LL_SPI_NOR_RES_ERR  On unaligned address or unknown size.
+///
+ll_spi_nor_res_t ll_spi_nor_erase(const struct ll_spi_nor *const dev, const uint32_t addr, const uint32_t size);
+
+///
+/// \brief Starts the log at the sector, the space from there on is erased as the log grows.
+///
+/// \param[in,out] dev  The device.
+/// \param[in]     addr The sector aligned address.
+///
+/// \return ll_spi_nor_res_t   The SPI NOR result.
+/// \retval LL_SPI_NOR_RES_OK  On success.
+/// \retval LL_SPI_NOR_RES_ERR On unaligned address.
+///
+ll_spi_nor_res_t ll_spi_nor_log_start(struct ll_spi_nor *const dev, const uint32_t addr);
+
+///
+/// \brief Appends the data to the log, never waits for the device.
+///
+/// \param[in,out] dev  The device.
+/// \param[in]     data The data.
+/// \param[in]     size The data size.
+///
+/// \return uint32_t The count of the bytes taken, less than the size while both pages are full.
+///
+uint32_t ll_spi_nor_log_write(struct ll_spi_nor *const dev, const uint8_t *const data, const uint32_t size);
+
+///
+/// \brief Moves the log on: programs the full page, or erases ahead while there is none.
+///
+/// \param[in,out] dev The device.
+///
+/// \return ll_spi_nor_res_t    The SPI NOR result.
+/// \retval LL_SPI_NOR_RES_OK   On nothing left to do.
+/// \retval LL_SPI_NOR_RES_BUSY On the program or the erase in progress.
+/// \retval LL_SPI_NOR_RES_FULL On the log at the device end.
+///
+ll_spi_nor_res_t ll_spi_nor_log_poll(struct ll_spi_nor *const dev);
+
+///
+/// \brief Programs the page filled so far and waits for the device, the next write starts a new page.
+///
+/// \param[in,out] dev The device.
+///
+/// \return ll_spi_nor_res_t    The SPI NOR result.
+/// \retval LL_SPI_NOR_RES_OK   On success.
+/// \retval LL_SPI_NOR_RES_FULL On the log at the device end.
+///
+ll_spi_nor_res_t ll_spi_nor_log_flush(struct ll_spi_nor *const dev);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _LL_SPI_NOR_H */
@@ -0,0 +1,88 @@
+#include "ll_spi_nor.h"
+#include "libopencm3/stm32/gpio.h"
+#include "libopencm3/stm32/rcc.h"
+#include "libopencm3/stm32/spi.h"
+#include <stddef.h>
+
+///
+/// \brief The flash chip select, the BMI270 keeps PA4.
+///
+#ifndef LL_SPI_NOR_CS_PORT
+#define LL_SPI_NOR_CS_PORT  GPIOB
+#define LL_SPI_NOR_CS_RCC   RCC_GPIOB
+#define LL_SPI_NOR_CS_PIN   GPIO12
+#endif  /* LL_SPI_NOR_CS_PORT */
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief Sets the chip select up and releases it, the SPI1 is set up by the bootloader.
+///
+static void ll_spi_nor_spi1_init(void);
+
+///
+/// \brief Selects the flash.
+///
+static void ll_spi_nor_spi1_select(void);
+
+///
+/// \brief Releases the flash.
+///
+static void ll_spi_nor_spi1_deselect(void);
+
+///
+/// \brief Transfers the bytes.
+///
+/// \param[in]  tx   The data to send, NULL to send 0xff.
+/// \param[out] rx   The data received, NULL to drop it.
+/// \param[in]  size The data size.
+///
+static void ll_spi_nor_spi1_xfer(const uint8_t *const tx, uint8_t *const rx, const uint32_t size);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static void ll_spi_nor_spi1_init(void)
+{
+    rcc_periph_clock_enable(LL_SPI_NOR_CS_RCC);
+    gpio_set(LL_SPI_NOR_CS_PORT, LL_SPI_NOR_CS_PIN);
+    gpio_mode_setup(LL_SPI_NOR_CS_PORT, GPIO_MODE_OUTPUT, GPIO_PUPD_NONE, LL_SPI_NOR_CS_PIN);
+}
+
+static void ll_spi_nor_spi1_select(void)
+{
+    gpio_clear(LL_SPI_NOR_CS_PORT, LL_SPI_NOR_CS_PIN);
+    spi_enable(SPI1);
+}
+
+static void ll_spi_nor_spi1_deselect(void)
+{
+    spi_disable(SPI1);
+    gpio_set(LL_SPI_NOR_CS_PORT, LL_SPI_NOR_CS_PIN);
+}
+
+static void ll_spi_nor_spi1_xfer(const uint8_t *const tx, uint8_t *const rx, const uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        spi_send8(SPI1, (tx != NULL) ? tx[i] : 0xff);
+        uint8_t byte = spi_read8(SPI1);
+
+        if (rx != NULL)
+        {
+            rx[i] = byte;
+        }
+    }
+}
+
+///***********************************************************************************************************
+/// Global objects - definition.
+///***********************************************************************************************************
+const struct ll_spi_nor_bus ll_spi_nor_bus_spi1 =
+{
+    .init     = ll_spi_nor_spi1_init,
+    .select   = ll_spi_nor_spi1_select,
+    .deselect = ll_spi_nor_spi1_deselect,
+    .xfer     = ll_spi_nor_spi1_xfer,
+};
@@ -1,4 +1,5 @@
 #include "ll_usart.h"
+#include "ll_usart_dma.h"
 #include "libopencm3/stm32/usart.h"
 #if (defined(DEBUG) && (DEBUG == 1))
 #include "printf.h"
@@ -6,6 +7,7 @@
 
 #define LL_USART_DEBUG_BAUDRATE  (115200u)
 #define LL_USART_DEBUG_INTERFACE (USART3)
+#define LL_USART_DEBUG_DMA_INST  (LL_USART_DMA_INST_USART3)
 
 ///*************************************************************************************************
 /// Private objects - declaration.
@@ -17,6 +19,7 @@ typedef struct
 {
     uint32_t baud;
     uint32_t intf;
+    uint32_t dma;                       /*!< 1 if the output goes through the DMA ring. */
     ll_usart_status_t stat;
 } ll_usart_t;
 
@@ -34,7 +37,23 @@ static ll_usart_t ll_usart;
 #if (defined(DEBUG) && (DEBUG == 1))
 void _putchar(char character)
 {
-    usart_send_blocking(LL_USART_DEBUG_INTERFACE, (uint16_t)character);
+    uint8_t byte = (uint8_t)character;
+
+    /* The images which never start the console, e.g. the updater, keep the blocking output. */
+    if (ll_usart.dma == 0)
+    {
+        usart_send_blocking(LL_USART_DEBUG_INTERFACE, (uint16_t)character);
+        return;
+    }
+
+    (void)ll_usart_dma_tx_write(LL_USART_DEBUG_DMA_INST, &byte, 1);
+
+    /* The DMA starts once per line rather than once per character, the long lines go in halves. */
+    if ((character == '\n') ||
+        (ll_usart_dma_tx_pending(LL_USART_DEBUG_DMA_INST) >= (LL_USART_DMA_TX_BUF_SIZE / 2u)))
+    {
+        ll_usart_dma_tx_kick(LL_USART_DEBUG_DMA_INST);
+    }
 }
 #else
 void _putchar(char character)
@@ -72,6 +91,7 @@ void ll_usart_debug_init(void)
 
         usart_enable(ll_usart.intf);
 
+        ll_usart.dma  = (ll_usart_dma_tx_init(LL_USART_DEBUG_DMA_INST) == LL_USART_DMA_RES_OK) ? 1 : 0;
         ll_usart.stat = LL_USART_STATUS_INIT;
     }
 }
@@ -84,6 +104,12 @@ void ll_usart_debug_deinit(void)
 
         ll_usart.baud = 0;
         ll_usart.intf = 0;
+        ll_usart.dma  = 0;
         ll_usart.stat = LL_USART_STATUS_DEINIT;
     }
 }
+
+uint32_t ll_usart_debug_dropped(void)
+{
+    return ll_usart_dma_tx_dropped(LL_USART_DEBUG_DMA_INST);
+}
@@ -42,7 +42,7 @@ ll_usart_status_t ll_usart_is_initialized(void);
 void ll_usart_set_init_status(ll_usart_status_t status);
 
 ///
-/// \brief Initializes the USART debug interface.
+/// \brief Initializes the USART debug interface and its DMA transmission.
 ///
 void ll_usart_debug_init(void);
 
@@ -51,6 +51,16 @@ void ll_usart_debug_init(void);
 ///
 void ll_usart_debug_deinit(void);
 
+///
+/// \brief Gets the number of the debug output bytes dropped on the full transmission ring.
+///
+/// The output never blocks once the interface is initialized, printf queues the bytes and DMA
+/// sends them.
+///
+/// \return uint32_t The number of dropped bytes.
+///
+uint32_t ll_usart_debug_dropped(void);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
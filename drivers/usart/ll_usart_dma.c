@@ -0,0 +1,495 @@
+#include "ll_usart_dma.h"
+#include "cache.h"
+#include "timing.h"
+#include "data_structure/ring_buffer.h"
+#include "libopencm3/cm3/nvic.h"
+#include "libopencm3/stm32/dma.h"
+#include "libopencm3/stm32/gpio.h"
+#include "libopencm3/stm32/usart.h"
+#include <stddef.h>
+
+///
+/// \brief The USART interrupt clear flags, the errors and the idle line.
+///
+#define LL_USART_DMA_ICR_ALL    (USART_ICR_PECF | USART_ICR_FECF | USART_ICR_NCF | USART_ICR_ORECF | USART_ICR_IDLECF)
+
+///*************************************************************************************************
+/// Private objects - declaration.
+///*************************************************************************************************
+///
+/// \brief The USART DMA hardware description.
+///
+struct ll_usart_dma_hw
+{
+    uint32_t usart;
+    uint32_t dma;
+    uint8_t stream;
+    uint8_t tx_stream;
+    uint8_t tx_irq;
+    uint32_t chsel;                             /*!< The DMA_SxCR_CHSEL_x of both streams.                  */
+    uint32_t port;
+    uint16_t pin;
+    uint8_t af;
+    const volatile uint32_t *clk;
+};
+
+///
+/// \brief The USART DMA structure.
+///
+struct ll_usart_dma
+{
+    const struct ll_usart_dma_hw hw;
+    uint8_t *const buf;
+    uint8_t *const tx_buf;
+    uint32_t tail;
+    ll_usart_dma_rx_cb_t cb;
+    void *arg;
+    ring_buffer_t tx_ring;
+    uint32_t tx_len;                            /*!< The bytes the running DMA transfer reads in place.     */
+    uint32_t tx_dropped;
+};
+
+///*************************************************************************************************
+/// Private objects - definition.
+///*************************************************************************************************
+///
+/// \brief The USART6 reception buffer.
+///
+static CACHE_DMA_BUFFER(uint8_t, usart6_rx_buf, LL_USART_DMA_RX_BUF_SIZE);
+
+///
+/// \brief The USART3 reception buffer.
+///
+static CACHE_DMA_BUFFER(uint8_t, usart3_rx_buf, LL_USART_DMA_RX_BUF_SIZE);
+
+///
+/// \brief The USART3 transmission ring storage.
+///
+static CACHE_DMA_BUFFER(uint8_t, usart3_tx_buf, LL_USART_DMA_TX_BUF_SIZE);
+
+///
+/// \brief The USART DMA instances.
+///
+static struct ll_usart_dma ll_usart_dma_arr[LL_USART_DMA_INST_TOTAL] =
+{
+    [LL_USART_DMA_INST_USART6] =
+    {
+        .hw =
+        {
+            .usart     = USART6,
+            .dma       = DMA2,
+            .stream    = DMA_STREAM1,
+            .chsel     = DMA_SxCR_CHSEL_5,
+            .port      = GPIOC,
+            .pin       = GPIO7,
+            .af        = GPIO_AF8,
+            .clk       = &timing_apb2_freq,
+        },
+        .buf    = usart6_rx_buf,
+        .tx_buf = NULL,
+    },
+    [LL_USART_DMA_INST_USART3] =
+    {
+        .hw =
+        {
+            .usart     = USART3,
+            .dma       = DMA1,
+            .stream    = DMA_STREAM1,
+            .tx_stream = DMA_STREAM3,
+            .tx_irq    = NVIC_DMA1_STREAM3_IRQ,
+            .chsel     = DMA_SxCR_CHSEL_4,
+            .port      = GPIOC,
+            .pin       = GPIO11,
+            .af        = GPIO_AF7,
+            .clk       = &timing_apb1_freq,
+        },
+        .buf    = usart3_rx_buf,
+        .tx_buf = usart3_tx_buf,
+    },
+};
+
+///*************************************************************************************************
+/// Private functions - declaration.
+///*************************************************************************************************
+///
+/// \brief Delivers the bytes received since the previous call.
+///
+/// \param[in] dev  The pointer to the USART DMA instance.
+/// \param[in] idle True if called on the idle line, false otherwise.
+///
+static void rx_drain(struct ll_usart_dma *const dev, const bool idle);
+
+///
+/// \brief Pops the bytes of the completed transfer and starts the next one on the queued bytes,
+///        called from the transmission stream interrupt only.
+///
+/// \param[in] dev The pointer to the USART DMA instance.
+///
+static void tx_drain(struct ll_usart_dma *const dev);
+
+///*************************************************************************************************
+/// Private functions - definition.
+///*************************************************************************************************
+static void rx_drain(struct ll_usart_dma *const dev, const bool idle)
+{
+    if (dev->cb == NULL)
+    {
+        return;
+    }
+
+    /* The counter reloads to the buffer size after the last byte, so zero never stays visible. */
+    uint32_t head = LL_USART_DMA_RX_BUF_SIZE - dma_get_number_of_data(dev->hw.dma, dev->hw.stream);
+    uint32_t tail = dev->tail;
+
+    if (head >= LL_USART_DMA_RX_BUF_SIZE)
+    {
+        head = 0;
+    }
+
+    if (head == tail)
+    {
+        if (idle)
+        {
+            dev->cb(dev->arg, NULL, 0, true);
+        }
+
+        return;
+    }
+
+    if (head < tail)
+    {
+        (void)cache_dma_rx_complete(&dev->buf[tail], LL_USART_DMA_RX_BUF_SIZE - tail);
+        dev->cb(dev->arg, &dev->buf[tail], LL_USART_DMA_RX_BUF_SIZE - tail, (idle && (head == 0)));
+        tail = 0;
+    }
+
+    if (head > tail)
+    {
+        (void)cache_dma_rx_complete(&dev->buf[tail], head - tail);
+        dev->cb(dev->arg, &dev->buf[tail], head - tail, idle);
+    }
+
+    dev->tail = head;
+}
+
+static void tx_drain(struct ll_usart_dma *const dev)
+{
+    const struct ll_usart_dma_hw *hw = &dev->hw;
+    const void *data;
+
+    /* The stream disables itself on the transfer complete, the kick finds it running otherwise. */
+    if ((dev->tx_ring.data == NULL) || (DMA_SCR(hw->dma, hw->tx_stream) & DMA_SxCR_EN))
+    {
+        return;
+    }
+
+    (void)ring_buffer_skip(&dev->tx_ring, dev->tx_len);
+    dev->tx_len = ring_buffer_peek(&dev->tx_ring, &data);
+
+    if (dev->tx_len == 0)
+    {
+        return;
+    }
+
+    (void)cache_dma_tx_prepare(data, dev->tx_len);
+
+    /* The rest of the stream configuration stays from ll_usart_dma_tx_init(). */
+    dma_clear_interrupt_flags(hw->dma, hw->tx_stream, DMA_ISR_FLAGS);
+    dma_set_memory_address(hw->dma, hw->tx_stream, (uint32_t)data);
+    dma_set_number_of_data(hw->dma, hw->tx_stream, (uint16_t)dev->tx_len);
+    dma_enable_stream(hw->dma, hw->tx_stream);
+}
+
+///*************************************************************************************************
+/// Global functions - definition.
+///*************************************************************************************************
+ll_usart_dma_res_t ll_usart_dma_rx_init(const ll_usart_dma_inst_t inst, const struct ll_usart_dma_conf *const conf,
+                                        const ll_usart_dma_rx_cb_t cb, void *const arg)
+{
+    if ((inst < LL_USART_DMA_INST_BEGIN) || (inst >= LL_USART_DMA_INST_TOTAL) || (conf == NULL) ||
+        (conf->baud == 0) || (cb == NULL))
+    {
+        return LL_USART_DMA_RES_ERR;
+    }
+
+    struct ll_usart_dma *dev         = &ll_usart_dma_arr[inst];
+    const struct ll_usart_dma_hw *hw = &dev->hw;
+
+    ll_usart_dma_rx_deinit(inst);
+
+    dev->tail = 0;
+    dev->cb   = cb;
+    dev->arg  = arg;
+
+    /* RX pin in the alternate function mode, pulled to the idle level. */
+    gpio_mode_setup(hw->port, GPIO_MODE_AF, conf->inv ? GPIO_PUPD_NONE : GPIO_PUPD_PULLUP, hw->pin);
+    gpio_set_af(hw->port, hw->af, hw->pin);
+
+    (void)cache_dma_rx_prepare(dev->buf, LL_USART_DMA_RX_BUF_SIZE);
+
+    dma_stream_reset(hw->dma, hw->stream);
+    dma_channel_select(hw->dma, hw->stream, hw->chsel);
+    dma_set_priority(hw->dma, hw->stream, DMA_SxCR_PL_HIGH);
+    dma_set_transfer_mode(hw->dma, hw->stream, DMA_SxCR_DIR_PERIPHERAL_TO_MEM);
+    dma_set_peripheral_address(hw->dma, hw->stream, (uint32_t)&USART_RDR(hw->usart));
+    dma_set_memory_address(hw->dma, hw->stream, (uint32_t)dev->buf);
+    dma_set_number_of_data(hw->dma, hw->stream, LL_USART_DMA_RX_BUF_SIZE);
+    dma_enable_memory_increment_mode(hw->dma, hw->stream);
+    dma_enable_circular_mode(hw->dma, hw->stream);
+    dma_enable_transfer_complete_interrupt(hw->dma, hw->stream);
+    dma_enable_half_transfer_interrupt(hw->dma, hw->stream);
+    dma_clear_interrupt_flags(hw->dma, hw->stream, DMA_ISR_FLAGS);
+    dma_enable_stream(hw->dma, hw->stream);
+
+    /*
+     * The APB clocks are handed over by the bootloader, usart_set_baudrate() would take the libopencm3
+     * defaults. The USART is oversampled by 16.
+     */
+    USART_BRR(hw->usart) = (*hw->clk + (conf->baud / 2u)) / conf->baud;
+
+    usart_set_stopbits(hw->usart, (conf->stop == LL_USART_DMA_STOP_2) ? USART_STOPBITS_2 : USART_STOPBITS_1);
+
+    if (conf->inv)
+    {
+        USART_CR2(hw->usart) |= USART_CR2_RXINV;
+    }
+    else
+    {
+        USART_CR2(hw->usart) &= ~USART_CR2_RXINV;
+    }
+
+    /* The overrun is not detected, a lost byte is caught by the protocol checksum instead. */
+    usart_enable_rx_dma(hw->usart);
+    USART_CR3(hw->usart) |= USART_CR3_OVRDIS;
+
+    /* The parity bit takes the ninth data bit. */
+    switch (conf->parity)
+    {
+        case LL_USART_DMA_PARITY_EVEN:
+            usart_set_databits(hw->usart, 9);
+            usart_set_parity(hw->usart, USART_PARITY_EVEN);
+            break;
+
+        case LL_USART_DMA_PARITY_ODD:
+            usart_set_databits(hw->usart, 9);
+            usart_set_parity(hw->usart, USART_PARITY_ODD);
+            break;
+
+        default:
+            usart_set_databits(hw->usart, 8);
+            usart_set_parity(hw->usart, USART_PARITY_NONE);
+            break;
+    }
+
+    usart_set_mode(hw->usart, conf->tx ? USART_MODE_TX_RX : USART_MODE_RX);
+
+    USART_ICR(hw->usart)  = LL_USART_DMA_ICR_ALL;
+    USART_CR1(hw->usart) |= USART_CR1_IDLEIE;
+    usart_enable(hw->usart);
+
+    return LL_USART_DMA_RES_OK;
+}
+
+void ll_usart_dma_rx_deinit(const ll_usart_dma_inst_t inst)
+{
+    if ((inst < LL_USART_DMA_INST_BEGIN) || (inst >= LL_USART_DMA_INST_TOTAL))
+    {
+        return;
+    }
+
+    struct ll_usart_dma *dev         = &ll_usart_dma_arr[inst];
+    const struct ll_usart_dma_hw *hw = &dev->hw;
+
+    USART_CR1(hw->usart) = 0;
+    USART_CR3(hw->usart) &= USART_CR3_DMAT;
+
+    dma_disable_stream(hw->dma, hw->stream);
+    while (DMA_SCR(hw->dma, hw->stream) & DMA_SxCR_EN);
+    dma_clear_interrupt_flags(hw->dma, hw->stream, DMA_ISR_FLAGS);
+
+    dev->cb  = NULL;
+    dev->arg = NULL;
+}
+
+ll_usart_dma_res_t ll_usart_dma_tx_init(const ll_usart_dma_inst_t inst)
+{
+    if ((inst < LL_USART_DMA_INST_BEGIN) || (inst >= LL_USART_DMA_INST_TOTAL) ||
+        (ll_usart_dma_arr[inst].tx_buf == NULL))
+    {
+        return LL_USART_DMA_RES_ERR;
+    }
+
+    struct ll_usart_dma *dev         = &ll_usart_dma_arr[inst];
+    const struct ll_usart_dma_hw *hw = &dev->hw;
+
+    dma_disable_stream(hw->dma, hw->tx_stream);
+    while (DMA_SCR(hw->dma, hw->tx_stream) & DMA_SxCR_EN);
+
+    /* Configured once, tx_drain() sets the memory address and the length of every transfer. */
+    dma_stream_reset(hw->dma, hw->tx_stream);
+    dma_channel_select(hw->dma, hw->tx_stream, hw->chsel);
+    dma_set_transfer_mode(hw->dma, hw->tx_stream, DMA_SxCR_DIR_MEM_TO_PERIPHERAL);
+    dma_set_peripheral_address(hw->dma, hw->tx_stream, (uint32_t)&USART_TDR(hw->usart));
+    dma_enable_memory_increment_mode(hw->dma, hw->tx_stream);
+    dma_enable_transfer_complete_interrupt(hw->dma, hw->tx_stream);
+
+    if (ring_buffer_init(&dev->tx_ring, dev->tx_buf, 1, LL_USART_DMA_TX_BUF_SIZE) != RING_BUFFER_RESULT_SUCCESS)
+    {
+        return LL_USART_DMA_RES_ERR;
+    }
+
+    dev->tx_len     = 0;
+    dev->tx_dropped = 0;
+
+    usart_enable_tx_dma(hw->usart);
+
+    return LL_USART_DMA_RES_OK;
+}
+
+uint32_t ll_usart_dma_tx_write(const ll_usart_dma_inst_t inst, const uint8_t *const data, const uint32_t len)
+{
+    if ((inst < LL_USART_DMA_INST_BEGIN) || (inst >= LL_USART_DMA_INST_TOTAL))
+    {
+        return 0;
+    }
+
+    struct ll_usart_dma *dev = &ll_usart_dma_arr[inst];
+
+    if (dev->tx_ring.data == NULL)
+    {
+        return 0;
+    }
+
+    uint32_t queued = ring_buffer_push_n(&dev->tx_ring, data, len);
+
+    dev->tx_dropped += len - queued;
+
+    return queued;
+}
+
+uint32_t ll_usart_dma_tx_space(const ll_usart_dma_inst_t inst)
+{
+    if ((inst < LL_USART_DMA_INST_BEGIN) || (inst >= LL_USART_DMA_INST_TOTAL) ||
+        (ll_usart_dma_arr[inst].tx_ring.data == NULL))
+    {
+        return 0;
+    }
+
+    return ring_buffer_space(&ll_usart_dma_arr[inst].tx_ring);
+}
+
+uint32_t ll_usart_dma_tx_reserve(const ll_usart_dma_inst_t inst, uint8_t **const data)
+{
+    if ((inst < LL_USART_DMA_INST_BEGIN) || (inst >= LL_USART_DMA_INST_TOTAL) ||
+        (ll_usart_dma_arr[inst].tx_ring.data == NULL))
+    {
+        return 0;
+    }
+
+    return ring_buffer_reserve(&ll_usart_dma_arr[inst].tx_ring, (void **)data);
+}
+
+void ll_usart_dma_tx_commit(const ll_usart_dma_inst_t inst, const uint32_t len)
+{
+    if ((inst < LL_USART_DMA_INST_BEGIN) || (inst >= LL_USART_DMA_INST_TOTAL) ||
+        (ll_usart_dma_arr[inst].tx_ring.data == NULL))
+    {
+        return;
+    }
+
+    (void)ring_buffer_commit(&ll_usart_dma_arr[inst].tx_ring, len);
+}
+
+void ll_usart_dma_tx_kick(const ll_usart_dma_inst_t inst)
+{
+    if ((inst < LL_USART_DMA_INST_BEGIN) || (inst >= LL_USART_DMA_INST_TOTAL) ||
+        (ll_usart_dma_arr[inst].tx_ring.data == NULL))
+    {
+        return;
+    }
+
+    /* The ring has a single consumer, the stream interrupt, so the thread only makes it pending. */
+    nvic_set_pending_irq(ll_usart_dma_arr[inst].hw.tx_irq);
+}
+
+uint32_t ll_usart_dma_tx_pending(const ll_usart_dma_inst_t inst)
+{
+    if ((inst < LL_USART_DMA_INST_BEGIN) || (inst >= LL_USART_DMA_INST_TOTAL))
+    {
+        return 0;
+    }
+
+    return ring_buffer_count(&ll_usart_dma_arr[inst].tx_ring);
+}
+
+uint32_t ll_usart_dma_tx_dropped(const ll_usart_dma_inst_t inst)
+{
+    if ((inst < LL_USART_DMA_INST_BEGIN) || (inst >= LL_USART_DMA_INST_TOTAL))
+    {
+        return 0;
+    }
+
+    return ll_usart_dma_arr[inst].tx_dropped;
+}
+
+void _usart6_handler(void)
+{
+    struct ll_usart_dma *dev = &ll_usart_dma_arr[LL_USART_DMA_INST_USART6];
+    bool idle                = usart_get_flag(dev->hw.usart, USART_ISR_IDLE);
+
+    USART_ICR(dev->hw.usart) = LL_USART_DMA_ICR_ALL;
+
+    if (idle)
+    {
+        rx_drain(dev, true);
+    }
+}
+
+void _dma2stream1_handler(void)
+{
+    struct ll_usart_dma *dev = &ll_usart_dma_arr[LL_USART_DMA_INST_USART6];
+    bool xfer                = dma_get_interrupt_flag(dev->hw.dma, dev->hw.stream, DMA_HTIF | DMA_TCIF);
+
+    /* The drain reads the transfer counter, a flag raised after the check is not lost. */
+    dma_clear_interrupt_flags(dev->hw.dma, dev->hw.stream, DMA_ISR_FLAGS);
+
+    if (xfer)
+    {
+        rx_drain(dev, false);
+    }
+}
+
+void _usart3_handler(void)
+{
+    struct ll_usart_dma *dev = &ll_usart_dma_arr[LL_USART_DMA_INST_USART3];
+    bool idle                = usart_get_flag(dev->hw.usart, USART_ISR_IDLE);
+
+    USART_ICR(dev->hw.usart) = LL_USART_DMA_ICR_ALL;
+
+    if (idle)
+    {
+        rx_drain(dev, true);
+    }
+}
+
+void _dma1stream1_handler(void)
+{
+    struct ll_usart_dma *dev = &ll_usart_dma_arr[LL_USART_DMA_INST_USART3];
+    bool xfer                = dma_get_interrupt_flag(dev->hw.dma, dev->hw.stream, DMA_HTIF | DMA_TCIF);
+
+    /* The drain reads the transfer counter, a flag raised after the check is not lost. */
+    dma_clear_interrupt_flags(dev->hw.dma, dev->hw.stream, DMA_ISR_FLAGS);
+
+    if (xfer)
+    {
+        rx_drain(dev, false);
+    }
+}
+
+void _dma1stream3_handler(void)
+{
+    struct ll_usart_dma *dev = &ll_usart_dma_arr[LL_USART_DMA_INST_USART3];
+
+    dma_clear_interrupt_flags(dev->hw.dma, dev->hw.tx_stream, DMA_ISR_FLAGS);
+    tx_drain(dev);
+}
@@ -0,0 +1,196 @@
+#ifndef _LL_USART_DMA_H
+#define _LL_USART_DMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LL_USART_DMA_RX_BUF_SIZE    (128u)      /*!< The circular reception buffer size in bytes.           */
+#define LL_USART_DMA_TX_BUF_SIZE    (1024u)     /*!< The transmission ring size in bytes, a power of two.   */
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+///
+/// \brief The USART DMA result type.
+///
+typedef enum
+{
+    LL_USART_DMA_RES_OK = 0,
+    LL_USART_DMA_RES_ERR,
+} ll_usart_dma_res_t;
+
+///
+/// \brief The USART DMA instances.
+///
+/// LL_USART_DMA_INST_USART6 -> USART6_RX (PC7),  DMA2 stream 1 channel 5, receive only: USART6_TX (PC6)
+///                             is the TIM8_CH1 RC capture input (RFCH3)
+/// LL_USART_DMA_INST_USART3 -> USART3_RX (PC11), DMA1 stream 1 channel 4
+///                             USART3_TX (PC10), DMA1 stream 3 channel 4
+///
+typedef enum
+{
+    LL_USART_DMA_INST_BEGIN  = 0,
+    LL_USART_DMA_INST_USART6 = 0,
+    LL_USART_DMA_INST_USART3,
+    LL_USART_DMA_INST_TOTAL,
+} ll_usart_dma_inst_t;
+
+///
+/// \brief The USART DMA parity type.
+///
+typedef enum
+{
+    LL_USART_DMA_PARITY_NONE = 0,
+    LL_USART_DMA_PARITY_EVEN,
+    LL_USART_DMA_PARITY_ODD,
+} ll_usart_dma_parity_t;
+
+///
+/// \brief The USART DMA stop bits type.
+///
+typedef enum
+{
+    LL_USART_DMA_STOP_1 = 0,
+    LL_USART_DMA_STOP_2,
+} ll_usart_dma_stop_t;
+
+///
+/// \brief The USART DMA reception callback type.
+///
+/// The callback is executed from the USART idle line and the DMA half/full transfer interrupts
+/// with the bytes received since the previous call. The bytes wrapping around the end of the
+/// circular buffer are delivered in two calls.
+///
+/// \param[in] arg  The argument given during the initialization.
+/// \param[in] data The received bytes, NULL if there are none.
+/// \param[in] len  The number of received bytes.
+/// \param[in] idle True if the line went idle after the delivered bytes, false otherwise.
+///
+typedef void (*ll_usart_dma_rx_cb_t)(void *const arg, const uint8_t *const data, const uint32_t len,
+                                     const bool idle);
+
+///
+/// \brief The USART DMA configuration.
+///
+struct ll_usart_dma_conf
+{
+    uint32_t baud;
+    ll_usart_dma_parity_t parity;
+    ll_usart_dma_stop_t stop;
+    bool inv;                                   /*!< Inverts the RX pin level.                              */
+    bool tx;                                    /*!< Keeps the transmitter enabled for the blocking writes. */
+};
+
+///
+/// \brief Starts the USART reception into the circular DMA buffer.
+///
+/// The peripheral clocks and the interrupts are enabled by the bootloader, this function configures
+/// the RX pin, the USART and the DMA stream.
+///
+/// \param[in] inst The USART DMA instance.
+/// \param[in] conf The pointer to the configuration.
+/// \param[in] cb   The reception callback.
+/// \param[in] arg  The callback argument.
+///
+/// \return ll_usart_dma_res_t   The USART DMA result.
+/// \retval LL_USART_DMA_RES_OK  On success.
+/// \retval LL_USART_DMA_RES_ERR Otherwise.
+///
+ll_usart_dma_res_t ll_usart_dma_rx_init(const ll_usart_dma_inst_t inst, const struct ll_usart_dma_conf *const conf,
+                                        const ll_usart_dma_rx_cb_t cb, void *const arg);
+
+///
+/// \brief Stops the USART reception.
+///
+/// \param[in] inst The USART DMA instance.
+///
+void ll_usart_dma_rx_deinit(const ll_usart_dma_inst_t inst);
+
+///
+/// \brief Starts the USART transmission from the ring drained by DMA.
+///
+/// The USART and its TX pin are expected to be configured with the transmitter enabled, this
+/// function only enables its DMA requests. Only USART3 transmits.
+///
+/// \param[in] inst The USART DMA instance.
+///
+/// \return ll_usart_dma_res_t   The USART DMA result.
+/// \retval LL_USART_DMA_RES_OK  On success.
+/// \retval LL_USART_DMA_RES_ERR Otherwise.
+///
+ll_usart_dma_res_t ll_usart_dma_tx_init(const ll_usart_dma_inst_t inst);
+
+///
+/// \brief Queues the bytes for the transmission, never blocks.
+///
+/// The bytes which do not fit the ring are dropped and counted. The ring has a single producer, so
+/// the writes to one instance are made from one context only, never from the interrupts.
+///
+/// \param[in] inst The USART DMA instance.
+/// \param[in] data The bytes.
+/// \param[in] len  The number of bytes.
+///
+/// \return uint32_t The number of queued bytes.
+///
+uint32_t ll_usart_dma_tx_write(const ll_usart_dma_inst_t inst, const uint8_t *const data, const uint32_t len);
+
+///
+/// \brief Gets the number of the bytes which still fit the ring.
+///
+/// \param[in] inst The USART DMA instance.
+///
+/// \return uint32_t The number of free bytes.
+///
+uint32_t ll_usart_dma_tx_space(const ll_usart_dma_inst_t inst);
+
+///
+/// \brief Gets the free bytes back to back in the ring, for the serializer which writes the bytes
+///        in place and queues them with ll_usart_dma_tx_commit.
+///
+/// \param[in]  inst The USART DMA instance.
+/// \param[out] data The address of the first free byte.
+///
+/// \return uint32_t The number of the free bytes up to the end of the ring storage.
+///
+uint32_t ll_usart_dma_tx_reserve(const ll_usart_dma_inst_t inst, uint8_t **const data);
+
+///
+/// \brief Queues the bytes written in place, never blocks.
+///
+/// \param[in] inst The USART DMA instance.
+/// \param[in] len  The number of bytes, up to the reserved ones.
+///
+void ll_usart_dma_tx_commit(const ll_usart_dma_inst_t inst, const uint32_t len);
+
+///
+/// \brief Starts the DMA on the queued bytes unless it is running already, the rest follow on its
+///        transfer complete interrupt.
+///
+/// \param[in] inst The USART DMA instance.
+///
+void ll_usart_dma_tx_kick(const ll_usart_dma_inst_t inst);
+
+///
+/// \brief Gets the number of the queued bytes.
+///
+/// \param[in] inst The USART DMA instance.
+///
+/// \return uint32_t The number of bytes not sent yet.
+///
+uint32_t ll_usart_dma_tx_pending(const ll_usart_dma_inst_t inst);
+
+///
+/// \brief Gets the number of the bytes dropped on the full ring since the initialization.
+///
+/// \param[in] inst The USART DMA instance.
+///
+/// \return uint32_t The number of dropped bytes.
+///
+uint32_t ll_usart_dma_tx_dropped(const ll_usart_dma_inst_t inst);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _LL_USART_DMA_H */
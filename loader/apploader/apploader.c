@@ -1,9 +1,65 @@
 #include "apploader.h"
+#include "boot_control.h"
+#include "boot_handoff.h"
+#include "cache.h"
 #include "ghost_feather_common.h"
+#include "image_header.h"
 #include "memory_map.h"
+#include "timing.h"
+#include "libopencm3/stm32/crc.h"
+#include "libopencm3/stm32/dma.h"
 #include "libopencm3/stm32/rcc.h"
 #include "libopencm3/stm32/gpio.h"
 
+#include <stdbool.h>
+#include <stddef.h>
+
+///
+/// \brief The result of the app image check in the shared SRAM.
+///
+#define APPLOADER_CHECK         ((volatile apploader_check_t *)&__boot_shared__)
+
+///
+/// \brief The number of the boot-control record slots.
+///
+#define APPLOADER_BOOT_CTRL_RECORDS ((uint32_t)&__boot_ctrl_size__ / sizeof(boot_control_record_t))
+
+///
+/// \brief Gets the AXIM address of the flash memory the image is linked to through the ITCM, the DMA
+///        reaches the flash memory through the AXIM only.
+///
+#define APPLOADER_ITCM_TO_AXIM(address) ((uint32_t)(address) - 0x00200000u + 0x08000000u)
+
+///
+/// \brief The DMA feeding the CRC unit, DMA2 is the only one moving memory to memory.
+///
+#define APPLOADER_DMA           DMA2
+#define APPLOADER_DMA_STREAM    DMA_STREAM0
+
+///*************************************************************************************************
+/// Private objects - declaration.
+///*************************************************************************************************
+///
+/// \brief The app slot type.
+///
+typedef struct
+{
+    uint32_t *start;
+    uint32_t *size;                         /*!< The linker symbol whose address is the slot size.     */
+} apploader_slot_t;
+
+///*************************************************************************************************
+/// Private objects - definition.
+///*************************************************************************************************
+///
+/// \brief The app slots, each image is linked to one of them.
+///
+static const apploader_slot_t apploader_slots[BOOT_CONTROL_SLOTS] =
+{
+    { .start = &__app_start__,   .size = &__app_size__   },
+    { .start = &__app_b_start__, .size = &__app_b_size__ },
+};
+
 ///*************************************************************************************************
 /// Private functions - declaration.
 ///*************************************************************************************************
@@ -19,6 +75,39 @@
 ///
 static void jump(uint32_t pc, uint32_t sp);
 
+///
+/// \brief Feeds the words to the CRC unit by a memory to memory DMA transfer and waits for it.
+///
+/// \param[in] source The AXIM address of the words.
+/// \param[in] words  The number of the words, 65535 at most.
+///
+/// \return bool True if the transfer completed, false on a transfer error.
+///
+static bool crc32_dma(const uint32_t source, const uint32_t words);
+
+///
+/// \brief Calculates the CRC-32 of the image by the CRC unit.
+///
+/// The words before and after the CRC-32 field of the header are fed by the DMA, the CPU takes over
+/// on a transfer error. The CRC unit is reset and its clock disabled afterwards, the started image
+/// finds it as after the power on. The DMA stream is left disabled with its flags cleared, DMA2
+/// stays clocked for the rest of the boot chain.
+///
+/// \param[in] image The start of the image, its header checked already.
+///
+/// \return uint32_t The CRC-32 to compare with the header one.
+///
+static uint32_t crc32_calculate(const uint32_t *const image);
+
+///
+/// \brief Checks the header and the CRC-32 of the app image in the slot.
+///
+/// \param[in] slot The app slot.
+///
+/// \return image_header_res_t The image header result.
+///
+static image_header_res_t check_app(const apploader_slot_t *const slot);
+
 ///
 /// \brief Turns the LED on.
 ///
@@ -44,6 +133,84 @@ static void jump(uint32_t pc, uint32_t sp)
     ");
 }
 
+static bool crc32_dma(const uint32_t source, const uint32_t words)
+{
+    bool error;
+
+    if (words == 0)
+    {
+        return true;
+    }
+
+    dma_stream_reset(APPLOADER_DMA, APPLOADER_DMA_STREAM);
+
+    /* Memory to memory, the peripheral port reads the image and the memory port writes CRC_DR. */
+    dma_set_transfer_mode(APPLOADER_DMA, APPLOADER_DMA_STREAM, DMA_SxCR_DIR_MEM_TO_MEM);
+    dma_set_priority(APPLOADER_DMA, APPLOADER_DMA_STREAM, DMA_SxCR_PL_HIGH);
+    dma_set_peripheral_size(APPLOADER_DMA, APPLOADER_DMA_STREAM, DMA_SxCR_PSIZE_32BIT);
+    dma_set_memory_size(APPLOADER_DMA, APPLOADER_DMA_STREAM, DMA_SxCR_MSIZE_32BIT);
+    dma_enable_peripheral_increment_mode(APPLOADER_DMA, APPLOADER_DMA_STREAM);
+    dma_enable_fifo_mode(APPLOADER_DMA, APPLOADER_DMA_STREAM);
+    dma_set_fifo_threshold(APPLOADER_DMA, APPLOADER_DMA_STREAM, DMA_SxFCR_FTH_4_4_FULL);
+    dma_set_peripheral_address(APPLOADER_DMA, APPLOADER_DMA_STREAM, source);
+    dma_set_memory_address(APPLOADER_DMA, APPLOADER_DMA_STREAM, (uint32_t)&CRC_DR);
+    dma_set_number_of_data(APPLOADER_DMA, APPLOADER_DMA_STREAM, (uint16_t)words);
+    dma_enable_stream(APPLOADER_DMA, APPLOADER_DMA_STREAM);
+
+    while (!dma_get_interrupt_flag(APPLOADER_DMA, APPLOADER_DMA_STREAM, DMA_TCIF | DMA_TEIF));
+
+    error = dma_get_interrupt_flag(APPLOADER_DMA, APPLOADER_DMA_STREAM, DMA_TEIF);
+
+    dma_disable_stream(APPLOADER_DMA, APPLOADER_DMA_STREAM);
+    dma_clear_interrupt_flags(APPLOADER_DMA, APPLOADER_DMA_STREAM, DMA_ISR_FLAGS);
+
+    return !error;
+}
+
+static uint32_t crc32_calculate(const uint32_t *const image)
+{
+    const image_header_t *header = image_header_get(image);
+    uint32_t source = APPLOADER_ITCM_TO_AXIM(image);
+    uint32_t after  = IMAGE_HEADER_CRC32_OFFSET + sizeof(uint32_t);
+    uint32_t crc32;
+
+    /* DMA2 is clocked by the bootloader for the whole boot chain, the stream is left disabled. */
+    rcc_periph_clock_enable(RCC_CRC);
+
+    /* The CRC-32 of zlib, the words are bit reversed in as the bytes are little endian. */
+    CRC_INIT = 0xffffffff;
+    CRC_POL  = 0x04c11db7;
+    CRC_CR   = (CRC_CR_REV_IN_WORD << CRC_CR_REV_IN_SHIFT) | CRC_CR_REV_OUT | CRC_CR_RESET;
+
+    if (crc32_dma(source, IMAGE_HEADER_CRC32_OFFSET / sizeof(uint32_t)) &&
+        crc32_dma(source + after, (header->length - after) / sizeof(uint32_t)))
+    {
+        crc32 = ~CRC_DR;
+    }
+    else
+    {
+        crc32 = image_header_crc32(image);
+    }
+
+    rcc_periph_reset_pulse(RST_CRC);
+    rcc_periph_clock_disable(RCC_CRC);
+
+    return crc32;
+}
+
+static image_header_res_t check_app(const apploader_slot_t *const slot)
+{
+    const image_header_t *header = image_header_get(slot->start);
+    image_header_res_t res = image_header_check(header, (uint32_t)slot->size);
+
+    if (res != IMAGE_HEADER_RES_OK)
+    {
+        return res;
+    }
+
+    return (crc32_calculate(slot->start) == header->crc32) ? IMAGE_HEADER_RES_OK : IMAGE_HEADER_RES_ERR_CRC;
+}
+
 static void led_on(void)
 {
     gpio_set(GPIOA, GPIO2);
@@ -61,15 +228,71 @@ void apploader_start(void)
 {
     //led_on();
 
+    volatile apploader_check_t *check = APPLOADER_CHECK;
+    uint32_t *img = (uint32_t*)&__updater_start__;
+
+    timing_boot_stamp(TIMING_BOOT_STAGE_APPLOADER);
+
+    check->slot    = BOOT_CONTROL_SLOTS;
+    check->version = 0;
+
 #if (defined(GHOST_FEATHER_COMMON_START_APP) && (GHOST_FEATHER_COMMON_START_APP == 1))
-    uint32_t *img = (uint32_t*)&__app_start__;
+    /* The cycle counter was started by the bootloader. */
+    uint32_t start = timing_cnt_get();
+
+    /* The updater requested before the reset is started once, the slots are not checked. */
+    if (boot_handoff_take_request(BOOT_HANDOFF) == BOOT_HANDOFF_STAGE_UPDATER)
+    {
+        BOOT_HANDOFF->reason = BOOT_HANDOFF_REASON_REQUESTED;
+        check->result = IMAGE_HEADER_RES_OK;
+    }
+    else
+    {
+        const boot_control_record_t *record = boot_control_find((const boot_control_record_t *)&__boot_ctrl_start__,
+                                                                APPLOADER_BOOT_CTRL_RECORDS, NULL);
+        uint32_t preferred = boot_control_preferred(record);
+
+        /* The other slot is started when the one the record names is erased, torn or corrupted, the
+         * updater when both are. */
+        for (uint32_t i = 0; i < BOOT_CONTROL_SLOTS; i++)
+        {
+            const apploader_slot_t *slot = &apploader_slots[(preferred + i) % BOOT_CONTROL_SLOTS];
+            image_header_res_t res = check_app(slot);
+
+            if (i == 0)
+            {
+                check->result = res;
+            }
+
+            if (res == IMAGE_HEADER_RES_OK)
+            {
+                img            = slot->start;
+                check->slot    = (preferred + i) % BOOT_CONTROL_SLOTS;
+                check->version = image_header_get(slot->start)->version;
+                break;
+            }
+        }
+
+        if (check->slot == BOOT_CONTROL_SLOTS)
+        {
+            BOOT_HANDOFF->reason = BOOT_HANDOFF_REASON_NO_IMAGE;
+        }
+    }
+
+    check->cycles = timing_cnt_get() - start;
 #else
-    uint32_t *img = (uint32_t*)&__updater_start__;
+    check->result = IMAGE_HEADER_RES_OK;
+    check->cycles = 0;
 #endif  /* GHOST_FEATHER_COMMON_START_APP */
 
+    check->start = (uint32_t)img;
+
     uint32_t img_sp = img[0];
     uint32_t img_pc = img[1];
 
+    timing_boot_stamp(TIMING_BOOT_STAGE_IMAGE_CHECKED);
+
+    cache_handoff();
     jump(img_pc, img_sp);
 
     /* Never return */
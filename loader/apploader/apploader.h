@@ -3,6 +3,23 @@
 
 #include <stdint.h>
 
+///
+/// \brief The result of the app image check, left in the shared SRAM for the started image.
+///
+typedef struct
+{
+    uint32_t result;                        /*!< The image_header_res_t of the slot tried first.       */
+    uint32_t cycles;                        /*!< The DWT cycles the check took.                        */
+    uint32_t version;                       /*!< The version of the app started, 0 for the updater.    */
+    uint32_t start;                         /*!< The start address of the image started.               */
+    uint32_t slot;                          /*!< The slot started, BOOT_CONTROL_SLOTS for the updater. */
+} apploader_check_t;
+
+///
+/// \brief The check result the linker script places in the shared SRAM.
+///
+extern apploader_check_t __boot_shared__;
+
 ///
 /// \brief Starts the apploader.
 ///
@@ -1,4 +1,6 @@
 #include "bootloader.h"
+#include "boot_handoff.h"
+#include "cache.h"
 #include "memory_map.h"
 #include "timing.h"
 #include "libopencm3/cm3/nvic.h"
@@ -6,6 +8,11 @@
 #include "libopencm3/stm32/gpio.h"
 #include "libopencm3/stm32/rcc.h"
 
+///
+/// \brief The reset flags of RCC_CSR, LPWRRSTF down to BORRSTF.
+///
+#define BOOTLOADER_RESET_FLAGS  (0xfe000000u)
+
 ///*************************************************************************************************
 /// Private functions - declaration.
 ///*************************************************************************************************
@@ -55,6 +62,14 @@ static void gpio_setup(void);
 ///
 static void systick_setup(void);
 
+///
+/// \brief Opens the hand-off block.
+///
+/// The block of the previous boot is kept over a warm reset, with the calibration and the stage
+/// requested, it is created again after the power-on or if it does not validate.
+///
+static void handoff_setup(void);
+
 ///
 /// \brief Turns the LED on.
 ///
@@ -104,12 +119,29 @@ static void rcc_setup(void)
 
     /* Enable clock for TIM12. */
     rcc_periph_clock_enable(RCC_TIM12);
+
+    /* Enable clock for USART3. */
+    rcc_periph_clock_enable(RCC_USART3);
+
+    /* Enable clock for USART6. */
+    rcc_periph_clock_enable(RCC_USART6);
+
+    /* Enable clock for DMA1. */
+    rcc_periph_clock_enable(RCC_DMA1);
+
+    /* Enable clock for DMA2. */
+    rcc_periph_clock_enable(RCC_DMA2);
 }
 
 static void nvic_setup()
 {
     nvic_enable_irq(NVIC_TIM8_BRK_TIM12_IRQ);
     nvic_enable_irq(NVIC_TIM8_CC_IRQ);
+    nvic_enable_irq(NVIC_USART3_IRQ);
+    nvic_enable_irq(NVIC_USART6_IRQ);
+    nvic_enable_irq(NVIC_DMA1_STREAM1_IRQ);
+    nvic_enable_irq(NVIC_DMA1_STREAM3_IRQ);
+    nvic_enable_irq(NVIC_DMA2_STREAM1_IRQ);
 }
 
 static void gpio_setup(void)
@@ -136,6 +168,11 @@ static void gpio_setup(void)
     /* Set TIM12 gpios alternate function. */
     gpio_mode_setup(GPIOB, GPIO_MODE_AF, GPIO_PUPD_NONE, (GPIO14 | GPIO15));
     gpio_set_af(GPIOB, GPIO_AF9, (GPIO14 | GPIO15));
+
+    /* Set USART3 (DFU) gpios alternate function, the RX line is pulled to its idle level. */
+    gpio_mode_setup(GPIOC, GPIO_MODE_AF, GPIO_PUPD_NONE, GPIO10);
+    gpio_mode_setup(GPIOC, GPIO_MODE_AF, GPIO_PUPD_PULLUP, GPIO11);
+    gpio_set_af(GPIOC, GPIO_AF7, (GPIO10 | GPIO11));
 }
 
 static void systick_setup(void)
@@ -147,13 +184,32 @@ static void systick_setup(void)
 
 static void timing_setup(void)
 {
-    timing_init();
-    timing_start();
     timing_sysclk_freq = rcc_ahb_frequency;
     timing_apb1_freq = rcc_apb1_frequency;
     timing_apb2_freq = rcc_apb2_frequency;
 }
 
+static void handoff_setup(void)
+{
+    volatile boot_handoff_t *handoff = BOOT_HANDOFF;
+    uint32_t reset_cause = RCC_CSR & BOOTLOADER_RESET_FLAGS;
+
+    /* The SRAM content is random after the power-on and the brown-out resets. */
+    if (((reset_cause & (RCC_CSR_PORRSTF | RCC_CSR_BORRSTF)) != 0) || !boot_handoff_is_valid(handoff))
+    {
+        boot_handoff_create(handoff);
+    }
+    else
+    {
+        handoff->reason = BOOT_HANDOFF_REASON_WARM;
+    }
+
+    handoff->reset_cause = reset_cause;
+    RCC_CSR |= RCC_CSR_RMVF;
+
+    boot_handoff_seal(handoff);
+}
+
 static void led_on(void)
 {
     gpio_set(GPIOA, GPIO2);
@@ -169,7 +225,20 @@ static void led_off(void)
 ///*************************************************************************************************
 void bootloader_start(void)
 {
+    /* The clock bring-up is counted in HSI cycles. */
+    timing_init();
+    timing_start();
+
+    handoff_setup();
+
     rcc_setup();
+
+    /* The counter ran on HSI during the clock bring-up, it restarts on the system clock. */
+    timing_boot_start();
+
+    /* The flash wait states are set by now, enable the caches once for the whole boot chain. */
+    cache_init();
+
     nvic_setup();
     gpio_setup();
     systick_setup();
@@ -179,8 +248,11 @@ void bootloader_start(void)
     uint32_t img_sp = img[0];
     uint32_t img_pc = img[1];
 
+    timing_boot_stamp(TIMING_BOOT_STAGE_BOOTLOADER);
+
+    cache_handoff();
     jump(img_pc, img_sp);
-    
+
     /* Never return */
     while (1);
 }
@@ -11,5 +11,15 @@ extern uint32_t __updater_start__;
 extern uint32_t __updater_size__;
 extern uint32_t __app_start__;
 extern uint32_t __app_size__;
+extern uint32_t __app_b_start__;
+extern uint32_t __app_b_size__;
+extern uint32_t __boot_ctrl_start__;
+extern uint32_t __boot_ctrl_size__;
+extern uint32_t __journal_start__;
+extern uint32_t __journal_size__;
+extern uint32_t __shared_start__;
+extern uint32_t __shared_size__;
+extern uint32_t __stage_start__;
+extern uint32_t __stage_size__;
 
 #endif /* _MEMORY_MAP_H */
@@ -0,0 +1,249 @@
+#include "ahrs.h"
+#include "blackbox.h"
+#include "ghf.h"
+#include "pid.h"
+#include "data_structure/ring_buffer.h"
+#include <stddef.h>
+#include <string.h>
+
+///***********************************************************************************************************
+/// Private objects - declaration.
+///***********************************************************************************************************
+///
+/// \brief The recorder structure.
+///
+struct blackbox
+{
+    blackbox_encoder_t encoder;
+    blackbox_stats_t   stats;
+    uint32_t           divider;
+    uint32_t           cycle;
+};
+
+///***********************************************************************************************************
+/// Private objects - definition.
+///***********************************************************************************************************
+///
+/// \brief The recorder object.
+///
+static struct blackbox blackbox;
+
+///
+/// \brief The encoded bytes, pushed by the control loop and popped by the consumer.
+///
+RING_BUFFER_DEFINE(blackbox_ring, 1, BLACKBOX_RING_SIZE);
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief Writes the zig-zag varint of the change, 7 bits per byte, the least significant first.
+///
+/// \param[out] buffer The buffer of 5 bytes at least.
+/// \param[in]  delta  The change, wrapped to 32 bits.
+///
+/// \return uint32_t The count of the written bytes.
+///
+static uint32_t varint_put(uint8_t *const buffer, const uint32_t delta);
+
+///
+/// \brief Scales the float into the logged integer.
+///
+/// \param[in] value The float.
+///
+/// \return int32_t The scaled value.
+///
+static int32_t scale(const float32_t value);
+
+///
+/// \brief Takes the frame from the ghf data and the PID terms.
+///
+/// \param[in]  handle The pointer to ghf.
+/// \param[out] frame  The frame.
+///
+static void snapshot(const struct ghf *const handle, blackbox_frame_t *const frame);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static uint32_t varint_put(uint8_t *const buffer, const uint32_t delta)
+{
+    /* The small changes of either sign are the short ones. */
+    uint32_t value = (delta << 1) ^ (uint32_t)((int32_t)delta >> 31);
+    uint32_t size  = 0;
+
+    while (value >= 0x80u)
+    {
+        buffer[size++] = (uint8_t)(value | 0x80u);
+        value >>= 7;
+    }
+
+    buffer[size++] = (uint8_t)value;
+
+    return size;
+}
+
+static int32_t scale(const float32_t value)
+{
+    return (int32_t)(value * BLACKBOX_FLOAT_SCALE);
+}
+
+static void snapshot(const struct ghf *const handle, blackbox_frame_t *const frame)
+{
+    struct pid_terms roll;
+    struct pid_terms pitch;
+    struct pid_terms yaw;
+
+    pid_terms_get(handle->module.pid_roll,  &roll);
+    pid_terms_get(handle->module.pid_pitch, &pitch);
+    pid_terms_get(handle->module.pid_yaw,   &yaw);
+
+    frame->field[BLACKBOX_FIELD_TIME_START] = (int32_t)handle->data.time.start;
+    frame->field[BLACKBOX_FIELD_TIME_TOTAL] = (int32_t)handle->data.time.total;
+    frame->field[BLACKBOX_FIELD_ROLL]       = scale(handle->data.roll);
+    frame->field[BLACKBOX_FIELD_PITCH]      = scale(handle->data.pitch);
+    frame->field[BLACKBOX_FIELD_THROTTLE]   = scale(handle->data.throttle);
+    frame->field[BLACKBOX_FIELD_YAW]        = scale(handle->data.yaw);
+    frame->field[BLACKBOX_FIELD_PWM1]       = (int32_t)handle->data.pwm1;
+    frame->field[BLACKBOX_FIELD_PWM2]       = (int32_t)handle->data.pwm2;
+    frame->field[BLACKBOX_FIELD_PWM3]       = (int32_t)handle->data.pwm3;
+    frame->field[BLACKBOX_FIELD_PWM4]       = (int32_t)handle->data.pwm4;
+    frame->field[BLACKBOX_FIELD_AX]         = handle->data.raw_data.ax;
+    frame->field[BLACKBOX_FIELD_AY]         = handle->data.raw_data.ay;
+    frame->field[BLACKBOX_FIELD_AZ]         = handle->data.raw_data.az;
+    frame->field[BLACKBOX_FIELD_GX]         = handle->data.raw_data.gx;
+    frame->field[BLACKBOX_FIELD_GY]         = handle->data.raw_data.gy;
+    frame->field[BLACKBOX_FIELD_GZ]         = handle->data.raw_data.gz;
+    frame->field[BLACKBOX_FIELD_CALIB_GX]   = handle->data.calib.gx;
+    frame->field[BLACKBOX_FIELD_CALIB_GY]   = handle->data.calib.gy;
+    frame->field[BLACKBOX_FIELD_CALIB_GZ]   = handle->data.calib.gz;
+    frame->field[BLACKBOX_FIELD_ROLL_P]     = scale(roll.p);
+    frame->field[BLACKBOX_FIELD_ROLL_I]     = scale(roll.i);
+    frame->field[BLACKBOX_FIELD_ROLL_D]     = scale(roll.d);
+    frame->field[BLACKBOX_FIELD_PITCH_P]    = scale(pitch.p);
+    frame->field[BLACKBOX_FIELD_PITCH_I]    = scale(pitch.i);
+    frame->field[BLACKBOX_FIELD_PITCH_D]    = scale(pitch.d);
+    frame->field[BLACKBOX_FIELD_YAW_P]      = scale(yaw.p);
+    frame->field[BLACKBOX_FIELD_YAW_I]      = scale(yaw.i);
+    frame->field[BLACKBOX_FIELD_YAW_D]      = scale(yaw.d);
+}
+
+///***********************************************************************************************************
+/// Global functions - definition.
+///***********************************************************************************************************
+void blackbox_encoder_reset(blackbox_encoder_t *const encoder)
+{
+    if (encoder == NULL)
+    {
+        return;
+    }
+
+    memset(&encoder->prev, 0, sizeof(encoder->prev));
+    encoder->count  = 0;
+    encoder->resync = 1;
+}
+
+uint32_t blackbox_encode(blackbox_encoder_t *const encoder, const blackbox_frame_t *const frame,
+                         uint8_t *const buffer)
+{
+    uint32_t size = 1;
+
+    if ((encoder == NULL) || (frame == NULL) || (buffer == NULL))
+    {
+        return 0;
+    }
+
+    if ((encoder->resync == 1) || (encoder->count >= BLACKBOX_KEY_INTERVAL))
+    {
+        memset(&encoder->prev, 0, sizeof(encoder->prev));
+        encoder->count  = 0;
+        encoder->resync = 0;
+        buffer[0]       = BLACKBOX_FRAME_KEY;
+    }
+    else
+    {
+        buffer[0] = BLACKBOX_FRAME_DELTA;
+    }
+
+    for (uint32_t i = 0; i < BLACKBOX_FIELD_TOTAL; i++)
+    {
+        size += varint_put(&buffer[size], (uint32_t)frame->field[i] - (uint32_t)encoder->prev.field[i]);
+    }
+
+    encoder->prev = *frame;
+    encoder->count++;
+
+    return size;
+}
+
+void blackbox_init(const uint32_t divider)
+{
+    uint8_t header[8];
+
+    blackbox_encoder_reset(&blackbox.encoder);
+    memset(&blackbox.stats, 0, sizeof(blackbox.stats));
+    blackbox.divider = divider;
+    blackbox.cycle   = 0;
+
+    if (divider == 0)
+    {
+        return;
+    }
+
+    /* The decoder learns the layout and the rate from the header. */
+    header[0] = (uint8_t)(BLACKBOX_MAGIC >>  0);
+    header[1] = (uint8_t)(BLACKBOX_MAGIC >>  8);
+    header[2] = (uint8_t)(BLACKBOX_MAGIC >> 16);
+    header[3] = (uint8_t)(BLACKBOX_MAGIC >> 24);
+    header[4] = (uint8_t)BLACKBOX_VERSION;
+    header[5] = (uint8_t)BLACKBOX_FIELD_TOTAL;
+    header[6] = (uint8_t)(divider >> 0);
+    header[7] = (uint8_t)(divider >> 8);
+
+    ring_buffer_clear(&blackbox_ring);
+    blackbox.stats.bytes = ring_buffer_push_n(&blackbox_ring, &header[0], sizeof(header));
+}
+
+void blackbox_update(const struct ghf *const handle)
+{
+    blackbox_frame_t frame;
+    uint8_t buffer[BLACKBOX_FRAME_SIZE_MAX];
+    uint32_t size;
+
+    if ((handle == NULL) || (blackbox.divider == 0))
+    {
+        return;
+    }
+
+    if (++blackbox.cycle < blackbox.divider)
+    {
+        return;
+    }
+
+    blackbox.cycle = 0;
+
+    /* The frames go whole or not at all, the consumer only frees the space meanwhile. */
+    if (ring_buffer_space(&blackbox_ring) < BLACKBOX_FRAME_SIZE_MAX)
+    {
+        blackbox.encoder.resync = 1;
+        blackbox.stats.dropped++;
+        return;
+    }
+
+    snapshot(handle, &frame);
+    size = blackbox_encode(&blackbox.encoder, &frame, &buffer[0]);
+
+    (void)ring_buffer_push_n(&blackbox_ring, &buffer[0], size);
+    blackbox.stats.frames++;
+    blackbox.stats.bytes += size;
+}
+
+uint32_t blackbox_read(uint8_t *const buffer, const uint32_t size)
+{
+    return ring_buffer_pop_n(&blackbox_ring, buffer, size);
+}
+
+const blackbox_stats_t* blackbox_stats_get(void)
+{
+    return &blackbox.stats;
+}
@@ -0,0 +1,149 @@
+#ifndef _BLACKBOX_H
+#define _BLACKBOX_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+#define BLACKBOX_MAGIC          (0x42424647u)   /*!< "GFBB", the log header.                           */
+#define BLACKBOX_VERSION        (1u)            /*!< Increased with every change of the fields.        */
+#define BLACKBOX_FLOAT_SCALE    (10000.0f)      /*!< The floats are logged in 1/10000.                 */
+#define BLACKBOX_KEY_INTERVAL   (32u)           /*!< Every n-th frame is logged against zero.          */
+#define BLACKBOX_RING_SIZE      (0x1000u)       /*!< The encoded bytes waiting for the consumer.       */
+
+#define BLACKBOX_FRAME_KEY      (0x49u)         /*!< 'I', the values against zero.                     */
+#define BLACKBOX_FRAME_DELTA    (0x50u)         /*!< 'P', the values against the previous frame.       */
+
+///
+/// \brief The frame field type, in the logged order.
+///
+/// \note scripts/blackbox_decode.py keeps the same order.
+///
+typedef enum
+{
+    BLACKBOX_FIELD_TIME_START = 0,          /*!< The loop start, in timing ticks.                      */
+    BLACKBOX_FIELD_TIME_TOTAL,              /*!< The loop duration of the previous cycle, in us.       */
+    BLACKBOX_FIELD_ROLL,                    /*!< The mixer inputs, scaled floats.                      */
+    BLACKBOX_FIELD_PITCH,
+    BLACKBOX_FIELD_THROTTLE,
+    BLACKBOX_FIELD_YAW,
+    BLACKBOX_FIELD_PWM1,                    /*!< The motor outputs, in us.                             */
+    BLACKBOX_FIELD_PWM2,
+    BLACKBOX_FIELD_PWM3,
+    BLACKBOX_FIELD_PWM4,
+    BLACKBOX_FIELD_AX,                      /*!< The raw IMU samples, the gyroscope calibrated.        */
+    BLACKBOX_FIELD_AY,
+    BLACKBOX_FIELD_AZ,
+    BLACKBOX_FIELD_GX,
+    BLACKBOX_FIELD_GY,
+    BLACKBOX_FIELD_GZ,
+    BLACKBOX_FIELD_CALIB_GX,                /*!< The gyroscope calibration.                            */
+    BLACKBOX_FIELD_CALIB_GY,
+    BLACKBOX_FIELD_CALIB_GZ,
+    BLACKBOX_FIELD_ROLL_P,                  /*!< The PID terms, scaled floats.                         */
+    BLACKBOX_FIELD_ROLL_I,
+    BLACKBOX_FIELD_ROLL_D,
+    BLACKBOX_FIELD_PITCH_P,
+    BLACKBOX_FIELD_PITCH_I,
+    BLACKBOX_FIELD_PITCH_D,
+    BLACKBOX_FIELD_YAW_P,
+    BLACKBOX_FIELD_YAW_I,
+    BLACKBOX_FIELD_YAW_D,
+    BLACKBOX_FIELD_TOTAL,
+} blackbox_field_t;
+
+///
+/// \brief The longest encoded frame, the type and a 5 byte varint per field.
+///
+#define BLACKBOX_FRAME_SIZE_MAX (1u + (5u * BLACKBOX_FIELD_TOTAL))
+
+///
+/// \brief The frame type.
+///
+typedef struct
+{
+    int32_t field[BLACKBOX_FIELD_TOTAL];
+} blackbox_frame_t;
+
+///
+/// \brief The encoder state type, the frame the next delta is taken against.
+///
+typedef struct
+{
+    blackbox_frame_t prev;
+    uint32_t         count;                 /*!< The frames since the last key frame.                  */
+    uint32_t         resync;                /*!< 1 if the next frame has to be a key frame.            */
+} blackbox_encoder_t;
+
+///
+/// \brief The recorder statistics type.
+///
+typedef struct
+{
+    uint32_t frames;                        /*!< The logged frames.                                    */
+    uint32_t dropped;                       /*!< The frames which did not fit the ring buffer.         */
+    uint32_t bytes;                         /*!< The logged bytes, the header included.                */
+} blackbox_stats_t;
+
+struct ghf;
+
+///
+/// \brief Resets the encoder, the next frame is a key frame.
+///
+/// \param[out] encoder The encoder.
+///
+void blackbox_encoder_reset(blackbox_encoder_t *const encoder);
+
+///
+/// \brief Encodes the frame against the previous one, the zig-zag varint of every field change.
+///
+/// \param[in,out] encoder The encoder.
+/// \param[in]     frame   The frame.
+/// \param[out]    buffer  The buffer of BLACKBOX_FRAME_SIZE_MAX bytes.
+///
+/// \return uint32_t The encoded size.
+///
+uint32_t blackbox_encode(blackbox_encoder_t *const encoder, const blackbox_frame_t *const frame,
+                         uint8_t *const buffer);
+
+///
+/// \brief Starts the recorder, the log header goes first.
+///
+/// \param[in] divider The control cycles per frame, 0 stops the recorder.
+///
+void blackbox_init(const uint32_t divider);
+
+///
+/// \brief Snapshots the ghf data and the PID terms every divider-th call, never blocks.
+///
+/// A frame which does not fit the ring buffer is dropped whole and the next one is a key frame, so
+/// the log stays decodable.
+///
+/// \param[in] handle The pointer to ghf.
+///
+void blackbox_update(const struct ghf *const handle);
+
+///
+/// \brief Takes the encoded bytes out of the ring buffer, called by the consumer only.
+///
+/// \param[out] buffer The buffer.
+/// \param[in]  size   The buffer size.
+///
+/// \return uint32_t The count of the bytes taken.
+///
+uint32_t blackbox_read(uint8_t *const buffer, const uint32_t size);
+
+///
+/// \brief Gets the recorder statistics.
+///
+/// \return const blackbox_stats_t* The statistics.
+///
+const blackbox_stats_t* blackbox_stats_get(void);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _BLACKBOX_H */
@@ -0,0 +1,270 @@
+#include "crsf.h"
+#include <stddef.h>
+#include <string.h>
+
+#define CRSF_US_MID                 (1500)      /*!< The pulse width of the middle channel value.           */
+#define CRSF_US_SCALE_NUM           (5)         /*!< The channel value to microseconds scale numerator.     */
+#define CRSF_US_SCALE_DEN           (8)         /*!< The channel value to microseconds scale denominator.   */
+
+#define CRSF_POS_ADDR               (0u)        /*!< The address byte position.                             */
+#define CRSF_POS_LEN                (1u)        /*!< The length byte position.                              */
+#define CRSF_POS_TYPE               (2u)        /*!< The type byte position.                                */
+#define CRSF_POS_PAYLOAD            (3u)        /*!< The first payload byte position.                       */
+
+///***********************************************************************************************************
+/// Private objects - definition.
+///***********************************************************************************************************
+///
+/// \brief The CRC8 lookup table for the 0xd5 polynomial.
+///
+static const uint8_t crc8_lut[256] =
+{
+    0x00, 0xd5, 0x7f, 0xaa, 0xfe, 0x2b, 0x81, 0x54, 0x29, 0xfc, 0x56, 0x83, 0xd7, 0x02, 0xa8, 0x7d,
+    0x52, 0x87, 0x2d, 0xf8, 0xac, 0x79, 0xd3, 0x06, 0x7b, 0xae, 0x04, 0xd1, 0x85, 0x50, 0xfa, 0x2f,
+    0xa4, 0x71, 0xdb, 0x0e, 0x5a, 0x8f, 0x25, 0xf0, 0x8d, 0x58, 0xf2, 0x27, 0x73, 0xa6, 0x0c, 0xd9,
+    0xf6, 0x23, 0x89, 0x5c, 0x08, 0xdd, 0x77, 0xa2, 0xdf, 0x0a, 0xa0, 0x75, 0x21, 0xf4, 0x5e, 0x8b,
+    0x9d, 0x48, 0xe2, 0x37, 0x63, 0xb6, 0x1c, 0xc9, 0xb4, 0x61, 0xcb, 0x1e, 0x4a, 0x9f, 0x35, 0xe0,
+    0xcf, 0x1a, 0xb0, 0x65, 0x31, 0xe4, 0x4e, 0x9b, 0xe6, 0x33, 0x99, 0x4c, 0x18, 0xcd, 0x67, 0xb2,
+    0x39, 0xec, 0x46, 0x93, 0xc7, 0x12, 0xb8, 0x6d, 0x10, 0xc5, 0x6f, 0xba, 0xee, 0x3b, 0x91, 0x44,
+    0x6b, 0xbe, 0x14, 0xc1, 0x95, 0x40, 0xea, 0x3f, 0x42, 0x97, 0x3d, 0xe8, 0xbc, 0x69, 0xc3, 0x16,
+    0xef, 0x3a, 0x90, 0x45, 0x11, 0xc4, 0x6e, 0xbb, 0xc6, 0x13, 0xb9, 0x6c, 0x38, 0xed, 0x47, 0x92,
+    0xbd, 0x68, 0xc2, 0x17, 0x43, 0x96, 0x3c, 0xe9, 0x94, 0x41, 0xeb, 0x3e, 0x6a, 0xbf, 0x15, 0xc0,
+    0x4b, 0x9e, 0x34, 0xe1, 0xb5, 0x60, 0xca, 0x1f, 0x62, 0xb7, 0x1d, 0xc8, 0x9c, 0x49, 0xe3, 0x36,
+    0x19, 0xcc, 0x66, 0xb3, 0xe7, 0x32, 0x98, 0x4d, 0x30, 0xe5, 0x4f, 0x9a, 0xce, 0x1b, 0xb1, 0x64,
+    0x72, 0xa7, 0x0d, 0xd8, 0x8c, 0x59, 0xf3, 0x26, 0x5b, 0x8e, 0x24, 0xf1, 0xa5, 0x70, 0xda, 0x0f,
+    0x20, 0xf5, 0x5f, 0x8a, 0xde, 0x0b, 0xa1, 0x74, 0x09, 0xdc, 0x76, 0xa3, 0xf7, 0x22, 0x88, 0x5d,
+    0xd6, 0x03, 0xa9, 0x7c, 0x28, 0xfd, 0x57, 0x82, 0xff, 0x2a, 0x80, 0x55, 0x01, 0xd4, 0x7e, 0xab,
+    0x84, 0x51, 0xfb, 0x2e, 0x7a, 0xaf, 0x05, 0xd0, 0xad, 0x78, 0xd2, 0x07, 0x53, 0x86, 0x2c, 0xf9,
+};
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief Checks whether the byte is an accepted frame address.
+///
+/// \param[in] byte The received byte.
+///
+/// \return uint32_t Non-zero if the byte starts a frame, zero otherwise.
+///
+static uint32_t addr_is_valid(const uint8_t byte);
+
+///
+/// \brief Parses the link statistics payload.
+///
+/// \param[in]  payload The link statistics frame payload.
+/// \param[out] link    The parsed link statistics.
+///
+static void link_parse(const uint8_t *const payload, struct crsf_link *const link);
+
+///
+/// \brief Validates and decodes the complete frame stored in the parser buffer.
+///
+/// \param[in] handle The pointer to the CRSF structure.
+///
+static void frame_handle(struct crsf *const handle);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static uint32_t addr_is_valid(const uint8_t byte)
+{
+    return ((byte == CRSF_ADDR_FC) || (byte == CRSF_ADDR_RADIO_TX) ||
+            (byte == CRSF_ADDR_RX) || (byte == CRSF_ADDR_TX));
+}
+
+static void link_parse(const uint8_t *const payload, struct crsf_link *const link)
+{
+    link->up_rssi_1 = payload[0];
+    link->up_rssi_2 = payload[1];
+    link->up_lq     = payload[2];
+    link->up_snr    = (int8_t)payload[3];
+    link->ant       = payload[4];
+    link->rf_mode   = payload[5];
+    link->up_tx_pwr = payload[6];
+    link->down_rssi = payload[7];
+    link->down_lq   = payload[8];
+    link->down_snr  = (int8_t)payload[9];
+}
+
+static void frame_handle(struct crsf *const handle)
+{
+    uint32_t len  = handle->buf[CRSF_POS_LEN];
+    uint8_t type  = handle->buf[CRSF_POS_TYPE];
+    uint32_t size = len - 2u;
+
+    /* The CRC covers the type and the payload, the length field includes the CRC byte itself. */
+    if (crsf_crc8(&handle->buf[CRSF_POS_TYPE], len - 1u) != handle->buf[CRSF_POS_LEN + len])
+    {
+        handle->cnt.crc_err++;
+        return;
+    }
+
+    switch (type)
+    {
+        case CRSF_TYPE_RC_CH:
+            if (size != CRSF_PAYLOAD_SIZE_RC_CH)
+            {
+                handle->cnt.len_err++;
+                return;
+            }
+
+            crsf_ch_unpack(&handle->buf[CRSF_POS_PAYLOAD], handle->ch);
+            handle->cnt.rc_ch++;
+            break;
+
+        case CRSF_TYPE_LINK_STATS:
+            if (size < CRSF_PAYLOAD_SIZE_LINK_STATS)
+            {
+                handle->cnt.len_err++;
+                return;
+            }
+
+            link_parse(&handle->buf[CRSF_POS_PAYLOAD], &handle->link);
+            handle->cnt.link++;
+            break;
+
+        default:
+            handle->cnt.other++;
+            return;
+    }
+
+    if (handle->cb != NULL)
+    {
+        handle->cb(handle->arg, (crsf_type_t)type);
+    }
+}
+
+///***********************************************************************************************************
+/// Global functions - definition.
+///***********************************************************************************************************
+void crsf_init(struct crsf *const handle, const crsf_cb_t cb, void *const arg)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    memset(handle, 0, sizeof(struct crsf));
+
+    for (uint32_t i = 0; i < CRSF_CH_TOTAL; i++)
+    {
+        handle->ch[i] = CRSF_CH_VAL_MID;
+    }
+
+    handle->cb  = cb;
+    handle->arg = arg;
+}
+
+void crsf_rx(struct crsf *const handle, const uint8_t *const data, const uint32_t len)
+{
+    if ((handle == NULL) || (data == NULL))
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        uint8_t byte = data[i];
+
+        switch (handle->pos)
+        {
+            case CRSF_POS_ADDR:
+                if (addr_is_valid(byte))
+                {
+                    handle->buf[handle->pos++] = byte;
+                }
+                break;
+
+            case CRSF_POS_LEN:
+                if ((byte < CRSF_FRAME_LEN_MIN) || (byte > CRSF_FRAME_LEN_MAX))
+                {
+                    handle->cnt.len_err++;
+                    handle->pos = 0;
+
+                    /* The rejected byte may itself be the start of the next frame. */
+                    if (addr_is_valid(byte))
+                    {
+                        handle->buf[handle->pos++] = byte;
+                    }
+                    break;
+                }
+
+                handle->buf[handle->pos++] = byte;
+                break;
+
+            default:
+                handle->buf[handle->pos++] = byte;
+
+                if (handle->pos == (handle->buf[CRSF_POS_LEN] + 2u))
+                {
+                    frame_handle(handle);
+                    handle->pos = 0;
+                }
+                break;
+        }
+    }
+}
+
+void crsf_rx_idle(struct crsf *const handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    if (handle->pos != 0)
+    {
+        handle->cnt.trunc++;
+        handle->pos = 0;
+    }
+}
+
+uint8_t crsf_crc8(const uint8_t *const data, const uint32_t len)
+{
+    uint8_t crc = 0;
+
+    if (data == NULL)
+    {
+        return crc;
+    }
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        crc = crc8_lut[crc ^ data[i]];
+    }
+
+    return crc;
+}
+
+void crsf_ch_unpack(const uint8_t *const payload, uint16_t *const ch)
+{
+    if ((payload == NULL) || (ch == NULL))
+    {
+        return;
+    }
+
+    uint32_t acc  = 0;
+    uint32_t bits = 0;
+    uint32_t idx  = 0;
+
+    for (uint32_t i = 0; i < CRSF_CH_TOTAL; i++)
+    {
+        while (bits < CRSF_CH_BITS)
+        {
+            acc  |= (uint32_t)payload[idx++] << bits;
+            bits += 8u;
+        }
+
+        ch[i] = (uint16_t)(acc & CRSF_CH_MASK);
+        acc  >>= CRSF_CH_BITS;
+        bits  -= CRSF_CH_BITS;
+    }
+}
+
+uint32_t crsf_ch_to_us(const uint16_t val)
+{
+    int32_t diff = (int32_t)val - (int32_t)CRSF_CH_VAL_MID;
+
+    return (uint32_t)(CRSF_US_MID + ((diff * CRSF_US_SCALE_NUM) / CRSF_US_SCALE_DEN));
+}
@@ -0,0 +1,172 @@
+#ifndef _CRSF_H
+#define _CRSF_H
+
+#include <stdint.h>
+
+#define CRSF_BAUDRATE               (420000u)   /*!< The receiver to flight controller baud rate.           */
+#define CRSF_FRAME_SIZE_MAX         (64u)       /*!< The longest frame, address and length bytes included.  */
+#define CRSF_FRAME_LEN_MIN          (2u)        /*!< The shortest length field (type and crc only).         */
+#define CRSF_FRAME_LEN_MAX          (62u)       /*!< The longest length field.                              */
+#define CRSF_CH_TOTAL               (16u)       /*!< The number of channels in the packed channels frame.   */
+#define CRSF_CH_BITS                (11u)       /*!< The width of a single packed channel.                  */
+#define CRSF_CH_MASK                (0x07ffu)   /*!< The packed channel mask.                               */
+#define CRSF_CH_VAL_MIN             (172u)      /*!< The channel value sent for 988 us.                     */
+#define CRSF_CH_VAL_MID             (992u)      /*!< The channel value sent for 1500 us.                    */
+#define CRSF_CH_VAL_MAX             (1811u)     /*!< The channel value sent for 2012 us.                    */
+#define CRSF_CRC8_POLY              (0xd5u)     /*!< The DVB-S2 polynomial.                                 */
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+///
+/// \brief The CRSF device addresses accepted in the first frame byte.
+///
+typedef enum crsf_addr
+{
+    CRSF_ADDR_FC       = 0xc8,
+    CRSF_ADDR_RADIO_TX = 0xea,
+    CRSF_ADDR_RX       = 0xec,
+    CRSF_ADDR_TX       = 0xee,
+} crsf_addr_t;
+
+///
+/// \brief The CRSF frame types handled by the parser.
+///
+typedef enum crsf_type
+{
+    CRSF_TYPE_LINK_STATS = 0x14,
+    CRSF_TYPE_RC_CH      = 0x16,
+} crsf_type_t;
+
+///
+/// \brief The CRSF frame payload sizes.
+///
+typedef enum crsf_payload_size
+{
+    CRSF_PAYLOAD_SIZE_LINK_STATS = 10,
+    CRSF_PAYLOAD_SIZE_RC_CH      = 22,
+} crsf_payload_size_t;
+
+///
+/// \brief The CRSF link statistics.
+///
+/// The uplink is the radio to receiver direction and the downlink the opposite one. The RSSI values
+/// are sent as positive numbers, the real value in dBm is their negation.
+///
+struct crsf_link
+{
+    uint8_t up_rssi_1;
+    uint8_t up_rssi_2;
+    uint8_t up_lq;
+    int8_t up_snr;
+    uint8_t ant;
+    uint8_t rf_mode;
+    uint8_t up_tx_pwr;
+    uint8_t down_rssi;
+    uint8_t down_lq;
+    int8_t down_snr;
+};
+
+///
+/// \brief The CRSF receiver counters.
+///
+struct crsf_cnt
+{
+    uint32_t rc_ch;                             /*!< The valid channels frames.                             */
+    uint32_t link;                              /*!< The valid link statistics frames.                      */
+    uint32_t other;                             /*!< The valid frames of the unhandled types.               */
+    uint32_t crc_err;                           /*!< The frames dropped because of the CRC mismatch.        */
+    uint32_t len_err;                           /*!< The frames dropped because of the invalid length.      */
+    uint32_t trunc;                             /*!< The frames cut off by the idle line.                   */
+};
+
+///
+/// \brief The CRSF frame callback type.
+///
+/// The callback is executed from the context which feeds the parser (the reception interrupt on
+/// target), once per valid channels or link statistics frame.
+///
+/// \param[in] arg  The argument given during the initialization.
+/// \param[in] type The decoded frame type.
+///
+typedef void (*crsf_cb_t)(void *const arg, const crsf_type_t type);
+
+///
+/// \brief The CRSF structure.
+///
+struct crsf
+{
+    uint8_t buf[CRSF_FRAME_SIZE_MAX];
+    uint32_t pos;
+    uint16_t ch[CRSF_CH_TOTAL];
+    struct crsf_link link;
+    struct crsf_cnt cnt;
+    crsf_cb_t cb;
+    void *arg;
+};
+
+///
+/// \brief Initializes the CRSF parser.
+///
+/// \param[in] handle The pointer to the CRSF structure.
+/// \param[in] cb     The frame callback, may be NULL.
+/// \param[in] arg    The callback argument.
+///
+void crsf_init(struct crsf *const handle, const crsf_cb_t cb, void *const arg);
+
+///
+/// \brief Feeds the received bytes into the parser.
+///
+/// The bytes do not have to be aligned to the frames, a frame may be split between calls and one
+/// call may carry several frames. The parser resynchronizes on the next address byte after an
+/// invalid length or CRC.
+///
+/// \param[in] handle The pointer to the CRSF structure.
+/// \param[in] data   The received bytes.
+/// \param[in] len    The number of received bytes.
+///
+void crsf_rx(struct crsf *const handle, const uint8_t *const data, const uint32_t len);
+
+///
+/// \brief Signals the idle line.
+///
+/// The transmitter sends every frame in one burst, so a frame which is still incomplete when the
+/// line goes idle will never be completed and is discarded.
+///
+/// \param[in] handle The pointer to the CRSF structure.
+///
+void crsf_rx_idle(struct crsf *const handle);
+
+///
+/// \brief Calculates the CRSF CRC8 (DVB-S2).
+///
+/// \param[in] data The data.
+/// \param[in] len  The data length.
+///
+/// \return uint8_t The CRC8 value.
+///
+uint8_t crsf_crc8(const uint8_t *const data, const uint32_t len);
+
+///
+/// \brief Unpacks the 16 little-endian 11-bit channels.
+///
+/// \param[in]  payload The channels frame payload.
+/// \param[out] ch      The unpacked channel values.
+///
+void crsf_ch_unpack(const uint8_t *const payload, uint16_t *const ch);
+
+///
+/// \brief Converts the channel value to the pulse width.
+///
+/// \param[in] val The channel value.
+///
+/// \return uint32_t The equivalent pulse width in microseconds.
+///
+uint32_t crsf_ch_to_us(const uint16_t val);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _CRSF_H */
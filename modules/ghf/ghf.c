@@ -1,5 +1,6 @@
 #include "ahrs.h"
 #include "bmi270.h"
+#include "boot_handoff.h"
 #include "cf.h"
 #include "ghf.h"
 #include "motor.h"
@@ -9,6 +10,29 @@
 #include "timing.h"
 #include "ll_spi.h"
 
+///
+/// \brief The RC backend, selected by the GHF_RC_BACKEND CMake option.
+///
+#ifndef GHF_RC_BACKEND
+#define GHF_RC_BACKEND rc_backend_pwm
+#endif  /* GHF_RC_BACKEND */
+
+///
+/// \brief The stick set-point smoothing, selected by the GHF_RC_SMOOTH CMake option. The PT2 adds the
+///        least delay of the smoothing types, see rc_smooth_type_t, OFF adds none.
+///
+#ifndef GHF_RC_SMOOTH
+#define GHF_RC_SMOOTH RC_SMOOTH_PT2
+#endif  /* GHF_RC_SMOOTH */
+
+///
+/// \brief Skips the IMU config load and calibration the previous boot left in place, selected by the
+///        GHF_FAST_BOOT CMake option.
+///
+#ifndef GHF_FAST_BOOT
+#define GHF_FAST_BOOT 0
+#endif  /* GHF_FAST_BOOT */
+
 ///***********************************************************************************************************
 /// Private objects - definition.
 ///***********************************************************************************************************
@@ -28,7 +52,9 @@ static struct ghf ghf;
 static void setup(struct ghf *const handle);
 
 ///
-/// \brief Calibrates the ghf IMU.
+/// \brief Calibrates the ghf IMU, the calibration is handed over to the next boot.
+///
+/// \note On the fast path the calibration of the previous boot is restored after a warm reset.
 ///
 /// \param[in] The pointer to ghf.
 ///
@@ -41,6 +67,13 @@ static void calib(struct ghf *const handle);
 ///
 static void is_ready(struct ghf *const handle);
 
+///
+/// \brief Initializes the IMU, resumes the one configured before the warm reset on the fast path.
+///
+/// \return bmi270_res_t The BMI270 result.
+///
+static bmi270_res_t imu_init(void);
+
 ///***********************************************************************************************************
 /// Private functions - definition.
 ///***********************************************************************************************************
@@ -100,10 +133,23 @@ static void setup(struct ghf *const handle)
 
 static void calib(struct ghf *const handle)
 {
+    volatile boot_handoff_t *handoff = BOOT_HANDOFF;
+
     int32_t gx = 0;
     int32_t gz = 0;
     int32_t gy = 0;
 
+#if (GHF_FAST_BOOT == 1)
+    /* The bootloader invalidates the calibration after the power-on. */
+    if (handoff->calib.valid == 1)
+    {
+        handle->data.calib.gx = handoff->calib.gx;
+        handle->data.calib.gy = handoff->calib.gy;
+        handle->data.calib.gz = handoff->calib.gz;
+        return;
+    }
+#endif  /* GHF_FAST_BOOT */
+
     for (int i=0; i<100; ++i)
     {
         bmi270_gyr_read();
@@ -115,20 +161,36 @@ static void calib(struct ghf *const handle)
     handle->data.calib.gx = gx / 100;
     handle->data.calib.gy = gy / 100;
     handle->data.calib.gz = gz / 100;
+
+    handoff->calib.gx    = handle->data.calib.gx;
+    handoff->calib.gy    = handle->data.calib.gy;
+    handoff->calib.gz    = handle->data.calib.gz;
+    handoff->calib.valid = 1;
+    boot_handoff_seal(handoff);
 }
 
 static void is_ready(struct ghf *const handle)
 {
-    rc_sig_raw_gen(handle->module.rc_6);
-    rc_sig_norm(handle->module.rc_6, RC_NORM_ASYM);
+    (void)rc_update();
 
     while (handle->module.rc_6->sig.norm > 0.8f)
     {
-        rc_sig_raw_gen(handle->module.rc_6);
-        rc_sig_norm(handle->module.rc_6, RC_NORM_ASYM);
+        (void)rc_update();
     }
 }
 
+static bmi270_res_t imu_init(void)
+{
+#if (GHF_FAST_BOOT == 1)
+    if (bmi270_resume() == BMI270_RES_OK)
+    {
+        return BMI270_RES_OK;
+    }
+#endif  /* GHF_FAST_BOOT */
+
+    return bmi270_init();
+}
+
 ///***********************************************************************************************************
 /// Global functions - definition.
 ///***********************************************************************************************************
@@ -148,12 +210,22 @@ void ghf_init(struct ghf *const handle)
     ahrs_init(handle->module.ahrs, handle->config.acc_scale, handle->config.gyr_scale,
             handle->config.alpha, handle->config.dt);
 
-    rc_init(handle->module.rc_1, TIM_INST_12, LL_TIM_CCR_CH1);
-    rc_init(handle->module.rc_2, TIM_INST_12, LL_TIM_CCR_CH2);
-    rc_init(handle->module.rc_3, TIM_INST_8,  LL_TIM_CCR_CH1);
-    rc_init(handle->module.rc_4, TIM_INST_8,  LL_TIM_CCR_CH2);
-    rc_init(handle->module.rc_5, TIM_INST_8,  LL_TIM_CCR_CH3);
-    rc_init(handle->module.rc_6, TIM_INST_8,  LL_TIM_CCR_CH4);
+    rc_init(handle->module.rc_1, RC_NORM_SYM);
+    rc_init(handle->module.rc_2, RC_NORM_SYM);
+    rc_init(handle->module.rc_3, RC_NORM_ASYM);
+    rc_init(handle->module.rc_4, RC_NORM_SYM);
+    rc_init(handle->module.rc_5, RC_NORM_ASYM);
+    rc_init(handle->module.rc_6, RC_NORM_ASYM);
+
+    rc_smooth_set(handle->module.rc_1, GHF_RC_SMOOTH);
+    rc_smooth_set(handle->module.rc_2, GHF_RC_SMOOTH);
+    rc_smooth_set(handle->module.rc_3, GHF_RC_SMOOTH);
+    rc_smooth_set(handle->module.rc_4, GHF_RC_SMOOTH);
+
+    if (rc_start(&GHF_RC_BACKEND) != RC_RES_OK)
+    {
+        while(1);
+    }
 
     motor_init(handle->module.motor_1, TIM_INST_4, LL_TIM_CCR_CH1);
     motor_init(handle->module.motor_2, TIM_INST_4, LL_TIM_CCR_CH2);
@@ -164,15 +236,23 @@ void ghf_init(struct ghf *const handle)
     pid_init(handle->module.pid_pitch, handle->config.kp, handle->config.ki, handle->config.kd, handle->config.dt);
     pid_init(handle->module.pid_yaw,   handle->config.kp, handle->config.ki, handle->config.kd, handle->config.dt);
 
+    timing_boot_stamp(TIMING_BOOT_STAGE_DRIVERS);
+
     is_ready(handle);
 
-    if (bmi270_init() != BMI270_RES_OK)
+    timing_boot_stamp(TIMING_BOOT_STAGE_RC_READY);
+
+    if (imu_init() != BMI270_RES_OK)
     {
         while(1);
     }
     bmi270_pwr_mode_set(BMI270_PWR_MODE_NORM_IMU);
 
+    timing_boot_stamp(TIMING_BOOT_STAGE_IMU);
+
     calib(handle);
+
+    timing_boot_stamp(TIMING_BOOT_STAGE_ARMABLE);
 }
 
 void ghf_deinit(struct ghf *const handle)
@@ -120,3 +120,23 @@ float32_t pid_update(struct pid *const handle, float32_t sp, float32_t pv)
 
     return handle->u;
 }
+
+void pid_terms_get(const struct pid *const handle, struct pid_terms *const terms)
+{
+    if (terms == NULL)
+    {
+        return;
+    }
+
+    if (handle == NULL)
+    {
+        terms->p = 0.0f;
+        terms->i = 0.0f;
+        terms->d = 0.0f;
+        return;
+    }
+
+    terms->p = handle->p.val;
+    terms->i = handle->i.val;
+    terms->d = handle->d.val;
+}
@@ -14,6 +14,16 @@ typedef float float32_t;
 ///
 struct pid;
 
+///
+/// \brief The PID controller terms of the last update.
+///
+struct pid_terms
+{
+    float32_t p;
+    float32_t i;
+    float32_t d;
+};
+
 ///
 /// \brief The PID controller instance type.
 ///
@@ -65,6 +75,14 @@ struct pid* pid_get(const pid_inst_t inst);
 ///
 float32_t pid_update(struct pid *const handle, float32_t sp, float32_t pv);
 
+///
+/// \brief Gets the PID controller terms of the last update.
+///
+/// \param[in]  handle The pointer to PID controller.
+/// \param[out] terms  The terms, zeroed on null handle.
+///
+void pid_terms_get(const struct pid *const handle, struct pid_terms *const terms);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
@@ -0,0 +1,80 @@
+#include "ppm.h"
+#include <stddef.h>
+#include <string.h>
+
+#define PPM_CH_VAL_MID              (1500u)     /*!< The channel value before the first frame.              */
+
+///***********************************************************************************************************
+/// Global functions - definition.
+///***********************************************************************************************************
+void ppm_init(struct ppm *const handle, const ppm_cb_t cb, void *const arg)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    memset(handle, 0, sizeof(struct ppm));
+
+    for (uint32_t i = 0; i < PPM_CH_MAX; i++)
+    {
+        handle->ch[i] = PPM_CH_VAL_MID;
+    }
+
+    handle->cb  = cb;
+    handle->arg = arg;
+}
+
+void ppm_edge(struct ppm *const handle, const uint32_t dt)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    if (dt >= PPM_SYNC_MIN)
+    {
+        /* The separator of the sync slot may still be pending, it carries no channel. */
+        if (handle->sync && (handle->idx >= PPM_CH_MIN))
+        {
+            handle->ch_cnt = handle->idx;
+            handle->cnt.frame++;
+
+            if (handle->cb != NULL)
+            {
+                handle->cb(handle->arg);
+            }
+        }
+
+        handle->sync = 1;
+        handle->half = 0;
+        handle->idx  = 0;
+        return;
+    }
+
+    if (!handle->sync)
+    {
+        return;
+    }
+
+    if (!handle->half)
+    {
+        handle->sep  = dt;
+        handle->half = 1;
+        return;
+    }
+
+    uint32_t slot = handle->sep + dt;
+
+    handle->half = 0;
+
+    if ((slot < PPM_CH_VALID_MIN) || (slot > PPM_CH_VALID_MAX) || (handle->idx >= PPM_CH_MAX))
+    {
+        /* Wait for the next sync rather than shifting the channels. */
+        handle->cnt.err++;
+        handle->sync = 0;
+        return;
+    }
+
+    handle->ch[handle->idx++] = (uint16_t)slot;
+}
@@ -0,0 +1,78 @@
+#ifndef _PPM_H
+#define _PPM_H
+
+#include <stdint.h>
+
+#define PPM_CH_MIN                  (4u)        /*!< The fewest channels accepted as a valid frame.         */
+#define PPM_CH_MAX                  (12u)       /*!< The most channels decoded from one frame.              */
+#define PPM_CH_VALID_MIN            (750u)      /*!< The shortest channel slot in microseconds.             */
+#define PPM_CH_VALID_MAX            (2250u)     /*!< The longest channel slot in microseconds.              */
+#define PPM_SYNC_MIN                (2700u)     /*!< The shortest sync level in microseconds.               */
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+///
+/// \brief The PPM decoder counters.
+///
+struct ppm_cnt
+{
+    uint32_t frame;                             /*!< The valid frames.                                      */
+    uint32_t err;                               /*!< The frames dropped because of an invalid slot.         */
+};
+
+///
+/// \brief The PPM frame callback type.
+///
+/// The callback is executed from the context which feeds the decoder (the capture interrupt on
+/// target), once per valid frame, at the start of the sync level.
+///
+/// \param[in] arg The argument given during the initialization.
+///
+typedef void (*ppm_cb_t)(void *const arg);
+
+///
+/// \brief The PPM structure.
+///
+/// The decoder is fed with the intervals between both signal edges, so it does not depend on the
+/// signal polarity. Every channel slot consists of the short separator and the remaining level, the
+/// long remaining level of the sync slot marks the end of the frame.
+///
+struct ppm
+{
+    uint32_t sync;
+    uint32_t half;
+    uint32_t sep;
+    uint32_t idx;
+    uint32_t ch_cnt;
+    uint16_t ch[PPM_CH_MAX];
+    struct ppm_cnt cnt;
+    ppm_cb_t cb;
+    void *arg;
+};
+
+///
+/// \brief Initializes the PPM decoder.
+///
+/// \param[in] handle The pointer to the PPM structure.
+/// \param[in] cb     The frame callback, may be NULL.
+/// \param[in] arg    The callback argument.
+///
+void ppm_init(struct ppm *const handle, const ppm_cb_t cb, void *const arg);
+
+///
+/// \brief Feeds the interval between two consecutive edges into the decoder.
+///
+/// It does a constant amount of work, so it can be called directly from the capture interrupt.
+///
+/// \param[in] handle The pointer to the PPM structure.
+/// \param[in] dt     The interval in microseconds.
+///
+void ppm_edge(struct ppm *const handle, const uint32_t dt);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _PPM_H */
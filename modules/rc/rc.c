@@ -1,4 +1,5 @@
 #include "rc.h"
+#include "timing.h"
 #include <string.h>
 
 ///***********************************************************************************************************
@@ -9,6 +10,42 @@
 ///
 static struct rc rc_arr[RC_CH_TOTAL];
 
+///
+/// \brief The RC frame written by the backend interrupts.
+///
+static struct rc_frame rc_frame_pub;
+
+///
+/// \brief The RC frame lock, odd while the frame is being written.
+///
+static volatile uint32_t rc_frame_lock;
+
+///
+/// \brief The RC snapshot taken by the main loop.
+///
+static struct rc_frame rc_frame_snap;
+
+///
+/// \brief The running RC backend.
+///
+static const struct rc_backend *rc_backend;
+
+///
+/// \brief The cycle counter value of the previous snapshot.
+///
+static uint32_t rc_update_ts;
+
+///
+/// \brief The throttle channel timestamp of the previous snapshot.
+///
+static uint32_t rc_link_ts;
+
+///
+/// \brief The time since the throttle channel was updated (s), accumulated over the snapshots so
+///        the cycle counter wrap-around can not hide a long silence.
+///
+static float32_t rc_link_age;
+
 ///***********************************************************************************************************
 /// Private functions - declaration.
 ///***********************************************************************************************************
@@ -34,6 +71,48 @@ static float32_t norm_asym_f32(const float32_t min, const float32_t max, const f
 ///
 static float32_t norm_sym_f32(const float32_t min, const float32_t max, const float32_t val);
 
+///
+/// \brief Normalizes the PWM pulse width.
+///
+/// \param[in] raw  The PWM pulse width.
+/// \param[in] norm The normalization type.
+///
+/// \return The normalized 32-bit floating-point value.
+///
+static float32_t sig_norm_f32(const uint32_t raw, const rc_norm_t norm);
+
+///
+/// \brief Prevents the compiler from reordering memory accesses across this point.
+///
+static inline void barrier(void);
+
+///
+/// \brief Starts the frame update.
+///
+static inline void frame_begin(void);
+
+///
+/// \brief Completes the frame update.
+///
+static inline void frame_end(void);
+
+///
+/// \brief Writes the RC channel signal into the frame being updated.
+///
+/// \param[in] id  The RC channel.
+/// \param[in] raw The PWM pulse width.
+/// \param[in] ts  The cycle counter value at reception.
+///
+static inline void frame_write(const rc_ch_t id, const uint32_t raw, const uint32_t ts);
+
+///
+/// \brief Updates the RC channel signal from the snapshot.
+///
+/// \param[in] handle The pointer to the RC channel.
+/// \param[in] dt     The time since the previous snapshot in seconds.
+///
+static void sig_update(struct rc *const handle, const float32_t dt);
+
 ///***********************************************************************************************************
 /// Private functions - definition.
 ///***********************************************************************************************************
@@ -47,21 +126,97 @@ static float32_t norm_sym_f32(const float32_t min, const float32_t max, const fl
     return ((2 * ((val - min) / (max - min))) - 1);
 }
 
+static float32_t sig_norm_f32(const uint32_t raw, const rc_norm_t norm)
+{
+    float32_t val;
+
+    if (raw < RC_SIG_RAW_MIN)
+    {
+        val = (float32_t)RC_SIG_RAW_MIN;
+    }
+    else if (raw > RC_SIG_RAW_MAX)
+    {
+        val = (float32_t)RC_SIG_RAW_MAX;
+    }
+    else
+    {
+        val = (float32_t)raw;
+    }
+
+    switch (norm)
+    {
+        case RC_NORM_SYM:
+            val = norm_sym_f32((float32_t)RC_SIG_RAW_MIN, (float32_t)RC_SIG_RAW_MAX, val);
+            break;
+
+        case RC_NORM_ASYM:
+            val = norm_asym_f32((float32_t)RC_SIG_RAW_MIN, (float32_t)RC_SIG_RAW_MAX, val);
+            break;
+
+        default:
+            break;
+    }
+
+    return val;
+}
+
+static inline void barrier(void)
+{
+    __asm volatile ("" ::: "memory");
+}
+
+static inline void frame_begin(void)
+{
+    rc_frame_lock++;
+    barrier();
+}
+
+static inline void frame_end(void)
+{
+    rc_frame_pub.seq++;
+
+    barrier();
+    rc_frame_lock++;
+}
+
+static inline void frame_write(const rc_ch_t id, const uint32_t raw, const uint32_t ts)
+{
+    rc_frame_pub.ts[id]   = ts;
+    rc_frame_pub.raw[id]  = raw;
+    rc_frame_pub.norm[id] = sig_norm_f32(raw, rc_arr[id].norm);
+}
+
+static void sig_update(struct rc *const handle, const float32_t dt)
+{
+    uint32_t ts = rc_frame_snap.ts[handle->id];
+
+    if (ts != handle->ts)
+    {
+        /* Measured per channel, as PWM receivers send them one by one, but not from the rc_init() placeholder. */
+        float32_t interval = (handle->sig.raw != 0) ? ((float32_t)(ts - handle->ts) * TIMING_TICK_DURATION) : 0.0f;
+
+        handle->ts = ts;
+        rc_smooth_frame(&handle->smooth, rc_frame_snap.norm[handle->id], interval);
+    }
+
+    handle->sig.raw  = rc_frame_snap.raw[handle->id];
+    handle->sig.norm = rc_smooth_apply(&handle->smooth, dt);
+}
+
 ///***********************************************************************************************************
 /// Global functions - definition.
 ///***********************************************************************************************************
-void rc_init(struct rc *const handle, const tim_inst_t inst, const ll_tim_ccr_ch_t ch)
+void rc_init(struct rc *const handle, const rc_norm_t norm)
 {
-    if (handle == NULL)
+    if ((handle == NULL) || (handle < &rc_arr[RC_CH_BEGIN]) || (handle >= &rc_arr[RC_CH_TOTAL]))
     {
         return;
     }
 
-    /* TODO: Change tim_dev_arr_get() to tim_get() */
-    struct tim_dev *tim_dev_arr = tim_dev_arr_get();
+    handle->id   = (rc_ch_t)(handle - &rc_arr[RC_CH_BEGIN]);
+    handle->norm = norm;
 
-    handle->tim    = &tim_dev_arr[inst];
-    handle->ccr_ch = ch;
+    rc_publish_ch(handle->id, 0);
 }
 
 void rc_deinit(struct rc *const handle)
@@ -84,53 +239,148 @@ struct rc* rc_get(const rc_ch_t ch)
     return &rc_arr[ch];
 }
 
-void rc_sig_raw_gen(struct rc *const handle)
+rc_res_t rc_start(const struct rc_backend *const backend)
 {
-    if (handle == NULL)
+    if ((backend == NULL) || (backend->start == NULL) || (backend->stop == NULL))
+    {
+        return RC_RES_ERR;
+    }
+
+    rc_stop();
+
+    if (backend->start() != RC_RES_OK)
+    {
+        backend->stop();
+        return RC_RES_ERR;
+    }
+
+    rc_backend = backend;
+
+    return RC_RES_OK;
+}
+
+void rc_stop(void)
+{
+    if (rc_backend == NULL)
     {
         return;
     }
 
-    handle->tim->ccr_data_get(handle->tim->tim, handle->ccr_ch, &handle->ccr_data);
+    rc_backend->stop();
+    rc_backend = NULL;
+}
 
-    if (handle->ccr_data.curr > handle->ccr_data.prev)
+void rc_frame_get(struct rc_frame *const frame)
+{
+    if (frame == NULL)
     {
-        handle->sig.raw = ((handle->ccr_data.curr - handle->ccr_data.prev) < 2200)
-                        ? handle->ccr_data.curr - handle->ccr_data.prev : handle->sig.raw;
+        return;
     }
+
+    uint32_t lock;
+
+    do
+    {
+        lock = rc_frame_lock;
+        barrier();
+
+        memcpy(frame, &rc_frame_pub, sizeof(struct rc_frame));
+
+        barrier();
+    } while ((lock & 0x01u) || (lock != rc_frame_lock));
 }
 
-void rc_sig_norm(struct rc *const handle, const rc_norm_t norm)
+const struct rc_frame* rc_update(void)
+{
+    uint32_t now = timing_cnt_get();
+    float32_t dt = (float32_t)(now - rc_update_ts) * TIMING_TICK_DURATION;
+
+    rc_update_ts = now;
+
+    rc_frame_get(&rc_frame_snap);
+
+    if (rc_frame_snap.ts[RC_CH_3] != rc_link_ts)
+    {
+        rc_link_ts  = rc_frame_snap.ts[RC_CH_3];
+        rc_link_age = 0.0f;
+    }
+    else if (rc_link_age <= RC_LINK_TIMEOUT)
+    {
+        rc_link_age += dt;
+    }
+
+    rc_frame_snap.lost = ((rc_frame_snap.link.failsafe != 0) || (rc_link_age > RC_LINK_TIMEOUT)) ? 1u : 0u;
+
+    for (uint32_t i = RC_CH_BEGIN; i < RC_CH_TOTAL; i++)
+    {
+        sig_update(&rc_arr[i], dt);
+    }
+
+    return &rc_frame_snap;
+}
+
+void rc_smooth_set(struct rc *const handle, const rc_smooth_type_t type)
 {
     if (handle == NULL)
     {
         return;
     }
 
-    if (handle->sig.raw < 1000)
+    rc_smooth_init(&handle->smooth, type, handle->sig.norm);
+}
+
+void rc_sig_norm(struct rc *const handle, const rc_norm_t norm)
+{
+    if (handle == NULL)
     {
-        handle->sig.norm = 1000.0;
+        return;
     }
-    else if (handle->sig.raw > 2000)
+
+    handle->sig.norm = sig_norm_f32(handle->sig.raw, norm);
+}
+
+void rc_publish(const uint32_t *const raw, const uint32_t cnt)
+{
+    if (raw == NULL)
     {
-        handle->sig.norm = 2000.0;
+        return;
     }
-    else
+
+    uint32_t total = (cnt < RC_CH_TOTAL) ? cnt : RC_CH_TOTAL;
+    uint32_t ts = timing_cnt_get();
+
+    frame_begin();
+
+    for (uint32_t i = RC_CH_BEGIN; i < total; i++)
     {
-        handle->sig.norm = (float32_t)handle->sig.raw;
+        frame_write((rc_ch_t)i, raw[i], ts);
     }
 
-    switch (norm)
+    frame_end();
+}
+
+void rc_publish_ch(const rc_ch_t ch, const uint32_t raw)
+{
+    if ((ch < RC_CH_BEGIN) || (ch >= RC_CH_TOTAL))
     {
-        case RC_NORM_SYM:
-            handle->sig.norm = norm_sym_f32(1000.0, 2000.0, handle->sig.norm);
-            break;
+        return;
+    }
 
-        case RC_NORM_ASYM:
-            handle->sig.norm = norm_asym_f32(1000.0, 2000.0, handle->sig.norm);
-            break;
+    uint32_t ts = timing_cnt_get();
 
-        default:
-            break;
+    frame_begin();
+    frame_write(ch, raw, ts);
+    frame_end();
+}
+
+void rc_publish_link(const struct rc_link *const link)
+{
+    if (link == NULL)
+    {
+        return;
     }
+
+    frame_begin();
+    rc_frame_pub.link = *link;
+    frame_end();
 }
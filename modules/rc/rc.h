@@ -1,8 +1,15 @@
 #ifndef _RC_H
 #define _RC_H
 
+#include "rc_smooth.h"
 #include <stdint.h>
-#include "tim.h"
+
+#define RC_SIG_RAW_MIN          (1000u)     /*!< The pulse width mapped to the lowest stick position.   */
+#define RC_SIG_RAW_MAX          (2000u)     /*!< The pulse width mapped to the highest stick position.  */
+#define RC_SIG_RAW_VALID_MIN    (800u)      /*!< The shortest pulse width accepted as a valid pulse.    */
+#define RC_SIG_RAW_VALID_MAX    (2200u)     /*!< The longest pulse width accepted as a valid pulse.     */
+#define RC_CAP_CNT_MASK         (0xffffu)   /*!< The capture counter mask (16-bit timers).              */
+#define RC_LINK_TIMEOUT         (0.25f)     /*!< The throttle silence taken as the link loss (s).       */
 
 #ifdef __cplusplus
 extern "C" {
@@ -23,6 +30,12 @@ extern "C" {
 /// RFCH5  -> TIM8_CH3  (PC8)   adv4
 /// RFCH6  -> TIM8_CH4  (PC9)   adv4
 ///
+/// The single wire receivers replace RFCH1..RFCH6:
+///
+/// PPM    -> TIM12_CH1 (PB14)  gp2
+/// CRSF   -> USART6_RX (PC7)   dma2 stream1
+/// SBUS   -> USART6_RX (PC7)   dma2 stream1, inverted
+///
 ///  ----------------------------
 /// |                    BAT |*+-|
 /// |                    CH6 |s+-|  --> SWB
@@ -34,14 +47,12 @@ extern "C" {
 ///  ----------------------------
 ///
 
-///
-/// \brief The 32-bit floating-ponit type.
-///
-typedef float float32_t;
-
 ///
 /// \brief The RC channel identifiers.
 ///
+/// The PWM backend feeds the first six channels only, the serial and PPM backends as many as the
+/// receiver sends.
+///
 typedef enum rc_ch
 {
     RC_CH_BEGIN = 0,
@@ -51,9 +62,28 @@ typedef enum rc_ch
     RC_CH_4,            /* Yaw      */
     RC_CH_5,            /* SWA      */
     RC_CH_6,            /* SWB      */
+    RC_CH_7,            /* AUX      */
+    RC_CH_8,            /* AUX      */
+    RC_CH_9,            /* AUX      */
+    RC_CH_10,           /* AUX      */
+    RC_CH_11,           /* AUX      */
+    RC_CH_12,           /* AUX      */
+    RC_CH_13,           /* AUX      */
+    RC_CH_14,           /* AUX      */
+    RC_CH_15,           /* AUX      */
+    RC_CH_16,           /* AUX      */
     RC_CH_TOTAL,
 } rc_ch_t;
 
+///
+/// \brief The RC module result type.
+///
+typedef enum rc_res
+{
+    RC_RES_OK = 0,
+    RC_RES_ERR,
+} rc_res_t;
+
 ///
 /// \brief The RC channel normalization type.
 ///
@@ -72,25 +102,88 @@ struct rc_sig
     float32_t norm;
 };
 
+///
+/// \brief The RC link state, reported by the serial receivers only.
+///
+struct rc_link
+{
+    uint32_t lq;                            /*!< The uplink quality in percent.                         */
+    int32_t rssi;                           /*!< The uplink RSSI of the active antenna in dBm.          */
+    uint32_t failsafe;                      /*!< Non-zero while the receiver reports the failsafe.      */
+};
+
+///
+/// \brief The RC frame published by the backend interrupts.
+///
+/// The sequence number is incremented on every published pulse or packet, so a consumer can tell
+/// whether anything has changed since its previous snapshot. The timestamps hold the cycle counter
+/// value of the last update of every channel, they give the frame interval to the smoothing.
+///
+/// The link is lost when the receiver reports the failsafe or the throttle channel has not been
+/// updated for RC_LINK_TIMEOUT, the receivers which stop sending on the radio loss report nothing.
+///
+struct rc_frame
+{
+    uint32_t seq;
+    uint32_t ts[RC_CH_TOTAL];
+    uint32_t raw[RC_CH_TOTAL];
+    float32_t norm[RC_CH_TOTAL];
+    struct rc_link link;
+    uint32_t lost;                          /*!< Non-zero while the link is lost, set in the snapshot.  */
+};
+
 ///
 /// \brief The RC structure.
 ///
 struct rc
 {
-    struct tim_dev *tim;
-    struct ll_tim_ccr_data ccr_data;
-    ll_tim_ccr_ch_t ccr_ch;
+    rc_ch_t id;
+    rc_norm_t norm;
+    uint32_t ts;
+    struct rc_smooth smooth;
     struct rc_sig sig;
 };
 
+///
+/// \brief The RC backend interface.
+///
+/// A backend owns the receiver hardware and decodes the channels in its interrupts, then hands
+/// them over with rc_publish(), rc_publish_ch() and rc_publish_link(). Only one backend runs at a
+/// time.
+///
+struct rc_backend
+{
+    rc_res_t (*start)(void);
+    void (*stop)(void);
+};
+
+///
+/// \brief The PWM backend, one timer capture channel per RC channel (RFCH1..RFCH6).
+///
+extern const struct rc_backend rc_backend_pwm;
+
+///
+/// \brief The PPM backend, all channels on the TIM12_CH1 capture channel.
+///
+extern const struct rc_backend rc_backend_ppm;
+
+///
+/// \brief The CRSF backend, 420 kbaud 8N1 on USART6.
+///
+extern const struct rc_backend rc_backend_crsf;
+
+///
+/// \brief The SBUS backend, inverted 100 kbaud 8E2 on USART6.
+///
+extern const struct rc_backend rc_backend_sbus;
+
 ///
 /// \brief Initializes the RC channel.
 ///
 /// \param[in] handle The pointer to the RC channel.
-/// \param[in] inst   The timer instance.
-/// \param[in] ch     The timer capture/compare channel.
+/// \param[in] norm   The normalization type.
 ///
-void rc_init(struct rc *const handle, const tim_inst_t inst, const ll_tim_ccr_ch_t ch);
+void rc_init(struct rc *const handle, const rc_norm_t norm);
 
 ///
 /// \brief Denitializes the RC channel.
@@ -109,11 +202,50 @@ void rc_deinit(struct rc *const handle);
 struct rc* rc_get(const rc_ch_t ch);
 
 ///
-/// \brief Generates PWM pulse width from capture/compare register.
+/// \brief Starts the given backend, the running one is stopped first.
+///
+/// \param[in] backend The pointer to the backend.
+///
+/// \return rc_res_t   The RC result.
+/// \retval RC_RES_OK  On success.
+/// \retval RC_RES_ERR Otherwise.
+///
+rc_res_t rc_start(const struct rc_backend *const backend);
+
+///
+/// \brief Stops the running backend.
+///
+void rc_stop(void);
+
+///
+/// \brief Takes a consistent copy of the frame published by the backend interrupts.
+///
+/// \param[out] frame The pointer to the frame copy.
+///
+void rc_frame_get(struct rc_frame *const frame);
+
+///
+/// \brief Takes the snapshot of all RC channels.
+///
+/// Updates the signal of every RC channel from one consistent frame. It is meant to be called once
+/// per control loop, before any RC signal is read. The normalized signal of the smoothed channels
+/// is advanced by the time elapsed since the previous call, the raw signal is never smoothed.
+///
+/// The snapshot reports the link loss, the caller must not fly on the channels while it is set.
+///
+/// \return const struct rc_frame* The snapshot.
+///
+const struct rc_frame* rc_update(void);
+
+///
+/// \brief Sets the set-point smoothing of the RC channel.
+///
+/// \note  It is meant for the stick channels, the switches should be left unsmoothed.
 ///
 /// \param[in] handle The pointer to the RC channel.
+/// \param[in] type   The smoothing type.
 ///
-void rc_sig_raw_gen(struct rc *const handle);
+void rc_smooth_set(struct rc *const handle, const rc_smooth_type_t type);
 
 ///
 /// \brief Normalizes PWM pulse width for a given RC channel.
@@ -123,6 +255,35 @@ void rc_sig_raw_gen(struct rc *const handle);
 ///
 void rc_sig_norm(struct rc *const handle, const rc_norm_t norm);
 
+///
+/// \brief Publishes the consecutive channels starting from RC_CH_1 in one frame.
+///
+/// \note  It is meant to be called by the backends, from one interrupt priority level only.
+///
+/// \param[in] raw The pulse widths in microseconds.
+/// \param[in] cnt The number of channels, the ones above RC_CH_TOTAL are ignored.
+///
+void rc_publish(const uint32_t *const raw, const uint32_t cnt);
+
+///
+/// \brief Publishes the single channel.
+///
+/// \note  It is meant to be called by the backends, from one interrupt priority level only.
+///
+/// \param[in] ch  The RC channel.
+/// \param[in] raw The pulse width in microseconds.
+///
+void rc_publish_ch(const rc_ch_t ch, const uint32_t raw);
+
+///
+/// \brief Publishes the link state.
+///
+/// \note  It is meant to be called by the backends, from one interrupt priority level only.
+///
+/// \param[in] link The pointer to the link state.
+///
+void rc_publish_link(const struct rc_link *const link);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
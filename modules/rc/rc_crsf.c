@@ -0,0 +1,127 @@
+#include "rc.h"
+#include "crsf.h"
+#include "ll_usart_dma.h"
+#include <stddef.h>
+
+///***********************************************************************************************************
+/// Private objects - definition.
+///***********************************************************************************************************
+///
+/// \brief The CRSF receiver, fed from the USART reception interrupts.
+///
+static struct crsf rc_crsf;
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief The USART reception callback, executed from the reception interrupts.
+///
+/// \param[in] arg  Unused.
+/// \param[in] data The received bytes.
+/// \param[in] len  The number of received bytes.
+/// \param[in] idle True if the line went idle after the received bytes.
+///
+static void rx_handler(void *const arg, const uint8_t *const data, const uint32_t len, const bool idle);
+
+///
+/// \brief The CRSF frame callback, executed from the reception interrupts.
+///
+/// \param[in] arg  Unused.
+/// \param[in] type The decoded frame type.
+///
+static void crsf_handler(void *const arg, const crsf_type_t type);
+
+///
+/// \brief Starts the CRSF backend.
+///
+/// \return rc_res_t   The RC result.
+/// \retval RC_RES_OK  On success.
+/// \retval RC_RES_ERR Otherwise.
+///
+static rc_res_t start(void);
+
+///
+/// \brief Stops the CRSF backend.
+///
+static void stop(void);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static void rx_handler(void *const arg, const uint8_t *const data, const uint32_t len, const bool idle)
+{
+    (void)arg;
+
+    crsf_rx(&rc_crsf, data, len);
+
+    if (idle)
+    {
+        crsf_rx_idle(&rc_crsf);
+    }
+}
+
+static void crsf_handler(void *const arg, const crsf_type_t type)
+{
+    (void)arg;
+
+    uint32_t raw[CRSF_CH_TOTAL];
+    struct rc_link link;
+
+    switch (type)
+    {
+        case CRSF_TYPE_RC_CH:
+            for (uint32_t i = 0; i < CRSF_CH_TOTAL; i++)
+            {
+                raw[i] = crsf_ch_to_us(rc_crsf.ch[i]);
+            }
+
+            rc_publish(raw, CRSF_CH_TOTAL);
+            break;
+
+        case CRSF_TYPE_LINK_STATS:
+            link.lq       = rc_crsf.link.up_lq;
+            link.rssi     = -(int32_t)((rc_crsf.link.ant == 0) ? rc_crsf.link.up_rssi_1 : rc_crsf.link.up_rssi_2);
+            link.failsafe = 0;
+
+            rc_publish_link(&link);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static rc_res_t start(void)
+{
+    const struct ll_usart_dma_conf conf =
+    {
+        .baud   = CRSF_BAUDRATE,
+        .parity = LL_USART_DMA_PARITY_NONE,
+        .stop   = LL_USART_DMA_STOP_1,
+        .inv    = false,
+    };
+
+    crsf_init(&rc_crsf, &crsf_handler, NULL);
+
+    if (ll_usart_dma_rx_init(LL_USART_DMA_INST_USART6, &conf, &rx_handler, NULL) != LL_USART_DMA_RES_OK)
+    {
+        return RC_RES_ERR;
+    }
+
+    return RC_RES_OK;
+}
+
+static void stop(void)
+{
+    ll_usart_dma_rx_deinit(LL_USART_DMA_INST_USART6);
+}
+
+///***********************************************************************************************************
+/// Global objects - definition.
+///***********************************************************************************************************
+const struct rc_backend rc_backend_crsf =
+{
+    .start = &start,
+    .stop  = &stop,
+};
@@ -0,0 +1,108 @@
+#include "rc.h"
+#include "ppm.h"
+#include "tim.h"
+#include <stddef.h>
+
+#define RC_PPM_TIM_INST             (TIM_INST_12)       /*!< The PPM input timer (RFCH1).                   */
+#define RC_PPM_TIM_CH               (LL_TIM_CCR_CH1)    /*!< The PPM input capture channel (PB14).          */
+
+///***********************************************************************************************************
+/// Private objects - definition.
+///***********************************************************************************************************
+///
+/// \brief The PPM decoder, owned by the capture interrupt.
+///
+static struct ppm rc_ppm;
+
+///
+/// \brief The previous captured counter value.
+///
+static uint32_t rc_ppm_prev;
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief The timer capture callback, executed from the capture/compare interrupt.
+///
+/// \param[in] arg Unused.
+/// \param[in] ccr The captured counter value.
+///
+static void cap_handler(void *const arg, const uint32_t ccr);
+
+///
+/// \brief The PPM frame callback, executed from the capture/compare interrupt.
+///
+/// \param[in] arg Unused.
+///
+static void ppm_handler(void *const arg);
+
+///
+/// \brief Starts the PPM backend.
+///
+/// \return rc_res_t   The RC result.
+/// \retval RC_RES_OK  On success.
+/// \retval RC_RES_ERR Otherwise.
+///
+static rc_res_t start(void);
+
+///
+/// \brief Stops the PPM backend.
+///
+static void stop(void);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static void cap_handler(void *const arg, const uint32_t ccr)
+{
+    (void)arg;
+
+    /* The modulo difference handles the counter wrap between both edges. */
+    uint32_t dt = (ccr - rc_ppm_prev) & RC_CAP_CNT_MASK;
+
+    rc_ppm_prev = ccr;
+
+    ppm_edge(&rc_ppm, dt);
+}
+
+static void ppm_handler(void *const arg)
+{
+    (void)arg;
+
+    uint32_t raw[PPM_CH_MAX];
+
+    for (uint32_t i = 0; i < rc_ppm.ch_cnt; i++)
+    {
+        raw[i] = rc_ppm.ch[i];
+    }
+
+    rc_publish(raw, rc_ppm.ch_cnt);
+}
+
+static rc_res_t start(void)
+{
+    ppm_init(&rc_ppm, &ppm_handler, NULL);
+    rc_ppm_prev = 0;
+
+    if (tim_cap_cb_set(RC_PPM_TIM_INST, RC_PPM_TIM_CH, &cap_handler, NULL) != TIM_RES_OK)
+    {
+        return RC_RES_ERR;
+    }
+
+    return RC_RES_OK;
+}
+
+static void stop(void)
+{
+    (void)tim_cap_cb_set(RC_PPM_TIM_INST, RC_PPM_TIM_CH, NULL, NULL);
+}
+
+///***********************************************************************************************************
+/// Global objects - definition.
+///***********************************************************************************************************
+const struct rc_backend rc_backend_ppm =
+{
+    .start = &start,
+    .stop  = &stop,
+};
@@ -0,0 +1,140 @@
+#include "rc.h"
+#include "tim.h"
+#include <stddef.h>
+
+///***********************************************************************************************************
+/// Private objects - declaration.
+///***********************************************************************************************************
+///
+/// \brief The PWM capture edge type.
+///
+typedef enum pwm_edge
+{
+    PWM_EDGE_SYNC = 0,                      /*!< The edge polarity is not known yet.                    */
+    PWM_EDGE_RISING,                        /*!< The next capture starts the pulse.                     */
+    PWM_EDGE_FALLING,                       /*!< The next capture ends the pulse.                       */
+} pwm_edge_t;
+
+///
+/// \brief The PWM input, owned by the capture interrupt.
+///
+struct pwm_in
+{
+    const rc_ch_t id;
+    const tim_inst_t inst;
+    const ll_tim_ccr_ch_t ch;
+    uint32_t prev;
+    pwm_edge_t edge;
+};
+
+///***********************************************************************************************************
+/// Private objects - definition.
+///***********************************************************************************************************
+///
+/// \brief The PWM inputs, see the timer usage in rc.h.
+///
+static struct pwm_in pwm_in_arr[] =
+{
+    {.id = RC_CH_1, .inst = TIM_INST_12, .ch = LL_TIM_CCR_CH1},
+    {.id = RC_CH_2, .inst = TIM_INST_12, .ch = LL_TIM_CCR_CH2},
+    {.id = RC_CH_3, .inst = TIM_INST_8,  .ch = LL_TIM_CCR_CH1},
+    {.id = RC_CH_4, .inst = TIM_INST_8,  .ch = LL_TIM_CCR_CH2},
+    {.id = RC_CH_5, .inst = TIM_INST_8,  .ch = LL_TIM_CCR_CH3},
+    {.id = RC_CH_6, .inst = TIM_INST_8,  .ch = LL_TIM_CCR_CH4},
+};
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief The timer capture callback, executed from the capture/compare interrupt.
+///
+/// \param[in] arg The pointer to the PWM input.
+/// \param[in] ccr The captured counter value.
+///
+static void cap_handler(void *const arg, const uint32_t ccr);
+
+///
+/// \brief Starts the PWM backend.
+///
+/// \return rc_res_t   The RC result.
+/// \retval RC_RES_OK  On success.
+/// \retval RC_RES_ERR Otherwise.
+///
+static rc_res_t start(void);
+
+///
+/// \brief Stops the PWM backend.
+///
+static void stop(void);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static void cap_handler(void *const arg, const uint32_t ccr)
+{
+    struct pwm_in *in = (struct pwm_in *)arg;
+
+    /* The modulo difference handles the counter wrap between both edges. */
+    uint32_t width = (ccr - in->prev) & RC_CAP_CNT_MASK;
+
+    in->prev = ccr;
+
+    switch (in->edge)
+    {
+        case PWM_EDGE_SYNC:
+        case PWM_EDGE_RISING:
+            in->edge = PWM_EDGE_FALLING;
+            break;
+
+        case PWM_EDGE_FALLING:
+            if ((width < RC_SIG_RAW_VALID_MIN) || (width > RC_SIG_RAW_VALID_MAX))
+            {
+                /* The measured interval was the gap between pulses, so this edge starts the pulse. */
+                break;
+            }
+
+            in->edge = PWM_EDGE_RISING;
+            rc_publish_ch(in->id, width);
+            break;
+
+        default:
+            in->edge = PWM_EDGE_SYNC;
+            break;
+    }
+}
+
+static rc_res_t start(void)
+{
+    for (uint32_t i = 0; i < (sizeof(pwm_in_arr) / sizeof(pwm_in_arr[0])); i++)
+    {
+        struct pwm_in *in = &pwm_in_arr[i];
+
+        in->prev = 0;
+        in->edge = PWM_EDGE_SYNC;
+
+        if (tim_cap_cb_set(in->inst, in->ch, &cap_handler, in) != TIM_RES_OK)
+        {
+            return RC_RES_ERR;
+        }
+    }
+
+    return RC_RES_OK;
+}
+
+static void stop(void)
+{
+    for (uint32_t i = 0; i < (sizeof(pwm_in_arr) / sizeof(pwm_in_arr[0])); i++)
+    {
+        (void)tim_cap_cb_set(pwm_in_arr[i].inst, pwm_in_arr[i].ch, NULL, NULL);
+    }
+}
+
+///***********************************************************************************************************
+/// Global objects - definition.
+///***********************************************************************************************************
+const struct rc_backend rc_backend_pwm =
+{
+    .start = &start,
+    .stop  = &stop,
+};
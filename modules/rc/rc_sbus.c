@@ -0,0 +1,117 @@
+#include "rc.h"
+#include "sbus.h"
+#include "ll_usart_dma.h"
+#include <stddef.h>
+
+///***********************************************************************************************************
+/// Private objects - definition.
+///***********************************************************************************************************
+///
+/// \brief The SBUS receiver, fed from the USART reception interrupts.
+///
+static struct sbus rc_sbus;
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief The USART reception callback, executed from the reception interrupts.
+///
+/// \param[in] arg  Unused.
+/// \param[in] data The received bytes.
+/// \param[in] len  The number of received bytes.
+/// \param[in] idle True if the line went idle after the received bytes.
+///
+static void rx_handler(void *const arg, const uint8_t *const data, const uint32_t len, const bool idle);
+
+///
+/// \brief The SBUS frame callback, executed from the reception interrupts.
+///
+/// \param[in] arg Unused.
+///
+static void sbus_handler(void *const arg);
+
+///
+/// \brief Starts the SBUS backend.
+///
+/// \return rc_res_t   The RC result.
+/// \retval RC_RES_OK  On success.
+/// \retval RC_RES_ERR Otherwise.
+///
+static rc_res_t start(void);
+
+///
+/// \brief Stops the SBUS backend.
+///
+static void stop(void);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static void rx_handler(void *const arg, const uint8_t *const data, const uint32_t len, const bool idle)
+{
+    (void)arg;
+
+    sbus_rx(&rc_sbus, data, len);
+
+    if (idle)
+    {
+        sbus_rx_idle(&rc_sbus);
+    }
+}
+
+static void sbus_handler(void *const arg)
+{
+    (void)arg;
+
+    uint32_t raw[SBUS_CH_TOTAL];
+    struct rc_link link =
+    {
+        .lq       = 0,
+        .rssi     = 0,
+        .failsafe = (rc_sbus.flags & SBUS_FLAG_FAILSAFE) ? 1u : 0u,
+    };
+
+    for (uint32_t i = 0; i < SBUS_CH_TOTAL; i++)
+    {
+        raw[i] = sbus_ch_to_us(rc_sbus.ch[i]);
+    }
+
+    rc_publish(raw, SBUS_CH_TOTAL);
+    rc_publish_link(&link);
+}
+
+static rc_res_t start(void)
+{
+    /* The USART inverts the line itself, no external inverter is needed. */
+    const struct ll_usart_dma_conf conf =
+    {
+        .baud   = SBUS_BAUDRATE,
+        .parity = LL_USART_DMA_PARITY_EVEN,
+        .stop   = LL_USART_DMA_STOP_2,
+        .inv    = true,
+    };
+
+    sbus_init(&rc_sbus, &sbus_handler, NULL);
+
+    if (ll_usart_dma_rx_init(LL_USART_DMA_INST_USART6, &conf, &rx_handler, NULL) != LL_USART_DMA_RES_OK)
+    {
+        return RC_RES_ERR;
+    }
+
+    return RC_RES_OK;
+}
+
+static void stop(void)
+{
+    ll_usart_dma_rx_deinit(LL_USART_DMA_INST_USART6);
+}
+
+///***********************************************************************************************************
+/// Global objects - definition.
+///***********************************************************************************************************
+const struct rc_backend rc_backend_sbus =
+{
+    .start = &start,
+    .stop  = &stop,
+};
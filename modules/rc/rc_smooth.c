@@ -0,0 +1,123 @@
+#include "rc_smooth.h"
+#include <stddef.h>
+
+#ifndef M_PI
+#define M_PI    (3.1415926535f)
+#endif  /* M_PI */
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief Computes the PT1 stage gain of the PT2 filter matching the frame interval.
+///
+/// \param[in] interval The frame interval in seconds.
+/// \param[in] dt       The loop time in seconds.
+///
+/// \return float32_t The PT1 gain.
+///
+static float32_t pt2_gain(const float32_t interval, const float32_t dt);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static float32_t pt2_gain(const float32_t interval, const float32_t dt)
+{
+    /* Each stage cutoff is raised so the cascade still has its -3 dB point at the requested cutoff. */
+    float32_t cutoff = (RC_SMOOTH_PT2_CUTOFF_RATIO * RC_SMOOTH_PT2_CUTOFF_CORR) / interval;
+    float32_t rc = 1.0f / (2.0f * M_PI * cutoff);
+
+    return (dt / (rc + dt));
+}
+
+///***********************************************************************************************************
+/// Global functions - definition.
+///***********************************************************************************************************
+void rc_smooth_init(struct rc_smooth *const handle, const rc_smooth_type_t type, const float32_t val)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    handle->type     = type;
+    handle->interval = 0.0f;
+    handle->target   = val;
+    handle->rate     = 0.0f;
+    handle->pt1      = val;
+    handle->out      = val;
+}
+
+void rc_smooth_frame(struct rc_smooth *const handle, const float32_t val, const float32_t interval)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    if ((interval >= RC_SMOOTH_INTERVAL_MIN) && (interval <= RC_SMOOTH_INTERVAL_MAX))
+    {
+        if (handle->interval == 0.0f)
+        {
+            handle->interval = interval;
+        }
+        else
+        {
+            handle->interval += RC_SMOOTH_INTERVAL_GAIN * (interval - handle->interval);
+        }
+    }
+
+    handle->target = val;
+
+    /* The ramp starts from the current output right away, so it ends when the next frame is due. */
+    handle->rate = (handle->interval > 0.0f) ? ((val - handle->out) / handle->interval) : 0.0f;
+}
+
+float32_t rc_smooth_apply(struct rc_smooth *const handle, const float32_t dt)
+{
+    if (handle == NULL)
+    {
+        return 0.0f;
+    }
+
+    if (handle->interval == 0.0f)
+    {
+        handle->pt1 = handle->target;
+        handle->out = handle->target;
+
+        return handle->out;
+    }
+
+    if (dt <= 0.0f)
+    {
+        return handle->out;
+    }
+
+    float32_t k;
+
+    switch (handle->type)
+    {
+        case RC_SMOOTH_LINEAR:
+            handle->out += handle->rate * dt;
+
+            if (((handle->rate >= 0.0f) && (handle->out > handle->target)) ||
+                ((handle->rate <  0.0f) && (handle->out < handle->target)))
+            {
+                handle->out = handle->target;
+            }
+            break;
+
+        case RC_SMOOTH_PT2:
+            k = pt2_gain(handle->interval, dt);
+
+            handle->pt1 += k * (handle->target - handle->pt1);
+            handle->out += k * (handle->pt1 - handle->out);
+            break;
+
+        default:
+            handle->out = handle->target;
+            break;
+    }
+
+    return handle->out;
+}
@@ -0,0 +1,85 @@
+#ifndef _RC_SMOOTH_H
+#define _RC_SMOOTH_H
+
+#include <stdint.h>
+
+#define RC_SMOOTH_INTERVAL_MIN      (0.001f)    /*!< The shortest frame interval accepted in seconds.        */
+#define RC_SMOOTH_INTERVAL_MAX      (0.05f)     /*!< The longest frame interval accepted in seconds.         */
+#define RC_SMOOTH_INTERVAL_GAIN     (0.05f)     /*!< The frame interval estimator gain.                      */
+#define RC_SMOOTH_PT2_CUTOFF_RATIO  (0.5f)      /*!< The PT2 cutoff frequency relative to the frame rate.    */
+#define RC_SMOOTH_PT2_CUTOFF_CORR   (1.553774f) /*!< The PT1 stage correction, 1/sqrt(2^(1/2)-1).            */
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+///
+/// \brief The 32-bit floating-ponit type.
+///
+typedef float float32_t;
+
+///
+/// \brief The RC set-point smoothing type.
+///
+/// Both smoothing types delay the set-point over the sample-and-hold of RC_SMOOTH_OFF. For the stick
+/// moving at a constant rate the added delay is half of the frame interval with RC_SMOOTH_LINEAR and
+/// 0.41 of it with RC_SMOOTH_PT2, 10 ms and 8.2 ms at 50 Hz, 2 ms and 1.6 ms at 250 Hz.
+///
+typedef enum rc_smooth_type
+{
+    RC_SMOOTH_OFF = 0,                      /*!< The frame value is passed through.                     */
+    RC_SMOOTH_LINEAR,                       /*!< The output ramps to the frame value in one interval.   */
+    RC_SMOOTH_PT2,                          /*!< The output follows the frame value through a PT2.      */
+} rc_smooth_type_t;
+
+///
+/// \brief The RC set-point smoothing stage.
+///
+/// The stage is fed with the received frame values and evaluated once per control loop. The
+/// frame interval is estimated from the intervals between the received frames, the ones outside
+/// of RC_SMOOTH_INTERVAL_MIN..RC_SMOOTH_INTERVAL_MAX (lost frames, link start) are ignored. The
+/// output follows the frame values as is until the first interval has been measured.
+///
+struct rc_smooth
+{
+    rc_smooth_type_t type;
+    float32_t interval;                     /*!< The estimated frame interval in seconds, 0 if unknown. */
+    float32_t target;                       /*!< The last received frame value.                         */
+    float32_t rate;                         /*!< The linear ramp rate in units per second.              */
+    float32_t pt1;                          /*!< The first PT2 stage state.                             */
+    float32_t out;                          /*!< The smoothed value.                                    */
+};
+
+///
+/// \brief Initializes the smoothing stage.
+///
+/// \param[in] handle The pointer to the smoothing stage.
+/// \param[in] type   The smoothing type.
+/// \param[in] val    The initial value.
+///
+void rc_smooth_init(struct rc_smooth *const handle, const rc_smooth_type_t type, const float32_t val);
+
+///
+/// \brief Feeds the received frame value.
+///
+/// \param[in] handle   The pointer to the smoothing stage.
+/// \param[in] val      The frame value.
+/// \param[in] interval The time since the previous frame in seconds, 0 if unknown.
+///
+void rc_smooth_frame(struct rc_smooth *const handle, const float32_t val, const float32_t interval);
+
+///
+/// \brief Advances the smoothing stage by one control loop.
+///
+/// \param[in] handle The pointer to the smoothing stage.
+/// \param[in] dt     The time since the previous call in seconds.
+///
+/// \return float32_t The smoothed value.
+///
+float32_t rc_smooth_apply(struct rc_smooth *const handle, const float32_t dt);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _RC_SMOOTH_H */
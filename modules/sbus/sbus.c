@@ -0,0 +1,155 @@
+#include "sbus.h"
+#include <stddef.h>
+#include <string.h>
+
+#define SBUS_US_MID                 (1500)      /*!< The pulse width of the middle channel value.           */
+#define SBUS_US_SCALE_NUM           (5)         /*!< The channel value to microseconds scale numerator.     */
+#define SBUS_US_SCALE_DEN           (8)         /*!< The channel value to microseconds scale denominator.   */
+
+#define SBUS_POS_HEADER             (0u)        /*!< The header byte position.                              */
+#define SBUS_POS_DATA               (1u)        /*!< The first channel byte position.                       */
+#define SBUS_POS_FLAGS              (23u)       /*!< The flags byte position.                               */
+#define SBUS_POS_FOOTER             (24u)       /*!< The footer byte position.                              */
+#define SBUS_GROUP_SIZE             (11u)       /*!< The bytes holding eight packed channels.               */
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief Unpacks eight 11-bit channels from eleven bytes.
+///
+/// \param[in]  b  The packed bytes.
+/// \param[out] ch The unpacked channel values.
+///
+static inline void group_unpack(const uint8_t *const b, uint16_t *const ch);
+
+///
+/// \brief Validates and decodes the complete frame stored in the parser buffer.
+///
+/// \param[in] handle The pointer to the SBUS structure.
+///
+static void frame_handle(struct sbus *const handle);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static inline void group_unpack(const uint8_t *const b, uint16_t *const ch)
+{
+    ch[0] = (uint16_t)(((uint32_t)b[0]        | ((uint32_t)b[1] << 8))                           & SBUS_CH_MASK);
+    ch[1] = (uint16_t)(((uint32_t)b[1]  >> 3  | ((uint32_t)b[2] << 5))                           & SBUS_CH_MASK);
+    ch[2] = (uint16_t)(((uint32_t)b[2]  >> 6  | ((uint32_t)b[3] << 2) | ((uint32_t)b[4] << 10))  & SBUS_CH_MASK);
+    ch[3] = (uint16_t)(((uint32_t)b[4]  >> 1  | ((uint32_t)b[5] << 7))                           & SBUS_CH_MASK);
+    ch[4] = (uint16_t)(((uint32_t)b[5]  >> 4  | ((uint32_t)b[6] << 4))                           & SBUS_CH_MASK);
+    ch[5] = (uint16_t)(((uint32_t)b[6]  >> 7  | ((uint32_t)b[7] << 1) | ((uint32_t)b[8] << 9))   & SBUS_CH_MASK);
+    ch[6] = (uint16_t)(((uint32_t)b[8]  >> 2  | ((uint32_t)b[9] << 6))                           & SBUS_CH_MASK);
+    ch[7] = (uint16_t)(((uint32_t)b[9]  >> 5  | ((uint32_t)b[10] << 3))                          & SBUS_CH_MASK);
+}
+
+static void frame_handle(struct sbus *const handle)
+{
+    uint8_t footer = handle->buf[SBUS_POS_FOOTER];
+
+    if ((footer != SBUS_FOOTER) && ((footer & SBUS2_FOOTER_MASK) != SBUS2_FOOTER))
+    {
+        handle->cnt.err++;
+        return;
+    }
+
+    handle->flags = handle->buf[SBUS_POS_FLAGS];
+    handle->cnt.frame++;
+
+    if (handle->flags & SBUS_FLAG_FRAME_LOST)
+    {
+        handle->cnt.lost++;
+    }
+
+    /* The failsafe frame carries the positions programmed in the receiver, the flag is reported too. */
+    if (handle->flags & SBUS_FLAG_FAILSAFE)
+    {
+        handle->cnt.failsafe++;
+    }
+
+    sbus_ch_unpack(&handle->buf[SBUS_POS_DATA], handle->ch);
+
+    if (handle->cb != NULL)
+    {
+        handle->cb(handle->arg);
+    }
+}
+
+///***********************************************************************************************************
+/// Global functions - definition.
+///***********************************************************************************************************
+void sbus_init(struct sbus *const handle, const sbus_cb_t cb, void *const arg)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    memset(handle, 0, sizeof(struct sbus));
+
+    for (uint32_t i = 0; i < SBUS_CH_TOTAL; i++)
+    {
+        handle->ch[i] = SBUS_CH_VAL_MID;
+    }
+
+    handle->cb  = cb;
+    handle->arg = arg;
+}
+
+void sbus_rx(struct sbus *const handle, const uint8_t *const data, const uint32_t len)
+{
+    if ((handle == NULL) || (data == NULL))
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if ((handle->pos == SBUS_POS_HEADER) && (data[i] != SBUS_HEADER))
+        {
+            continue;
+        }
+
+        handle->buf[handle->pos++] = data[i];
+
+        if (handle->pos == SBUS_FRAME_SIZE)
+        {
+            frame_handle(handle);
+            handle->pos = 0;
+        }
+    }
+}
+
+void sbus_rx_idle(struct sbus *const handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    if (handle->pos != 0)
+    {
+        handle->cnt.trunc++;
+        handle->pos = 0;
+    }
+}
+
+void sbus_ch_unpack(const uint8_t *const data, uint16_t *const ch)
+{
+    if ((data == NULL) || (ch == NULL))
+    {
+        return;
+    }
+
+    group_unpack(&data[0], &ch[0]);
+    group_unpack(&data[SBUS_GROUP_SIZE], &ch[8]);
+}
+
+uint32_t sbus_ch_to_us(const uint16_t val)
+{
+    int32_t diff = (int32_t)val - (int32_t)SBUS_CH_VAL_MID;
+
+    return (uint32_t)(SBUS_US_MID + ((diff * SBUS_US_SCALE_NUM) / SBUS_US_SCALE_DEN));
+}
@@ -0,0 +1,112 @@
+#ifndef _SBUS_H
+#define _SBUS_H
+
+#include <stdint.h>
+
+#define SBUS_BAUDRATE               (100000u)   /*!< The SBUS baud rate, 8E2 with the inverted level.       */
+#define SBUS_FRAME_SIZE             (25u)       /*!< The frame size, header and footer included.            */
+#define SBUS_CH_TOTAL               (16u)       /*!< The number of proportional channels.                   */
+#define SBUS_HEADER                 (0x0fu)     /*!< The frame header byte.                                 */
+#define SBUS_FOOTER                 (0x00u)     /*!< The SBUS frame footer byte.                            */
+#define SBUS2_FOOTER_MASK           (0x0fu)     /*!< The SBUS2 footer mask, the upper nibble is the slot.   */
+#define SBUS2_FOOTER                (0x04u)     /*!< The SBUS2 footer byte after masking.                   */
+#define SBUS_CH_MASK                (0x07ffu)   /*!< The packed channel mask.                               */
+#define SBUS_CH_VAL_MIN             (172u)      /*!< The channel value sent for 988 us.                     */
+#define SBUS_CH_VAL_MID             (992u)      /*!< The channel value sent for 1500 us.                    */
+#define SBUS_CH_VAL_MAX             (1811u)     /*!< The channel value sent for 2012 us.                    */
+
+#define SBUS_FLAG_CH17              (0x01u)     /*!< The digital channel 17.                                */
+#define SBUS_FLAG_CH18              (0x02u)     /*!< The digital channel 18.                                */
+#define SBUS_FLAG_FRAME_LOST        (0x04u)     /*!< The receiver has lost the frame from the radio.        */
+#define SBUS_FLAG_FAILSAFE          (0x08u)     /*!< The receiver is in the failsafe.                       */
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+///
+/// \brief The SBUS receiver counters.
+///
+struct sbus_cnt
+{
+    uint32_t frame;                             /*!< The valid frames.                                      */
+    uint32_t lost;                              /*!< The valid frames with the frame lost flag.             */
+    uint32_t failsafe;                          /*!< The valid frames with the failsafe flag.               */
+    uint32_t err;                               /*!< The frames dropped because of the invalid footer.      */
+    uint32_t trunc;                             /*!< The frames cut off by the idle line.                   */
+};
+
+///
+/// \brief The SBUS frame callback type.
+///
+/// The callback is executed from the context which feeds the parser (the reception interrupt on
+/// target), once per valid frame.
+///
+/// \param[in] arg The argument given during the initialization.
+///
+typedef void (*sbus_cb_t)(void *const arg);
+
+///
+/// \brief The SBUS structure.
+///
+struct sbus
+{
+    uint8_t buf[SBUS_FRAME_SIZE];
+    uint32_t pos;
+    uint16_t ch[SBUS_CH_TOTAL];
+    uint8_t flags;
+    struct sbus_cnt cnt;
+    sbus_cb_t cb;
+    void *arg;
+};
+
+///
+/// \brief Initializes the SBUS parser.
+///
+/// \param[in] handle The pointer to the SBUS structure.
+/// \param[in] cb     The frame callback, may be NULL.
+/// \param[in] arg    The callback argument.
+///
+void sbus_init(struct sbus *const handle, const sbus_cb_t cb, void *const arg);
+
+///
+/// \brief Feeds the received bytes into the parser.
+///
+/// The header byte may also appear inside the channel data, so the parser relies on the idle line
+/// between the frames to find the frame start.
+///
+/// \param[in] handle The pointer to the SBUS structure.
+/// \param[in] data   The received bytes.
+/// \param[in] len    The number of received bytes.
+///
+void sbus_rx(struct sbus *const handle, const uint8_t *const data, const uint32_t len);
+
+///
+/// \brief Signals the idle line, an incomplete frame is discarded.
+///
+/// \param[in] handle The pointer to the SBUS structure.
+///
+void sbus_rx_idle(struct sbus *const handle);
+
+///
+/// \brief Unpacks the 16 little-endian 11-bit channels.
+///
+/// \param[in]  data The 22 channel bytes of the frame.
+/// \param[out] ch   The unpacked channel values.
+///
+void sbus_ch_unpack(const uint8_t *const data, uint16_t *const ch);
+
+///
+/// \brief Converts the channel value to the pulse width.
+///
+/// \param[in] val The channel value.
+///
+/// \return uint32_t The equivalent pulse width in microseconds.
+///
+uint32_t sbus_ch_to_us(const uint16_t val);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _SBUS_H */
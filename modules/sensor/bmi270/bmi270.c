@@ -494,6 +494,33 @@ bmi270_res_t bmi270_init(void)
     return BMI270_RES_OK;
 }
 
+bmi270_res_t bmi270_resume(void)
+{
+    struct bmi270_dev *dev = &bmi270;
+
+    uint8_t byte;
+
+    memset(&dev->acc,  0, sizeof(dev->acc));
+    memset(&dev->gyr,  0, sizeof(dev->gyr));
+    memset(&dev->temp, 0, sizeof(dev->temp));
+
+    ll_bmi270_spi_reg_read_byte(&dev->spi_conf, BMI270_REG_CHIP_ID, &byte);
+    if (byte != BMI270_POR_CHIP_ID)
+    {
+        return BMI270_RES_ERR;
+    }
+
+    ll_bmi270_spi_reg_read_byte(&dev->spi_conf, BMI270_REG_INST, &byte);
+    if ((byte & BMI270_INST_MSG_MSK) != BMI270_INST_MSG_INIT_OK)
+    {
+        return BMI270_RES_ERR;
+    }
+
+    dev->stat = BMI270_STAT_INIT;
+
+    return BMI270_RES_OK;
+}
+
 void bmi270_deinit(void)
 {
     struct bmi270_dev *dev = &bmi270;
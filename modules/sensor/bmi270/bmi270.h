@@ -387,6 +387,18 @@ const struct bmi270_pwr_mode_conf* bmi270_pwr_mode_get_conf(const bmi270_pwr_mod
 ///
 bmi270_res_t bmi270_init(void);
 
+///
+/// \brief Resumes the BMI270 initialized before the warm reset of the MCU.
+///
+/// The IMU keeps its power and its config file over the warm reset, the config load must not be
+/// completed twice after its POR.
+///
+/// \return bmi270_res_t   The BMI270 result.
+/// \retval BMI270_RES_OK  If the config file is loaded already.
+/// \retval BMI270_RES_ERR Otherwise, the BMI270 has to be initialized.
+///
+bmi270_res_t bmi270_resume(void);
+
 ///
 /// \brief Deinitializes the BMI270.
 ///
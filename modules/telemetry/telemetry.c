@@ -0,0 +1,370 @@
+#include "ahrs.h"
+#include "ghf.h"
+#include "rc.h"
+#include "telemetry.h"
+#include <stddef.h>
+#include <string.h>
+
+///***********************************************************************************************************
+/// Private objects - declaration.
+///***********************************************************************************************************
+///
+/// \brief The message schedule structure.
+///
+struct telemetry_slot
+{
+    uint32_t divider;                       /*!< The control cycles per message, 0 if off.            */
+    uint32_t count;
+    uint8_t  due;
+};
+
+///
+/// \brief The frame writer structure, the bytes go straight into the reserved sink space.
+///
+struct telemetry_cursor
+{
+    uint8_t  *data;
+    uint32_t left;                          /*!< The reserved bytes not written yet.                  */
+    uint32_t size;                          /*!< The bytes written since the last commit.             */
+    uint16_t crc;
+};
+
+///
+/// \brief The telemetry structure.
+///
+struct telemetry
+{
+    const struct telemetry_sink *sink;
+    const struct telemetry_boot *boot;
+    uint32_t                    loop_hz;
+    struct telemetry_slot       slot[TELEMETRY_MSG_TOTAL];
+    uint32_t                    next;       /*!< The message checked first, round robin.              */
+    uint8_t                     seq;
+    telemetry_stats_t           stats;
+};
+
+///***********************************************************************************************************
+/// Private objects - definition.
+///***********************************************************************************************************
+///
+/// \brief The telemetry object.
+///
+static struct telemetry telemetry;
+
+///
+/// \brief The payload sizes.
+///
+static const uint8_t telemetry_payload[TELEMETRY_MSG_TOTAL] =
+{
+    [TELEMETRY_MSG_ATTITUDE] = 3 * sizeof(float32_t),
+    [TELEMETRY_MSG_RATES]    = 3 * sizeof(int16_t),
+    [TELEMETRY_MSG_RC]       = TELEMETRY_RC_TOTAL * sizeof(int16_t),
+    [TELEMETRY_MSG_MOTORS]   = 4 * sizeof(uint16_t),
+    [TELEMETRY_MSG_LOOP]     = 3 * sizeof(uint32_t),
+    [TELEMETRY_MSG_BOOT]     = (TIMING_BOOT_STAGE_TOTAL_SIZE + 2) * sizeof(uint32_t),
+};
+
+///
+/// \brief The CRC-16/CCITT-FALSE table, a nibble at a time.
+///
+static const uint16_t telemetry_crc_table[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
+};
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief Writes the byte, moves on to the space reserved at the sink start when the first part is full.
+///
+/// \param[in,out] cursor The frame writer.
+/// \param[in]     byte   The byte.
+///
+static void put_u8(struct telemetry_cursor *const cursor, const uint8_t byte);
+
+///
+/// \brief Writes the byte and adds it to the CRC.
+///
+/// \param[in,out] cursor The frame writer.
+/// \param[in]     byte   The byte.
+///
+static void put_crc_u8(struct telemetry_cursor *const cursor, const uint8_t byte);
+
+///
+/// \brief Writes the little-endian 16-bit value.
+///
+/// \param[in,out] cursor The frame writer.
+/// \param[in]     value  The value.
+///
+static void put_u16(struct telemetry_cursor *const cursor, const uint16_t value);
+
+///
+/// \brief Writes the little-endian 32-bit value.
+///
+/// \param[in,out] cursor The frame writer.
+/// \param[in]     value  The value.
+///
+static void put_u32(struct telemetry_cursor *const cursor, const uint32_t value);
+
+///
+/// \brief Writes the float as its little-endian bits.
+///
+/// \param[in,out] cursor The frame writer.
+/// \param[in]     value  The value.
+///
+static void put_f32(struct telemetry_cursor *const cursor, const float32_t value);
+
+///
+/// \brief Writes the message payload from the module state.
+///
+/// \param[in,out] cursor The frame writer.
+/// \param[in]     msg    The message.
+/// \param[in]     handle The pointer to ghf.
+///
+static void payload_put(struct telemetry_cursor *const cursor, const telemetry_msg_t msg,
+                        const struct ghf *const handle);
+
+///
+/// \brief Sends the message frame, the sink holds it whole.
+///
+/// \param[in] msg    The message.
+/// \param[in] handle The pointer to ghf.
+///
+static void frame_send(const telemetry_msg_t msg, const struct ghf *const handle);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static void put_u8(struct telemetry_cursor *const cursor, const uint8_t byte)
+{
+    /* The frame crossing the ring end is queued in two parts, nothing else is written in between. */
+    if (cursor->left == 0)
+    {
+        telemetry.sink->commit(cursor->size);
+        cursor->size = 0;
+        cursor->left = telemetry.sink->reserve(&cursor->data);
+    }
+
+    cursor->data[cursor->size++] = byte;
+    cursor->left--;
+}
+
+static void put_crc_u8(struct telemetry_cursor *const cursor, const uint8_t byte)
+{
+    uint16_t crc = cursor->crc;
+
+    crc = (uint16_t)(crc << 4) ^ telemetry_crc_table[(crc >> 12) ^ (byte >> 4)];
+    crc = (uint16_t)(crc << 4) ^ telemetry_crc_table[(crc >> 12) ^ (byte & 0x0fu)];
+
+    cursor->crc = crc;
+    put_u8(cursor, byte);
+}
+
+static void put_u16(struct telemetry_cursor *const cursor, const uint16_t value)
+{
+    put_crc_u8(cursor, (uint8_t)(value >> 0));
+    put_crc_u8(cursor, (uint8_t)(value >> 8));
+}
+
+static void put_u32(struct telemetry_cursor *const cursor, const uint32_t value)
+{
+    put_crc_u8(cursor, (uint8_t)(value >>  0));
+    put_crc_u8(cursor, (uint8_t)(value >>  8));
+    put_crc_u8(cursor, (uint8_t)(value >> 16));
+    put_crc_u8(cursor, (uint8_t)(value >> 24));
+}
+
+static void put_f32(struct telemetry_cursor *const cursor, const float32_t value)
+{
+    uint32_t bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+    put_u32(cursor, bits);
+}
+
+static void payload_put(struct telemetry_cursor *const cursor, const telemetry_msg_t msg,
+                        const struct ghf *const handle)
+{
+    const struct rc *const rc[TELEMETRY_RC_TOTAL] =
+    {
+        handle->module.rc_1, handle->module.rc_2, handle->module.rc_3,
+        handle->module.rc_4, handle->module.rc_5, handle->module.rc_6,
+    };
+
+    switch (msg)
+    {
+    case TELEMETRY_MSG_ATTITUDE:
+        put_f32(cursor, handle->module.ahrs->out.roll);
+        put_f32(cursor, handle->module.ahrs->out.pitch);
+        put_f32(cursor, handle->module.ahrs->out.yaw);
+        break;
+    case TELEMETRY_MSG_RATES:
+        put_u16(cursor, (uint16_t)handle->data.raw_data.gx);
+        put_u16(cursor, (uint16_t)handle->data.raw_data.gy);
+        put_u16(cursor, (uint16_t)handle->data.raw_data.gz);
+        break;
+    case TELEMETRY_MSG_RC:
+        for (uint32_t i = 0; i < TELEMETRY_RC_TOTAL; i++)
+        {
+            put_u16(cursor, (uint16_t)(int16_t)(rc[i]->sig.norm * TELEMETRY_RC_SCALE));
+        }
+        break;
+    case TELEMETRY_MSG_MOTORS:
+        put_u16(cursor, (uint16_t)handle->data.pwm1);
+        put_u16(cursor, (uint16_t)handle->data.pwm2);
+        put_u16(cursor, (uint16_t)handle->data.pwm3);
+        put_u16(cursor, (uint16_t)handle->data.pwm4);
+        break;
+    case TELEMETRY_MSG_LOOP:
+        put_u32(cursor, handle->data.time.total);
+        put_u32(cursor, telemetry.stats.cycles);
+        put_u32(cursor, telemetry.stats.dropped);
+        break;
+    case TELEMETRY_MSG_BOOT:
+        for (uint32_t i = 0; i < TIMING_BOOT_STAGE_TOTAL_SIZE; i++)
+        {
+            put_u32(cursor, telemetry.boot->stage_us[i]);
+        }
+        put_u32(cursor, telemetry.boot->reason);
+        put_u32(cursor, telemetry.boot->reset_cause);
+        break;
+    default:
+        break;
+    }
+}
+
+static void frame_send(const telemetry_msg_t msg, const struct ghf *const handle)
+{
+    struct telemetry_cursor cursor;
+
+    cursor.size = 0;
+    cursor.crc  = 0xffff;
+    cursor.left = telemetry.sink->reserve(&cursor.data);
+
+    put_u8(&cursor, TELEMETRY_SYNC_1);
+    put_u8(&cursor, TELEMETRY_SYNC_2);
+    put_crc_u8(&cursor, (uint8_t)msg);
+    put_crc_u8(&cursor, telemetry_payload[msg]);
+    put_crc_u8(&cursor, telemetry.seq++);
+
+    payload_put(&cursor, msg, handle);
+
+    put_u8(&cursor, (uint8_t)(cursor.crc >> 0));
+    put_u8(&cursor, (uint8_t)(cursor.crc >> 8));
+
+    telemetry.sink->commit(cursor.size);
+}
+
+///***********************************************************************************************************
+/// Global functions - definition.
+///***********************************************************************************************************
+void telemetry_init(const struct telemetry_sink *const sink, const struct telemetry_boot *const boot,
+                    const uint32_t loop_hz)
+{
+    memset(&telemetry, 0, sizeof(telemetry));
+
+    telemetry.sink    = sink;
+    telemetry.boot    = boot;
+    telemetry.loop_hz = loop_hz;
+}
+
+void telemetry_rate_set(const telemetry_msg_t msg, const uint32_t hz)
+{
+    if ((uint32_t)msg >= TELEMETRY_MSG_TOTAL)
+    {
+        return;
+    }
+
+    struct telemetry_slot *slot = &telemetry.slot[msg];
+
+    if ((hz == 0) || (telemetry.loop_hz == 0))
+    {
+        slot->divider = 0;
+    }
+    else
+    {
+        slot->divider = (hz < telemetry.loop_hz) ? ((telemetry.loop_hz + (hz / 2u)) / hz) : 1u;
+    }
+
+    slot->count = 0;
+    slot->due   = 0;
+}
+
+uint32_t telemetry_update(const struct ghf *const handle)
+{
+    uint32_t bytes = 0;
+    uint32_t msg   = telemetry.next;
+
+    if ((handle == NULL) || (telemetry.sink == NULL))
+    {
+        return 0;
+    }
+
+    telemetry.stats.cycles++;
+
+    for (uint32_t i = 0; i < TELEMETRY_MSG_TOTAL; i++)
+    {
+        struct telemetry_slot *slot = &telemetry.slot[i];
+
+        if ((slot->divider == 0) || (++slot->count < slot->divider))
+        {
+            continue;
+        }
+
+        slot->count = 0;
+        telemetry.stats.late += slot->due;
+        slot->due = ((i != TELEMETRY_MSG_BOOT) || (telemetry.boot != NULL)) ? 1 : 0;
+    }
+
+    /* The budget bounds the time spent here, the messages left over go first the next cycle. */
+    for (uint32_t i = 0; i < TELEMETRY_MSG_TOTAL; i++, msg = (msg + 1u) % TELEMETRY_MSG_TOTAL)
+    {
+        uint32_t size = TELEMETRY_HEADER_SIZE + telemetry_payload[msg] + TELEMETRY_CRC_SIZE;
+
+        if (telemetry.slot[msg].due == 0)
+        {
+            continue;
+        }
+
+        if ((bytes + size) > TELEMETRY_BUDGET)
+        {
+            break;
+        }
+
+        telemetry.slot[msg].due = 0;
+
+        /* The link is behind, the frame is dropped whole and the receiver sees the sequence gap. */
+        if (telemetry.sink->space() < size)
+        {
+            telemetry.stats.dropped++;
+            telemetry.seq++;
+            continue;
+        }
+
+        frame_send((telemetry_msg_t)msg, handle);
+        bytes += size;
+        telemetry.stats.frames++;
+    }
+
+    telemetry.next        = msg;
+    telemetry.stats.bytes += bytes;
+
+    return bytes;
+}
+
+uint32_t telemetry_payload_size(const telemetry_msg_t msg)
+{
+    if ((uint32_t)msg >= TELEMETRY_MSG_TOTAL)
+    {
+        return 0;
+    }
+
+    return telemetry_payload[msg];
+}
+
+const telemetry_stats_t* telemetry_stats_get(void)
+{
+    return &telemetry.stats;
+}
@@ -0,0 +1,125 @@
+#ifndef _TELEMETRY_H
+#define _TELEMETRY_H
+
+#include "timing.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+#define TELEMETRY_SYNC_1        (0xa5u)         /*!< The first frame byte.                             */
+#define TELEMETRY_SYNC_2        (0x5au)         /*!< The second frame byte.                            */
+#define TELEMETRY_HEADER_SIZE   (5u)            /*!< The sync bytes, the id, the length, the sequence. */
+#define TELEMETRY_CRC_SIZE      (2u)            /*!< The CRC-16/CCITT-FALSE of the id to the payload.  */
+#define TELEMETRY_RC_SCALE      (10000.0f)      /*!< The RC signals are sent in 1/10000.               */
+#define TELEMETRY_RC_TOTAL      (6u)            /*!< The RC channels sent.                             */
+
+///
+/// \brief The bytes serialized per control cycle at most, the due messages past it wait for the next one.
+///
+#ifndef TELEMETRY_BUDGET
+#define TELEMETRY_BUDGET        (64u)
+#endif  /* TELEMETRY_BUDGET */
+
+///
+/// \brief The telemetry message type, the frame id.
+///
+/// \note scripts/telemetry_receive.py keeps the same ids and payloads.
+///
+typedef enum
+{
+    TELEMETRY_MSG_ATTITUDE = 0,             /*!< The AHRS roll, pitch and yaw, f32 in degrees.          */
+    TELEMETRY_MSG_RATES,                    /*!< The calibrated gyroscope samples, i16.                 */
+    TELEMETRY_MSG_RC,                       /*!< The normalized RC signals, i16 in 1/10000.             */
+    TELEMETRY_MSG_MOTORS,                   /*!< The motor outputs, u16 in us.                          */
+    TELEMETRY_MSG_LOOP,                     /*!< The loop duration in us, the cycle, the dropped ones.  */
+    TELEMETRY_MSG_BOOT,                     /*!< The boot stage durations in us, the reason, the reset. */
+    TELEMETRY_MSG_TOTAL,
+} telemetry_msg_t;
+
+///
+/// \brief The telemetry sink type, the transmission ring the frames are serialized into in place.
+///
+struct telemetry_sink
+{
+    uint32_t (*space)(void);                            /*!< The free bytes.                            */
+    uint32_t (*reserve)(uint8_t **const data);          /*!< The free bytes back to back.               */
+    void (*commit)(const uint32_t len);                 /*!< Queues the bytes written in place.         */
+};
+
+///
+/// \brief The boot statistics type, filled once by the app.
+///
+struct telemetry_boot
+{
+    uint32_t stage_us[TIMING_BOOT_STAGE_TOTAL_SIZE];
+    uint32_t reason;
+    uint32_t reset_cause;
+};
+
+///
+/// \brief The telemetry statistics type.
+///
+typedef struct
+{
+    uint32_t cycles;                        /*!< The updates.                                          */
+    uint32_t frames;                        /*!< The sent frames.                                      */
+    uint32_t bytes;                         /*!< The sent bytes.                                       */
+    uint32_t dropped;                       /*!< The frames which did not fit the sink.                */
+    uint32_t late;                          /*!< The frames due again before the budget let them out.  */
+} telemetry_stats_t;
+
+struct ghf;
+
+///
+/// \brief Starts the telemetry with every message off.
+///
+/// \param[in] sink    The sink, kept by the telemetry.
+/// \param[in] boot    The boot statistics, kept by the telemetry, NULL if unknown.
+/// \param[in] loop_hz The control loop rate.
+///
+void telemetry_init(const struct telemetry_sink *const sink, const struct telemetry_boot *const boot,
+                    const uint32_t loop_hz);
+
+///
+/// \brief Sets the message rate, rounded to a whole divider of the loop rate.
+///
+/// \param[in] msg The message.
+/// \param[in] hz  The rate, 0 turns the message off.
+///
+void telemetry_rate_set(const telemetry_msg_t msg, const uint32_t hz);
+
+///
+/// \brief Sends the due messages, called once per control cycle, never blocks.
+///
+/// The messages are serialized straight from the module state into the sink, up to TELEMETRY_BUDGET
+/// bytes. The due messages past the budget go first in the next cycle.
+///
+/// \param[in] handle The pointer to ghf.
+///
+/// \return uint32_t The count of the bytes queued.
+///
+uint32_t telemetry_update(const struct ghf *const handle);
+
+///
+/// \brief Gets the payload size of the message.
+///
+/// \param[in] msg The message.
+///
+/// \return uint32_t The payload size, 0 for an unknown message.
+///
+uint32_t telemetry_payload_size(const telemetry_msg_t msg);
+
+///
+/// \brief Gets the telemetry statistics.
+///
+/// \return const telemetry_stats_t* The statistics.
+///
+const telemetry_stats_t* telemetry_stats_get(void);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _TELEMETRY_H */
@@ -2,6 +2,21 @@
 #include "ll_tim_advx.h"
 #include "ll_tim_common.h"
 #include "ll_tim_gpx.h"
+#include <stddef.h>
+
+#define TIM_CAP_CH_TOTAL    (4u)
+
+///***********************************************************************************************************
+/// Private objects - declaration.
+///***********************************************************************************************************
+///
+/// \brief The TIM input capture callback entry.
+///
+struct tim_cap
+{
+    tim_cap_cb_t cb;
+    void *arg;
+};
 
 ///***********************************************************************************************************
 /// Private objects - definition.
@@ -771,6 +786,36 @@ static struct tim_dev tim_dev_arr[TIM_INST_TOTAL] =
     },
 };
 
+///
+/// \brief The TIM input capture callbacks.
+///
+static struct tim_cap tim_cap_arr[TIM_INST_TOTAL][TIM_CAP_CH_TOTAL];
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief Notifies the registered callback about the new capture.
+///
+/// \param[in] inst The TIM instance identifier.
+/// \param[in] ch   The TIM capture/compare channel.
+/// \param[in] ccr  The captured counter value.
+///
+static inline void cap_notify(const tim_inst_t inst, const ll_tim_ccr_ch_t ch, const uint32_t ccr);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static inline void cap_notify(const tim_inst_t inst, const ll_tim_ccr_ch_t ch, const uint32_t ccr)
+{
+    struct tim_cap *cap = &tim_cap_arr[inst][ch];
+
+    if (cap->cb != NULL)
+    {
+        cap->cb(cap->arg, ccr);
+    }
+}
+
 ///***********************************************************************************************************
 /// Global functions - definition.
 ///***********************************************************************************************************
@@ -785,6 +830,8 @@ void _tim8brktim12_handler(void)
 
         tim->ccr_data[LL_TIM_CCR_CH1].prev = tim->ccr_data[LL_TIM_CCR_CH1].curr;
         tim->ccr_data[LL_TIM_CCR_CH1].curr = curr;
+
+        cap_notify(TIM_INST_12, LL_TIM_CCR_CH1, curr);
     }
 
     if (tim->rmap->sr.bf.cc2if)
@@ -793,6 +840,8 @@ void _tim8brktim12_handler(void)
 
         tim->ccr_data[LL_TIM_CCR_CH2].prev = tim->ccr_data[LL_TIM_CCR_CH2].curr;
         tim->ccr_data[LL_TIM_CCR_CH2].curr = curr;
+
+        cap_notify(TIM_INST_12, LL_TIM_CCR_CH2, curr);
     }
 }
 
@@ -807,6 +856,8 @@ void _tim8cc_handler(void)
 
         tim->ccr_data[LL_TIM_CCR_CH1].prev = tim->ccr_data[LL_TIM_CCR_CH1].curr;
         tim->ccr_data[LL_TIM_CCR_CH1].curr = curr;
+
+        cap_notify(TIM_INST_8, LL_TIM_CCR_CH1, curr);
     }
 
     if (tim->rmap->sr.bf.cc2if)
@@ -815,6 +866,8 @@ void _tim8cc_handler(void)
 
         tim->ccr_data[LL_TIM_CCR_CH2].prev = tim->ccr_data[LL_TIM_CCR_CH2].curr;
         tim->ccr_data[LL_TIM_CCR_CH2].curr = curr;
+
+        cap_notify(TIM_INST_8, LL_TIM_CCR_CH2, curr);
     }
 
     if (tim->rmap->sr.bf.cc3if)
@@ -823,6 +876,8 @@ void _tim8cc_handler(void)
 
         tim->ccr_data[LL_TIM_CCR_CH3].prev = tim->ccr_data[LL_TIM_CCR_CH3].curr;
         tim->ccr_data[LL_TIM_CCR_CH3].curr = curr;
+
+        cap_notify(TIM_INST_8, LL_TIM_CCR_CH3, curr);
     }
 
     if (tim->rmap->sr.bf.cc4if)
@@ -831,6 +886,8 @@ void _tim8cc_handler(void)
 
         tim->ccr_data[LL_TIM_CCR_CH4].prev = tim->ccr_data[LL_TIM_CCR_CH4].curr;
         tim->ccr_data[LL_TIM_CCR_CH4].curr = curr;
+
+        cap_notify(TIM_INST_8, LL_TIM_CCR_CH4, curr);
     }
 }
 
@@ -857,3 +914,19 @@ void tim_init(void)
         tim_dev_arr[i].enable(tim_dev_arr[i].tim);
     }
 }
+
+tim_res_t tim_cap_cb_set(const tim_inst_t inst, const ll_tim_ccr_ch_t ch, const tim_cap_cb_t cb, void *const arg)
+{
+    if ((inst < TIM_INST_BEGIN) || (inst >= TIM_INST_TOTAL) || (ch < LL_TIM_CCR_CH1) ||
+        (ch >= (ll_tim_ccr_ch_t)TIM_CAP_CH_TOTAL))
+    {
+        return TIM_RES_ERR;
+    }
+
+    /* Disarm first, so the interrupt never sees a new callback with an old argument. */
+    tim_cap_arr[inst][ch].cb  = NULL;
+    tim_cap_arr[inst][ch].arg = arg;
+    tim_cap_arr[inst][ch].cb  = cb;
+
+    return TIM_RES_OK;
+}
@@ -29,6 +29,17 @@ typedef enum tim_inst
     TIM_INST_TOTAL,
 } tim_inst_t;
 
+///
+/// \brief The TIM input capture callback type.
+///
+/// The callback is executed from the TIM capture/compare interrupt, so it has to be short and
+/// must not block.
+///
+/// \param[in] arg The argument given during the callback registration.
+/// \param[in] ccr The captured counter value.
+///
+typedef void (*tim_cap_cb_t)(void *const arg, const uint32_t ccr);
+
 ///
 /// \brief The TIM device.
 ///
@@ -64,6 +75,20 @@ struct tim_dev* tim_dev_arr_get(void);
 ///
 void tim_init(void);
 
+///
+/// \brief Registers the input capture callback for the given TIM channel.
+///
+/// \param[in] inst The TIM instance identifier.
+/// \param[in] ch   The TIM capture/compare channel.
+/// \param[in] cb   The callback, NULL unregisters the current one.
+/// \param[in] arg  The argument passed to the callback.
+///
+/// \return tim_res_t   The TIM result.
+/// \retval TIM_RES_OK  On success.
+/// \retval TIM_RES_ERR Otherwise.
+///
+tim_res_t tim_cap_cb_set(const tim_inst_t inst, const ll_tim_ccr_ch_t ch, const tim_cap_cb_t cb, void *const arg);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
@@ -49,10 +49,6 @@ void vtol_take_off_proc(void)
     struct rc_sig *pitch    = &rc_2->sig;
     struct rc_sig *throttle = &rc_3->sig;
 
-    rc_sig_raw_gen(rc_1);
-    rc_sig_raw_gen(rc_2);
-    rc_sig_raw_gen(rc_3);
-
     if ((phase->stat == VTOL_STAT_OFF) && (throttle->raw < 1200))
     {
         switch (phase->step.take_off)
@@ -103,10 +99,6 @@ void vtol_land_proc(void)
     struct rc_sig *pitch    = &rc_2->sig;
     struct rc_sig *throttle = &rc_3->sig;
 
-    rc_sig_raw_gen(rc_1);
-    rc_sig_raw_gen(rc_2);
-    rc_sig_raw_gen(rc_3);
-    
     if ((phase->stat == VTOL_STAT_ON) && (throttle->raw < 1200))
     {
         switch (phase->step.land)
@@ -146,6 +138,15 @@ void vtol_land_proc(void)
     }
 }
 
+void vtol_disarm(void)
+{
+    struct vtol_phase *phase = &ghf_vtol_phase;
+
+    phase->step.take_off = VTOL_TAKE_OFF_STEP_0;
+    phase->step.land     = VTOL_LAND_STEP_0;
+    phase->stat          = VTOL_STAT_OFF;
+}
+
 vtol_stat_t vtol_stat_get(void)
 {
     struct vtol_phase *phase = &ghf_vtol_phase;
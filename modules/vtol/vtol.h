@@ -78,6 +78,15 @@ void vtol_take_off_proc(void);
 ///
 void vtol_land_proc(void);
 
+///
+/// \brief Disarms at once, without the landing procedure.
+///
+/// Sets the VTOL status to inactive and restarts both stick
+/// sequences. It is meant for the RC link loss, when the sticks
+/// can not be trusted to perform the landing procedure.
+///
+void vtol_disarm(void);
+
 ///
 /// \brief Gets VTOL status.
 ///
@@ -0,0 +1,79 @@
+import json
+import os
+import sys
+
+"""
+@brief The slowdown in percent over which a benchmark is reported as the regression.
+"""
+BENCHMARK_THRESHOLD = 5.0
+
+
+def benchmark_load(path):
+    """
+    @brief Loads the Google Benchmark JSON reports: one file or the directory benchmark_run.sh wrote.
+
+    @param path The report file or directory.
+
+    @return The CPU time in nanoseconds by the benchmark name, the median of the repetitions if they
+            were aggregated.
+    """
+    files = [os.path.join(path, name) for name in sorted(os.listdir(path)) if name.endswith('.json')] \
+        if os.path.isdir(path) else [path]
+    times = {}
+
+    for file_path in files:
+        with open(file_path, 'r') as file:
+            report = json.load(file)
+
+        scale = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+        for benchmark in report['benchmarks']:
+            if benchmark.get('error_occurred', False):
+                continue
+
+            # The median is steadier than the mean, the other aggregates are skipped.
+            if benchmark.get('run_type') == 'aggregate':
+                if benchmark.get('aggregate_name') != 'median':
+                    continue
+                name = benchmark['run_name']
+            else:
+                name = benchmark['name']
+                if name in times:
+                    continue
+
+            times[name] = benchmark['cpu_time'] * scale[benchmark.get('time_unit', 'ns')]
+
+    return times
+
+
+if (__name__ == '__main__'):
+    if (len(sys.argv) not in (3, 4)):
+        print("Usage: benchmark_compare.py <old report or dir> <new report or dir> [threshold %]")
+        sys.exit(1)
+
+    old = benchmark_load(sys.argv[1])
+    new = benchmark_load(sys.argv[2])
+    threshold = float(sys.argv[3]) if (len(sys.argv) == 4) else BENCHMARK_THRESHOLD
+    regressions = 0
+
+    print("{:<40} {:>12} {:>12} {:>9}".format('benchmark', 'old [ns]', 'new [ns]', 'change'))
+
+    for name in sorted(set(old) | set(new)):
+        if (name not in old) or (name not in new):
+            print("{:<40} {:>12} {:>12}".format(name, '%.1f' % old[name] if name in old else '-',
+                                                '%.1f' % new[name] if name in new else '-'))
+            continue
+
+        change = ((new[name] - old[name]) / old[name]) * 100.0
+        mark = ''
+
+        if change > threshold:
+            mark = ' slower'
+            regressions += 1
+        elif change < -threshold:
+            mark = ' faster'
+
+        print("{:<40} {:>12.1f} {:>12.1f} {:>+8.1f}%{}".format(name, old[name], new[name], change, mark))
+
+    print("Benchmark: " + str(regressions) + " slower by more than " + str(threshold) + " %", file=sys.stderr)
+    sys.exit(1 if regressions > 0 else 0)
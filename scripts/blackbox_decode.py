@@ -0,0 +1,151 @@
+import csv
+import struct
+import sys
+
+"""
+@brief The log header magic, modules/blackbox/blackbox.h BLACKBOX_MAGIC.
+"""
+BLACKBOX_MAGIC = 0x42424647
+
+"""
+@brief The field layout version, modules/blackbox/blackbox.h BLACKBOX_VERSION.
+"""
+BLACKBOX_VERSION = 1
+
+"""
+@brief The float scale, modules/blackbox/blackbox.h BLACKBOX_FLOAT_SCALE.
+"""
+BLACKBOX_FLOAT_SCALE = 10000.0
+
+"""
+@brief The frame types, modules/blackbox/blackbox.h BLACKBOX_FRAME_KEY and BLACKBOX_FRAME_DELTA.
+"""
+BLACKBOX_FRAME_KEY = 0x49
+BLACKBOX_FRAME_DELTA = 0x50
+
+"""
+@brief The fields in the logged order, modules/blackbox/blackbox.h blackbox_field_t, and whether
+       they are scaled floats.
+"""
+BLACKBOX_FIELDS = [
+    ('time_start', False), ('time_total', False),
+    ('roll', True), ('pitch', True), ('throttle', True), ('yaw', True),
+    ('pwm1', False), ('pwm2', False), ('pwm3', False), ('pwm4', False),
+    ('ax', False), ('ay', False), ('az', False),
+    ('gx', False), ('gy', False), ('gz', False),
+    ('calib_gx', False), ('calib_gy', False), ('calib_gz', False),
+    ('roll_p', True), ('roll_i', True), ('roll_d', True),
+    ('pitch_p', True), ('pitch_i', True), ('pitch_d', True),
+    ('yaw_p', True), ('yaw_i', True), ('yaw_d', True),
+]
+
+
+def varint_get(data, offset):
+    """
+    @brief Reads the zig-zag varint of the field change.
+
+    @param data The log.
+    @param offset The varint offset.
+    @return The signed change and the offset past the varint, None if the log ends inside it.
+    """
+    value = 0
+    shift = 0
+
+    while (offset < len(data)) and (shift < 35):
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7f) << shift
+        shift += 7
+
+        if ((byte & 0x80) == 0):
+            return ((value >> 1) ^ -(value & 1)), offset
+
+    return None
+
+
+def to_int32(value):
+    """
+    @brief Wraps the value to the signed 32-bit range the recorder calculates in.
+    """
+    value &= 0xffffffff
+    return value - 0x100000000 if (value & 0x80000000) else value
+
+
+def blackbox_decode(data):
+    """
+    @brief Decodes the log into the frames of the field values.
+
+    The decoding stops at the frame cut by the end of the log, the recorder drops the frames which
+    do not fit whole.
+
+    @param data The log, the header first.
+    @return The divider and the list of the frames, each a list of the raw field values.
+    """
+    if (len(data) < 8):
+        raise RuntimeError("No blackbox header")
+
+    magic, version, count, divider = struct.unpack_from('<IBBH', data, 0)
+    if (magic != BLACKBOX_MAGIC):
+        raise RuntimeError("No blackbox magic")
+    if ((version != BLACKBOX_VERSION) or (count != len(BLACKBOX_FIELDS))):
+        raise RuntimeError("Unknown blackbox version " + str(version) + " of " + str(count) + " fields")
+
+    frames = []
+    prev = None
+    offset = 8
+
+    while (offset < len(data)):
+        kind = data[offset]
+        if (kind == BLACKBOX_FRAME_KEY):
+            base = [0] * count
+        elif ((kind == BLACKBOX_FRAME_DELTA) and (prev is not None)):
+            base = prev
+        else:
+            raise RuntimeError("Unknown frame " + hex(kind) + " at " + hex(offset))
+
+        frame = []
+        position = offset + 1
+        for i in range(count):
+            result = varint_get(data, position)
+            if (result is None):
+                return divider, frames
+            delta, position = result
+            frame.append(to_int32(base[i] + delta))
+
+        frames.append(frame)
+        prev = frame
+        offset = position
+
+    return divider, frames
+
+
+def blackbox_csv(frames, file):
+    """
+    @brief Writes the frames as CSV, the scaled floats turned back into floats.
+
+    @param frames The frames.
+    @param file The text file.
+    """
+    writer = csv.writer(file)
+    writer.writerow([name for name, _ in BLACKBOX_FIELDS])
+
+    for frame in frames:
+        writer.writerow([(value / BLACKBOX_FLOAT_SCALE) if scaled else value
+                         for value, (_, scaled) in zip(frame, BLACKBOX_FIELDS)])
+
+
+if (__name__ == '__main__'):
+    if (len(sys.argv) not in (2, 3)):
+        print("Usage: blackbox_decode.py <log.bin> [log.csv]")
+        sys.exit(1)
+
+    with open(sys.argv[1], 'rb') as file:
+        divider, frames = blackbox_decode(file.read())
+
+    if (len(sys.argv) == 3):
+        with open(sys.argv[2], 'w', newline='') as file:
+            blackbox_csv(frames, file)
+    else:
+        blackbox_csv(frames, sys.stdout)
+
+    print("Blackbox: " + str(len(frames)) + " frames, every " + str(divider) + " cycles", file=sys.stderr)
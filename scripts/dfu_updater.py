@@ -1,6 +1,7 @@
 import sys
 import serial
 import time
+import zlib
 
 from elftools.elf.elffile import ELFFile
 from tqdm import tqdm
@@ -15,10 +16,41 @@ from dust_packet import DUST_OPCODE
 from dust_packet import DUST_LENGTH
 from dust_packet import DUST_ACK
 from dust_packet import DUST_ACK_FREQUENCY
+from dust_packet import DUST_ARQ_MODE
+from dust_packet import DUST_COMPRESSION
+from dust_packet import DUST_EXT_OPCODE
+from dust_packet import DUST_ARQ_SEQUENCE_SIZE
+from dust_packet import DUST_ARQ_WINDOW_MAX
 from dust_packet import DUST_PACKET_HEADER_SIZE
 from dust_packet import DUST_PACKET_CRC16_SIZE
 
 from dfu_updater_segment import dfu_updater_segment
+from dfu_updater_lz import lz_compress
+
+"""
+@brief Time to wait for the bitmap ACK before polling again, in seconds.
+"""
+DFU_UPDATER_POLL_TIMEOUT = 1.0
+
+"""
+@brief The block of the delta update, dfu/updater/delta.h DELTA_BLOCK_SIZE.
+"""
+DFU_UPDATER_DELTA_BLOCK_SIZE = 0x400
+
+"""
+@brief The largest payload the host sends, the device may advertise less.
+"""
+DFU_UPDATER_PAYLOAD_SIZE_MAX = 0x1000
+
+"""
+@brief The replies of the device are limited to the classic payload sizes.
+"""
+DFU_UPDATER_REPLY_SIZE_MAX = 0x100
+
+"""
+@brief The ITCM addresses the app slots are linked to, linkerscript/memory_map.ld rom_app and rom_app_b.
+"""
+DFU_UPDATER_SLOT_ADDRESSES = [0x00210000, 0x00220000]
 
 class dfu_updater:
     """
@@ -39,18 +71,29 @@ class dfu_updater:
         preparing default configurations for the dust protocol.
 
         @note The script expects the following arguments in order:
-              <bin> <port> <baudrate>.
+              <bin> <port> <baudrate> [<max baudrate>] [<other slot bin>].
+
+        The other slot bin is the same app linked to the other slot, it defaults to the '-b.elf'
+        sibling of the slot A image (and the reverse).
 
-        Example: python3 dfu_usart.py firmware.bin COM3 9600
+        Example: python3 dfu_usart.py firmware.bin COM3 115200 921600
         """
         if ( len(sys.argv) < 4 ):
-            print("Invalid usage: python3 dfu_usart.py <bin> <port> <baudrate>")
+            print("Invalid usage: python3 dfu_usart.py <bin> <port> <baudrate> [<max baudrate>] [<other slot bin>]")
             sys.exit()
         self.bin               = sys.argv[1]
         self.port              = sys.argv[2]
         self.baudrate          = sys.argv[3]
+        self.baudrate_max      = int(sys.argv[4]) if (len(sys.argv) > 4) else 921600
+        self.bin_other         = sys.argv[5] if (len(sys.argv) > 5) else self.sibling(self.bin)
+        self.slot              = 0
         self.text              = dfu_updater_segment(name = '.text', sections = [])
         self.usart             = None
+        self.stream            = []
+        self.compression       = DUST_COMPRESSION.NONE.value
+        self.delta             = 0
+        self.blocks            = []
+        self.resume            = 0
         self.instance          = dust_instance()
         self.length_hash_table = {
             0x20  : DUST_LENGTH.BYTES32.value,
@@ -109,13 +152,12 @@ class dfu_updater:
         """
         @brief Transmits serialized data over USART.
 
-        This method writes each byte from the serialized buffer of the dust instance
-        to the USART interface.
+        This method writes the serialized buffer of the dust instance to the USART interface
+        in one call, a write per byte costs a syscall and a USB transfer each.
 
         @note Ensure that the USART connection is initialized before calling this method.
         """
-        for byte in self.instance.serialized.buffer:
-            self.usart.write(byte.to_bytes(1, byteorder = 'big'))
+        self.usart.write(bytes(self.instance.serialized.buffer))
 
     def receive(self):
         """
@@ -127,13 +169,53 @@ class dfu_updater:
         @return DUST_RESULT.SUCCESS.value On successful deserialization and validation.
         @return DUST_RESULT.ERROR.value   If the packet is corrupted or deserialization fails.
         """
-        serialized_packet_size = DUST_PACKET_HEADER_SIZE + self.instance.options.payload_size + DUST_PACKET_CRC16_SIZE
+        reply_size = min(self.instance.options.payload_size, DFU_UPDATER_REPLY_SIZE_MAX)
+        serialized_packet_size = DUST_PACKET_HEADER_SIZE + reply_size + DUST_PACKET_CRC16_SIZE
         serialized_packet = self.usart.read(size=serialized_packet_size)
+        if (len(serialized_packet) != serialized_packet_size):
+            return DUST_RESULT.ERROR.value
         if (self.instance.packet.deserialize(serialized_packet) != DUST_RESULT.SUCCESS.value):
             return DUST_RESULT.ERROR.value
         return DUST_RESULT.SUCCESS.value
 
-    def connect(self, ack_frequency, payload_size):
+    def transmit_data(self, packet_number, ack):
+        """
+        @brief Transmits the data packet carrying the given part of the firmware.
+
+        @param packet_number The index of the packet within the firmware, sent modulo the 11-bit packet number.
+        @param ack           DUST_ACK.SET.value to poll the device for the ACK.
+        """
+        length = self.length()
+        self.instance.packet.header.create(DUST_OPCODE.DATA.value, length, ack, packet_number % DUST_ARQ_SEQUENCE_SIZE)
+        self.instance.packet.payload.create(buffer=self.fill_data(packet_number))
+        self.instance.packet.create(self.instance.packet.header, self.instance.packet.payload)
+        self.instance.serialized.create(buffer=self.instance.packet.serialize())
+        self.transmit()
+
+    def length(self):
+        """
+        @brief Gets the header length field of the payload size in use.
+
+        The negotiated payloads above 256 bytes carry DUST_LENGTH.BYTES256, the device frames them by
+        the negotiated size.
+
+        @return The header length field.
+        """
+        return self.length_hash_table.get(self.instance.options.payload_size, DUST_LENGTH.BYTES256.value)
+
+    def arq_window(self):
+        """
+        @brief Calculates the selective repeat window the same way the updater does.
+
+        The bitmap ACK has to fit into one payload, which limits the window besides the ack frequency.
+
+        @return The window size in packets.
+        """
+        window = self.ack_frequency_hash_table[self.instance.options.ack_frequency]
+        return min(window, self.instance.options.payload_size * 8, DUST_ARQ_WINDOW_MAX)
+
+    def connect(self, ack_frequency, payload_size, arq_mode = DUST_ARQ_MODE.SELECTIVE_REPEAT.value, delta = 0,
+                negotiate = 1):
         """
         @brief Establishes a connection using the dust protocol.
 
@@ -143,25 +225,149 @@ class dfu_updater:
 
         @param ack_frequency The acknowledgment frequency to be used during communication.
         @param payload_size  The size of the payload for each packet.
+        @param arq_mode      The retransmission mode.
+        @param delta         1 to transfer the blocks which differ from the installed image only.
+        @param negotiate     1 to switch to the largest payload and the fastest baud rate both sides support.
+
+        @return True if connected, False otherwise, the image linked to the active slot included.
 
         @note Ensure that the USART connection is initialized before calling this method.
         """
         if isinstance(self.usart, serial.Serial):
             print("\nTrying to connect...")
-            number_of_packets = self.calculate_number_of_packets(self.text.size, payload_size)
-            self.instance.options.create(ack_frequency, number_of_packets, payload_size)
+            self.delta = delta
+            number_of_packets = self.calculate_number_of_packets(len(self.stream), payload_size)
+            # Only the raw image is resumed, the updater does not journal the LZ decoder.
+            image_hash = 0
+            if ((self.compression == DUST_COMPRESSION.NONE.value) and (delta == 0)):
+                image_hash = zlib.crc32(bytes(self.text.converted_hexdata))
+            self.instance.options.create(ack_frequency, number_of_packets, payload_size, arq_mode,
+                                         self.compression, len(self.text.converted_hexdata), delta, negotiate,
+                                         image_hash, self.slot)
             self.instance.packet.header.create(DUST_OPCODE.CONNECT.value, DUST_LENGTH.BYTES32.value, DUST_ACK.UNSET.value, packet_number=0x00)
             self.instance.packet.payload.create(buffer=self.instance.options.serialize())
             self.instance.packet.create(self.instance.packet.header, self.instance.packet.payload)
             self.instance.serialized.create(buffer=self.instance.packet.serialize())
             self.transmit()
-            if (self.receive() == DUST_RESULT.SUCCESS.value):
+            result = self.receive()
+            # The updater programs the inactive slot only, the image linked to the active one is refused.
+            if ((result == DUST_RESULT.SUCCESS.value) and (self.instance.packet.header.bits.ack == DUST_ACK.UNSET.value) and
+                (self.instance.packet.payload.buffer[0] == DUST_EXT_OPCODE.SLOT.value)):
+                print("The image is linked to the active slot, the updater programs slot " +
+                      str(self.instance.packet.payload.buffer[1]))
+                return False
+            if (negotiate != 0):
+                if ((result != DUST_RESULT.SUCCESS.value) or (self.instance.packet.header.bits.ack != DUST_ACK.SET.value)):
+                    print("Capabilities were not received")
+                    return False
+                self.negotiate()
+                result = self.receive()
+            if (result == DUST_RESULT.SUCCESS.value):
                 if (self.instance.packet.header.bits.ack == DUST_ACK.SET.value):
+                    if (self.instance.packet.payload.buffer[0] == DUST_EXT_OPCODE.RESUME.value):
+                        self.resume = int.from_bytes(bytes(self.instance.packet.payload.buffer[1:5]), byteorder = 'big')
+                    if (negotiate != 0):
+                        self.apply_settings()
                     print("Connected")
+                    if (self.resume != 0):
+                        print("Resuming from packet " + str(self.resume))
+                    if (self.delta != 0):
+                        self.exchange_manifest()
+                    return True
                 else:
                     print("ACK was not received")
         else:
             print("Usart is not initialized...")
+        return False
+
+    def negotiate(self):
+        """
+        @brief Picks the link settings out of the capabilities received and sends them.
+
+        The capabilities carry the maximum payload size BE16, the number of baud rates and the baud
+        rates BE32. The largest payload and the fastest baud rate supported by both sides are picked,
+        the delta update keeps the payload within its blocks. Both sides switch once the device has
+        acknowledged the settings.
+        """
+        capabilities = self.instance.packet.payload.buffer
+        payload_size_max = (capabilities[1] << 0x08) | capabilities[2]
+        bauds = [int.from_bytes(bytes(capabilities[(4 + (i * 4)):(8 + (i * 4))]), byteorder = 'big')
+                 for i in range(capabilities[3])]
+        payload_size = min(payload_size_max, DFU_UPDATER_PAYLOAD_SIZE_MAX)
+        if (self.delta != 0):
+            payload_size = min(payload_size, DFU_UPDATER_DELTA_BLOCK_SIZE)
+        # The power of two keeps the delta blocks split into whole packets.
+        payload_size = 1 << (payload_size.bit_length() - 1)
+        baud = max([b for b in bauds if (b <= self.baudrate_max)], default = int(self.baudrate))
+        self.settings = (payload_size, baud, self.calculate_number_of_packets(len(self.stream), payload_size))
+        print("Capabilities: payload " + str(payload_size_max) + " bytes, bauds " + str(bauds))
+        payload = [DUST_EXT_OPCODE.SETTINGS.value, (payload_size >> 0x08) & 0xff, payload_size & 0xff]
+        payload.extend(baud.to_bytes(4, byteorder = 'big'))
+        payload.extend(self.settings[2].to_bytes(4, byteorder = 'big'))
+        payload.extend([0x00]*(self.instance.options.payload_size - len(payload)))
+        self.instance.packet.header.create(DUST_OPCODE.CONNECT.value, self.length(), DUST_ACK.UNSET.value, packet_number=0x00)
+        self.instance.packet.payload.create(buffer=payload)
+        self.instance.packet.create(self.instance.packet.header, self.instance.packet.payload)
+        self.instance.serialized.create(buffer=self.instance.packet.serialize())
+        self.transmit()
+
+    def apply_settings(self):
+        """
+        @brief Switches to the link settings acknowledged by the device.
+        """
+        payload_size, baud, number_of_packets = self.settings
+        self.instance.options.payload_size = payload_size
+        self.instance.options.number_of_packets = number_of_packets
+        self.usart.baudrate = baud
+        print("Settings: payload " + str(payload_size) + " bytes, baud " + str(baud))
+
+    def transmit_manifest(self, first, hashes):
+        """
+        @brief Transmits the manifest message carrying the hashes of the consecutive blocks.
+
+        @param first  The index of the first block.
+        @param hashes The CRC-32 of the blocks.
+        """
+        payload = [DUST_EXT_OPCODE.MANIFEST.value, (first >> 0x08) & 0xff, first & 0xff, len(hashes)]
+        for block_hash in hashes:
+            payload.extend(block_hash.to_bytes(4, byteorder = 'big'))
+        payload.extend([0x00]*(self.instance.options.payload_size - len(payload)))
+        length = self.length()
+        self.instance.packet.header.create(DUST_OPCODE.CONNECT.value, length, DUST_ACK.UNSET.value, packet_number=0x00)
+        self.instance.packet.payload.create(buffer=payload)
+        self.instance.packet.create(self.instance.packet.header, self.instance.packet.payload)
+        self.instance.serialized.create(buffer=self.instance.packet.serialize())
+        self.transmit()
+
+    def exchange_manifest(self):
+        """
+        @brief Sends the block hashes of the new image and receives the blocks the device misses.
+
+        Every manifest message is acknowledged, the last one is answered by the blocks message
+        naming the blocks which differ from the installed image, bit n of byte 3 + n / 8 standing
+        for the block n. The device erases the application region before it replies.
+        """
+        image = bytes(self.text.converted_hexdata)
+        hashes = [zlib.crc32(image[i:(i + DFU_UPDATER_DELTA_BLOCK_SIZE)])
+                  for i in range(0, len(image), DFU_UPDATER_DELTA_BLOCK_SIZE)]
+        count = (self.instance.options.payload_size - 4) // 4
+        for first in range(0, len(hashes), count):
+            last = (first + count) >= len(hashes)
+            while True:
+                self.transmit_manifest(first, hashes[first:(first + count)])
+                if ((self.receive() == DUST_RESULT.SUCCESS.value) and
+                    (self.instance.packet.header.bits.ack == DUST_ACK.SET.value)):
+                    if (not last):
+                        break
+                    if ((self.instance.packet.header.bits.opcode == DUST_OPCODE.CONNECT.value) and
+                        (self.instance.packet.payload.buffer[0] == DUST_EXT_OPCODE.BLOCKS.value)):
+                        break
+                self.usart.reset_input_buffer()
+        bitmap = self.instance.packet.payload.buffer[3:]
+        self.blocks = [n for n in range(len(hashes)) if ((bitmap[n // 8] >> (n % 8)) & 0x01)]
+        packets_per_block = DFU_UPDATER_DELTA_BLOCK_SIZE // self.instance.options.payload_size
+        self.instance.options.number_of_packets = len(self.blocks) * packets_per_block
+        print("Delta: " + str(len(self.blocks)) + " of " + str(len(hashes)) + " blocks differ")
 
     def disconnect(self):
         """
@@ -204,31 +410,101 @@ class dfu_updater:
         """
         @brief Updates the device firmware using the dust protocol.
 
-        This method sends firmware data to the device in packets. Each packet is prepared
-        with appropriate headers, payloads, and serialization. ACKs are received periodically
-        based on the specified acknowledgment frequency.
+        This method sends firmware data to the device in packets, retransmitting the lost ones
+        as the ARQ mode negotiated in the handshake requires.
 
         @note Ensure that the USART connection is initialized before calling this method.
         """
-        # TODO: Check the retransmission machanism
         if isinstance(self.usart, serial.Serial):
             print("")
-            packet_number = 0
-            payload_size = self.length_hash_table[self.instance.options.payload_size]
-            for packet_number in tqdm(range(self.instance.options.number_of_packets), desc = "Update"):
-                self.instance.packet.header.create(DUST_OPCODE.DATA.value, payload_size, DUST_ACK.UNSET.value, packet_number)
-                self.instance.packet.payload.create(buffer=self.fill_data(packet_number))
-                self.instance.packet.create(self.instance.packet.header, self.instance.packet.payload)
-                self.instance.serialized.create(buffer=self.instance.packet.serialize())
-                self.transmit()
-                if ((((packet_number + 1)  % self.ack_frequency_hash_table[self.instance.options.ack_frequency]) == 0) or
-                     ((packet_number + 1) == self.instance.options.number_of_packets)):
-                    if (self.receive() == DUST_RESULT.SUCCESS.value):
-                        if (self.instance.packet.header.bits.ack != DUST_ACK.SET.value):
-                            packet_number -= self.ack_frequency_hash_table[self.instance.options.ack_frequency]
+            if (self.instance.options.arq_mode == DUST_ARQ_MODE.SELECTIVE_REPEAT.value):
+                self.update_selective_repeat()
+            else:
+                self.update_go_back()
         else:
             print("Usart is not initialized...")
 
+    def update_go_back(self):
+        """
+        @brief Sends the firmware with go-back retransmissions.
+
+        The device acknowledges every window as a whole, the whole window is sent again on a NACK.
+        """
+        number_of_packets = self.instance.options.number_of_packets
+        window = self.ack_frequency_hash_table[self.instance.options.ack_frequency]
+        base = self.resume
+        with tqdm(total = number_of_packets, initial = base, desc = "Update") as progress:
+            while (base < number_of_packets):
+                length = min(window, number_of_packets - base)
+                for packet_number in range(base, base + length):
+                    self.transmit_data(packet_number, DUST_ACK.UNSET.value)
+                if (self.receive() == DUST_RESULT.SUCCESS.value):
+                    if (self.instance.packet.header.bits.ack == DUST_ACK.SET.value):
+                        base += length
+                        progress.update(length)
+
+    def update_selective_repeat(self):
+        """
+        @brief Sends the firmware with selective repeat retransmissions.
+
+        The last packet of the window polls the device, which replies with a bitmap ACK naming the
+        received packets of the window, bit n of byte n / 8 standing for the packet base + n. Only
+        the missing packets are sent again, the last of them polling once more. The lost ACK is
+        recovered by polling again with the last packet after a timeout.
+        """
+        number_of_packets = self.instance.options.number_of_packets
+        window = self.arq_window()
+        timeout = self.usart.timeout
+        retransmissions = 0
+        self.usart.timeout = DFU_UPDATER_POLL_TIMEOUT
+        with tqdm(total = number_of_packets, initial = self.resume, desc = "Update") as progress:
+            for base in range(self.resume, number_of_packets, window):
+                length = min(window, number_of_packets - base)
+                missing = list(range(base, base + length))
+                while (len(missing) != 0):
+                    for packet_number in missing[:-1]:
+                        self.transmit_data(packet_number, DUST_ACK.UNSET.value)
+                    while True:
+                        self.transmit_data(missing[-1], DUST_ACK.SET.value)
+                        if ((self.receive() == DUST_RESULT.SUCCESS.value) and
+                            (self.instance.packet.header.bits.opcode == DUST_OPCODE.DATA.value) and
+                            (self.instance.packet.header.bits.ack == DUST_ACK.SET.value) and
+                            (self.instance.packet.header.bits.packet_number == (base % DUST_ARQ_SEQUENCE_SIZE))):
+                            break
+                        # The partial reply must not shift the next one.
+                        self.usart.reset_input_buffer()
+                    bitmap = self.instance.packet.payload.buffer
+                    missing = [base + n for n in range(length) if ((bitmap[n // 8] >> (n % 8)) & 0x01) == 0]
+                    retransmissions += len(missing)
+                progress.update(length)
+        self.usart.timeout = timeout
+        print("Retransmitted packets: " + str(retransmissions))
+
+    def sibling(self, path):
+        """
+        @brief Names the image of the same app linked to the other slot.
+
+        @param path The ELF file path, 'app.elf' or 'app-b.elf'.
+
+        @return The ELF file path of the other slot.
+        """
+        if (path.endswith('-b.elf')):
+            return path[:-len('-b.elf')] + '.elf'
+        return path[:-len('.elf')] + '-b.elf'
+
+    def load(self, path):
+        """
+        @brief Loads the '.text' image of the ELF file and the slot it is linked to.
+
+        @param path The ELF file path.
+        """
+        self.bin  = path
+        self.text = dfu_updater_segment(name = '.text', sections = [])
+        self.readelf_get_sections(self.text)
+        self.text.calculate_size()
+        self.text.convert_to_little_endian()
+        self.slot = DFU_UPDATER_SLOT_ADDRESSES.index(self.text.sections[0]['sh_addr'])
+
     def readelf_get_sections(self, segment):
         """
         @brief Reads ELF sections that match the given segment name.
@@ -262,32 +538,58 @@ class dfu_updater:
         else:
             return int(firmware_size / payload_size)
 
+    def prepare_stream(self, compression):
+        """
+        @brief Prepares the stream of the firmware data carried by the data packets.
+
+        The compressed stream is decompressed by the updater, which programs the image it decodes.
+
+        @param compression The image compression.
+        """
+        self.compression = compression
+        if (compression == DUST_COMPRESSION.LZ.value):
+            self.stream = lz_compress(self.text.converted_hexdata)
+            print("Compressed: " + str(len(self.text.converted_hexdata)) + " -> " + str(len(self.stream)) +
+                  " bytes, ratio " + f"{(len(self.text.converted_hexdata) / len(self.stream)):.2f}")
+        else:
+            self.stream = list(self.text.converted_hexdata)
+
     def prepare_data(self):
         """
         @brief Prepares firmware data by aligning it to the payload size.
 
-        This method appends padding bytes (0xFF) to the firmware data to ensure its size
+        This method appends padding bytes (0xFF) to the stream to ensure its size
         aligns with the payload size defined in the dust instance options.
 
         @note This method should be called before transmitting firmware data.
         """
-        number_of_alignment_bytes = (self.instance.options.payload_size - (len(self.text.converted_hexdata) % self.instance.options.payload_size))
+        if (self.delta != 0):
+            # The blocks are sent whole, the last one included.
+            while ((len(self.stream) % DFU_UPDATER_DELTA_BLOCK_SIZE) != 0):
+                self.stream.append(0xff)
+            return
+        number_of_alignment_bytes = (self.instance.options.payload_size - (len(self.stream) % self.instance.options.payload_size))
         for i in range(0, number_of_alignment_bytes):
-            self.text.converted_hexdata.append(0xff)
+            self.stream.append(0xff)
 
     def fill_data(self, packet_number):
         """
         @brief Fills the payload data for a specific packet.
 
-        This method fills a slice of firmware data corresponding to the given packet number
-        and payload size.
+        This method fills a slice of the stream corresponding to the given packet number
+        and payload size. The delta update numbers the packets of the transferred blocks only.
 
         @param packet_number The index of the packet to fill data for.
 
         @return A list containing the payload data for the specified packet.
         """
         payload_size = self.instance.options.payload_size
-        return self.text.converted_hexdata[(packet_number * payload_size):((packet_number * payload_size) + payload_size)]
+        offset = packet_number * payload_size
+        if (self.delta != 0):
+            packets_per_block = DFU_UPDATER_DELTA_BLOCK_SIZE // payload_size
+            offset = (self.blocks[packet_number // packets_per_block] * DFU_UPDATER_DELTA_BLOCK_SIZE) + \
+                     ((packet_number % packets_per_block) * payload_size)
+        return self.stream[offset:(offset + payload_size)]
 
     def print_arguments(self):
         """
@@ -297,6 +599,7 @@ class dfu_updater:
         during initialization.
         """
         print("Bin:      " + self.bin)
+        print("Other:    " + self.bin_other)
         print("Port:     " + self.port)
         print("Baudrate: " + self.baudrate)
 
@@ -304,15 +607,22 @@ class dfu_updater:
 updater = dfu_updater()
 updater.print_arguments()
 
-updater.readelf_get_sections(updater.text)
-updater.text.calculate_size()
-updater.text.convert_to_little_endian()
+updater.load(updater.bin)
 
 dust_crc16_generate_lut(0x1021)
 
+updater.prepare_stream(DUST_COMPRESSION.LZ.value)
+
 updater.init()
-updater.connect(DUST_ACK_FREQUENCY.AFTER_EACH_PACKET.value, 32)
+start = time.perf_counter()
+if (not updater.connect(DUST_ACK_FREQUENCY.AFTER_64_PACKETS.value, 32, DUST_ARQ_MODE.SELECTIVE_REPEAT.value)):
+    # The updater waits for the handshake of the image linked to the inactive slot.
+    updater.load(updater.bin_other)
+    print("Retrying with " + updater.bin + ", slot " + str(updater.slot))
+    updater.prepare_stream(DUST_COMPRESSION.LZ.value)
+    updater.connect(DUST_ACK_FREQUENCY.AFTER_64_PACKETS.value, 32, DUST_ARQ_MODE.SELECTIVE_REPEAT.value)
 updater.prepare_data()
 updater.update()
 updater.disconnect()
+print("Update time: " + f"{(time.perf_counter() - start):.2f}" + " s")
 updater.deinit()
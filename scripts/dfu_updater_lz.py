@@ -0,0 +1,94 @@
+"""
+@brief LZSS coder of the firmware images streamed to the updater.
+
+The stream is the one dfu/updater/lz_decoder.h describes: a flag byte precedes every group of eight
+items, its bit n (LSB first) tells whether the item n is a literal byte (1) or a match (0). A match
+takes two bytes, the 12-bit distance minus one, low byte first followed by its high nibble in the
+upper nibble of the second byte, and the length minus 3 in its lower nibble.
+"""
+
+LZ_WINDOW_SIZE = 0x1000
+LZ_MATCH_MIN   = 0x03
+LZ_MATCH_MAX   = 0x12
+LZ_CHAIN_DEPTH = 0x40
+
+
+def lz_compress(data):
+    """
+    @brief Compresses the data with the greedy LZSS coder.
+
+    The candidates are found through the chains of the positions sharing their first three bytes,
+    walked up to LZ_CHAIN_DEPTH positions deep.
+
+    @param data The data to compress.
+    @return A list of bytes holding the compressed stream.
+    """
+    data = bytes(data)
+    output = []
+    chains = {}
+    position = 0
+    flags_position = 0
+    items = 8
+    while (position < len(data)):
+        if (items == 8):
+            flags_position = len(output)
+            output.append(0x00)
+            items = 0
+        best_length = 0
+        best_distance = 0
+        key = data[position:(position + LZ_MATCH_MIN)]
+        if (len(key) == LZ_MATCH_MIN):
+            limit = min(LZ_MATCH_MAX, len(data) - position)
+            for candidate in reversed(chains.get(key, [])[-LZ_CHAIN_DEPTH:]):
+                distance = position - candidate
+                if (distance > LZ_WINDOW_SIZE):
+                    break
+                length = LZ_MATCH_MIN
+                while ((length < limit) and (data[candidate + length] == data[position + length])):
+                    length += 1
+                if (length > best_length):
+                    best_length = length
+                    best_distance = distance
+                    if (length == limit):
+                        break
+        if (best_length >= LZ_MATCH_MIN):
+            output.append((best_distance - 1) & 0xff)
+            output.append((((best_distance - 1) >> 4) & 0xf0) | (best_length - LZ_MATCH_MIN))
+            step = best_length
+        else:
+            output[flags_position] |= (0x01 << items)
+            output.append(data[position])
+            step = 1
+        for i in range(position, position + step):
+            chains.setdefault(data[i:(i + LZ_MATCH_MIN)], []).append(i)
+        position += step
+        items += 1
+    return output
+
+
+def lz_decompress(data, size):
+    """
+    @brief Decompresses the LZSS stream, the reference of the updater decoder.
+
+    @param data The compressed stream.
+    @param size The decompressed size, the bytes following it are padding.
+    @return A list of bytes holding the decompressed data.
+    """
+    output = []
+    position = 0
+    while ((len(output) < size) and (position < len(data))):
+        flags = data[position]
+        position += 1
+        for item in range(8):
+            if ((len(output) >= size) or (position >= len(data))):
+                break
+            if ((flags >> item) & 0x01):
+                output.append(data[position])
+                position += 1
+            else:
+                distance = (data[position] | ((data[position + 1] & 0xf0) << 4)) + 1
+                length = (data[position + 1] & 0x0f) + LZ_MATCH_MIN
+                position += 2
+                for i in range(length):
+                    output.append(output[len(output) - distance])
+    return output
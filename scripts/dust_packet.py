@@ -6,6 +6,8 @@ from enum import Enum
 DUST_PACKET_HEADER_SIZE = 4
 DUST_PACKET_CRC16_SIZE  = 2
 DUST_CRC16_LUT_SIZE     = 256
+DUST_ARQ_SEQUENCE_SIZE  = 2048
+DUST_ARQ_WINDOW_MAX     = 512
 
 c_uint8  = ctypes.c_uint8
 c_uint16 = ctypes.c_uint16
@@ -63,6 +65,21 @@ class DUST_OPCODE(Enum):
     ERROR      = 0x03
 
 
+class DUST_EXT_OPCODE(Enum):
+    """
+    @brief Enum for DUST_EXT_OPCODE.
+
+    The extended opcodes carried in the first payload byte of the CONNECT packets following the
+    handshake, the header opcode field has no room left.
+    """
+    MANIFEST     = 0x01
+    BLOCKS       = 0x02
+    CAPABILITIES = 0x03
+    SETTINGS     = 0x04
+    RESUME       = 0x05
+    SLOT         = 0x06
+
+
 class DUST_LENGTH(Enum):
     """
     @brief Enum for DUST_LENGTH.
@@ -101,6 +118,26 @@ class DUST_ACK_FREQUENCY(Enum):
     AFTER_512_PACKETS = 0x07
 
 
+class DUST_ARQ_MODE(Enum):
+    """
+    @brief Enum for DUST_ARQ_MODE.
+
+    Specifies how the lost data packets are retransmitted in the dust protocol.
+    """
+    GO_BACK          = 0x00
+    SELECTIVE_REPEAT = 0x01
+
+
+class DUST_COMPRESSION(Enum):
+    """
+    @brief Enum for DUST_COMPRESSION.
+
+    Specifies how the firmware image is coded in the data packets.
+    """
+    NONE = 0x00
+    LZ   = 0x01
+
+
 class dust_header_bits(ctypes.BigEndianStructure):
     """
     @brief Structure representing the individual bits of a dust header.
@@ -345,33 +382,63 @@ class dust_handshake_options(ctypes.BigEndianStructure):
     @brief Structure representing dust handshake options.
 
     This structure contains the settings for the handshake process, including acknowledgment frequency,
-    number of packets, and payload size.
+    number of packets, payload size, ARQ mode and image compression.
     """
     _fields_ = [("ack_frequency",     c_uint8),
                 ("number_of_packets", c_uint32),
-                ("payload_size",      c_uint16)]
+                ("payload_size",      c_uint16),
+                ("arq_mode",          c_uint8),
+                ("compression",       c_uint8),
+                ("image_size",        c_uint32),
+                ("delta",             c_uint8),
+                ("negotiate",         c_uint8),
+                ("image_hash",        c_uint32),
+                ("slot",              c_uint8)]
 
     def __init__(self):
         """
         @brief Initializes the handshake options.
 
-        Sets all fields (`ack_frequency`, `number_of_packets`, and `payload_size`) to 0.
+        Sets all fields to 0.
         """
         self.ack_frequency     = 0
         self.number_of_packets = 0
         self.payload_size      = 0
-
-    def create(self, ack_frequency, number_of_packets, payload_size):
+        self.arq_mode          = 0
+        self.compression       = 0
+        self.image_size        = 0
+        self.delta             = 0
+        self.negotiate         = 0
+        self.image_hash        = 0
+        self.slot              = 0
+
+    def create(self, ack_frequency, number_of_packets, payload_size, arq_mode = DUST_ARQ_MODE.GO_BACK.value,
+               compression = DUST_COMPRESSION.NONE.value, image_size = 0, delta = 0, negotiate = 0,
+               image_hash = 0, slot = 0):
         """
         @brief Creates handshake options with the specified parameters.
 
         @param ack_frequency     The acknowledgment frequency setting.
         @param number_of_packets The total number of packets for the handshake.
         @param payload_size      The size of the payload in bytes.
+        @param arq_mode          The retransmission mode, the updaters not aware of it use go-back.
+        @param compression       The image compression, the packets carry the compressed stream.
+        @param image_size        The size of the image the updater decompresses.
+        @param delta             1 to exchange the block manifest and transfer the changed blocks only.
+        @param negotiate         1 to ask for the capabilities and switch to the payload size and baud rate picked.
+        @param image_hash        The CRC-32 of the image, the interrupted transfer of the same image resumes.
+        @param slot              The app slot the image is linked to, the updater refuses the active one.
         """
         self.ack_frequency     = ack_frequency
         self.number_of_packets = number_of_packets
         self.payload_size      = payload_size
+        self.arq_mode          = arq_mode
+        self.compression       = compression
+        self.image_size        = image_size
+        self.delta             = delta
+        self.negotiate         = negotiate
+        self.image_hash        = image_hash
+        self.slot              = slot
 
     def serialize(self):
         """
@@ -389,7 +456,20 @@ class dust_handshake_options(ctypes.BigEndianStructure):
         serialized_options.append(((self.number_of_packets & 0x000000ff) >> 0x00))
         serialized_options.append(((self.payload_size & 0xff00) >> 0x08))
         serialized_options.append(((self.payload_size & 0x00ff) >> 0x00))
-        serialized_options.extend([0x00]*25)
+        serialized_options.append(self.arq_mode)
+        serialized_options.append(self.compression)
+        serialized_options.append(((self.image_size & 0xff000000) >> 0x18))
+        serialized_options.append(((self.image_size & 0x00ff0000) >> 0x10))
+        serialized_options.append(((self.image_size & 0x0000ff00) >> 0x08))
+        serialized_options.append(((self.image_size & 0x000000ff) >> 0x00))
+        serialized_options.append(self.delta)
+        serialized_options.append(self.negotiate)
+        serialized_options.append(((self.image_hash & 0xff000000) >> 0x18))
+        serialized_options.append(((self.image_hash & 0x00ff0000) >> 0x10))
+        serialized_options.append(((self.image_hash & 0x0000ff00) >> 0x08))
+        serialized_options.append(((self.image_hash & 0x000000ff) >> 0x00))
+        serialized_options.append(self.slot)
+        serialized_options.extend([0x00]*12)
         return serialized_options
 
 
@@ -456,6 +536,13 @@ class dust_instance:
         print("ack_frequency:     " + str(f"{self.options.ack_frequency:#x}"))
         print("number_of_packets: " + str(f"{self.options.number_of_packets:#x}"))
         print("payload_size:      " + str(f"{self.options.payload_size:#x}"))
+        print("arq_mode:          " + str(f"{self.options.arq_mode:#x}"))
+        print("compression:       " + str(f"{self.options.compression:#x}"))
+        print("image_size:        " + str(f"{self.options.image_size:#x}"))
+        print("delta:             " + str(f"{self.options.delta:#x}"))
+        print("negotiate:         " + str(f"{self.options.negotiate:#x}"))
+        print("image_hash:        " + str(f"{self.options.image_hash:#x}"))
+        print("slot:              " + str(f"{self.options.slot:#x}"))
 
     def print_packet(self):
         """
@@ -0,0 +1,62 @@
+import struct
+import sys
+import zlib
+
+from elftools.elf.elffile import ELFFile
+
+"""
+@brief The image header magic, shared/image_header/image_header.h IMAGE_HEADER_MAGIC.
+"""
+IMAGE_HEADER_MAGIC = 0x48494647
+
+"""
+@brief The header offset from the image start, shared/image_header/image_header.h IMAGE_HEADER_OFFSET.
+"""
+IMAGE_HEADER_OFFSET = 0x0200
+
+"""
+@brief The offset of the CRC-32 field, shared/image_header/image_header.h IMAGE_HEADER_CRC32_OFFSET.
+"""
+IMAGE_HEADER_CRC32_OFFSET = IMAGE_HEADER_OFFSET + 0x0c
+
+
+def image_header_patch(path):
+    """
+    @brief Fills in the length and the CRC-32 of the image header in the linked ELF file.
+
+    The image is the '.text' section, the one the updater transfers. The CRC-32 covers the image
+    but the CRC-32 field, the length included.
+
+    @param path The ELF file path.
+    @return The length and the CRC-32.
+    """
+    with open(path, 'r+b') as file:
+        section = ELFFile(file).get_section_by_name('.text')
+        if (section is None):
+            raise RuntimeError("No .text section in " + path)
+
+        image = bytearray(section.data())
+        length = (len(image) + 3) & ~3
+        image.extend(b'\x00' * (length - len(image)))
+
+        (magic,) = struct.unpack_from('<I', image, IMAGE_HEADER_OFFSET)
+        if (magic != IMAGE_HEADER_MAGIC):
+            raise RuntimeError("No image header at " + hex(IMAGE_HEADER_OFFSET) + " in " + path)
+
+        struct.pack_into('<I', image, IMAGE_HEADER_OFFSET + 0x08, length)
+        crc32 = zlib.crc32(image[IMAGE_HEADER_CRC32_OFFSET + 4:length],
+                           zlib.crc32(image[:IMAGE_HEADER_CRC32_OFFSET])) & 0xffffffff
+
+        file.seek(section['sh_offset'] + IMAGE_HEADER_OFFSET + 0x08)
+        file.write(struct.pack('<II', length, crc32))
+
+    return length, crc32
+
+
+if (__name__ == '__main__'):
+    if (len(sys.argv) != 2):
+        print("Usage: image_header.py <image.elf>")
+        sys.exit(1)
+
+    length, crc32 = image_header_patch(sys.argv[1])
+    print("Image header: length " + hex(length) + ", crc32 " + hex(crc32))
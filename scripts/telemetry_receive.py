@@ -0,0 +1,173 @@
+import struct
+import sys
+
+"""
+@brief The frame sync bytes, modules/telemetry/telemetry.h TELEMETRY_SYNC_1 and TELEMETRY_SYNC_2.
+"""
+TELEMETRY_SYNC = b'\xa5\x5a'
+
+"""
+@brief The header and the CRC sizes, modules/telemetry/telemetry.h TELEMETRY_HEADER_SIZE and
+       TELEMETRY_CRC_SIZE.
+"""
+TELEMETRY_HEADER_SIZE = 5
+TELEMETRY_CRC_SIZE = 2
+
+"""
+@brief The RC signal scale, modules/telemetry/telemetry.h TELEMETRY_RC_SCALE.
+"""
+TELEMETRY_RC_SCALE = 10000.0
+
+"""
+@brief The boot stage names, shared/timing/timing.h timing_boot_stage_t.
+"""
+TELEMETRY_BOOT_STAGES = [
+    'clocks', 'bootloader', 'apploader', 'image_checked', 'image', 'drivers', 'rc_ready', 'imu', 'armable',
+]
+
+"""
+@brief The messages by id, modules/telemetry/telemetry.h telemetry_msg_t: the name, the payload
+       format and the field names.
+"""
+TELEMETRY_MSGS = {
+    0: ('attitude', '<3f', ['roll', 'pitch', 'yaw']),
+    1: ('rates', '<3h', ['gx', 'gy', 'gz']),
+    2: ('rc', '<6h', ['rc1', 'rc2', 'rc3', 'rc4', 'rc5', 'rc6']),
+    3: ('motors', '<4H', ['pwm1', 'pwm2', 'pwm3', 'pwm4']),
+    4: ('loop', '<3I', ['total_us', 'cycles', 'dropped']),
+    5: ('boot', '<' + str(len(TELEMETRY_BOOT_STAGES) + 2) + 'I',
+        [stage + '_us' for stage in TELEMETRY_BOOT_STAGES] + ['reason', 'reset_cause']),
+}
+
+
+def telemetry_crc16(data, crc=0xffff):
+    """
+    @brief Calculates the CRC-16/CCITT-FALSE the telemetry appends to the frame.
+
+    @param data The bytes from the id to the payload end.
+    @param crc The initial value.
+    @return The CRC.
+    """
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xffff
+
+    return crc
+
+
+class telemetry_receiver:
+    """
+    @class telemetry_receiver
+    @brief Splits the byte stream into the telemetry frames.
+
+    The telemetry shares the USART with the debug output, the receiver looks for the sync bytes and
+    takes the frame only when its length and its CRC match, the text in between is skipped.
+    """
+
+    def __init__(self):
+        """
+        @brief Starts with no data and no frame seen.
+        """
+        self.data = bytearray()
+        self.seq = None
+        self.frames = 0
+        self.lost = 0
+        self.errors = 0
+
+    def feed(self, data):
+        """
+        @brief Adds the received bytes and decodes the whole frames among them.
+
+        @param data The received bytes.
+        @return The list of the decoded messages, each the name and the dictionary of the fields.
+        """
+        self.data += data
+        msgs = []
+
+        while True:
+            start = self.data.find(TELEMETRY_SYNC)
+            if (start < 0):
+                del self.data[:max(len(self.data) - 1, 0)]
+                return msgs
+
+            del self.data[:start]
+            if (len(self.data) < TELEMETRY_HEADER_SIZE):
+                return msgs
+
+            msg_id, length, seq = self.data[2], self.data[3], self.data[4]
+            msg = TELEMETRY_MSGS.get(msg_id)
+
+            if ((msg is None) or (length != struct.calcsize(msg[1]))):
+                self.errors += 1
+                del self.data[:1]
+                continue
+
+            size = TELEMETRY_HEADER_SIZE + length + TELEMETRY_CRC_SIZE
+            if (len(self.data) < size):
+                return msgs
+
+            crc = struct.unpack_from('<H', self.data, TELEMETRY_HEADER_SIZE + length)[0]
+            if (crc != telemetry_crc16(self.data[2:TELEMETRY_HEADER_SIZE + length])):
+                self.errors += 1
+                del self.data[:1]
+                continue
+
+            values = struct.unpack_from(msg[1], self.data, TELEMETRY_HEADER_SIZE)
+            fields = dict(zip(msg[2], values))
+            if (msg[0] == 'rc'):
+                fields = {name: value / TELEMETRY_RC_SCALE for name, value in fields.items()}
+
+            # The gap in the sequence is the frames the device dropped or the link lost.
+            if (self.seq is not None):
+                self.lost += (seq - self.seq - 1) & 0xff
+            self.seq = seq
+            self.frames += 1
+
+            msgs.append((msg[0], fields))
+            del self.data[:size]
+
+
+def telemetry_format(name, fields):
+    """
+    @brief Formats the message as one line.
+
+    @param name The message name.
+    @param fields The message fields.
+    @return The line.
+    """
+    values = [(key + '=' + (('%.4f' % value) if isinstance(value, float) else str(value)))
+              for key, value in fields.items()]
+
+    return name.ljust(8) + ' ' + ' '.join(values)
+
+
+if (__name__ == '__main__'):
+    if (len(sys.argv) not in (2, 3)):
+        print("Usage: telemetry_receive.py <port> [baudrate]")
+        print("       telemetry_receive.py <capture.bin>")
+        sys.exit(1)
+
+    receiver = telemetry_receiver()
+
+    if (len(sys.argv) == 2) and not sys.argv[1].startswith(('/dev/', 'COM')):
+        with open(sys.argv[1], 'rb') as file:
+            for name, fields in receiver.feed(file.read()):
+                print(telemetry_format(name, fields))
+    else:
+        import serial
+
+        usart = serial.Serial(port=sys.argv[1], baudrate=int(sys.argv[2]) if (len(sys.argv) == 3) else 115200,
+                              timeout=0.1)
+        try:
+            while True:
+                for name, fields in receiver.feed(usart.read(256)):
+                    print(telemetry_format(name, fields))
+        except KeyboardInterrupt:
+            pass
+        finally:
+            usart.close()
+
+    print("Telemetry: " + str(receiver.frames) + " frames, " + str(receiver.lost) + " lost, " +
+          str(receiver.errors) + " errors", file=sys.stderr)
@@ -0,0 +1,106 @@
+#include "boot_control.h"
+#include "image_header.h"
+#include <stddef.h>
+
+///*************************************************************************************************
+/// Private functions - declaration.
+///*************************************************************************************************
+///
+/// \brief Calculates the CRC-32 of the record fields.
+///
+/// \param[in] record The record.
+///
+/// \return uint32_t The CRC-32.
+///
+static uint32_t record_crc(const boot_control_record_t *const record);
+
+///
+/// \brief Checks whether the record slot is erased.
+///
+/// \param[in] record The record slot.
+///
+/// \return bool True if all the bytes read 0xff, false otherwise.
+///
+static bool record_is_erased(const boot_control_record_t *const record);
+
+///*************************************************************************************************
+/// Private functions - definition.
+///*************************************************************************************************
+static uint32_t record_crc(const boot_control_record_t *const record)
+{
+    return ~image_header_crc32_update(0xffffffff, (const uint8_t *)record, offsetof(boot_control_record_t, crc));
+}
+
+static bool record_is_erased(const boot_control_record_t *const record)
+{
+    const uint32_t *word = (const uint32_t *)record;
+
+    for (uint32_t i = 0; i < (sizeof(boot_control_record_t) / sizeof(uint32_t)); i++)
+    {
+        if (word[i] != 0xffffffff)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+///*************************************************************************************************
+/// Global functions - definition.
+///*************************************************************************************************
+void boot_control_record_create(boot_control_record_t *const record, const uint32_t slot, const uint32_t sequence)
+{
+    if (record == NULL)
+    {
+        return;
+    }
+
+    record->magic    = BOOT_CONTROL_MAGIC;
+    record->slot     = slot;
+    record->sequence = sequence;
+    record->crc      = record_crc(record);
+}
+
+bool boot_control_record_is_valid(const boot_control_record_t *const record)
+{
+    return (record != NULL) && (record->magic == BOOT_CONTROL_MAGIC) && (record->slot < BOOT_CONTROL_SLOTS) &&
+           (record->crc == record_crc(record));
+}
+
+const boot_control_record_t* boot_control_find(const boot_control_record_t *const log, const uint32_t count,
+                                               uint32_t *const free)
+{
+    const boot_control_record_t *record = NULL;
+    uint32_t i = 0;
+
+    if (log == NULL)
+    {
+        return NULL;
+    }
+
+    for (; (i < count) && !record_is_erased(&log[i]); i++)
+    {
+        if (boot_control_record_is_valid(&log[i]))
+        {
+            record = &log[i];
+        }
+    }
+
+    if (free != NULL)
+    {
+        *free = i;
+    }
+
+    return record;
+}
+
+uint32_t boot_control_preferred(const boot_control_record_t *const record)
+{
+    return (record == NULL) ? 0 : record->slot;
+}
+
+uint32_t boot_control_next_sequence(const boot_control_record_t *const record)
+{
+    return (record == NULL) ? 0 : (record->sequence + 1);
+}
@@ -0,0 +1,83 @@
+#ifndef _BOOT_CONTROL_H
+#define _BOOT_CONTROL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+#define BOOT_CONTROL_MAGIC      (0x4c544342u)   /*!< "BCTL", an erased record reads 0xffffffff.       */
+#define BOOT_CONTROL_SLOTS      (2u)            /*!< The app slots A and B.                            */
+
+///
+/// \brief The boot-control record type.
+///
+/// The record names the app slot to boot. The records are appended to a flash sector of their own,
+/// the newest valid one wins, so switching the slot is a single record write.
+///
+typedef struct
+{
+    uint32_t magic;
+    uint32_t slot;                          /*!< The slot to boot, 0 for A and 1 for B.                */
+    uint32_t sequence;                      /*!< Increases with every record, the highest one wins.    */
+    uint32_t crc;                           /*!< The CRC-32 of the fields above.                       */
+} boot_control_record_t;
+
+///
+/// \brief Creates the record.
+///
+/// \param[out] record   The record.
+/// \param[in]  slot     The slot to boot.
+/// \param[in]  sequence The record sequence number.
+///
+void boot_control_record_create(boot_control_record_t *const record, const uint32_t slot, const uint32_t sequence);
+
+///
+/// \brief Checks the record magic, slot and CRC.
+///
+/// \param[in] record The record, possibly torn.
+///
+/// \return bool True if the record is valid, false otherwise.
+///
+bool boot_control_record_is_valid(const boot_control_record_t *const record);
+
+///
+/// \brief Finds the newest record and the first erased slot of the records in flash.
+///
+/// The records are appended to the erased slots in order, a record torn by the power loss is
+/// skipped.
+///
+/// \param[in]  log   The records.
+/// \param[in]  count The number of the record slots.
+/// \param[out] free  The index of the first erased slot, count if the log is full.
+///
+/// \return const boot_control_record_t* The newest valid record, NULL if there is none.
+///
+const boot_control_record_t* boot_control_find(const boot_control_record_t *const log, const uint32_t count,
+                                               uint32_t *const free);
+
+///
+/// \brief Gets the slot to try first.
+///
+/// \param[in] record The newest record, NULL if there is none.
+///
+/// \return uint32_t The slot the record names, the slot A without a record.
+///
+uint32_t boot_control_preferred(const boot_control_record_t *const record);
+
+///
+/// \brief Gets the sequence number of the next record.
+///
+/// \param[in] record The newest record, NULL if there is none.
+///
+/// \return uint32_t The sequence number.
+///
+uint32_t boot_control_next_sequence(const boot_control_record_t *const record);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _BOOT_CONTROL_H */
@@ -0,0 +1,97 @@
+#include "boot_handoff.h"
+#include "image_header.h"
+#include <stddef.h>
+
+///*************************************************************************************************
+/// Private functions - declaration.
+///*************************************************************************************************
+///
+/// \brief Calculates the CRC-32 of the block fields.
+///
+/// \param[in] handoff The block.
+///
+/// \return uint32_t The CRC-32.
+///
+static uint32_t handoff_crc(const volatile boot_handoff_t *const handoff);
+
+///*************************************************************************************************
+/// Private functions - definition.
+///*************************************************************************************************
+static uint32_t handoff_crc(const volatile boot_handoff_t *const handoff)
+{
+    return ~image_header_crc32_update(0xffffffff, (const uint8_t *)handoff, offsetof(boot_handoff_t, crc));
+}
+
+///*************************************************************************************************
+/// Global functions - definition.
+///*************************************************************************************************
+void boot_handoff_create(volatile boot_handoff_t *const handoff)
+{
+    volatile uint32_t *word = (volatile uint32_t *)handoff;
+
+    if (handoff == NULL)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < (sizeof(boot_handoff_t) / sizeof(uint32_t)); i++)
+    {
+        word[i] = 0;
+    }
+
+    handoff->magic      = BOOT_HANDOFF_MAGIC;
+    handoff->version    = BOOT_HANDOFF_VERSION;
+    handoff->size       = sizeof(boot_handoff_t);
+    handoff->reason     = BOOT_HANDOFF_REASON_COLD;
+    handoff->next_stage = BOOT_HANDOFF_STAGE_APP;
+
+    boot_handoff_seal(handoff);
+}
+
+bool boot_handoff_is_valid(const volatile boot_handoff_t *const handoff)
+{
+    return (handoff != NULL) && (handoff->magic == BOOT_HANDOFF_MAGIC) && (handoff->version == BOOT_HANDOFF_VERSION) &&
+           (handoff->size == sizeof(boot_handoff_t)) && (handoff->crc == handoff_crc(handoff));
+}
+
+void boot_handoff_seal(volatile boot_handoff_t *const handoff)
+{
+    if (handoff == NULL)
+    {
+        return;
+    }
+
+    handoff->crc = handoff_crc(handoff);
+}
+
+void boot_handoff_request(volatile boot_handoff_t *const handoff, const boot_handoff_stage_t stage)
+{
+    if (handoff == NULL)
+    {
+        return;
+    }
+
+    handoff->next_stage = stage;
+
+    boot_handoff_seal(handoff);
+}
+
+boot_handoff_stage_t boot_handoff_take_request(volatile boot_handoff_t *const handoff)
+{
+    boot_handoff_stage_t stage;
+
+    if (handoff == NULL)
+    {
+        return BOOT_HANDOFF_STAGE_APP;
+    }
+
+    stage = (boot_handoff_stage_t)handoff->next_stage;
+
+    if (stage != BOOT_HANDOFF_STAGE_APP)
+    {
+        handoff->next_stage = BOOT_HANDOFF_STAGE_APP;
+        boot_handoff_seal(handoff);
+    }
+
+    return (stage == BOOT_HANDOFF_STAGE_UPDATER) ? BOOT_HANDOFF_STAGE_UPDATER : BOOT_HANDOFF_STAGE_APP;
+}
@@ -0,0 +1,134 @@
+#ifndef _BOOT_HANDOFF_H
+#define _BOOT_HANDOFF_H
+
+#include "memory_map.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+#define BOOT_HANDOFF_MAGIC      (0x464f4842u)   /*!< "BHOF", the SRAM content at POR is random.        */
+#define BOOT_HANDOFF_VERSION    (1u)            /*!< Increased with every change of the layout.        */
+#define BOOT_HANDOFF_STAMPS     (0x0cu)         /*!< The boot stage stamps, timing_boot_stage_t.       */
+
+///
+/// \brief The hand-off block in the shared SRAM.
+///
+#define BOOT_HANDOFF            ((volatile boot_handoff_t *)&__handoff_shared__)
+
+///
+/// \brief The boot stage type, the image the apploader starts.
+///
+typedef enum
+{
+    BOOT_HANDOFF_STAGE_APP = 0,
+    BOOT_HANDOFF_STAGE_UPDATER,
+} boot_handoff_stage_t;
+
+///
+/// \brief The boot reason type.
+///
+typedef enum
+{
+    BOOT_HANDOFF_REASON_COLD = 0,           /*!< The power-on or the block was not valid.              */
+    BOOT_HANDOFF_REASON_WARM,               /*!< The reset kept the block of the previous boot.        */
+    BOOT_HANDOFF_REASON_REQUESTED,          /*!< The updater was requested before the reset.           */
+    BOOT_HANDOFF_REASON_NO_IMAGE,           /*!< The updater was started as no app slot is valid.      */
+} boot_handoff_reason_t;
+
+///
+/// \brief The clock configuration type, the frequencies in Hz.
+///
+typedef struct
+{
+    uint32_t sysclk;
+    uint32_t apb1;
+    uint32_t apb2;
+} boot_handoff_clocks_t;
+
+///
+/// \brief The gyroscope calibration type.
+///
+typedef struct
+{
+    uint32_t valid;                         /*!< 1 once the app calibrated the gyroscope.              */
+    int32_t  gx;
+    int32_t  gy;
+    int32_t  gz;
+} boot_handoff_calib_t;
+
+///
+/// \brief The hand-off block type.
+///
+/// The bootloader keeps the block over a warm reset, if it validates, and creates it otherwise.
+/// Every stage which changes it seals it again before it hands over, the block of an older or a
+/// newer layout is not valid.
+///
+typedef struct
+{
+    uint32_t              magic;
+    uint16_t              version;              /*!< BOOT_HANDOFF_VERSION.                             */
+    uint16_t              size;                 /*!< The block size, sizeof(boot_handoff_t).           */
+    uint32_t              reset_cause;          /*!< The RCC_CSR reset flags the bootloader cleared.   */
+    uint8_t               reason;               /*!< The boot_handoff_reason_t.                        */
+    uint8_t               next_stage;           /*!< The boot_handoff_stage_t the apploader starts.    */
+    uint16_t              reserved;
+    boot_handoff_clocks_t clocks;
+    uint32_t              stamps[BOOT_HANDOFF_STAMPS];
+    boot_handoff_calib_t  calib;
+    uint32_t              crc;                  /*!< The CRC-32 of the fields above.                   */
+} boot_handoff_t;
+
+///
+/// \brief The hand-off block the linker script places in the shared SRAM, declared with its type so
+///        the accesses through BOOT_HANDOFF stay within the object.
+///
+extern boot_handoff_t __handoff_shared__;
+
+///
+/// \brief Creates the block of the cold boot, the calibration is not valid.
+///
+/// \param[out] handoff The block.
+///
+void boot_handoff_create(volatile boot_handoff_t *const handoff);
+
+///
+/// \brief Checks the block magic, version, size and CRC.
+///
+/// \param[in] handoff The block, possibly random.
+///
+/// \return bool True if the block is valid, false otherwise.
+///
+bool boot_handoff_is_valid(const volatile boot_handoff_t *const handoff);
+
+///
+/// \brief Calculates the CRC of the changed block.
+///
+/// \param[in,out] handoff The block.
+///
+void boot_handoff_seal(volatile boot_handoff_t *const handoff);
+
+///
+/// \brief Requests the stage the apploader starts after the next reset.
+///
+/// \param[in,out] handoff The block.
+/// \param[in]     stage   The requested stage.
+///
+void boot_handoff_request(volatile boot_handoff_t *const handoff, const boot_handoff_stage_t stage);
+
+///
+/// \brief Takes the stage requested before the reset, the request is served once.
+///
+/// \param[in,out] handoff The block, validated by the bootloader.
+///
+/// \return boot_handoff_stage_t The requested stage, BOOT_HANDOFF_STAGE_APP without a request.
+///
+boot_handoff_stage_t boot_handoff_take_request(volatile boot_handoff_t *const handoff);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _BOOT_HANDOFF_H */
@@ -0,0 +1,347 @@
+#include "cache.h"
+#include "memory_map.h"
+#include "libopencm3/cm3/mpu.h"
+#include "libopencm3/cm3/scb.h"
+#include "libopencm3/stm32/flash.h"
+#include <stddef.h>
+
+#define CCSIDR_SETS(x)  (((x) >> 0x0d) & 0x7fffu)
+#define CCSIDR_WAYS(x)  (((x) >> 0x03) & 0x03ffu)
+#define DCSW_SET_POS    (0x05u)
+#define DCSW_WAY_POS    (0x1eu)
+
+///
+/// \brief The normal, non-cacheable memory type, TEX 0b001 with C and B cleared. libopencm3 has the
+///        TEX field mask only.
+///
+#define MPU_RASR_ATTR_TEX_NORMAL    (0x01u << 0x13)
+
+///
+/// \brief The caches and the flash accelerator turned on by cache_init(), selected by the GFC_CACHE
+///        CMake option. Turning them off gives the baseline of the boot stamps and the loop time.
+///
+#ifndef CACHE_ENABLE
+#define CACHE_ENABLE    1
+#endif  /* CACHE_ENABLE */
+
+///*************************************************************************************************
+/// Private objects - declaration.
+///*************************************************************************************************
+///
+/// \brief The data cache set/way maintenance operation type.
+///
+typedef enum
+{
+    CACHE_DCACHE_OP_CLEAN = 0,
+    CACHE_DCACHE_OP_INVALIDATE,
+    CACHE_DCACHE_OP_CLEAN_INVALIDATE,
+} cache_dcache_op_t;
+
+///*************************************************************************************************
+/// Private functions - declaration.
+///*************************************************************************************************
+///
+/// \brief Executes the data synchronization barrier.
+///
+static inline void dsb(void);
+
+///
+/// \brief Executes the instruction synchronization barrier.
+///
+static inline void isb(void);
+
+///
+/// \brief Performs the maintenance operation on every set and way of the data cache.
+///
+/// \param[in] op The maintenance operation.
+///
+static void dcache_op_all(const cache_dcache_op_t op);
+
+///
+/// \brief Maps the SRAM shared by the boot stages as normal, non-cacheable memory.
+///
+/// The hand-off block, the image check and the journal copy reach the SRAM as they are written, a
+/// warm reset drops the dirty cache lines. The rest of the memory keeps the default map.
+///
+static void mpu_shared_init(void);
+
+///
+/// \brief Performs the maintenance operation on the lines covering the given address range.
+///
+/// \param[in] reg  The maintenance by address register.
+/// \param[in] addr The start address.
+/// \param[in] size The range size in bytes.
+///
+/// \return cache_res_t   The cache result.
+/// \retval CACHE_RES_OK  On success.
+/// \retval CACHE_RES_ERR Otherwise.
+///
+static cache_res_t dcache_op_range(volatile uint32_t *const reg, const void *const addr,
+                                   const uint32_t size);
+
+///*************************************************************************************************
+/// Private functions - definition.
+///*************************************************************************************************
+static inline void dsb(void)
+{
+    __asm volatile ("dsb 0xf" ::: "memory");
+}
+
+static inline void isb(void)
+{
+    __asm volatile ("isb 0xf" ::: "memory");
+}
+
+static void dcache_op_all(const cache_dcache_op_t op)
+{
+    /* Select the level 1 data cache. */
+    SCB_CSSELR = 0;
+    dsb();
+
+    uint32_t ccsidr = SCB_CCSIDR;
+    uint32_t sets   = CCSIDR_SETS(ccsidr);
+
+    do
+    {
+        uint32_t ways = CCSIDR_WAYS(ccsidr);
+
+        do
+        {
+            uint32_t sw = (sets << DCSW_SET_POS) | (ways << DCSW_WAY_POS);
+
+            switch (op)
+            {
+                case CACHE_DCACHE_OP_CLEAN:
+                    SCB_DCCSW = sw;
+                    break;
+
+                case CACHE_DCACHE_OP_INVALIDATE:
+                    SCB_DCISW = sw;
+                    break;
+
+                case CACHE_DCACHE_OP_CLEAN_INVALIDATE:
+                    SCB_DCCISW = sw;
+                    break;
+
+                default:
+                    break;
+            }
+        } while (ways-- != 0);
+    } while (sets-- != 0);
+
+    dsb();
+    isb();
+}
+
+static void mpu_shared_init(void)
+{
+    /* The region is a power of two aligned to its size, checked by the linker script. */
+    uint32_t size = (uint32_t)&__shared_size__;
+
+    dsb();
+    MPU_CTRL = 0;
+
+    MPU_RNR  = 0;
+    MPU_RBAR = (uint32_t)&__shared_start__;
+    MPU_RASR = MPU_RASR_ATTR_AP_PRW_URW | MPU_RASR_ATTR_TEX_NORMAL |
+               (((uint32_t)__builtin_ctz(size) - 1u) << MPU_RASR_SIZE_LSB) | MPU_RASR_ENABLE;
+
+    MPU_CTRL = MPU_CTRL_PRIVDEFENA | MPU_CTRL_ENABLE;
+    dsb();
+    isb();
+}
+
+static cache_res_t dcache_op_range(volatile uint32_t *const reg, const void *const addr,
+                                   const uint32_t size)
+{
+    if ((addr == NULL) || (size == 0))
+    {
+        return CACHE_RES_ERR;
+    }
+
+    uint32_t line = (uint32_t)addr & ~(CACHE_LINE_SIZE - 1u);
+    uint32_t end  = (uint32_t)addr + size;
+
+    dsb();
+
+    for (; line < end; line += CACHE_LINE_SIZE)
+    {
+        *reg = line;
+    }
+
+    dsb();
+    isb();
+
+    return CACHE_RES_OK;
+}
+
+///*************************************************************************************************
+/// Global functions - definition.
+///*************************************************************************************************
+void cache_init(void)
+{
+#if (CACHE_ENABLE == 1)
+    /* Mapped before the data cache is on, no line of the shared SRAM is cached. */
+    mpu_shared_init();
+    cache_flash_accel_enable();
+    cache_icache_enable();
+    cache_dcache_enable();
+#endif  /* CACHE_ENABLE */
+}
+
+void cache_handoff(void)
+{
+    if (SCB_CCR & SCB_CCR_DC)
+    {
+        dcache_op_all(CACHE_DCACHE_OP_CLEAN_INVALIDATE);
+    }
+
+    cache_icache_invalidate();
+}
+
+bool cache_is_enabled(void)
+{
+    return ((SCB_CCR & (SCB_CCR_IC | SCB_CCR_DC)) == (SCB_CCR_IC | SCB_CCR_DC));
+}
+
+void cache_icache_enable(void)
+{
+    if (SCB_CCR & SCB_CCR_IC)
+    {
+        return;
+    }
+
+    dsb();
+    isb();
+    SCB_ICIALLU = 0;
+    dsb();
+    isb();
+    SCB_CCR |= SCB_CCR_IC;
+    dsb();
+    isb();
+}
+
+void cache_icache_disable(void)
+{
+    dsb();
+    isb();
+    SCB_CCR &= ~SCB_CCR_IC;
+    SCB_ICIALLU = 0;
+    dsb();
+    isb();
+}
+
+void cache_icache_invalidate(void)
+{
+    dsb();
+    isb();
+    SCB_ICIALLU = 0;
+    dsb();
+    isb();
+}
+
+void cache_dcache_enable(void)
+{
+    if (SCB_CCR & SCB_CCR_DC)
+    {
+        return;
+    }
+
+    /* The cache content is unknown after reset. */
+    dcache_op_all(CACHE_DCACHE_OP_INVALIDATE);
+
+    SCB_CCR |= SCB_CCR_DC;
+    dsb();
+    isb();
+}
+
+void cache_dcache_disable(void)
+{
+    if (!(SCB_CCR & SCB_CCR_DC))
+    {
+        return;
+    }
+
+    SCB_CCR &= ~SCB_CCR_DC;
+    dsb();
+
+    dcache_op_all(CACHE_DCACHE_OP_CLEAN_INVALIDATE);
+}
+
+void cache_dcache_clean(void)
+{
+    dcache_op_all(CACHE_DCACHE_OP_CLEAN);
+}
+
+void cache_dcache_invalidate(void)
+{
+    dcache_op_all(CACHE_DCACHE_OP_INVALIDATE);
+}
+
+void cache_dcache_clean_invalidate(void)
+{
+    dcache_op_all(CACHE_DCACHE_OP_CLEAN_INVALIDATE);
+}
+
+cache_res_t cache_dcache_clean_range(const void *const addr, const uint32_t size)
+{
+    return dcache_op_range(&SCB_DCCMVAC, addr, size);
+}
+
+cache_res_t cache_dcache_invalidate_range(void *const addr, const uint32_t size)
+{
+    return dcache_op_range(&SCB_DCIMVAC, addr, size);
+}
+
+cache_res_t cache_dcache_clean_invalidate_range(void *const addr, const uint32_t size)
+{
+    return dcache_op_range(&SCB_DCCIMVAC, addr, size);
+}
+
+cache_res_t cache_dma_tx_prepare(const void *const buf, const uint32_t size)
+{
+    if (!(SCB_CCR & SCB_CCR_DC))
+    {
+        return (buf == NULL) ? CACHE_RES_ERR : CACHE_RES_OK;
+    }
+
+    return cache_dcache_clean_range(buf, size);
+}
+
+cache_res_t cache_dma_rx_prepare(void *const buf, const uint32_t size)
+{
+    if (!(SCB_CCR & SCB_CCR_DC))
+    {
+        return (buf == NULL) ? CACHE_RES_ERR : CACHE_RES_OK;
+    }
+
+    /* Write back the dirty lines now, so their eviction can not overwrite the DMA data later. */
+    return cache_dcache_clean_invalidate_range(buf, size);
+}
+
+cache_res_t cache_dma_rx_complete(void *const buf, const uint32_t size)
+{
+    if (!(SCB_CCR & SCB_CCR_DC))
+    {
+        return (buf == NULL) ? CACHE_RES_ERR : CACHE_RES_OK;
+    }
+
+    /* Drop the lines speculatively fetched while the transfer was running. */
+    return cache_dcache_invalidate_range(buf, size);
+}
+
+void cache_flash_accel_enable(void)
+{
+    FLASH_ACR |= (FLASH_ACR_ARTEN | FLASH_ACR_PRFTEN);
+}
+
+void cache_flash_accel_reset(void)
+{
+    uint32_t acr = FLASH_ACR;
+
+    /* The ART can only be reset while it is disabled. */
+    FLASH_ACR = acr & ~FLASH_ACR_ARTEN;
+    FLASH_ACR = (acr & ~FLASH_ACR_ARTEN) | FLASH_ACR_ARTRST;
+    FLASH_ACR = (acr & ~FLASH_ACR_ARTEN);
+    FLASH_ACR = acr;
+}
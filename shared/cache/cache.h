@@ -0,0 +1,213 @@
+#ifndef _CACHE_H
+#define _CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+///
+/// \brief The Cortex-M7 L1 cache line size in bytes.
+///
+#define CACHE_LINE_SIZE                 (32u)
+
+///
+/// \brief Aligns the object to the cache line boundary.
+///
+#define CACHE_ALIGNED                   __attribute__((aligned(CACHE_LINE_SIZE)))
+
+///
+/// \brief Rounds the given size up to the multiple of the cache line size.
+///
+#define CACHE_ALIGN_SIZE(size)          ((((uint32_t)(size)) + (CACHE_LINE_SIZE - 1u)) & ~(CACHE_LINE_SIZE - 1u))
+
+///
+/// \brief Defines a DMA buffer which occupies whole cache lines only.
+///
+/// Neither the start nor the end of the buffer shares a cache line with other objects, so
+/// invalidating the buffer after a DMA reception never discards CPU writes to its neighbours.
+///
+/// \param type  The element type.
+/// \param name  The buffer name.
+/// \param count The number of elements.
+///
+#define CACHE_DMA_BUFFER(type, name, count) \
+    type name[CACHE_ALIGN_SIZE(sizeof(type) * (count)) / sizeof(type)] CACHE_ALIGNED
+
+///
+/// \brief The cache result type.
+///
+typedef enum cache_res
+{
+    CACHE_RES_OK = 0,
+    CACHE_RES_ERR,
+} cache_res_t;
+
+///
+/// \brief Enables the instruction cache, the data cache, the ART accelerator and the flash
+///        prefetch.
+///
+/// The SRAM shared by the boot stages is mapped non-cacheable by the MPU beforehand, so the
+/// hand-off block, the image check and the journal copy survive a warm reset.
+///
+/// \note  It is meant to be called once in the boot chain, after the flash wait states have been
+///        configured for the target system clock. It does nothing when the GFC_CACHE CMake option
+///        is off, the boot report and the telemetry loop time of such a build are the baseline.
+///
+void cache_init(void);
+
+///
+/// \brief Prepares the caches before transferring control to another image.
+///
+/// Cleans and invalidates the data cache so the next image observes all of the memory written by
+/// the current one, and invalidates the instruction cache together with the ART accelerator so no
+/// stale instructions of the current image survive the jump.
+///
+void cache_handoff(void);
+
+///
+/// \brief Checks whether both L1 caches are enabled.
+///
+/// \return bool True if the instruction and data caches are enabled, false otherwise.
+///
+bool cache_is_enabled(void);
+
+///
+/// \brief Enables the instruction cache.
+///
+void cache_icache_enable(void);
+
+///
+/// \brief Disables the instruction cache.
+///
+void cache_icache_disable(void);
+
+///
+/// \brief Invalidates the whole instruction cache.
+///
+void cache_icache_invalidate(void);
+
+///
+/// \brief Enables the data cache.
+///
+void cache_dcache_enable(void);
+
+///
+/// \brief Disables the data cache.
+///
+/// \note  The dirty lines are cleaned to memory before the cache is turned off.
+///
+void cache_dcache_disable(void);
+
+///
+/// \brief Cleans the whole data cache.
+///
+void cache_dcache_clean(void);
+
+///
+/// \brief Invalidates the whole data cache.
+///
+/// \warning All of the dirty lines are discarded.
+///
+void cache_dcache_invalidate(void);
+
+///
+/// \brief Cleans and invalidates the whole data cache.
+///
+void cache_dcache_clean_invalidate(void);
+
+///
+/// \brief Cleans the data cache lines covering the given address range.
+///
+/// \param[in] addr The start address.
+/// \param[in] size The range size in bytes.
+///
+/// \return cache_res_t   The cache result.
+/// \retval CACHE_RES_OK  On success.
+/// \retval CACHE_RES_ERR Otherwise.
+///
+cache_res_t cache_dcache_clean_range(const void *const addr, const uint32_t size);
+
+///
+/// \brief Invalidates the data cache lines covering the given address range.
+///
+/// \warning The range is extended to whole cache lines, use CACHE_DMA_BUFFER to avoid discarding
+///          the neighbouring objects.
+///
+/// \param[in] addr The start address.
+/// \param[in] size The range size in bytes.
+///
+/// \return cache_res_t   The cache result.
+/// \retval CACHE_RES_OK  On success.
+/// \retval CACHE_RES_ERR Otherwise.
+///
+cache_res_t cache_dcache_invalidate_range(void *const addr, const uint32_t size);
+
+///
+/// \brief Cleans and invalidates the data cache lines covering the given address range.
+///
+/// \param[in] addr The start address.
+/// \param[in] size The range size in bytes.
+///
+/// \return cache_res_t   The cache result.
+/// \retval CACHE_RES_OK  On success.
+/// \retval CACHE_RES_ERR Otherwise.
+///
+cache_res_t cache_dcache_clean_invalidate_range(void *const addr, const uint32_t size);
+
+///
+/// \brief Prepares the buffer which will be read by DMA (memory to peripheral).
+///
+/// \param[in] buf  The buffer address.
+/// \param[in] size The buffer size in bytes.
+///
+/// \return cache_res_t   The cache result.
+/// \retval CACHE_RES_OK  On success.
+/// \retval CACHE_RES_ERR Otherwise.
+///
+cache_res_t cache_dma_tx_prepare(const void *const buf, const uint32_t size);
+
+///
+/// \brief Prepares the buffer which will be written by DMA (peripheral to memory).
+///
+/// \param[in] buf  The buffer address.
+/// \param[in] size The buffer size in bytes.
+///
+/// \return cache_res_t   The cache result.
+/// \retval CACHE_RES_OK  On success.
+/// \retval CACHE_RES_ERR Otherwise.
+///
+cache_res_t cache_dma_rx_prepare(void *const buf, const uint32_t size);
+
+///
+/// \brief Makes the data written by DMA visible to the CPU.
+///
+/// \param[in] buf  The buffer address.
+/// \param[in] size The buffer size in bytes.
+///
+/// \return cache_res_t   The cache result.
+/// \retval CACHE_RES_OK  On success.
+/// \retval CACHE_RES_ERR Otherwise.
+///
+cache_res_t cache_dma_rx_complete(void *const buf, const uint32_t size);
+
+///
+/// \brief Enables the flash ART accelerator and the flash prefetch.
+///
+void cache_flash_accel_enable(void);
+
+///
+/// \brief Resets the flash ART accelerator.
+///
+/// \note  It has to be called after the flash memory has been programmed, otherwise the ART may
+///        still serve the old content.
+///
+void cache_flash_accel_reset(void);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _CACHE_H */
@@ -0,0 +1,279 @@
+#include "data_structure/ring_buffer.h"
+#include <stddef.h>
+#include <string.h>
+
+///*************************************************************************************************
+/// Private functions - declaration.
+///*************************************************************************************************
+///
+/// \brief Copies the elements into the ring buffer from the index on, wrapped at the end.
+///
+/// \param[in,out] ring     The ring buffer.
+/// \param[in]     index    The free running index of the first element.
+/// \param[in]     elements The elements.
+/// \param[in]     count    The count of the elements, not more than the capacity.
+///
+static void ring_buffer_write(ring_buffer_t *const ring, const uint32_t index, const uint8_t *const elements,
+                              const uint32_t count);
+
+///
+/// \brief Copies the elements out of the ring buffer from the index on, wrapped at the end.
+///
+/// \param[in]  ring     The ring buffer.
+/// \param[in]  index    The free running index of the first element.
+/// \param[out] elements The elements.
+/// \param[in]  count    The count of the elements, not more than the capacity.
+///
+static void ring_buffer_read(const ring_buffer_t *const ring, const uint32_t index, uint8_t *const elements,
+                             const uint32_t count);
+
+///*************************************************************************************************
+/// Private functions - definition.
+///*************************************************************************************************
+static void ring_buffer_write(ring_buffer_t *const ring, const uint32_t index, const uint8_t *const elements,
+                              const uint32_t count)
+{
+    const uint32_t offset = index & ring->mask;
+    const uint32_t first  = ((ring->mask + 1u - offset) < count) ? (ring->mask + 1u - offset) : count;
+
+    memcpy(&ring->data[offset * ring->element_size], &elements[0], first * ring->element_size);
+
+    if (first < count)
+    {
+        memcpy(&ring->data[0], &elements[first * ring->element_size], (count - first) * ring->element_size);
+    }
+}
+
+static void ring_buffer_read(const ring_buffer_t *const ring, const uint32_t index, uint8_t *const elements,
+                             const uint32_t count)
+{
+    const uint32_t offset = index & ring->mask;
+    const uint32_t first  = ((ring->mask + 1u - offset) < count) ? (ring->mask + 1u - offset) : count;
+
+    memcpy(&elements[0], &ring->data[offset * ring->element_size], first * ring->element_size);
+
+    if (first < count)
+    {
+        memcpy(&elements[first * ring->element_size], &ring->data[0], (count - first) * ring->element_size);
+    }
+}
+
+///*************************************************************************************************
+/// Global functions - definition.
+///*************************************************************************************************
+ring_buffer_result_t ring_buffer_init(ring_buffer_t *const ring, void *const data, const uint32_t element_size,
+                                      const uint32_t capacity)
+{
+    if ((ring == NULL) || (data == NULL))
+    {
+        return RING_BUFFER_RESULT_NULL_POINTER;
+    }
+
+    if ((element_size == 0) || !RING_BUFFER_IS_POWER_OF_TWO(capacity))
+    {
+        return RING_BUFFER_RESULT_ERROR;
+    }
+
+    ring->data         = (uint8_t *)data;
+    ring->mask         = capacity - 1u;
+    ring->element_size = element_size;
+    ring->head         = 0;
+    ring->tail         = 0;
+
+    return RING_BUFFER_RESULT_SUCCESS;
+}
+
+void ring_buffer_clear(ring_buffer_t *const ring)
+{
+    /* The consumer pops everything pushed so far, the producer keeps its head. */
+    __atomic_store_n(&ring->tail, __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+}
+
+uint32_t ring_buffer_count(const ring_buffer_t *const ring)
+{
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
+
+uint32_t ring_buffer_space(const ring_buffer_t *const ring)
+{
+    return (ring->mask + 1u) - ring_buffer_count(ring);
+}
+
+ring_buffer_result_t ring_buffer_push(ring_buffer_t *const ring, const void *const element)
+{
+    if ((ring == NULL) || (element == NULL))
+    {
+        return RING_BUFFER_RESULT_NULL_POINTER;
+    }
+
+    const uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    const uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    if ((head - tail) > ring->mask)
+    {
+        return RING_BUFFER_RESULT_FULL;
+    }
+
+    /* The byte streams skip the call of the copy of the variable size. */
+    if (ring->element_size == 1u)
+    {
+        ring->data[head & ring->mask] = *(const uint8_t *)element;
+    }
+    else
+    {
+        memcpy(&ring->data[(head & ring->mask) * ring->element_size], element, ring->element_size);
+    }
+
+    /* The element is written before the consumer sees the new head. */
+    __atomic_store_n(&ring->head, head + 1u, __ATOMIC_RELEASE);
+
+    return RING_BUFFER_RESULT_SUCCESS;
+}
+
+ring_buffer_result_t ring_buffer_pop(ring_buffer_t *const ring, void *const element)
+{
+    if ((ring == NULL) || (element == NULL))
+    {
+        return RING_BUFFER_RESULT_NULL_POINTER;
+    }
+
+    const uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    const uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    if (head == tail)
+    {
+        return RING_BUFFER_RESULT_EMPTY;
+    }
+
+    if (ring->element_size == 1u)
+    {
+        *(uint8_t *)element = ring->data[tail & ring->mask];
+    }
+    else
+    {
+        memcpy(element, &ring->data[(tail & ring->mask) * ring->element_size], ring->element_size);
+    }
+
+    /* The element is read before the producer may overwrite it. */
+    __atomic_store_n(&ring->tail, tail + 1u, __ATOMIC_RELEASE);
+
+    return RING_BUFFER_RESULT_SUCCESS;
+}
+
+uint32_t ring_buffer_push_n(ring_buffer_t *const ring, const void *const elements, const uint32_t count)
+{
+    if ((ring == NULL) || (elements == NULL))
+    {
+        return 0;
+    }
+
+    const uint32_t head  = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    const uint32_t tail  = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    const uint32_t space = (ring->mask + 1u) - (head - tail);
+    const uint32_t size  = (count < space) ? count : space;
+
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    ring_buffer_write(ring, head, (const uint8_t *)elements, size);
+    __atomic_store_n(&ring->head, head + size, __ATOMIC_RELEASE);
+
+    return size;
+}
+
+uint32_t ring_buffer_pop_n(ring_buffer_t *const ring, void *const elements, const uint32_t count)
+{
+    if ((ring == NULL) || (elements == NULL))
+    {
+        return 0;
+    }
+
+    const uint32_t tail      = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    const uint32_t head      = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    const uint32_t available = head - tail;
+    const uint32_t size      = (count < available) ? count : available;
+
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    ring_buffer_read(ring, tail, (uint8_t *)elements, size);
+    __atomic_store_n(&ring->tail, tail + size, __ATOMIC_RELEASE);
+
+    return size;
+}
+
+uint32_t ring_buffer_reserve(const ring_buffer_t *const ring, void **const elements)
+{
+    if ((ring == NULL) || (elements == NULL))
+    {
+        return 0;
+    }
+
+    const uint32_t head   = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    const uint32_t tail   = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    const uint32_t index  = head & ring->mask;
+    const uint32_t space  = (ring->mask + 1u) - (head - tail);
+    const uint32_t linear = (ring->mask + 1u) - index;
+
+    *elements = &ring->data[index * ring->element_size];
+
+    return (space < linear) ? space : linear;
+}
+
+uint32_t ring_buffer_commit(ring_buffer_t *const ring, const uint32_t count)
+{
+    if (ring == NULL)
+    {
+        return 0;
+    }
+
+    const uint32_t head  = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    const uint32_t tail  = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    const uint32_t space = (ring->mask + 1u) - (head - tail);
+    const uint32_t size  = (count < space) ? count : space;
+
+    /* The elements are written in place before the consumer sees the new head. */
+    __atomic_store_n(&ring->head, head + size, __ATOMIC_RELEASE);
+
+    return size;
+}
+
+uint32_t ring_buffer_peek(const ring_buffer_t *const ring, const void **const elements)
+{
+    if ((ring == NULL) || (elements == NULL))
+    {
+        return 0;
+    }
+
+    const uint32_t tail      = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    const uint32_t head      = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    const uint32_t index     = tail & ring->mask;
+    const uint32_t available = head - tail;
+    const uint32_t linear    = (ring->mask + 1u) - index;
+
+    *elements = &ring->data[index * ring->element_size];
+
+    return (available < linear) ? available : linear;
+}
+
+uint32_t ring_buffer_skip(ring_buffer_t *const ring, const uint32_t count)
+{
+    if (ring == NULL)
+    {
+        return 0;
+    }
+
+    const uint32_t tail      = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    const uint32_t head      = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    const uint32_t available = head - tail;
+    const uint32_t size      = (count < available) ? count : available;
+
+    /* The elements are read in place before the producer may overwrite them. */
+    __atomic_store_n(&ring->tail, tail + size, __ATOMIC_RELEASE);
+
+    return size;
+}
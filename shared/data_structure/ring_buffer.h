@@ -0,0 +1,202 @@
+#ifndef _RING_BUFFER_H
+#define _RING_BUFFER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+///
+/// \brief Checks at compile time that the capacity is a non-zero power of two.
+///
+#define RING_BUFFER_IS_POWER_OF_TWO(capacity)   (((capacity) != 0u) && (((capacity) & ((capacity) - 1u)) == 0u))
+
+#ifdef __cplusplus
+#define RING_BUFFER_STATIC_ASSERT   static_assert
+#else
+#define RING_BUFFER_STATIC_ASSERT   _Static_assert
+#endif  /* __cplusplus */
+
+///
+/// \brief Defines the ring buffer instance with its static storage.
+///
+/// The capacity is given in elements and has to be a power of two, so the indices wrap by the mask.
+///
+/// \param[in] name         The instance name, the storage gets the name_data.
+/// \param[in] element_size The element size in bytes.
+/// \param[in] capacity     The capacity in elements.
+///
+#define RING_BUFFER_DEFINE(name, element_size, capacity)                                                \
+    RING_BUFFER_STATIC_ASSERT(RING_BUFFER_IS_POWER_OF_TWO(capacity), "The capacity is not a power of two"); \
+    static uint8_t name##_data[(element_size) * (capacity)] __attribute__((aligned(4)));                \
+    static ring_buffer_t name = { &name##_data[0], (capacity) - 1u, (element_size), 0u, 0u }
+
+///
+/// \brief The ring buffer result type.
+///
+typedef enum
+{
+    RING_BUFFER_RESULT_SUCCESS      = 0,
+    RING_BUFFER_RESULT_ERROR        = 1,
+    RING_BUFFER_RESULT_NULL_POINTER = 2,
+    RING_BUFFER_RESULT_FULL         = 3,
+    RING_BUFFER_RESULT_EMPTY        = 4,
+} ring_buffer_result_t;
+
+///
+/// \brief The single-producer, single-consumer ring buffer type.
+///
+/// The head and the tail run free and are masked on every access, the count is their difference,
+/// so all the capacity is used. Only the producer writes the head and only the consumer writes the
+/// tail, each one releases its own index after the data and acquires the other one before it, so
+/// an ISR and the main loop share the buffer without a lock.
+///
+typedef struct
+{
+    uint8_t          *data;         /*!< The storage of the capacity elements.                     */
+    uint32_t          mask;         /*!< The capacity minus one.                                   */
+    uint32_t          element_size; /*!< The element size in bytes.                                */
+    volatile uint32_t head;         /*!< The pushed element count, written by the producer.        */
+    volatile uint32_t tail;         /*!< The popped element count, written by the consumer.        */
+} ring_buffer_t;
+
+///*************************************************************************************************
+/// Global functions - definition.
+///*************************************************************************************************
+///
+/// \brief Initializes the ring buffer over the given storage.
+///
+/// \param[out] ring         The ring buffer.
+/// \param[in]  data         The storage of capacity * element_size bytes.
+/// \param[in]  element_size The element size in bytes.
+/// \param[in]  capacity     The capacity in elements, a power of two.
+///
+/// \return ring_buffer_result_t            Result of the function.
+/// \retval RING_BUFFER_RESULT_SUCCESS      On success.
+/// \retval RING_BUFFER_RESULT_NULL_POINTER On null pointer.
+/// \retval RING_BUFFER_RESULT_ERROR        On zero element size or capacity not a power of two.
+///
+ring_buffer_result_t ring_buffer_init(ring_buffer_t *const ring, void *const data, const uint32_t element_size,
+                                      const uint32_t capacity);
+
+///
+/// \brief Drops all the elements, called by the consumer.
+///
+/// \param[in,out] ring The ring buffer.
+///
+void ring_buffer_clear(ring_buffer_t *const ring);
+
+///
+/// \brief Gets the count of the elements to pop.
+///
+/// \param[in] ring The ring buffer.
+///
+/// \return uint32_t The count of the elements.
+///
+uint32_t ring_buffer_count(const ring_buffer_t *const ring);
+
+///
+/// \brief Gets the count of the elements to push.
+///
+/// \param[in] ring The ring buffer.
+///
+/// \return uint32_t The count of the free elements.
+///
+uint32_t ring_buffer_space(const ring_buffer_t *const ring);
+
+///
+/// \brief Pushes the element, called by the producer.
+///
+/// \param[in,out] ring    The ring buffer.
+/// \param[in]     element The element of element_size bytes.
+///
+/// \return ring_buffer_result_t            Result of the function.
+/// \retval RING_BUFFER_RESULT_SUCCESS      On success.
+/// \retval RING_BUFFER_RESULT_FULL         On full ring buffer, the element is not pushed.
+/// \retval RING_BUFFER_RESULT_NULL_POINTER On null pointer.
+///
+ring_buffer_result_t ring_buffer_push(ring_buffer_t *const ring, const void *const element);
+
+///
+/// \brief Pops the oldest element, called by the consumer.
+///
+/// \param[in,out] ring    The ring buffer.
+/// \param[out]    element The element of element_size bytes.
+///
+/// \return ring_buffer_result_t            Result of the function.
+/// \retval RING_BUFFER_RESULT_SUCCESS      On success.
+/// \retval RING_BUFFER_RESULT_EMPTY        On empty ring buffer.
+/// \retval RING_BUFFER_RESULT_NULL_POINTER On null pointer.
+///
+ring_buffer_result_t ring_buffer_pop(ring_buffer_t *const ring, void *const element);
+
+///
+/// \brief Pushes as many of the elements as fit, with at most two copies.
+///
+/// \param[in,out] ring     The ring buffer.
+/// \param[in]     elements The elements.
+/// \param[in]     count    The count of the elements.
+///
+/// \return uint32_t The count of the pushed elements.
+///
+uint32_t ring_buffer_push_n(ring_buffer_t *const ring, const void *const elements, const uint32_t count);
+
+///
+/// \brief Pops up to the count of the oldest elements, with at most two copies.
+///
+/// \param[in,out] ring     The ring buffer.
+/// \param[out]    elements The elements.
+/// \param[in]     count    The count of the elements the buffer holds.
+///
+/// \return uint32_t The count of the popped elements.
+///
+uint32_t ring_buffer_pop_n(ring_buffer_t *const ring, void *const elements, const uint32_t count);
+
+///
+/// \brief Gets the free elements back to back after the newest one, for the producer which writes
+///        them in place (e.g. a serializer) and pushes them with ring_buffer_commit later.
+///
+/// \param[in]  ring     The ring buffer.
+/// \param[out] elements The address of the first free element.
+///
+/// \return uint32_t The count of the free elements up to the end of the storage, 0 if full.
+///
+uint32_t ring_buffer_reserve(const ring_buffer_t *const ring, void **const elements);
+
+///
+/// \brief Pushes the elements written in place, called by the producer.
+///
+/// \param[in,out] ring  The ring buffer.
+/// \param[in]     count The count of the elements, up to the free ones.
+///
+/// \return uint32_t The count of the pushed elements.
+///
+uint32_t ring_buffer_commit(ring_buffer_t *const ring, const uint32_t count);
+
+///
+/// \brief Gets the oldest elements stored back to back, for the consumer which reads them in place
+///        (e.g. DMA) and pops them with ring_buffer_skip later.
+///
+/// \param[in]  ring     The ring buffer.
+/// \param[out] elements The address of the oldest element.
+///
+/// \return uint32_t The count of the elements up to the end of the storage, 0 if empty.
+///
+uint32_t ring_buffer_peek(const ring_buffer_t *const ring, const void **const elements);
+
+///
+/// \brief Pops the oldest elements without copying them, called by the consumer.
+///
+/// \param[in,out] ring  The ring buffer.
+/// \param[in]     count The count of the elements, up to the stored ones.
+///
+/// \return uint32_t The count of the popped elements.
+///
+uint32_t ring_buffer_skip(ring_buffer_t *const ring, const uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif /* _RING_BUFFER_H */
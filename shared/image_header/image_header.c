@@ -0,0 +1,63 @@
+#include "image_header.h"
+#include <stddef.h>
+
+///*************************************************************************************************
+/// Private objects - definition.
+///*************************************************************************************************
+///
+/// \brief The nibble-wise table of the reflected CRC-32 polynomial 0xedb88320.
+///
+static const uint32_t image_header_crc32_lut[0x10] =
+{
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c,
+};
+
+///*************************************************************************************************
+/// Global functions - definition.
+///*************************************************************************************************
+const image_header_t* image_header_get(const uint32_t *const image)
+{
+    return (const image_header_t *)&image[IMAGE_HEADER_OFFSET / sizeof(uint32_t)];
+}
+
+image_header_res_t image_header_check(const image_header_t *const header, const uint32_t size)
+{
+    if ((header == NULL) || (header->magic != IMAGE_HEADER_MAGIC))
+    {
+        return IMAGE_HEADER_RES_ERR_MAGIC;
+    }
+
+    if ((header->length < (IMAGE_HEADER_OFFSET + sizeof(image_header_t))) || (header->length > size) ||
+        ((header->length % sizeof(uint32_t)) != 0))
+    {
+        return IMAGE_HEADER_RES_ERR_LENGTH;
+    }
+
+    return IMAGE_HEADER_RES_OK;
+}
+
+uint32_t image_header_crc32_update(uint32_t crc, const uint8_t *const data, const uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        crc  = (crc >> 4) ^ image_header_crc32_lut[crc & 0x0f];
+        crc  = (crc >> 4) ^ image_header_crc32_lut[crc & 0x0f];
+    }
+
+    return crc;
+}
+
+uint32_t image_header_crc32(const uint32_t *const image)
+{
+    const image_header_t *header = image_header_get(image);
+    const uint8_t *data = (const uint8_t *)image;
+    uint32_t crc = 0xffffffff;
+
+    crc = image_header_crc32_update(crc, &data[0], IMAGE_HEADER_CRC32_OFFSET);
+    crc = image_header_crc32_update(crc, &data[IMAGE_HEADER_CRC32_OFFSET + sizeof(uint32_t)],
+                                    header->length - (IMAGE_HEADER_CRC32_OFFSET + sizeof(uint32_t)));
+
+    return ~crc;
+}
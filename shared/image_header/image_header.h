@@ -0,0 +1,96 @@
+#ifndef _IMAGE_HEADER_H
+#define _IMAGE_HEADER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+#define IMAGE_HEADER_MAGIC      (0x48494647u)   /*!< "GFIH", an erased image reads 0xffffffff.        */
+#define IMAGE_HEADER_OFFSET     (0x0200u)       /*!< The header follows the vector table.              */
+
+///
+/// \brief Packs the image version.
+///
+#define IMAGE_HEADER_VERSION(major, minor, patch) \
+    ((((uint32_t)(major) & 0xffu) << 0x10) | (((uint32_t)(minor) & 0xffu) << 0x08) | ((uint32_t)(patch) & 0xffu))
+
+///
+/// \brief The offset of the CRC-32 field, the CRC-32 covers the image before and after it.
+///
+#define IMAGE_HEADER_CRC32_OFFSET   (IMAGE_HEADER_OFFSET + 0x0cu)
+
+///
+/// \brief The image header type.
+///
+/// The image places the header at IMAGE_HEADER_OFFSET from its start, with the length and the
+/// CRC-32 left 0. The build fills them in after the link (scripts/image_header.py), so an image
+/// which was not patched never validates.
+///
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;                       /*!< IMAGE_HEADER_VERSION() of the image.                  */
+    uint32_t length;                        /*!< The image bytes from its start, a multiple of 4.      */
+    uint32_t crc32;                         /*!< The CRC-32 (zlib) of the image but this field.        */
+} image_header_t;
+
+///
+/// \brief The image header result type.
+///
+typedef enum
+{
+    IMAGE_HEADER_RES_OK = 0,
+    IMAGE_HEADER_RES_ERR_MAGIC,
+    IMAGE_HEADER_RES_ERR_LENGTH,
+    IMAGE_HEADER_RES_ERR_CRC,
+} image_header_res_t;
+
+///
+/// \brief Gets the header of the image.
+///
+/// \param[in] image The start of the image.
+///
+/// \return const image_header_t* The header.
+///
+const image_header_t* image_header_get(const uint32_t *const image);
+
+///
+/// \brief Checks the header fields of the image, the CRC-32 is not calculated.
+///
+/// \param[in] header The header, possibly of an erased or a partially written image.
+/// \param[in] size   The size of the image region.
+///
+/// \return image_header_res_t          The image header result.
+/// \retval IMAGE_HEADER_RES_OK         If the length of the image can be checked.
+/// \retval IMAGE_HEADER_RES_ERR_MAGIC  If there is no header.
+/// \retval IMAGE_HEADER_RES_ERR_LENGTH If the length does not fit the region.
+///
+image_header_res_t image_header_check(const image_header_t *const header, const uint32_t size);
+
+///
+/// \brief Continues the CRC-32 (zlib) over the data, on the CPU.
+///
+/// \param[in] crc  The CRC-32 so far, 0xffffffff to start.
+/// \param[in] data The data.
+/// \param[in] size The data size.
+///
+/// \return uint32_t The CRC-32 to continue, the final value is its complement.
+///
+uint32_t image_header_crc32_update(uint32_t crc, const uint8_t *const data, const uint32_t size);
+
+///
+/// \brief Calculates the CRC-32 of the image the header describes, on the CPU.
+///
+/// \param[in] image The start of the image, its header checked already.
+///
+/// \return uint32_t The CRC-32 to compare with the header one.
+///
+uint32_t image_header_crc32(const uint32_t *const image);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _IMAGE_HEADER_H */
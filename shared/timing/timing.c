@@ -5,26 +5,7 @@
 #include "libopencm3/stm32/rcc.h"
 #include <stdbool.h>
 
-///*************************************************************************************************
-/// Private objects - definition.
-///*************************************************************************************************
-///
-/// \brief System clock frequency value (Hz) stored in shared memory for use across all firmware
-///        stages.
-///
-volatile uint32_t __attribute__((section(".shared"))) timing_sysclk_freq;
-
-///
-/// \brief APB1 frequency value (Hz) stored in shared memory for use across all firmware
-///        stages.
-///
-volatile uint32_t __attribute__((section(".shared"))) timing_apb1_freq;
-
-///
-/// \brief APB2 frequency value (Hz) stored in shared memory for use across all firmware
-///        stages.
-///
-volatile uint32_t __attribute__((section(".shared"))) timing_apb2_freq;
+_Static_assert(TIMING_BOOT_STAGE_TOTAL_SIZE <= BOOT_HANDOFF_STAMPS, "The boot stages do not fit the hand-off block");
 
 ///*************************************************************************************************
 /// Global functions - definition.
@@ -57,6 +38,52 @@ uint32_t timing_cnt_get(void)
     return DWT_CYCCNT;
 }
 
+void timing_boot_start(void)
+{
+    uint32_t clocks = timing_cnt_get();
+
+    timing_start();
+
+    /* The hand-off block holds the stamps of the previous boot. */
+    for (uint32_t i = 0; i < TIMING_BOOT_STAGE_TOTAL_SIZE; i++)
+    {
+        timing_boot_stamps[i] = 0;
+    }
+
+    timing_boot_stamps[TIMING_BOOT_STAGE_CLOCKS] = clocks;
+
+    boot_handoff_seal(BOOT_HANDOFF);
+}
+
+void timing_boot_stamp(const timing_boot_stage_t stage)
+{
+    if (stage < TIMING_BOOT_STAGE_TOTAL_SIZE)
+    {
+        timing_boot_stamps[stage] = timing_cnt_get();
+
+        /* The block stays valid over a reset at any stage. */
+        boot_handoff_seal(BOOT_HANDOFF);
+    }
+}
+
+uint32_t timing_boot_us(const timing_boot_stage_t stage)
+{
+    if ((stage >= TIMING_BOOT_STAGE_TOTAL_SIZE) || (timing_boot_stamps[stage] == 0))
+    {
+        return 0;
+    }
+
+    if (stage == TIMING_BOOT_STAGE_CLOCKS)
+    {
+        return timing_boot_stamps[stage] / (TIMING_HSI_FREQ / 1000000u);
+    }
+
+    /* The counter restarted at 0 after the clock bring-up. */
+    uint32_t prev = (stage == TIMING_BOOT_STAGE_BOOTLOADER) ? 0 : timing_boot_stamps[stage - 1];
+
+    return (uint32_t)(((uint64_t)(timing_boot_stamps[stage] - prev) * 1000000u) / timing_sysclk_freq);
+}
+
 void timing_delay_us(const uint32_t us)
 {
     uint32_t ticks = TIMING_US_TO_TICKS(us);
@@ -1,28 +1,53 @@
 #ifndef _TIMING_H
 #define _TIMING_H
 
+#include "boot_handoff.h"
 #include <stdint.h>
 
 #define TIMING_TICK_DURATION    ((1.0f)/(timing_sysclk_freq))
 #define TIMING_US_TO_TICKS(us)  ((us)/((TIMING_TICK_DURATION) * (1000000.0f)))
+#define TIMING_HSI_FREQ         (16000000u)     /*!< The clock the bootloader starts on (Hz).          */
 
 ///
-/// \brief System clock frequency value (Hz) stored in shared memory for use across all firmware
-///        stages.
+/// \brief System clock frequency value (Hz) handed over to all firmware stages.
 ///
-extern volatile uint32_t timing_sysclk_freq;
+#define timing_sysclk_freq      (BOOT_HANDOFF->clocks.sysclk)
 
 ///
-/// \brief APB1 frequency value (Hz) stored in shared memory for use across all firmware
-///        stages.
+/// \brief APB1 frequency value (Hz) handed over to all firmware stages.
 ///
-extern volatile uint32_t timing_apb1_freq;
+#define timing_apb1_freq        (BOOT_HANDOFF->clocks.apb1)
 
 ///
-/// \brief APB2 frequency value (Hz) stored in shared memory for use across all firmware
-///        stages.
+/// \brief APB2 frequency value (Hz) handed over to all firmware stages.
 ///
-extern volatile uint32_t timing_apb2_freq;
+#define timing_apb2_freq        (BOOT_HANDOFF->clocks.apb2)
+
+///
+/// \brief The boot stage type.
+///
+/// The stages are stamped in order by the boot chain. The clock bring-up is counted in HSI cycles,
+/// the counter restarts on the system clock afterwards.
+///
+typedef enum timing_boot_stage
+{
+    TIMING_BOOT_STAGE_CLOCKS = 0,           /*!< The bootloader brought the clocks up.                 */
+    TIMING_BOOT_STAGE_BOOTLOADER,           /*!< The bootloader jumps to the apploader.                */
+    TIMING_BOOT_STAGE_APPLOADER,            /*!< The apploader is entered.                             */
+    TIMING_BOOT_STAGE_IMAGE_CHECKED,        /*!< The apploader jumps to the app or the updater.        */
+    TIMING_BOOT_STAGE_IMAGE,                /*!< The app or the updater is entered.                    */
+    TIMING_BOOT_STAGE_DRIVERS,              /*!< The drivers and the modules are initialized.          */
+    TIMING_BOOT_STAGE_RC_READY,             /*!< The radio released the ready switch.                  */
+    TIMING_BOOT_STAGE_IMU,                  /*!< The IMU is initialized.                               */
+    TIMING_BOOT_STAGE_ARMABLE,              /*!< The IMU is calibrated, the control loop starts.       */
+    TIMING_BOOT_STAGE_TOTAL_SIZE,
+} timing_boot_stage_t;
+
+///
+/// \brief The cycle counter values of the boot stages handed over to all firmware stages, 0 for the
+///        stages which were not reached.
+///
+#define timing_boot_stamps      (BOOT_HANDOFF->stamps)
 
 ///
 /// \brief The timing result type.
@@ -59,6 +84,33 @@ void timing_stop(void);
 ///
 uint32_t timing_cnt_get(void);
 
+///
+/// \brief Stamps the clock bring-up, clears the other stages and restarts the cycle counter.
+///
+/// \note Called by the bootloader once the system clock runs and the hand-off block was opened, the
+///       counter was started on HSI.
+///
+void timing_boot_start(void);
+
+///
+/// \brief Stamps the boot stage with the cycle counter value and seals the hand-off block.
+///
+/// \param[in] stage The boot stage reached.
+///
+void timing_boot_stamp(const timing_boot_stage_t stage);
+
+///
+/// \brief Gets the time spent in the boot stage, since the previous stage was stamped.
+///
+/// \note The counter wraps after 2^32 cycles, about 19.9 s at 216 MHz, the stage waiting for the
+///       radio may exceed it.
+///
+/// \param[in] stage The boot stage.
+///
+/// \return uint32_t The stage duration in microseconds, 0 if the stage was not reached.
+///
+uint32_t timing_boot_us(const timing_boot_stage_t stage);
+
 ///
 /// \brief Delays for the given number of microseconds.
 ///
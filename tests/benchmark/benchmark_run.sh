@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Builds and runs the benchmarks, one JSON report per executable in results/<commit>.
+# Compare two runs with: python3 ../../scripts/benchmark_compare.py results/<old> results/<new>
+
+out=results/$(git rev-parse --short HEAD)$(git diff --quiet HEAD -- ../.. || echo "-dirty")
+
+rm -rf build
+cmake -G "Ninja" -S . -B build -DPROJECT_ROOT_DIR=$(pwd)/../..
+cmake --build build
+
+mkdir -p ${out}
+
+for bench in spi_nor circular_buffer ring_buffer dust blackbox controller telemetry; do
+    bench_path=$(find build -type f -name ${bench} -perm -u+x | head -1)
+    ${bench_path} --benchmark_repetitions=5 --benchmark_report_aggregates_only=true \
+        --benchmark_out=${out}/${bench}.json --benchmark_out_format=json "$@"
+done
@@ -0,0 +1,202 @@
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <vector>
+#include "ll_spi_nor.h"
+#include "spi_nor_fake.h"
+
+#define SPI_NOR_CAPACITY        (0x14u)             /*!< The 1 MiB device.                              */
+#define LOG_PAGES               (0x0800u)           /*!< The pages logged by the throughput benchmarks. */
+#define LOG_CYCLES              (0x1000u)           /*!< The control cycles of the latency benchmarks.  */
+#define LOG_CYCLE_NS            (1000000u)          /*!< The 1 kHz control loop.                        */
+#define LOG_CYCLE_BYTES         (16u)               /*!< The blackbox frame every other cycle.          */
+
+///
+/// \brief The log written the simple way: the page programmed and waited for when full, the sector
+///        erased and waited for when reached.
+///
+struct naive
+{
+    uint8_t  page[LL_SPI_NOR_PAGE_SIZE];
+    uint32_t fill;
+    uint32_t addr;
+    uint32_t erased;
+};
+
+static void naive_write(struct ll_spi_nor *const dev, struct naive *const log, const uint8_t *const data,
+                        const uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        log->page[log->fill++] = data[i];
+
+        if (log->fill < LL_SPI_NOR_PAGE_SIZE)
+        {
+            continue;
+        }
+
+        if (log->addr >= log->erased)
+        {
+            (void)ll_spi_nor_erase(dev, log->erased, LL_SPI_NOR_SECTOR_SIZE);
+            ll_spi_nor_wait(dev);
+            log->erased += LL_SPI_NOR_SECTOR_SIZE;
+        }
+
+        (void)ll_spi_nor_page_program(dev, log->addr, &log->page[0], LL_SPI_NOR_PAGE_SIZE);
+        ll_spi_nor_wait(dev);
+        log->addr += LL_SPI_NOR_PAGE_SIZE;
+        log->fill  = 0;
+    }
+}
+
+///
+/// \brief Writes all the data to the log, polls it while it takes nothing.
+///
+static void log_write_all(struct ll_spi_nor *const dev, const uint8_t *const data, const uint32_t size)
+{
+    uint32_t taken = 0;
+
+    while (taken < size)
+    {
+        taken += ll_spi_nor_log_write(dev, &data[taken], size - taken);
+
+        if ((taken < size) && (ll_spi_nor_log_poll(dev) == LL_SPI_NOR_RES_FULL))
+        {
+            return;
+        }
+    }
+}
+
+///
+/// \brief Starts the fake device and the driver on it.
+///
+/// \note The times reported are the ones of the virtual clock of the fake, every byte on the bus,
+///       every page program and every erase advances it by the typical device time.
+///
+static bool start(benchmark::State &state, struct ll_spi_nor *const dev)
+{
+    spi_nor_fake_reset(SPI_NOR_CAPACITY);
+
+    if (ll_spi_nor_init(dev, &spi_nor_fake_bus) != LL_SPI_NOR_RES_OK)
+    {
+        state.SkipWithError("init failed");
+        return false;
+    }
+
+    return true;
+}
+
+///
+/// \brief The page logged as fast as the device takes it, the simple way.
+///
+static void BM_spi_nor_log_simple(benchmark::State &state)
+{
+    struct ll_spi_nor dev;
+    struct naive log = {};
+    std::vector<uint8_t> page(LL_SPI_NOR_PAGE_SIZE, 0xa5);
+
+    if (!start(state, &dev))
+    {
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        uint64_t begin = spi_nor_fake_now();
+        naive_write(&dev, &log, &page[0], page.size());
+        state.SetIterationTime((double)(spi_nor_fake_now() - begin) * 1e-9);
+    }
+
+    state.SetBytesProcessed(state.iterations() * LL_SPI_NOR_PAGE_SIZE);
+}
+BENCHMARK(BM_spi_nor_log_simple)->UseManualTime()->Iterations(LOG_PAGES);
+
+///
+/// \brief The page logged as fast as the device takes it, the page program and the erase ahead
+///        pipelined by the driver.
+///
+static void BM_spi_nor_log_pipelined(benchmark::State &state)
+{
+    struct ll_spi_nor dev;
+    std::vector<uint8_t> page(LL_SPI_NOR_PAGE_SIZE, 0xa5);
+
+    if (!start(state, &dev))
+    {
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        uint64_t begin = spi_nor_fake_now();
+        log_write_all(&dev, &page[0], page.size());
+        state.SetIterationTime((double)(spi_nor_fake_now() - begin) * 1e-9);
+    }
+
+    state.SetBytesProcessed(state.iterations() * LL_SPI_NOR_PAGE_SIZE);
+}
+BENCHMARK(BM_spi_nor_log_pipelined)->UseManualTime()->Iterations(LOG_PAGES);
+
+///
+/// \brief The time the control loop spends in the write of its bytes every cycle, the simple way.
+///
+static void BM_spi_nor_cycle_simple(benchmark::State &state)
+{
+    struct ll_spi_nor dev;
+    struct naive log = {};
+    std::vector<uint8_t> frame(LOG_CYCLE_BYTES, 0xa5);
+    uint64_t most = 0;
+
+    if (!start(state, &dev))
+    {
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        uint64_t begin = spi_nor_fake_now();
+        naive_write(&dev, &log, &frame[0], frame.size());
+        uint64_t spent = spi_nor_fake_now() - begin;
+
+        most = (spent > most) ? spent : most;
+        state.SetIterationTime((double)spent * 1e-9);
+        spi_nor_fake_elapse((spent < LOG_CYCLE_NS) ? (LOG_CYCLE_NS - spent) : 0);
+    }
+
+    state.counters["max_us"] = (double)most * 1e-3;
+}
+BENCHMARK(BM_spi_nor_cycle_simple)->UseManualTime()->Iterations(LOG_CYCLES);
+
+///
+/// \brief The time the control loop spends in the write of its bytes every cycle, the bytes the log
+///        does not take kept for the next cycle.
+///
+static void BM_spi_nor_cycle_pipelined(benchmark::State &state)
+{
+    struct ll_spi_nor dev;
+    std::vector<uint8_t> frame(LOG_CYCLE_BYTES, 0xa5);
+    std::vector<uint8_t> backlog;
+    uint64_t most = 0;
+    size_t backlog_most = 0;
+
+    if (!start(state, &dev))
+    {
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        uint64_t begin = spi_nor_fake_now();
+        backlog.insert(backlog.end(), frame.begin(), frame.end());
+        uint32_t taken = ll_spi_nor_log_write(&dev, backlog.data(), backlog.size());
+        backlog.erase(backlog.begin(), backlog.begin() + taken);
+        uint64_t spent = spi_nor_fake_now() - begin;
+
+        most         = (spent > most) ? spent : most;
+        backlog_most = (backlog.size() > backlog_most) ? backlog.size() : backlog_most;
+        state.SetIterationTime((double)spent * 1e-9);
+        spi_nor_fake_elapse((spent < LOG_CYCLE_NS) ? (LOG_CYCLE_NS - spent) : 0);
+    }
+
+    state.counters["max_us"]      = (double)most * 1e-3;
+    state.counters["max_backlog"] = (double)backlog_most;
+}
+BENCHMARK(BM_spi_nor_cycle_pipelined)->UseManualTime()->Iterations(LOG_CYCLES);
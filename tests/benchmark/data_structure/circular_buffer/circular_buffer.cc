@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include "data_structure/circular_buffer.h"
+
+///
+/// \brief The burst of pushes drained by as many pops, the argument is the burst size.
+///
+static void BM_circular_buffer_push_pop(benchmark::State &state)
+{
+    uint32_t burst = (uint32_t)state.range(0);
+    uint8_t element = 0;
+
+    circular_buffer_clear_all();
+
+    for (auto _ : state)
+    {
+        for (uint32_t i = 0; i < burst; i++)
+        {
+            circular_buffer_push(CIRCULAR_BUFFER_INSTANCE_0, (uint8_t)i);
+        }
+
+        for (uint32_t i = 0; i < burst; i++)
+        {
+            circular_buffer_pop(CIRCULAR_BUFFER_INSTANCE_0, &element);
+        }
+
+        benchmark::DoNotOptimize(element);
+    }
+
+    state.SetItemsProcessed(state.iterations() * burst);
+}
+BENCHMARK(BM_circular_buffer_push_pop)->RangeMultiplier(4)->Range(1, CIRCULAR_BUFFER_LENGTH);
+
+///
+/// \brief The push into the full buffer, the overflow path of the receiver falling behind.
+///
+static void BM_circular_buffer_push_full(benchmark::State &state)
+{
+    circular_buffer_clear_all();
+
+    for (uint32_t i = 0; i < CIRCULAR_BUFFER_LENGTH; i++)
+    {
+        circular_buffer_push(CIRCULAR_BUFFER_INSTANCE_0, (uint8_t)i);
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(circular_buffer_push(CIRCULAR_BUFFER_INSTANCE_0, 0x5a));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_circular_buffer_push_full);
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include "data_structure/circular_buffer.h"
+#include "data_structure/ring_buffer.h"
+
+#define RING_SIZE   (0x0100u)
+
+///
+/// \brief The byte ring, larger than the circular buffer so the bursts never fill it.
+///
+RING_BUFFER_DEFINE(ring, sizeof(uint8_t), RING_SIZE);
+
+///
+/// \brief The burst of pushes drained by as many pops, one byte per call. The arguments are the ones
+///        of BM_circular_buffer_push_pop, the rows compare one to one.
+///
+static void BM_ring_buffer_push_pop(benchmark::State &state)
+{
+    uint32_t burst = (uint32_t)state.range(0);
+    uint8_t element = 0;
+
+    ring_buffer_clear(&ring);
+
+    for (auto _ : state)
+    {
+        for (uint32_t i = 0; i < burst; i++)
+        {
+            uint8_t value = (uint8_t)i;
+            (void)ring_buffer_push(&ring, &value);
+        }
+
+        for (uint32_t i = 0; i < burst; i++)
+        {
+            (void)ring_buffer_pop(&ring, &element);
+        }
+
+        benchmark::DoNotOptimize(element);
+    }
+
+    state.SetItemsProcessed(state.iterations() * burst);
+}
+BENCHMARK(BM_ring_buffer_push_pop)->RangeMultiplier(4)->Range(1, CIRCULAR_BUFFER_LENGTH);
+
+///
+/// \brief The same burst pushed and popped as one block each, at most two copies per call.
+///
+static void BM_ring_buffer_push_pop_n(benchmark::State &state)
+{
+    uint32_t burst = (uint32_t)state.range(0);
+    uint8_t in[CIRCULAR_BUFFER_LENGTH];
+    uint8_t out[CIRCULAR_BUFFER_LENGTH];
+
+    for (uint32_t i = 0; i < CIRCULAR_BUFFER_LENGTH; i++)
+    {
+        in[i] = (uint8_t)i;
+    }
+
+    ring_buffer_clear(&ring);
+
+    /* The indices start off the burst boundary, so the blocks keep crossing the wrap. */
+    (void)ring_buffer_push_n(&ring, &in[0], 3);
+    (void)ring_buffer_pop_n(&ring, &out[0], 3);
+
+    for (auto _ : state)
+    {
+        (void)ring_buffer_push_n(&ring, &in[0], burst);
+        (void)ring_buffer_pop_n(&ring, &out[0], burst);
+
+        benchmark::DoNotOptimize(out[0]);
+    }
+
+    state.SetItemsProcessed(state.iterations() * burst);
+}
+BENCHMARK(BM_ring_buffer_push_pop_n)->RangeMultiplier(4)->Range(1, CIRCULAR_BUFFER_LENGTH);
@@ -0,0 +1,253 @@
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "dust.h"
+
+///
+/// \brief The payload of the given size, the bytes of an image.
+///
+static std::vector<uint8_t> data(const uint32_t size)
+{
+    std::vector<uint8_t> buffer(size);
+    uint32_t seed = 3;
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        seed      = (seed * 1103515245u) + 12345u;
+        buffer[i] = (uint8_t)(seed >> 16);
+    }
+
+    return buffer;
+}
+
+///
+/// \brief The byte-wise table method the crc16 used before, run over the published table.
+///
+static uint16_t crc16_bytewise(const uint8_t *const data, const uint32_t size)
+{
+    const uint16_t *lut = dust_crc16_get_lut_address();
+    uint16_t crc16 = 0;
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        crc16 = (uint16_t)((crc16 << 8) ^ lut[(crc16 >> 8) ^ data[i]]);
+    }
+
+    return crc16;
+}
+
+///
+/// \brief The crc16 of the packet as it was calculated before, through the temporary copies.
+///
+static uint16_t crc16_copied(const uint8_t *const header, const uint8_t *const payload, const uint32_t size)
+{
+    std::vector<uint8_t> serialized_data(payload, payload + size);
+    std::vector<uint8_t> serialized_header_and_data(DUST_PACKET_HEADER_SIZE + size);
+
+    memcpy(&serialized_header_and_data[0], header, DUST_PACKET_HEADER_SIZE);
+    memcpy(&serialized_header_and_data[DUST_PACKET_HEADER_SIZE], &serialized_data[0], size);
+
+    return crc16_bytewise(&serialized_header_and_data[0], serialized_header_and_data.size());
+}
+
+///
+/// \brief Gets the length field of the payload size.
+///
+static dust_length_t length_get(const uint32_t size)
+{
+    switch (size)
+    {
+        case 32:  return DUST_LENGTH_BYTES32;
+        case 64:  return DUST_LENGTH_BYTES64;
+        case 128: return DUST_LENGTH_BYTES128;
+        default:  return DUST_LENGTH_BYTES256;
+    }
+}
+
+///
+/// \brief Creates the packet of the payload size, the crc16 included.
+///
+static void packet_create(dust_packet_t *const packet, const uint32_t size)
+{
+    std::vector<uint8_t> payload = data(size);
+    dust_header_t header = {};
+
+    dust_crc16_generate_lut(0x1021);
+    dust_header_create(&header, DUST_OPCODE_DATA, length_get(size), DUST_ACK_UNSET, 1);
+
+    packet->header              = header;
+    packet->payload.buffer_size = size;
+    dust_payload_create(&packet->payload, &payload[0], size);
+}
+
+///
+/// \brief The crc16 of the data, the argument is its size: from the header alone to the large payload.
+///
+/// \note dust_crc16_calculate() is private, it runs the header and the payload through these calls.
+///
+static void BM_dust_crc16(benchmark::State &state)
+{
+    uint32_t size = (uint32_t)state.range(0);
+    std::vector<uint8_t> buffer = data(size);
+
+    dust_crc16_generate_lut(0x1021);
+
+    for (auto _ : state)
+    {
+        uint16_t crc16 = dust_crc16_init();
+
+        crc16 = dust_crc16_update(crc16, &buffer[0], size);
+        benchmark::DoNotOptimize(dust_crc16_final(crc16));
+    }
+
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_dust_crc16)->RangeMultiplier(2)->Range(DUST_PACKET_HEADER_SIZE, DUST_PACKET_PAYLOAD_LARGE_MAX_SIZE);
+
+///
+/// \brief The byte-wise table method over the same data, the previous crc16 without the copies.
+///
+static void BM_dust_crc16_bytewise(benchmark::State &state)
+{
+    uint32_t size = (uint32_t)state.range(0);
+    std::vector<uint8_t> buffer = data(size);
+
+    dust_crc16_generate_lut(0x1021);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(crc16_bytewise(&buffer[0], size));
+    }
+
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_dust_crc16_bytewise)->RangeMultiplier(2)->Range(DUST_PACKET_HEADER_SIZE, DUST_PACKET_PAYLOAD_LARGE_MAX_SIZE);
+
+///
+/// \brief The crc16 of the header and the payload the way it was calculated before, through the
+///        temporary copies and the byte-wise table, the argument is the payload size.
+///
+static void BM_dust_crc16_copied(benchmark::State &state)
+{
+    uint32_t size = (uint32_t)state.range(0);
+    std::vector<uint8_t> buffer = data(DUST_PACKET_HEADER_SIZE + size);
+
+    dust_crc16_generate_lut(0x1021);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(crc16_copied(&buffer[0], &buffer[DUST_PACKET_HEADER_SIZE], size));
+    }
+
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_dust_crc16_copied)->RangeMultiplier(2)->Range(32, DUST_PACKET_PAYLOAD_BUFFER_MAX_SIZE);
+
+///
+/// \brief The same crc16 run over the header and the payload in place, the argument is the payload size.
+///
+static void BM_dust_crc16_packet(benchmark::State &state)
+{
+    uint32_t size = (uint32_t)state.range(0);
+    std::vector<uint8_t> buffer = data(DUST_PACKET_HEADER_SIZE + size);
+
+    dust_crc16_generate_lut(0x1021);
+
+    for (auto _ : state)
+    {
+        uint16_t crc16 = dust_crc16_update(dust_crc16_init(), &buffer[0], DUST_PACKET_HEADER_SIZE);
+
+        crc16 = dust_crc16_update(crc16, &buffer[DUST_PACKET_HEADER_SIZE], size);
+        benchmark::DoNotOptimize(dust_crc16_final(crc16));
+    }
+
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_dust_crc16_packet)->RangeMultiplier(2)->Range(32, DUST_PACKET_PAYLOAD_BUFFER_MAX_SIZE);
+
+///
+/// \brief The packet serialization, the argument is the payload size.
+///
+static void BM_dust_serialize(benchmark::State &state)
+{
+    uint32_t size = (uint32_t)state.range(0);
+    std::vector<uint8_t> serialized(DUST_PACKET_HEADER_SIZE + size + DUST_PACKET_CRC16_SIZE);
+    static dust_packet_t packet;
+
+    packet_create(&packet, size);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(dust_serialize(&packet, &serialized[0], serialized.size()));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * serialized.size());
+}
+BENCHMARK(BM_dust_serialize)->RangeMultiplier(2)->Range(32, DUST_PACKET_PAYLOAD_BUFFER_MAX_SIZE);
+
+///
+/// \brief The packet deserialization, the crc16 check included, the argument is the payload size.
+///
+static void BM_dust_deserialize(benchmark::State &state)
+{
+    uint32_t size = (uint32_t)state.range(0);
+    std::vector<uint8_t> serialized(DUST_PACKET_HEADER_SIZE + size + DUST_PACKET_CRC16_SIZE);
+    static dust_packet_t packet;
+
+    packet_create(&packet, size);
+
+    if (dust_serialize(&packet, &serialized[0], serialized.size()) != DUST_RESULT_SUCCESS)
+    {
+        state.SkipWithError("serialization failed");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        if (dust_deserialize(&packet, &serialized[0], serialized.size()) != DUST_RESULT_SUCCESS)
+        {
+            state.SkipWithError("deserialization failed");
+            break;
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * serialized.size());
+}
+BENCHMARK(BM_dust_deserialize)->RangeMultiplier(2)->Range(32, DUST_PACKET_PAYLOAD_BUFFER_MAX_SIZE);
+
+///
+/// \brief The in-place parsing the receiver uses instead of the deserialization, for the comparison.
+///
+static void BM_dust_view_parse(benchmark::State &state)
+{
+    uint32_t size = (uint32_t)state.range(0);
+    std::vector<uint8_t> serialized(DUST_PACKET_HEADER_SIZE + size + DUST_PACKET_CRC16_SIZE);
+    static dust_packet_t packet;
+    dust_view_t view;
+
+    packet_create(&packet, size);
+
+    if (dust_serialize(&packet, &serialized[0], serialized.size()) != DUST_RESULT_SUCCESS)
+    {
+        state.SkipWithError("serialization failed");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        if (dust_view_parse(&view, &serialized[0], serialized.size(), size) != DUST_RESULT_SUCCESS)
+        {
+            state.SkipWithError("parsing failed");
+            break;
+        }
+
+        benchmark::DoNotOptimize(view);
+    }
+
+    state.SetBytesProcessed(state.iterations() * serialized.size());
+}
+BENCHMARK(BM_dust_view_parse)->RangeMultiplier(2)->Range(32, DUST_PACKET_PAYLOAD_BUFFER_MAX_SIZE);
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <vector>
+#include "ahrs.h"
+#include "ghf.h"
+#include "pid.h"
+#include "blackbox.h"
+
+#define SAMPLES     (0x0100u)               /* A power of two, the encoder cycles through the frames. */
+
+///
+/// \brief The slowly changing frames of the logged control cycles, the cycle counter wrapping.
+///
+static std::vector<blackbox_frame_t> frames(void)
+{
+    std::vector<blackbox_frame_t> samples(SAMPLES);
+
+    for (uint32_t n = 0; n < SAMPLES; n++)
+    {
+        for (uint32_t i = 0; i < BLACKBOX_FIELD_TOTAL; i++)
+        {
+            samples[n].field[i] = (int32_t)(((n * (i + 1)) % 7) * ((i & 1) ? -1 : 1)) + (int32_t)(i * 1000);
+        }
+
+        samples[n].field[BLACKBOX_FIELD_TIME_START] = (int32_t)(0xfffff000u + (n * 27000u));
+    }
+
+    return samples;
+}
+
+///
+/// \brief The delta and varint encoding of one frame, the cost the recorder adds to the logged cycle.
+///
+static void BM_blackbox_encode(benchmark::State &state)
+{
+    std::vector<blackbox_frame_t> samples = frames();
+    blackbox_encoder_t encoder;
+    uint8_t buffer[BLACKBOX_FRAME_SIZE_MAX];
+    uint64_t bytes = 0;
+    uint32_t n = 0;
+
+    blackbox_encoder_reset(&encoder);
+
+    for (auto _ : state)
+    {
+        bytes += blackbox_encode(&encoder, &samples[n++ & (SAMPLES - 1)], &buffer[0]);
+        benchmark::DoNotOptimize(buffer);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["bytes_per_frame"] = benchmark::Counter((double)bytes / (double)state.iterations());
+    state.counters["raw_bytes"]       = sizeof(blackbox_frame_t);
+}
+BENCHMARK(BM_blackbox_encode);
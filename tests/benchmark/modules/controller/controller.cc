@@ -0,0 +1,179 @@
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <vector>
+#include "ahrs.h"
+#include "app_mix.h"
+#include "boot_handoff.h"
+#include "cf.h"
+#include "ghf.h"
+#include "pid.h"
+#include "rc.h"
+
+#define SAMPLES     (0x0100u)               /* A power of two, the kernels cycle through the samples. */
+
+///
+/// \brief The hand-off block the rc timing reads the clocks from, the linker places __handoff_shared__ on it.
+///
+extern "C" boot_handoff_t benchmark_handoff;
+boot_handoff_t benchmark_handoff;
+
+///
+/// \brief The DWT cycle counter, the rc publishing stamps the frames with it.
+///
+extern "C" uint32_t timing_cnt_get(void)
+{
+    return 0;
+}
+
+///
+/// \brief The IMU samples of a hovering quadrotor, the noise of the sensor on the attitude.
+///
+static std::vector<struct ahrs_raw_data> imu_samples(void)
+{
+    std::vector<struct ahrs_raw_data> samples(SAMPLES);
+    uint32_t seed = 7;
+
+    for (auto &sample : samples)
+    {
+        seed      = (seed * 1103515245u) + 12345u;
+        sample.ax = (int16_t)((int32_t)((seed >> 16) & 0x7f) - 64);
+        sample.ay = (int16_t)((int32_t)((seed >> 8) & 0x7f) - 64);
+        sample.az = (int16_t)(4096 + (int32_t)((seed >> 20) & 0x3f) - 32);
+        sample.gx = (int16_t)((int32_t)((seed >> 4) & 0xff) - 128);
+        sample.gy = (int16_t)((int32_t)((seed >> 12) & 0xff) - 128);
+        sample.gz = (int16_t)((int32_t)((seed >> 24) & 0xff) - 128);
+    }
+
+    return samples;
+}
+
+///
+/// \brief The angles around the level attitude, in degrees.
+///
+static std::vector<float32_t> angles(void)
+{
+    std::vector<float32_t> samples(SAMPLES);
+    uint32_t seed = 11;
+
+    for (auto &sample : samples)
+    {
+        seed   = (seed * 1103515245u) + 12345u;
+        sample = ((float32_t)((seed >> 16) & 0x3ff) / 16.0f) - 32.0f;
+    }
+
+    return samples;
+}
+
+///
+/// \brief The attitude estimate of one control cycle.
+///
+static void BM_ahrs_update(benchmark::State &state)
+{
+    struct ahrs *ahrs = ahrs_get();
+    std::vector<struct ahrs_raw_data> samples = imu_samples();
+    uint32_t i = 0;
+
+    ahrs_init(ahrs, 1.0f / 4096.0f, 1.0f / 16.4f, 0.1f, 1.0f / 4000.0f);
+
+    for (auto _ : state)
+    {
+        ahrs_update(ahrs, &samples[i++ & (SAMPLES - 1)]);
+        benchmark::DoNotOptimize(ahrs->out);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ahrs_update);
+
+///
+/// \brief The complementary filter of one axis.
+///
+static void BM_cf_fuse(benchmark::State &state)
+{
+    struct cf *cf = cf_get(CF_INST_ROLL);
+    std::vector<float32_t> gyr = angles();
+    std::vector<float32_t> acc = angles();
+    uint32_t i = 0;
+
+    cf_init(cf, 0.1f, 0.0f);
+
+    for (auto _ : state)
+    {
+        uint32_t index = i++ & (SAMPLES - 1);
+
+        cf_fuse(cf, gyr[index], acc[SAMPLES - 1 - index]);
+        benchmark::DoNotOptimize(cf_get_ang(cf));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_cf_fuse);
+
+///
+/// \brief The PID controller of one axis, the gains of ghf with the integral and the derivative on.
+///
+static void BM_pid_update(benchmark::State &state)
+{
+    struct pid *pid = pid_get(PID_INST_ROLL);
+    std::vector<float32_t> pv = angles();
+    uint32_t i = 0;
+
+    pid_init(pid, 0.01f, 0.05f, 0.0007f, 1.0f / 4000.0f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pid_update(pid, 10.0f, pv[i++ & (SAMPLES - 1)]));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_pid_update);
+
+///
+/// \brief The stick normalization of one channel, the argument is the rc_norm_t.
+///
+static void BM_rc_sig_norm(benchmark::State &state)
+{
+    struct rc *rc = rc_get(RC_CH_1);
+    rc_norm_t norm = (rc_norm_t)state.range(0);
+    uint32_t i = 0;
+
+    rc_init(rc, norm);
+
+    for (auto _ : state)
+    {
+        /* Out of the range at both ends, the clamps are taken too. */
+        rc->sig.raw = 950 + ((i++ * 37) % 1100);
+        rc_sig_norm(rc, norm);
+        benchmark::DoNotOptimize(rc->sig.norm);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_rc_sig_norm)->Arg(RC_NORM_SYM)->Arg(RC_NORM_ASYM);
+
+///
+/// \brief The motor mix of app_update(), the controller outputs saturate the motors at times.
+///
+static void BM_app_mix(benchmark::State &state)
+{
+    struct ghf_data data = {};
+    std::vector<float32_t> out = angles();
+    uint32_t i = 0;
+
+    for (auto _ : state)
+    {
+        uint32_t index = i++ & (SAMPLES - 1);
+
+        data.throttle = 0.5f;
+        data.roll     = out[index] / 32.0f;
+        data.pitch    = out[(index + 1) & (SAMPLES - 1)] / 32.0f;
+        data.yaw      = out[(index + 2) & (SAMPLES - 1)] / 64.0f;
+
+        app_mix(&data);
+        benchmark::DoNotOptimize(data);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_app_mix);
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <string.h>
+#include "ahrs.h"
+#include "ghf.h"
+#include "rc.h"
+#include "telemetry.h"
+#include "data_structure/ring_buffer.h"
+
+#define LOOP_HZ     (1000u)
+#define RING_SIZE   (0x0100u)
+
+///
+/// \brief The sink ring, the transmission ring of the USART DMA on the target.
+///
+RING_BUFFER_DEFINE(ring, sizeof(uint8_t), RING_SIZE);
+
+static uint32_t sink_space(void)
+{
+    return ring_buffer_space(&ring);
+}
+
+static uint32_t sink_reserve(uint8_t **const data)
+{
+    return ring_buffer_reserve(&ring, (void **)data);
+}
+
+static void sink_commit(const uint32_t len)
+{
+    (void)ring_buffer_commit(&ring, len);
+}
+
+static const struct telemetry_sink sink =
+{
+    .space   = sink_space,
+    .reserve = sink_reserve,
+    .commit  = sink_commit,
+};
+
+///
+/// \brief The module state the messages are serialized from.
+///
+static struct ahrs ahrs;
+static struct rc rc[TELEMETRY_RC_TOTAL];
+static struct ghf ghf;
+
+///
+/// \brief The update with every message due every cycle, the cost at the full budget. The ring is
+///        emptied after every update as the DMA would, the skip is a single index store.
+///
+static void BM_telemetry_update(benchmark::State &state)
+{
+    struct telemetry_boot boot = {};
+    uint64_t bytes = 0;
+
+    memset(&ghf, 0, sizeof(ghf));
+    ghf.module.ahrs = &ahrs;
+    ghf.module.rc_1 = &rc[0];
+    ghf.module.rc_2 = &rc[1];
+    ghf.module.rc_3 = &rc[2];
+    ghf.module.rc_4 = &rc[3];
+    ghf.module.rc_5 = &rc[4];
+    ghf.module.rc_6 = &rc[5];
+
+    ring_buffer_clear(&ring);
+    telemetry_init(&sink, &boot, LOOP_HZ);
+
+    for (uint32_t msg = 0; msg < TELEMETRY_MSG_TOTAL; msg++)
+    {
+        telemetry_rate_set((telemetry_msg_t)msg, LOOP_HZ);
+    }
+
+    for (auto _ : state)
+    {
+        ahrs.out.roll += 1.0f;
+        bytes += telemetry_update(&ghf);
+
+        (void)ring_buffer_skip(&ring, ring_buffer_count(&ring));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed((int64_t)bytes);
+    state.counters["bytes_per_update"] = benchmark::Counter((double)bytes / (double)state.iterations());
+}
+BENCHMARK(BM_telemetry_update);
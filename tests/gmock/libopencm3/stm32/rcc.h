@@ -0,0 +1,10 @@
+#ifndef _GMOCK_LIBOPENCM3_RCC_H
+#define _GMOCK_LIBOPENCM3_RCC_H
+
+#include <stdint.h>
+
+///
+/// \brief Mock of the RCC header, the host builds set no clocks.
+///
+
+#endif  /* _GMOCK_LIBOPENCM3_RCC_H */
@@ -0,0 +1,212 @@
+#include "spi_nor_fake.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+///***********************************************************************************************************
+/// Private objects - declaration.
+///***********************************************************************************************************
+///
+/// \brief The fake device structure.
+///
+struct spi_nor_fake
+{
+    uint8_t  *memory;
+    uint32_t size;
+    uint8_t  capacity;
+    uint64_t now;                                   /*!< The virtual clock in ns.                       */
+    uint64_t busy_until;                            /*!< The end of the program or the erase.           */
+    uint8_t  wel;                                   /*!< The write enable latch.                        */
+    uint32_t errors;
+    uint8_t  cmd;                                   /*!< The command of this chip select, 0 if ignored. */
+    uint32_t count;                                 /*!< The bytes since the chip select.               */
+    uint32_t addr;
+};
+
+///***********************************************************************************************************
+/// Private objects - definition.
+///***********************************************************************************************************
+static struct spi_nor_fake fake;
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+static void spi_nor_fake_select(void);
+static void spi_nor_fake_deselect(void);
+static void spi_nor_fake_xfer(const uint8_t *const tx, uint8_t *const rx, const uint32_t size);
+static uint8_t spi_nor_fake_byte(const uint8_t byte);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static void spi_nor_fake_select(void)
+{
+    fake.cmd   = 0;
+    fake.count = 0;
+    fake.addr  = 0;
+}
+
+static void spi_nor_fake_deselect(void)
+{
+    uint32_t size = 0;
+    uint64_t time = 0;
+
+    /* The program and the erase start on the chip select release. */
+    switch (fake.cmd)
+    {
+    case LL_SPI_NOR_CMD_PP:
+        time = (fake.count > 4) ? SPI_NOR_FAKE_PP_NS : 0;
+        break;
+    case LL_SPI_NOR_CMD_SE:
+        size = LL_SPI_NOR_SECTOR_SIZE;
+        time = SPI_NOR_FAKE_SE_NS;
+        break;
+    case LL_SPI_NOR_CMD_BE:
+        size = LL_SPI_NOR_BLOCK_SIZE;
+        time = SPI_NOR_FAKE_BE_NS;
+        break;
+    default:
+        return;
+    }
+
+    if (size > 0)
+    {
+        if (fake.count != 4)
+        {
+            fake.errors++;
+            return;
+        }
+
+        memset(&fake.memory[(fake.addr % fake.size) & ~(size - 1)], 0xff, size);
+    }
+
+    fake.wel        = 0;
+    fake.busy_until = fake.now + time;
+}
+
+static uint8_t spi_nor_fake_byte(const uint8_t byte)
+{
+    uint8_t busy = (fake.now < fake.busy_until) ? 1 : 0;
+    uint8_t out  = 0xff;
+    uint32_t n   = fake.count++;
+
+    fake.now += SPI_NOR_FAKE_BYTE_NS;
+
+    if (n == 0)
+    {
+        fake.cmd = byte;
+
+        if ((busy == 1) && (byte != LL_SPI_NOR_CMD_RDSR))
+        {
+            fake.errors++;
+            fake.cmd = 0;
+        }
+        else if (byte == LL_SPI_NOR_CMD_WREN)
+        {
+            fake.wel = 1;
+        }
+        else if (((byte == LL_SPI_NOR_CMD_PP) || (byte == LL_SPI_NOR_CMD_SE) || (byte == LL_SPI_NOR_CMD_BE)) &&
+                 (fake.wel == 0))
+        {
+            fake.errors++;
+            fake.cmd = 0;
+        }
+
+        return out;
+    }
+
+    switch (fake.cmd)
+    {
+    case LL_SPI_NOR_CMD_JEDEC_ID:
+        if (fake.capacity != 0)
+        {
+            const uint8_t id[3] = {SPI_NOR_FAKE_MANUFACTURER, SPI_NOR_FAKE_TYPE, fake.capacity};
+            out = (n <= 3) ? id[n - 1] : 0xff;
+        }
+        break;
+    case LL_SPI_NOR_CMD_RDSR:
+        out = (uint8_t)((busy == 1) ? LL_SPI_NOR_SR_WIP : 0) | (uint8_t)(fake.wel << 1);
+        break;
+    case LL_SPI_NOR_CMD_FAST_READ:
+    case LL_SPI_NOR_CMD_PP:
+    case LL_SPI_NOR_CMD_SE:
+    case LL_SPI_NOR_CMD_BE:
+        if (n <= 3)
+        {
+            fake.addr = (fake.addr << 8) | byte;
+        }
+        else if (fake.cmd == LL_SPI_NOR_CMD_PP)
+        {
+            /* The program only clears bits and wraps within the page. */
+            uint32_t page = (fake.addr % fake.size) & ~(LL_SPI_NOR_PAGE_SIZE - 1);
+            fake.memory[page | ((fake.addr + n - 4) % LL_SPI_NOR_PAGE_SIZE)] &= byte;
+        }
+        else if ((fake.cmd == LL_SPI_NOR_CMD_FAST_READ) && (n >= 5))
+        {
+            out = fake.memory[(fake.addr + n - 5) % fake.size];
+        }
+        break;
+    default:
+        break;
+    }
+
+    return out;
+}
+
+static void spi_nor_fake_xfer(const uint8_t *const tx, uint8_t *const rx, const uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        uint8_t byte = spi_nor_fake_byte((tx != NULL) ? tx[i] : 0xff);
+
+        if (rx != NULL)
+        {
+            rx[i] = byte;
+        }
+    }
+}
+
+///***********************************************************************************************************
+/// Global objects - definition.
+///***********************************************************************************************************
+const struct ll_spi_nor_bus spi_nor_fake_bus =
+{
+    .init     = NULL,
+    .select   = spi_nor_fake_select,
+    .deselect = spi_nor_fake_deselect,
+    .xfer     = spi_nor_fake_xfer,
+};
+
+///***********************************************************************************************************
+/// Global functions - definition.
+///***********************************************************************************************************
+void spi_nor_fake_reset(const uint8_t capacity)
+{
+    free(fake.memory);
+    memset(&fake, 0, sizeof(fake));
+
+    fake.capacity = capacity;
+    fake.size     = (capacity != 0) ? (1u << capacity) : LL_SPI_NOR_BLOCK_SIZE;
+    fake.memory   = (uint8_t*)malloc(fake.size);
+    memset(fake.memory, 0x00, fake.size);
+}
+
+void spi_nor_fake_elapse(const uint64_t ns)
+{
+    fake.now += ns;
+}
+
+uint64_t spi_nor_fake_now(void)
+{
+    return fake.now;
+}
+
+uint32_t spi_nor_fake_errors(void)
+{
+    return fake.errors;
+}
+
+uint8_t* spi_nor_fake_memory(void)
+{
+    return fake.memory;
+}
@@ -0,0 +1,63 @@
+#ifndef _GMOCK_SPI_NOR_FAKE_H
+#define _GMOCK_SPI_NOR_FAKE_H
+
+#include "ll_spi_nor.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+#define SPI_NOR_FAKE_MANUFACTURER   (0xefu)             /*!< Winbond.                                   */
+#define SPI_NOR_FAKE_TYPE           (0x40u)             /*!< The W25Q series.                           */
+#define SPI_NOR_FAKE_BYTE_NS        (300u)              /*!< The byte on the bus at about 27 MHz.       */
+#define SPI_NOR_FAKE_PP_NS          (400000u)           /*!< The typical page program time.             */
+#define SPI_NOR_FAKE_SE_NS          (45000000u)         /*!< The typical sector erase time.             */
+#define SPI_NOR_FAKE_BE_NS          (150000000u)        /*!< The typical block erase time.              */
+
+///
+/// \brief The RAM backed SPI NOR flash on the virtual clock, every byte on the bus advances it.
+///
+extern const struct ll_spi_nor_bus spi_nor_fake_bus;
+
+///
+/// \brief Resets the fake at the virtual time 0, the memory full of zeros so the missed erase shows.
+///
+/// \param[in] capacity The log2 of the size reported by the JEDEC ID, 0 reads the absent device.
+///
+void spi_nor_fake_reset(const uint8_t capacity);
+
+///
+/// \brief Advances the virtual clock, the time the caller spends elsewhere.
+///
+/// \param[in] ns The time in ns.
+///
+void spi_nor_fake_elapse(const uint64_t ns);
+
+///
+/// \brief Gets the virtual clock.
+///
+/// \return uint64_t The time in ns.
+///
+uint64_t spi_nor_fake_now(void);
+
+///
+/// \brief Gets the count of the commands the real device would ignore: sent while busy, or the program
+///        and the erase without the write enable.
+///
+/// \return uint32_t The error count.
+///
+uint32_t spi_nor_fake_errors(void);
+
+///
+/// \brief Gets the device memory.
+///
+/// \return uint8_t* The memory of the capacity size.
+///
+uint8_t* spi_nor_fake_memory(void);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _GMOCK_SPI_NOR_FAKE_H */
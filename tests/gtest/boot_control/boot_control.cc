@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include "boot_control.h"
+
+#define RECORDS     (0x10u)
+
+///
+/// \brief Erases the records the way the flash sector erase does.
+///
+static void erase(boot_control_record_t *const log)
+{
+    memset(log, 0xff, RECORDS * sizeof(boot_control_record_t));
+}
+
+///
+/// \brief This test validates the record and refuses it with any field changed.
+///
+TEST(gtest_boot_control, record)
+{
+    boot_control_record_t record;
+    uint8_t *data = (uint8_t *)&record;
+
+    boot_control_record_create(&record, 1, 7);
+    EXPECT_EQ(record.magic, BOOT_CONTROL_MAGIC);
+    EXPECT_EQ(record.slot, 1u);
+    EXPECT_EQ(record.sequence, 7u);
+    EXPECT_TRUE(boot_control_record_is_valid(&record));
+
+    for (uint32_t i = 0; i < sizeof(record); i++)
+    {
+        data[i] ^= 0x01;
+        EXPECT_FALSE(boot_control_record_is_valid(&record)) << "byte " << i;
+        data[i] ^= 0x01;
+    }
+
+    /* The slot out of range with a matching CRC. */
+    boot_control_record_create(&record, BOOT_CONTROL_SLOTS, 7);
+    EXPECT_FALSE(boot_control_record_is_valid(&record));
+    EXPECT_FALSE(boot_control_record_is_valid(NULL));
+}
+
+///
+/// \brief This test finds the newest record past the torn ones and the first erased slot.
+///
+TEST(gtest_boot_control, find)
+{
+    boot_control_record_t log[RECORDS];
+    uint32_t free = 0;
+
+    erase(log);
+    EXPECT_EQ(boot_control_find(log, RECORDS, &free), nullptr);
+    EXPECT_EQ(free, 0u);
+    EXPECT_EQ(boot_control_find(NULL, RECORDS, &free), nullptr);
+
+    boot_control_record_create(&log[0], 1, 0);
+    boot_control_record_create(&log[1], 0, 1);
+    EXPECT_EQ(boot_control_find(log, RECORDS, &free), &log[1]);
+    EXPECT_EQ(free, 2u);
+
+    /* The record torn by the power loss keeps the previous one. */
+    boot_control_record_create(&log[2], 1, 2);
+    log[2].crc = 0xffffffff;
+    EXPECT_EQ(boot_control_find(log, RECORDS, &free), &log[1]);
+    EXPECT_EQ(free, 3u);
+
+    boot_control_record_create(&log[3], 1, 2);
+    EXPECT_EQ(boot_control_find(log, RECORDS, NULL), &log[3]);
+
+    /* The full log. */
+    for (uint32_t i = 0; i < RECORDS; i++)
+    {
+        boot_control_record_create(&log[i], i % BOOT_CONTROL_SLOTS, i);
+    }
+
+    EXPECT_EQ(boot_control_find(log, RECORDS, &free), &log[RECORDS - 1]);
+    EXPECT_EQ(free, RECORDS);
+}
+
+///
+/// \brief This test boots the slot A and starts the sequence at 0 without a record.
+///
+TEST(gtest_boot_control, preferred)
+{
+    boot_control_record_t record;
+
+    EXPECT_EQ(boot_control_preferred(NULL), 0u);
+    EXPECT_EQ(boot_control_next_sequence(NULL), 0u);
+
+    boot_control_record_create(&record, 1, 41);
+    EXPECT_EQ(boot_control_preferred(&record), 1u);
+    EXPECT_EQ(boot_control_next_sequence(&record), 42u);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include "boot_handoff.h"
+
+///
+/// \brief This test validates the created block and refuses it with any field changed.
+///
+TEST(gtest_boot_handoff, create)
+{
+    boot_handoff_t handoff;
+    uint8_t *data = (uint8_t *)&handoff;
+
+    memset(&handoff, 0x5a, sizeof(handoff));
+    EXPECT_FALSE(boot_handoff_is_valid(&handoff));
+
+    boot_handoff_create(&handoff);
+    EXPECT_TRUE(boot_handoff_is_valid(&handoff));
+    EXPECT_EQ(handoff.version, BOOT_HANDOFF_VERSION);
+    EXPECT_EQ(handoff.size, sizeof(boot_handoff_t));
+    EXPECT_EQ(handoff.reason, BOOT_HANDOFF_REASON_COLD);
+    EXPECT_EQ(handoff.next_stage, BOOT_HANDOFF_STAGE_APP);
+    EXPECT_EQ(handoff.calib.valid, 0u);
+
+    for (uint32_t i = 0; i < sizeof(handoff); i++)
+    {
+        data[i] ^= 0x01;
+        EXPECT_FALSE(boot_handoff_is_valid(&handoff)) << "byte " << i;
+        data[i] ^= 0x01;
+    }
+
+    EXPECT_FALSE(boot_handoff_is_valid(NULL));
+}
+
+///
+/// \brief This test refuses the block of another layout, sealed with a matching CRC.
+///
+TEST(gtest_boot_handoff, version)
+{
+    boot_handoff_t handoff;
+
+    boot_handoff_create(&handoff);
+    handoff.version = BOOT_HANDOFF_VERSION + 1;
+    boot_handoff_seal(&handoff);
+    EXPECT_FALSE(boot_handoff_is_valid(&handoff));
+
+    boot_handoff_create(&handoff);
+    handoff.size = sizeof(boot_handoff_t) - 4;
+    boot_handoff_seal(&handoff);
+    EXPECT_FALSE(boot_handoff_is_valid(&handoff));
+}
+
+///
+/// \brief This test keeps the block valid over the changes of the stages which seal it.
+///
+TEST(gtest_boot_handoff, seal)
+{
+    boot_handoff_t handoff;
+
+    boot_handoff_create(&handoff);
+    handoff.clocks.sysclk = 216000000;
+    handoff.stamps[1]     = 0x1234;
+    handoff.calib.valid   = 1;
+    handoff.calib.gx      = -7;
+    EXPECT_FALSE(boot_handoff_is_valid(&handoff));
+
+    boot_handoff_seal(&handoff);
+    EXPECT_TRUE(boot_handoff_is_valid(&handoff));
+}
+
+///
+/// \brief This test serves the requested stage once.
+///
+TEST(gtest_boot_handoff, request)
+{
+    boot_handoff_t handoff;
+
+    boot_handoff_create(&handoff);
+    EXPECT_EQ(boot_handoff_take_request(&handoff), BOOT_HANDOFF_STAGE_APP);
+
+    boot_handoff_request(&handoff, BOOT_HANDOFF_STAGE_UPDATER);
+    EXPECT_TRUE(boot_handoff_is_valid(&handoff));
+    EXPECT_EQ(boot_handoff_take_request(&handoff), BOOT_HANDOFF_STAGE_UPDATER);
+    EXPECT_TRUE(boot_handoff_is_valid(&handoff));
+    EXPECT_EQ(boot_handoff_take_request(&handoff), BOOT_HANDOFF_STAGE_APP);
+
+    /* The stage out of range is not served. */
+    handoff.next_stage = 0x7f;
+    boot_handoff_seal(&handoff);
+    EXPECT_EQ(boot_handoff_take_request(&handoff), BOOT_HANDOFF_STAGE_APP);
+    EXPECT_EQ(handoff.next_stage, BOOT_HANDOFF_STAGE_APP);
+    EXPECT_EQ(boot_handoff_take_request(NULL), BOOT_HANDOFF_STAGE_APP);
+}
@@ -0,0 +1,303 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "ll_spi_nor.h"
+#include "spi_nor_fake.h"
+
+#define SPI_NOR_CAPACITY        (0x14u)             /*!< The 1 MiB device.                              */
+#define LOG_SIZE                (0x80000u)          /*!< The bytes logged by the throughput test.       */
+#define LOG_CYCLES              (0x1000u)           /*!< The control cycles of the latency test.        */
+#define LOG_CYCLE_NS            (1000000u)          /*!< The 1 kHz control loop.                        */
+#define LOG_CYCLE_BYTES         (16u)               /*!< The blackbox frame every other cycle.          */
+
+///
+/// \brief Gets the test pattern byte at the log offset.
+///
+static uint8_t pattern_at(const uint32_t offset)
+{
+    return (uint8_t)((offset * 7u) ^ (offset >> 8));
+}
+
+///
+/// \brief The log written the simple way: the page programmed and waited for when full, the sector
+///        erased and waited for when reached.
+///
+struct naive
+{
+    uint8_t  page[LL_SPI_NOR_PAGE_SIZE];
+    uint32_t fill;
+    uint32_t addr;
+    uint32_t erased;
+};
+
+static void naive_write(struct ll_spi_nor *const dev, struct naive *const log, const uint8_t *const data,
+                        const uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        log->page[log->fill++] = data[i];
+
+        if (log->fill < LL_SPI_NOR_PAGE_SIZE)
+        {
+            continue;
+        }
+
+        if (log->addr >= log->erased)
+        {
+            ASSERT_EQ(ll_spi_nor_erase(dev, log->erased, LL_SPI_NOR_SECTOR_SIZE), LL_SPI_NOR_RES_OK);
+            ll_spi_nor_wait(dev);
+            log->erased += LL_SPI_NOR_SECTOR_SIZE;
+        }
+
+        ASSERT_EQ(ll_spi_nor_page_program(dev, log->addr, &log->page[0], LL_SPI_NOR_PAGE_SIZE),
+                  LL_SPI_NOR_RES_OK);
+        ll_spi_nor_wait(dev);
+        log->addr += LL_SPI_NOR_PAGE_SIZE;
+        log->fill  = 0;
+    }
+}
+
+///
+/// \brief Writes all the data to the log, polls it while it takes nothing.
+///
+static void log_write_all(struct ll_spi_nor *const dev, const uint8_t *const data, const uint32_t size)
+{
+    uint32_t taken = 0;
+
+    while (taken < size)
+    {
+        taken += ll_spi_nor_log_write(dev, &data[taken], size - taken);
+
+        if (taken < size)
+        {
+            ASSERT_NE(ll_spi_nor_log_poll(dev), LL_SPI_NOR_RES_FULL);
+        }
+    }
+}
+
+TEST(gtest_spi_nor, init)
+{
+    struct ll_spi_nor dev;
+
+    spi_nor_fake_reset(SPI_NOR_CAPACITY);
+
+    EXPECT_EQ(ll_spi_nor_init(&dev, &spi_nor_fake_bus), LL_SPI_NOR_RES_OK);
+    EXPECT_EQ(dev.id.manufacturer, SPI_NOR_FAKE_MANUFACTURER);
+    EXPECT_EQ(dev.id.type, SPI_NOR_FAKE_TYPE);
+    EXPECT_EQ(dev.id.capacity, SPI_NOR_CAPACITY);
+    EXPECT_EQ(dev.size, 1u << SPI_NOR_CAPACITY);
+    EXPECT_EQ(ll_spi_nor_busy(&dev), 0);
+    EXPECT_EQ(spi_nor_fake_errors(), 0u);
+
+    EXPECT_EQ(ll_spi_nor_init(NULL, &spi_nor_fake_bus), LL_SPI_NOR_RES_ERR);
+    EXPECT_EQ(ll_spi_nor_init(&dev, NULL), LL_SPI_NOR_RES_ERR);
+
+    /* The absent device reads all ones. */
+    spi_nor_fake_reset(0);
+    EXPECT_EQ(ll_spi_nor_init(&dev, &spi_nor_fake_bus), LL_SPI_NOR_RES_ERR);
+
+    spi_nor_fake_reset(0x0f);
+    EXPECT_EQ(ll_spi_nor_init(&dev, &spi_nor_fake_bus), LL_SPI_NOR_RES_ERR);
+}
+
+TEST(gtest_spi_nor, program)
+{
+    struct ll_spi_nor dev;
+    uint8_t data[LL_SPI_NOR_PAGE_SIZE];
+    uint8_t back[LL_SPI_NOR_PAGE_SIZE];
+
+    for (uint32_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = pattern_at(i);
+    }
+
+    spi_nor_fake_reset(SPI_NOR_CAPACITY);
+    ASSERT_EQ(ll_spi_nor_init(&dev, &spi_nor_fake_bus), LL_SPI_NOR_RES_OK);
+
+    EXPECT_EQ(ll_spi_nor_erase(&dev, 0x100, LL_SPI_NOR_SECTOR_SIZE), LL_SPI_NOR_RES_ERR);
+    EXPECT_EQ(ll_spi_nor_erase(&dev, LL_SPI_NOR_SECTOR_SIZE, LL_SPI_NOR_BLOCK_SIZE), LL_SPI_NOR_RES_ERR);
+    EXPECT_EQ(ll_spi_nor_erase(&dev, 0, 0x2000), LL_SPI_NOR_RES_ERR);
+    EXPECT_EQ(ll_spi_nor_erase(&dev, dev.size, LL_SPI_NOR_SECTOR_SIZE), LL_SPI_NOR_RES_ERR);
+    EXPECT_EQ(ll_spi_nor_page_program(&dev, 0x80, &data[0], 0x81), LL_SPI_NOR_RES_ERR);
+    EXPECT_EQ(ll_spi_nor_page_program(&dev, 0, &data[0], 0), LL_SPI_NOR_RES_ERR);
+    EXPECT_EQ(ll_spi_nor_page_program(&dev, dev.size, &data[0], 1), LL_SPI_NOR_RES_ERR);
+    EXPECT_EQ(ll_spi_nor_read(&dev, dev.size - 1, &back[0], 2), LL_SPI_NOR_RES_ERR);
+
+    /* The erase and the program only start, the next command waits for them. */
+    EXPECT_EQ(ll_spi_nor_erase(&dev, LL_SPI_NOR_SECTOR_SIZE, LL_SPI_NOR_SECTOR_SIZE), LL_SPI_NOR_RES_OK);
+    EXPECT_EQ(ll_spi_nor_busy(&dev), 1);
+    EXPECT_EQ(ll_spi_nor_page_program(&dev, LL_SPI_NOR_SECTOR_SIZE, &data[0], 0x80), LL_SPI_NOR_RES_BUSY);
+
+    spi_nor_fake_elapse(SPI_NOR_FAKE_SE_NS);
+    EXPECT_EQ(ll_spi_nor_page_program(&dev, LL_SPI_NOR_SECTOR_SIZE, &data[0], 0x80), LL_SPI_NOR_RES_OK);
+    ll_spi_nor_wait(&dev);
+    EXPECT_EQ(ll_spi_nor_page_program(&dev, LL_SPI_NOR_SECTOR_SIZE + 0x80, &data[0x80], 0x80),
+              LL_SPI_NOR_RES_OK);
+
+    EXPECT_EQ(ll_spi_nor_read(&dev, LL_SPI_NOR_SECTOR_SIZE, &back[0], sizeof(back)), LL_SPI_NOR_RES_OK);
+    EXPECT_EQ(memcmp(&data[0], &back[0], sizeof(data)), 0);
+    EXPECT_EQ(ll_spi_nor_read(&dev, LL_SPI_NOR_SECTOR_SIZE + LL_SPI_NOR_PAGE_SIZE, &back[0], 1),
+              LL_SPI_NOR_RES_OK);
+    EXPECT_EQ(back[0], 0xff);
+    EXPECT_EQ(spi_nor_fake_errors(), 0u);
+}
+
+TEST(gtest_spi_nor, log)
+{
+    struct ll_spi_nor dev;
+    std::vector<uint8_t> data(0x23456);
+    std::vector<uint8_t> back(0x24000);
+    uint32_t offset = 0;
+    uint32_t chunk  = 1;
+
+    for (uint32_t i = 0; i < data.size(); i++)
+    {
+        data[i] = pattern_at(i);
+    }
+
+    spi_nor_fake_reset(SPI_NOR_CAPACITY);
+    ASSERT_EQ(ll_spi_nor_init(&dev, &spi_nor_fake_bus), LL_SPI_NOR_RES_OK);
+    ASSERT_EQ(ll_spi_nor_log_start(&dev, 0x1000), LL_SPI_NOR_RES_OK);
+
+    while (offset < data.size())
+    {
+        uint32_t size = ((data.size() - offset) < chunk) ? (data.size() - offset) : chunk;
+
+        log_write_all(&dev, &data[offset], size);
+        offset += size;
+        chunk   = (chunk * 5u + 3u) % 0x300u;
+        spi_nor_fake_elapse(100000u);
+    }
+
+    EXPECT_EQ(ll_spi_nor_log_flush(&dev), LL_SPI_NOR_RES_OK);
+    EXPECT_EQ(ll_spi_nor_busy(&dev), 0);
+    EXPECT_EQ(dev.stats.pages, (data.size() + LL_SPI_NOR_PAGE_SIZE - 1) / LL_SPI_NOR_PAGE_SIZE);
+    EXPECT_GT(dev.stats.blocks, 0u);
+
+    /* The log starts at its sector, the old data before it stays, the flushed page ends in 0xff. */
+    EXPECT_EQ(ll_spi_nor_read(&dev, 0x1000, &back[0], back.size()), LL_SPI_NOR_RES_OK);
+    EXPECT_EQ(memcmp(&data[0], &back[0], data.size()), 0);
+    EXPECT_EQ(back[data.size()], 0xff);
+    EXPECT_EQ(back[(dev.stats.pages * LL_SPI_NOR_PAGE_SIZE) - 1], 0xff);
+    EXPECT_EQ(spi_nor_fake_memory()[0xfff], 0x00);
+    EXPECT_EQ(spi_nor_fake_errors(), 0u);
+}
+
+TEST(gtest_spi_nor, stall)
+{
+    struct ll_spi_nor dev;
+    uint8_t data[LL_SPI_NOR_PAGE_SIZE * 4];
+
+    memset(&data[0], 0x5a, sizeof(data));
+
+    spi_nor_fake_reset(SPI_NOR_CAPACITY);
+    ASSERT_EQ(ll_spi_nor_init(&dev, &spi_nor_fake_bus), LL_SPI_NOR_RES_OK);
+
+    /* The first erase keeps the device busy, both pages fill and the rest is left to the caller. */
+    EXPECT_EQ(ll_spi_nor_log_write(&dev, &data[0], sizeof(data)), 2 * LL_SPI_NOR_PAGE_SIZE);
+    EXPECT_EQ(dev.stats.stalls, 1u);
+    EXPECT_EQ(ll_spi_nor_log_write(&dev, &data[0], 1), 0u);
+    EXPECT_EQ(dev.stats.stalls, 2u);
+
+    spi_nor_fake_elapse(SPI_NOR_FAKE_BE_NS);
+    EXPECT_EQ(ll_spi_nor_log_poll(&dev), LL_SPI_NOR_RES_BUSY);
+    EXPECT_EQ(dev.stats.pages, 1u);
+    EXPECT_EQ(ll_spi_nor_log_write(&dev, &data[0], 1), 1u);
+    EXPECT_EQ(spi_nor_fake_errors(), 0u);
+}
+
+TEST(gtest_spi_nor, full)
+{
+    struct ll_spi_nor dev;
+    uint8_t data[LL_SPI_NOR_PAGE_SIZE];
+    uint32_t taken = 0;
+    ll_spi_nor_res_t res = LL_SPI_NOR_RES_OK;
+
+    memset(&data[0], 0xa5, sizeof(data));
+
+    spi_nor_fake_reset(0x10);
+    ASSERT_EQ(ll_spi_nor_init(&dev, &spi_nor_fake_bus), LL_SPI_NOR_RES_OK);
+
+    for (uint32_t i = 0; (i < 0x1000) && (res != LL_SPI_NOR_RES_FULL); i++)
+    {
+        taken += ll_spi_nor_log_write(&dev, &data[0], sizeof(data));
+        spi_nor_fake_elapse(SPI_NOR_FAKE_PP_NS);
+        res = ll_spi_nor_log_poll(&dev);
+    }
+
+    /* The device is full, the pages in the buffers are kept but never programmed. */
+    EXPECT_EQ(res, LL_SPI_NOR_RES_FULL);
+    EXPECT_EQ(dev.stats.pages, dev.size / LL_SPI_NOR_PAGE_SIZE);
+    EXPECT_EQ(taken, dev.size + (2 * LL_SPI_NOR_PAGE_SIZE));
+    EXPECT_EQ(ll_spi_nor_log_write(&dev, &data[0], sizeof(data)), 0u);
+    EXPECT_EQ(ll_spi_nor_log_flush(&dev), LL_SPI_NOR_RES_FULL);
+    EXPECT_EQ(spi_nor_fake_errors(), 0u);
+}
+
+TEST(gtest_spi_nor, pipelined)
+{
+    struct ll_spi_nor dev;
+    struct naive log = {};
+    std::vector<uint8_t> data(LOG_SIZE);
+    std::vector<uint8_t> backlog;
+    uint64_t naive_ns;
+    uint64_t pipelined_ns;
+    uint64_t naive_max = 0;
+    uint64_t pipelined_max = 0;
+    uint32_t backlog_max = 0;
+
+    for (uint32_t i = 0; i < data.size(); i++)
+    {
+        data[i] = pattern_at(i);
+    }
+
+    /* The throughput, the log written as fast as the device takes it. */
+    spi_nor_fake_reset(SPI_NOR_CAPACITY);
+    ASSERT_EQ(ll_spi_nor_init(&dev, &spi_nor_fake_bus), LL_SPI_NOR_RES_OK);
+    naive_write(&dev, &log, &data[0], data.size());
+    naive_ns = spi_nor_fake_now();
+
+    spi_nor_fake_reset(SPI_NOR_CAPACITY);
+    ASSERT_EQ(ll_spi_nor_init(&dev, &spi_nor_fake_bus), LL_SPI_NOR_RES_OK);
+    for (uint32_t offset = 0; offset < data.size(); offset += LL_SPI_NOR_PAGE_SIZE)
+    {
+        log_write_all(&dev, &data[offset], LL_SPI_NOR_PAGE_SIZE);
+    }
+    ASSERT_EQ(ll_spi_nor_log_flush(&dev), LL_SPI_NOR_RES_OK);
+    pipelined_ns = spi_nor_fake_now();
+    EXPECT_EQ(spi_nor_fake_errors(), 0u);
+
+    /* The latency, the time the control loop spends in the write of its bytes every cycle. */
+    log = {};
+    spi_nor_fake_reset(SPI_NOR_CAPACITY);
+    ASSERT_EQ(ll_spi_nor_init(&dev, &spi_nor_fake_bus), LL_SPI_NOR_RES_OK);
+    for (uint32_t cycle = 0; cycle < LOG_CYCLES; cycle++)
+    {
+        uint64_t start = spi_nor_fake_now();
+        naive_write(&dev, &log, &data[cycle * LOG_CYCLE_BYTES], LOG_CYCLE_BYTES);
+        uint64_t spent = spi_nor_fake_now() - start;
+        naive_max = (spent > naive_max) ? spent : naive_max;
+        spi_nor_fake_elapse((spent < LOG_CYCLE_NS) ? (LOG_CYCLE_NS - spent) : 0);
+    }
+
+    spi_nor_fake_reset(SPI_NOR_CAPACITY);
+    ASSERT_EQ(ll_spi_nor_init(&dev, &spi_nor_fake_bus), LL_SPI_NOR_RES_OK);
+    for (uint32_t cycle = 0; cycle < LOG_CYCLES; cycle++)
+    {
+        uint64_t start = spi_nor_fake_now();
+        backlog.insert(backlog.end(), &data[cycle * LOG_CYCLE_BYTES],
+                       &data[(cycle + 1) * LOG_CYCLE_BYTES]);
+        uint32_t taken = ll_spi_nor_log_write(&dev, backlog.data(), backlog.size());
+        backlog.erase(backlog.begin(), backlog.begin() + taken);
+        uint64_t spent = spi_nor_fake_now() - start;
+        pipelined_max = (spent > pipelined_max) ? spent : pipelined_max;
+        backlog_max = (backlog.size() > backlog_max) ? backlog.size() : backlog_max;
+        spi_nor_fake_elapse(LOG_CYCLE_NS - spent);
+    }
+    EXPECT_EQ(spi_nor_fake_errors(), 0u);
+
+    /* The pipelined log takes at most half the time of the simple one, its writes never wait. */
+    EXPECT_LT(pipelined_ns * 2, naive_ns);
+    EXPECT_LT(pipelined_max * 100, naive_max);
+}
@@ -0,0 +1,269 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include <thread>
+#include "data_structure/ring_buffer.h"
+
+#define STRESS_COUNT        (0x00040000u)
+
+///
+/// \brief The element of the size which is not a power of two.
+///
+typedef struct
+{
+    uint32_t sequence;
+    uint16_t value;
+    uint8_t  flags;
+} element_t;
+
+RING_BUFFER_DEFINE(ring_static, sizeof(element_t), 16);
+
+///
+/// \brief This test refuses the capacity which is not a power of two and the null storage.
+///
+TEST(gtest_ring_buffer, init)
+{
+    ring_buffer_t ring;
+    uint8_t data[0x30];
+
+    EXPECT_EQ(ring_buffer_init(&ring, &data[0], 1, 0x30), RING_BUFFER_RESULT_ERROR);
+    EXPECT_EQ(ring_buffer_init(&ring, &data[0], 1, 0), RING_BUFFER_RESULT_ERROR);
+    EXPECT_EQ(ring_buffer_init(&ring, &data[0], 0, 0x20), RING_BUFFER_RESULT_ERROR);
+    EXPECT_EQ(ring_buffer_init(&ring, NULL, 1, 0x20), RING_BUFFER_RESULT_NULL_POINTER);
+    EXPECT_EQ(ring_buffer_init(NULL, &data[0], 1, 0x20), RING_BUFFER_RESULT_NULL_POINTER);
+    ASSERT_EQ(ring_buffer_init(&ring, &data[0], 3, 0x10), RING_BUFFER_RESULT_SUCCESS);
+
+    EXPECT_EQ(ring_buffer_count(&ring), 0u);
+    EXPECT_EQ(ring_buffer_space(&ring), 0x10u);
+}
+
+///
+/// \brief This test pushes the elements until the buffer is full and pops them in order, all the
+///        capacity is used and nothing is overwritten.
+///
+TEST(gtest_ring_buffer, single)
+{
+    element_t element = {};
+
+    ring_buffer_clear(&ring_static);
+    EXPECT_EQ(ring_buffer_pop(&ring_static, &element), RING_BUFFER_RESULT_EMPTY);
+
+    /* Start close to the index overflow, the count is still the difference. */
+    ring_static.head = 0xfffffff8u;
+    ring_static.tail = 0xfffffff8u;
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        element = { i, (uint16_t)(i * 3), (uint8_t)i };
+        EXPECT_EQ(ring_buffer_push(&ring_static, &element), RING_BUFFER_RESULT_SUCCESS);
+    }
+
+    EXPECT_EQ(ring_buffer_push(&ring_static, &element), RING_BUFFER_RESULT_FULL);
+    EXPECT_EQ(ring_buffer_count(&ring_static), 16u);
+    EXPECT_EQ(ring_buffer_space(&ring_static), 0u);
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        ASSERT_EQ(ring_buffer_pop(&ring_static, &element), RING_BUFFER_RESULT_SUCCESS);
+        EXPECT_EQ(element.sequence, i);
+        EXPECT_EQ(element.value, i * 3);
+        EXPECT_EQ(element.flags, i);
+    }
+
+    EXPECT_EQ(ring_buffer_pop(&ring_static, &element), RING_BUFFER_RESULT_EMPTY);
+    EXPECT_EQ(ring_buffer_push(NULL, &element), RING_BUFFER_RESULT_NULL_POINTER);
+    EXPECT_EQ(ring_buffer_pop(&ring_static, NULL), RING_BUFFER_RESULT_NULL_POINTER);
+}
+
+///
+/// \brief This test pushes and pops the blocks over the wrap at every offset, the blocks which do
+///        not fit are cut to the space or the count.
+///
+TEST(gtest_ring_buffer, bulk)
+{
+    ring_buffer_t ring;
+    uint32_t data[0x20];
+    uint32_t in[0x30];
+    uint32_t out[0x30];
+    uint32_t next_in = 0;
+    uint32_t next_out = 0;
+
+    ASSERT_EQ(ring_buffer_init(&ring, &data[0], sizeof(uint32_t), 0x20), RING_BUFFER_RESULT_SUCCESS);
+
+    for (uint32_t size = 1; size <= 0x30; size++)
+    {
+        for (uint32_t i = 0; i < size; i++)
+        {
+            in[i] = next_in + i;
+        }
+
+        uint32_t expected = (size < ring_buffer_space(&ring)) ? size : ring_buffer_space(&ring);
+        uint32_t pushed = ring_buffer_push_n(&ring, &in[0], size);
+        EXPECT_EQ(pushed, expected);
+        next_in += pushed;
+
+        /* Leave some of the elements behind to move the tail over the wrap. */
+        uint32_t popped = ring_buffer_pop_n(&ring, &out[0], (size * 2) / 3);
+
+        for (uint32_t i = 0; i < popped; i++)
+        {
+            EXPECT_EQ(out[i], next_out + i);
+        }
+
+        next_out += popped;
+        EXPECT_EQ(ring_buffer_count(&ring), next_in - next_out);
+    }
+
+    uint32_t popped = ring_buffer_pop_n(&ring, &out[0], 0x30);
+    EXPECT_EQ(next_out + popped, next_in);
+    EXPECT_EQ(ring_buffer_pop_n(&ring, &out[0], 0x30), 0u);
+    EXPECT_EQ(ring_buffer_push_n(&ring, NULL, 1), 0u);
+    EXPECT_EQ(ring_buffer_pop_n(NULL, &out[0], 1), 0u);
+}
+
+TEST(gtest_ring_buffer, peek)
+{
+    ring_buffer_t ring;
+    uint8_t data[0x10];
+    uint8_t in[0x0c];
+    const void *elements;
+    uint8_t next_out = 0;
+
+    for (uint32_t i = 0; i < sizeof(in); i++)
+    {
+        in[i] = (uint8_t)i;
+    }
+
+    ASSERT_EQ(ring_buffer_init(&ring, &data[0], 1, sizeof(data)), RING_BUFFER_RESULT_SUCCESS);
+    EXPECT_EQ(ring_buffer_peek(&ring, &elements), 0u);
+
+    /* The stored elements past the end of the storage are peeked after the first part is skipped. */
+    EXPECT_EQ(ring_buffer_push_n(&ring, &in[0], 0x0c), 0x0cu);
+    EXPECT_EQ(ring_buffer_skip(&ring, 0x0a), 0x0au);
+    EXPECT_EQ(ring_buffer_push_n(&ring, &in[0], 0x0c), 0x0cu);
+
+    for (uint32_t expected : {0x06u, 0x08u})
+    {
+        uint32_t count = ring_buffer_peek(&ring, &elements);
+        ASSERT_EQ(count, expected);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            EXPECT_EQ(((const uint8_t *)elements)[i], in[(0x0a + next_out + i) % 0x0c]);
+        }
+
+        EXPECT_EQ(ring_buffer_skip(&ring, count), count);
+        next_out += count;
+    }
+
+    EXPECT_EQ(ring_buffer_count(&ring), 0u);
+    EXPECT_EQ(ring_buffer_skip(&ring, 1), 0u);
+    EXPECT_EQ(ring_buffer_peek(NULL, &elements), 0u);
+    EXPECT_EQ(ring_buffer_peek(&ring, NULL), 0u);
+}
+
+TEST(gtest_ring_buffer, reserve)
+{
+    ring_buffer_t ring;
+    uint8_t data[0x10];
+    uint8_t out[0x10];
+    void *elements;
+
+    ASSERT_EQ(ring_buffer_init(&ring, &data[0], 1, sizeof(data)), RING_BUFFER_RESULT_SUCCESS);
+    EXPECT_EQ(ring_buffer_reserve(&ring, &elements), 0x10u);
+    EXPECT_EQ(elements, (void *)&data[0]);
+
+    /* The free space past the end of the storage is reserved after the first part is committed. */
+    EXPECT_EQ(ring_buffer_commit(&ring, 0x0c), 0x0cu);
+    EXPECT_EQ(ring_buffer_pop_n(&ring, &out[0], 0x0a), 0x0au);
+
+    uint32_t count = ring_buffer_reserve(&ring, &elements);
+    ASSERT_EQ(count, 0x04u);
+    EXPECT_EQ(elements, (void *)&data[0x0c]);
+    memset(elements, 0xa5, count);
+    EXPECT_EQ(ring_buffer_commit(&ring, count), count);
+
+    count = ring_buffer_reserve(&ring, &elements);
+    ASSERT_EQ(count, 0x0au);
+    EXPECT_EQ(elements, (void *)&data[0]);
+    memset(elements, 0x5a, count);
+    EXPECT_EQ(ring_buffer_commit(&ring, 0x20), count);
+
+    EXPECT_EQ(ring_buffer_reserve(&ring, &elements), 0u);
+    EXPECT_EQ(ring_buffer_commit(&ring, 1), 0u);
+    EXPECT_EQ(ring_buffer_pop_n(&ring, &out[0], sizeof(out)), 0x10u);
+    EXPECT_EQ(out[0x02], 0xa5);
+    EXPECT_EQ(out[0x06], 0x5a);
+    EXPECT_EQ(ring_buffer_reserve(NULL, &elements), 0u);
+    EXPECT_EQ(ring_buffer_reserve(&ring, NULL), 0u);
+}
+
+///
+/// \brief This test runs the producer and the consumer on the separate threads, every element
+///        arrives once and in order.
+///
+TEST(gtest_ring_buffer, spsc)
+{
+    ring_buffer_t ring;
+    uint32_t data[0x40];
+    uint32_t errors = 0;
+
+    ASSERT_EQ(ring_buffer_init(&ring, &data[0], sizeof(uint32_t), 0x40), RING_BUFFER_RESULT_SUCCESS);
+
+    std::thread producer([&]() {
+        uint32_t block[7];
+        uint32_t next = 0;
+
+        while (next < STRESS_COUNT)
+        {
+            uint32_t size = ((STRESS_COUNT - next) < 7) ? (STRESS_COUNT - next) : 7;
+            uint32_t pushed;
+
+            for (uint32_t i = 0; i < size; i++)
+            {
+                block[i] = next + i;
+            }
+
+            if ((next % 3) == 0)
+            {
+                pushed = (ring_buffer_push(&ring, &block[0]) == RING_BUFFER_RESULT_SUCCESS) ? 1 : 0;
+            }
+            else
+            {
+                pushed = ring_buffer_push_n(&ring, &block[0], size);
+            }
+
+            next += pushed;
+
+            /* Give the consumer the core when the buffer is full. */
+            if (pushed == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t block[5];
+    uint32_t next = 0;
+
+    while (next < STRESS_COUNT)
+    {
+        uint32_t popped = ring_buffer_pop_n(&ring, &block[0], 5);
+
+        if (popped == 0)
+        {
+            std::this_thread::yield();
+        }
+
+        for (uint32_t i = 0; i < popped; i++)
+        {
+            errors += (block[i] != next) ? 1 : 0;
+            next++;
+        }
+    }
+
+    producer.join();
+
+    EXPECT_EQ(errors, 0u);
+    EXPECT_EQ(ring_buffer_count(&ring), 0u);
+}
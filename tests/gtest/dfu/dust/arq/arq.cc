@@ -0,0 +1,402 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "dust_arq.h"
+
+#define PAYLOAD_SIZE    (0x20u)
+#define SIZE            (DUST_PACKET_HEADER_SIZE + PAYLOAD_SIZE + DUST_PACKET_CRC16_SIZE)
+#define POLL_ATTEMPTS   (0x40u)
+
+///
+/// \brief The lossy link, which drops or corrupts the packets in both directions.
+///
+typedef struct
+{
+    uint32_t seed;
+    uint32_t drop;                          /*!< The dropped packets per mille.                        */
+    uint32_t corrupt;                       /*!< The corrupted packets per mille.                      */
+    int32_t  drop_index;                    /*!< The index of a single packet to drop, -1 if none.     */
+    uint32_t sent;
+    uint32_t lost;
+} link_t;
+
+///
+/// \brief The receiver side, the updater without the flash programming.
+///
+typedef struct
+{
+    dust_arq_t           arq;
+    std::vector<uint8_t> image;
+    bool                 reply;
+    uint8_t              reply_buffer[SIZE];
+} receiver_t;
+
+///
+/// \brief The sender side statistics.
+///
+typedef struct
+{
+    uint32_t packets;
+    uint32_t polls;
+    std::vector<uint32_t> sends;
+} sender_t;
+
+static uint32_t link_random(link_t *const link)
+{
+    link->seed = (link->seed * 1103515245u) + 12345u;
+
+    return (link->seed >> 16) % 1000u;
+}
+
+///
+/// \brief Passes the packet through the link.
+///
+/// \return False if the packet has been dropped.
+///
+static bool link_pass(link_t *const link, uint8_t *const data, const int32_t index)
+{
+    link->sent++;
+
+    if ((index >= 0) && (index == link->drop_index))
+    {
+        /* Dropped once, the retransmission gets through. */
+        link->drop_index = -1;
+        link->lost++;
+        return false;
+    }
+
+    if (link_random(link) < link->drop)
+    {
+        link->lost++;
+        return false;
+    }
+
+    if (link_random(link) < link->corrupt)
+    {
+        data[link_random(link) % SIZE] ^= 0x5a;
+        link->lost++;
+    }
+
+    return true;
+}
+
+static void receiver_process(receiver_t *const rx, const uint8_t *const data)
+{
+    dust_packet_t packet;
+    uint32_t index;
+
+    packet.payload.buffer_size = PAYLOAD_SIZE;
+
+    if ((dust_deserialize(&packet, data, SIZE) != DUST_RESULT_SUCCESS) ||
+        (packet.header.opcode != DUST_OPCODE_DATA))
+    {
+        return;
+    }
+
+    if (dust_arq_receive(&rx->arq, &packet.header, &index) == DUST_ARQ_RX_NEW)
+    {
+        memcpy(&rx->image[index * PAYLOAD_SIZE], &packet.payload.buffer[0], PAYLOAD_SIZE);
+    }
+
+    if (packet.header.ack == DUST_ACK_SET)
+    {
+        dust_header_t poll = packet.header;
+
+        ASSERT_EQ(dust_arq_ack_create(&rx->arq, &poll, &packet.header, &packet.payload.buffer[0],
+                                      packet.payload.buffer_size), DUST_RESULT_SUCCESS);
+        ASSERT_EQ(dust_serialize(&packet, rx->reply_buffer, SIZE), DUST_RESULT_SUCCESS);
+        rx->reply = true;
+    }
+}
+
+static void sender_transmit(sender_t *const tx, link_t *const link, receiver_t *const rx,
+                            const std::vector<uint8_t> &image, const uint32_t index, const bool poll)
+{
+    dust_packet_t packet;
+    uint8_t data[SIZE];
+
+    packet.payload.buffer_size = PAYLOAD_SIZE;
+    memcpy(&packet.payload.buffer[0], &image[index * PAYLOAD_SIZE], PAYLOAD_SIZE);
+
+    (void)dust_header_create(&packet.header, DUST_OPCODE_DATA, DUST_LENGTH_BYTES32,
+                             poll ? DUST_ACK_SET : DUST_ACK_UNSET,
+                             (uint16_t)(index & (DUST_ARQ_SEQUENCE_SIZE - 1)));
+    ASSERT_EQ(dust_serialize(&packet, data, sizeof(data)), DUST_RESULT_SUCCESS);
+
+    tx->packets++;
+    tx->sends[index]++;
+    tx->polls += poll ? 1 : 0;
+
+    if (link_pass(link, data, (int32_t)index))
+    {
+        receiver_process(rx, data);
+    }
+}
+
+///
+/// \brief Sends the image the way scripts/dfu_updater.py does.
+///
+/// The window is sent with the poll on its last packet, then only the packets the bitmap ACK names
+/// as missing are sent again. A lost ACK makes the sender poll again with the last packet.
+///
+static void sender_run(sender_t *const tx, link_t *const link, receiver_t *const rx,
+                       const std::vector<uint8_t> &image, const uint32_t total, const uint32_t window)
+{
+    tx->sends.assign(total, 0);
+
+    for (uint32_t base = 0; base < total; base += window)
+    {
+        uint32_t length = ((total - base) < window) ? (total - base) : window;
+        std::vector<uint32_t> missing;
+
+        for (uint32_t i = 0; i < length; i++)
+        {
+            missing.push_back(base + i);
+        }
+
+        while (!missing.empty())
+        {
+            uint32_t attempts = 0;
+
+            for (uint32_t i = 0; i < missing.size(); i++)
+            {
+                sender_transmit(tx, link, rx, image, missing[i], i == (missing.size() - 1));
+            }
+
+            while (true)
+            {
+                dust_packet_t packet;
+
+                packet.payload.buffer_size = PAYLOAD_SIZE;
+
+                if (rx->reply)
+                {
+                    rx->reply = false;
+
+                    if (link_pass(link, rx->reply_buffer, -1) &&
+                        (dust_deserialize(&packet, rx->reply_buffer, SIZE) == DUST_RESULT_SUCCESS) &&
+                        (packet.header.ack == DUST_ACK_SET) &&
+                        (packet.header.packet_number == (base & (DUST_ARQ_SEQUENCE_SIZE - 1))))
+                    {
+                        break;
+                    }
+                }
+
+                /* The ACK timed out, poll again. */
+                ASSERT_LT(attempts++, POLL_ATTEMPTS);
+                sender_transmit(tx, link, rx, image, missing.back(), true);
+            }
+
+            std::vector<uint32_t> next;
+            dust_packet_t packet;
+
+            packet.payload.buffer_size = PAYLOAD_SIZE;
+            ASSERT_EQ(dust_deserialize(&packet, rx->reply_buffer, SIZE), DUST_RESULT_SUCCESS);
+
+            for (uint32_t i = 0; i < length; i++)
+            {
+                if ((packet.payload.buffer[i / 8] & (0x01u << (i % 8))) == 0)
+                {
+                    next.push_back(base + i);
+                }
+            }
+
+            missing = next;
+        }
+    }
+}
+
+static void image_fill(std::vector<uint8_t> &image, const uint32_t total)
+{
+    image.resize(total * PAYLOAD_SIZE);
+
+    for (uint32_t i = 0; i < image.size(); i++)
+    {
+        image[i] = (uint8_t)((i * 31u) ^ (i >> 8));
+    }
+}
+
+class gtest_dust_arq : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        dust_crc16_generate_lut(0x1021);
+    }
+};
+
+///
+/// \brief This test retransmits exactly the packet lost in the middle of the window.
+///
+TEST_F(gtest_dust_arq, selective_retransmission)
+{
+    const uint32_t total = 40;
+    std::vector<uint8_t> image;
+    link_t link = { 1, 0, 0, 13, 0, 0 };
+    receiver_t rx;
+    sender_t tx = { 0, 0, {} };
+
+    image_fill(image, total);
+    rx.image.assign(image.size(), 0);
+    rx.reply = false;
+    ASSERT_EQ(dust_arq_init(&rx.arq, total, 16), DUST_RESULT_SUCCESS);
+
+    sender_run(&tx, &link, &rx, image, total, 16);
+
+    EXPECT_TRUE(dust_arq_is_complete(&rx.arq));
+    EXPECT_EQ(rx.image, image);
+    EXPECT_EQ(tx.packets, total + 1);
+    EXPECT_EQ(tx.sends[13], 2u);
+    EXPECT_EQ(tx.sends[12], 1u);
+    EXPECT_EQ(tx.sends[14], 1u);
+}
+
+///
+/// \brief This test transfers an image over a link losing and corrupting packets both ways.
+///
+TEST_F(gtest_dust_arq, lossy_link)
+{
+    const uint32_t windows[] = { 1, 8, 64, 256 };
+
+    for (uint32_t w = 0; w < (sizeof(windows) / sizeof(windows[0])); w++)
+    {
+        const uint32_t total = 300;
+        std::vector<uint8_t> image;
+        link_t link = { 7 + w, 50, 50, -1, 0, 0 };
+        receiver_t rx;
+        sender_t tx = { 0, 0, {} };
+
+        image_fill(image, total);
+        rx.image.assign(image.size(), 0);
+        rx.reply = false;
+        ASSERT_EQ(dust_arq_init(&rx.arq, total, windows[w]), DUST_RESULT_SUCCESS);
+
+        sender_run(&tx, &link, &rx, image, total, windows[w]);
+
+        EXPECT_TRUE(dust_arq_is_complete(&rx.arq));
+        EXPECT_EQ(rx.image, image);
+        EXPECT_GT(link.lost, 0u);
+
+        /* Every data packet beyond the image was sent to replace a lost one. */
+        EXPECT_LE(tx.packets - tx.polls, total + link.lost);
+    }
+}
+
+///
+/// \brief This test wraps the 11-bit packet number around.
+///
+TEST_F(gtest_dust_arq, wrap_around)
+{
+    const uint32_t total = DUST_ARQ_SEQUENCE_SIZE + 300;
+    std::vector<uint8_t> image;
+    link_t link = { 3, 20, 20, -1, 0, 0 };
+    receiver_t rx;
+    sender_t tx = { 0, 0, {} };
+
+    image_fill(image, total);
+    rx.image.assign(image.size(), 0);
+    rx.reply = false;
+    ASSERT_EQ(dust_arq_init(&rx.arq, total, 128), DUST_RESULT_SUCCESS);
+
+    sender_run(&tx, &link, &rx, image, total, 128);
+
+    EXPECT_TRUE(dust_arq_is_complete(&rx.arq));
+    EXPECT_EQ(rx.image, image);
+}
+
+///
+/// \brief This test answers the poll of the previous window after its ACK has been lost.
+///
+TEST_F(gtest_dust_arq, previous_window)
+{
+    dust_arq_t arq;
+    dust_header_t header;
+    dust_packet_t packet;
+    uint32_t index;
+
+    ASSERT_EQ(dust_arq_init(&arq, 12, 8), DUST_RESULT_SUCCESS);
+    packet.payload.buffer_size = PAYLOAD_SIZE;
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        (void)dust_header_create(&header, DUST_OPCODE_DATA, DUST_LENGTH_BYTES32, DUST_ACK_UNSET, i);
+        EXPECT_EQ(dust_arq_receive(&arq, &header, &index), DUST_ARQ_RX_NEW);
+        EXPECT_EQ(index, i);
+    }
+
+    (void)dust_header_create(&header, DUST_OPCODE_DATA, DUST_LENGTH_BYTES32, DUST_ACK_SET, 7);
+    EXPECT_EQ(dust_arq_receive(&arq, &header, &index), DUST_ARQ_RX_DUPLICATE);
+    ASSERT_EQ(dust_arq_ack_create(&arq, &header, &packet.header, &packet.payload.buffer[0], PAYLOAD_SIZE), DUST_RESULT_SUCCESS);
+    EXPECT_EQ(packet.header.packet_number, 0u);
+    EXPECT_EQ(packet.payload.buffer[0], 0xff);
+    EXPECT_EQ(arq.base, 8u);
+
+    /* The ACK has been lost, the sender polls with the last packet of the previous window. */
+    EXPECT_EQ(dust_arq_receive(&arq, &header, &index), DUST_ARQ_RX_OUT_OF_WINDOW);
+    ASSERT_EQ(dust_arq_ack_create(&arq, &header, &packet.header, &packet.payload.buffer[0], PAYLOAD_SIZE), DUST_RESULT_SUCCESS);
+    EXPECT_EQ(packet.header.packet_number, 0u);
+    EXPECT_EQ(packet.payload.buffer[0], 0xff);
+    EXPECT_EQ(arq.base, 8u);
+
+    /* The last window is shorter. */
+    for (uint32_t i = 8; i < 12; i++)
+    {
+        (void)dust_header_create(&header, DUST_OPCODE_DATA, DUST_LENGTH_BYTES32, DUST_ACK_UNSET, i);
+        EXPECT_EQ(dust_arq_receive(&arq, &header, &index), DUST_ARQ_RX_NEW);
+    }
+
+    ASSERT_EQ(dust_arq_ack_create(&arq, &header, &packet.header, &packet.payload.buffer[0], PAYLOAD_SIZE), DUST_RESULT_SUCCESS);
+    EXPECT_TRUE(dust_arq_is_complete(&arq));
+    ASSERT_EQ(dust_arq_ack_create(&arq, &header, &packet.header, &packet.payload.buffer[0], PAYLOAD_SIZE), DUST_RESULT_SUCCESS);
+    EXPECT_EQ(packet.header.packet_number, 8u);
+    EXPECT_EQ(packet.payload.buffer[0], 0x0f);
+}
+
+///
+/// \brief This test limits the window to the bitmap fitting into the payload.
+///
+TEST_F(gtest_dust_arq, window)
+{
+    dust_arq_t arq;
+
+    EXPECT_EQ(dust_arq_get_window(DUST_ACK_FREQUENCY_AFTER_512_PACKETS, 0x20), 256u);
+    EXPECT_EQ(dust_arq_get_window(DUST_ACK_FREQUENCY_AFTER_512_PACKETS, 0x100), 512u);
+    EXPECT_EQ(dust_arq_get_window(DUST_ACK_FREQUENCY_AFTER_8_PACKETS, 0x20), 8u);
+    EXPECT_EQ(dust_arq_init(&arq, 10, 0), DUST_RESULT_ERROR);
+    EXPECT_EQ(dust_arq_init(&arq, 10, DUST_ARQ_WINDOW_MAX + 1), DUST_RESULT_ERROR);
+}
+
+///
+/// \brief This test starts the first window at the packet the interrupted transfer resumes from.
+///
+TEST_F(gtest_dust_arq, resume)
+{
+    dust_arq_t arq;
+    dust_header_t header;
+    dust_packet_t packet;
+    uint32_t index;
+
+    ASSERT_EQ(dust_arq_init(&arq, 40, 16), DUST_RESULT_SUCCESS);
+    EXPECT_EQ(dust_arq_resume(&arq, 41), DUST_RESULT_ERROR);
+    ASSERT_EQ(dust_arq_resume(&arq, 20), DUST_RESULT_SUCCESS);
+    packet.payload.buffer_size = PAYLOAD_SIZE;
+
+    /* The committed packets are out of the window. */
+    (void)dust_header_create(&header, DUST_OPCODE_DATA, DUST_LENGTH_BYTES32, DUST_ACK_UNSET, 5);
+    EXPECT_EQ(dust_arq_receive(&arq, &header, &index), DUST_ARQ_RX_OUT_OF_WINDOW);
+
+    for (uint32_t i = 20; i < 36; i++)
+    {
+        (void)dust_header_create(&header, DUST_OPCODE_DATA, DUST_LENGTH_BYTES32, DUST_ACK_UNSET, i);
+        EXPECT_EQ(dust_arq_receive(&arq, &header, &index), DUST_ARQ_RX_NEW);
+        EXPECT_EQ(index, i);
+    }
+
+    header.ack = DUST_ACK_SET;
+    ASSERT_EQ(dust_arq_ack_create(&arq, &header, &packet.header, &packet.payload.buffer[0], PAYLOAD_SIZE), DUST_RESULT_SUCCESS);
+    EXPECT_EQ(packet.header.packet_number, 20u);
+    EXPECT_EQ(packet.payload.buffer[0], 0xff);
+    EXPECT_EQ(packet.payload.buffer[1], 0xff);
+    EXPECT_EQ(arq.base, 36u);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "dust.h"
+
+///
+/// \brief The byte-wise table method the crc16 used before, run over the published table.
+///
+static uint16_t crc16_bytewise(const uint8_t *const data, const uint32_t size)
+{
+    const uint16_t *lut = dust_crc16_get_lut_address();
+    uint16_t crc16 = 0;
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        crc16 = (uint16_t)((crc16 << 8) ^ lut[(crc16 >> 8) ^ data[i]]);
+    }
+
+    return crc16;
+}
+
+///
+/// \brief The crc16 of the packet as it was calculated before, through the temporary copies.
+///
+static uint16_t crc16_copied(const uint8_t *const header, const uint8_t *const payload, const uint32_t size)
+{
+    std::vector<uint8_t> serialized_data(payload, payload + size);
+    std::vector<uint8_t> serialized_header_and_data(DUST_PACKET_HEADER_SIZE + size);
+
+    memcpy(&serialized_header_and_data[0], header, DUST_PACKET_HEADER_SIZE);
+    memcpy(&serialized_header_and_data[DUST_PACKET_HEADER_SIZE], &serialized_data[0], size);
+
+    return crc16_bytewise(&serialized_header_and_data[0], serialized_header_and_data.size());
+}
+
+static std::vector<uint8_t> data(const uint32_t size)
+{
+    std::vector<uint8_t> buffer(size);
+    uint32_t seed = 3;
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        seed      = (seed * 1103515245u) + 12345u;
+        buffer[i] = (uint8_t)(seed >> 16);
+    }
+
+    return buffer;
+}
+
+class gtest_dust_crc16 : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        dust_crc16_generate_lut(0x1021);
+    }
+};
+
+///
+/// \brief This test checks the crc16 against the CRC-16/XMODEM check value.
+///
+TEST_F(gtest_dust_crc16, check_value)
+{
+    const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+    EXPECT_EQ(dust_crc16_final(dust_crc16_update(dust_crc16_init(), check, sizeof(check))), 0x31c3);
+    EXPECT_EQ(crc16_bytewise(check, sizeof(check)), 0x31c3);
+
+    /* The published table is still the byte-wise one. */
+    EXPECT_EQ(dust_crc16_get_lut_address()[0x01], 0x1021);
+    EXPECT_EQ(dust_crc16_get_lut_address()[0xff], 0x1ef0);
+}
+
+///
+/// \brief This test splits the data at every byte, at every alignment.
+///
+TEST_F(gtest_dust_crc16, incremental)
+{
+    std::vector<uint8_t> buffer = data(300);
+
+    for (uint32_t size = 0; size < 40; size++)
+    {
+        for (uint32_t offset = 0; offset < 8; offset++)
+        {
+            uint16_t expected = crc16_bytewise(&buffer[offset], size);
+
+            for (uint32_t split = 0; split <= size; split++)
+            {
+                uint16_t crc16 = dust_crc16_init();
+
+                crc16 = dust_crc16_update(crc16, &buffer[offset], split);
+                crc16 = dust_crc16_update(crc16, &buffer[offset + split], size - split);
+
+                ASSERT_EQ(dust_crc16_final(crc16), expected);
+            }
+        }
+    }
+
+    EXPECT_EQ(dust_crc16_update(dust_crc16_init(), &buffer[0], buffer.size()), crc16_bytewise(&buffer[0], buffer.size()));
+}
+
+///
+/// \brief This test keeps the packet crc16 of the previous method, for the other polynomial too.
+///
+TEST_F(gtest_dust_crc16, packet)
+{
+    const uint16_t polynomials[] = { 0x1021, 0x8005 };
+    std::vector<uint8_t> payload = data(DUST_PACKET_PAYLOAD_BUFFER_MAX_SIZE);
+    uint8_t serialized[DUST_PACKET_HEADER_SIZE + DUST_PACKET_PAYLOAD_BUFFER_MAX_SIZE + DUST_PACKET_CRC16_SIZE];
+
+    for (uint32_t p = 0; p < (sizeof(polynomials) / sizeof(polynomials[0])); p++)
+    {
+        dust_crc16_generate_lut(polynomials[p]);
+
+        for (uint32_t size = 0x20; size <= DUST_PACKET_PAYLOAD_BUFFER_MAX_SIZE; size <<= 1)
+        {
+            dust_packet_t packet;
+            dust_packet_t received;
+            uint32_t      serialized_size = DUST_PACKET_HEADER_SIZE + size + DUST_PACKET_CRC16_SIZE;
+
+            packet.payload.buffer_size = size;
+            memcpy(&packet.payload.buffer[0], &payload[0], size);
+            (void)dust_header_create(&packet.header, DUST_OPCODE_DATA, DUST_LENGTH_BYTES32, DUST_ACK_SET, 0x0123);
+
+            ASSERT_EQ(dust_serialize(&packet, serialized, serialized_size), DUST_RESULT_SUCCESS);
+            EXPECT_EQ(packet.crc16, crc16_copied(serialized, &payload[0], size));
+
+            received.payload.buffer_size = size;
+            EXPECT_EQ(dust_deserialize(&received, serialized, serialized_size), DUST_RESULT_SUCCESS);
+
+            serialized[DUST_PACKET_HEADER_SIZE + (size / 2)] ^= 0x10;
+            EXPECT_EQ(dust_deserialize(&received, serialized, serialized_size), DUST_RESULT_ERROR);
+        }
+    }
+}
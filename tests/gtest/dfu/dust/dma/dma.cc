@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include "dust_dma.h"
+
+#define SIZE (DUST_PACKET_HEADER_SIZE + 32 + DUST_PACKET_CRC16_SIZE)
+
+///
+/// \brief The reception callback captured by the fake USART DMA driver.
+///
+static ll_usart_dma_rx_cb_t rx_cb;
+
+///
+/// \brief The baud rate the fake USART DMA driver was started at.
+///
+static uint32_t rx_baud;
+
+ll_usart_dma_res_t ll_usart_dma_rx_init(const ll_usart_dma_inst_t inst, const struct ll_usart_dma_conf *const conf,
+                                        const ll_usart_dma_rx_cb_t cb, void *const arg)
+{
+    (void)inst;
+    (void)arg;
+
+    EXPECT_TRUE(conf->tx);
+    rx_cb   = cb;
+    rx_baud = conf->baud;
+
+    return LL_USART_DMA_RES_OK;
+}
+
+void ll_usart_dma_rx_deinit(const ll_usart_dma_inst_t inst)
+{
+    (void)inst;
+
+    rx_cb = NULL;
+}
+
+///
+/// \brief Feeds one packet filled with the given byte in chunks.
+///
+static void packet_feed(const uint8_t val, const uint32_t chunk)
+{
+    uint8_t data[SIZE];
+
+    memset(data, val, sizeof(data));
+
+    for (uint32_t i = 0; i < SIZE; i += chunk)
+    {
+        rx_cb(NULL, &data[i], ((SIZE - i) < chunk) ? (SIZE - i) : chunk, false);
+    }
+}
+
+///
+/// \brief This test assembles the packets split across the DMA chunks into both buffers.
+///
+TEST(gtest_dust_dma, ping_pong)
+{
+    const dust_serialized_t *rx;
+    const dust_serialized_t *prev;
+    dust_dma_stats_t stats;
+
+    ASSERT_EQ(dust_dma_start(LL_USART_DMA_INST_USART3, 115200, SIZE), DUST_RESULT_SUCCESS);
+    ASSERT_NE(rx_cb, nullptr);
+
+    packet_feed(0x11, 7);
+    packet_feed(0x22, 64);
+
+    rx = dust_dma_receive();
+    EXPECT_EQ(rx->buffer_size, SIZE);
+    EXPECT_EQ(rx->buffer[0], 0x11);
+    EXPECT_EQ(rx->buffer[SIZE - 1], 0x11);
+    dust_dma_release(rx);
+    prev = rx;
+
+    rx = dust_dma_receive();
+    EXPECT_NE(rx, prev);
+    EXPECT_EQ(rx->buffer[SIZE - 1], 0x22);
+    dust_dma_release(rx);
+
+    dust_dma_get_stats(&stats);
+    EXPECT_EQ(stats.packets, 2u);
+    EXPECT_EQ(stats.bytes, 2u * SIZE);
+    EXPECT_EQ(stats.overruns, 0u);
+
+    dust_dma_stop();
+}
+
+///
+/// \brief This test drops the packet arriving while both buffers are owned by the receiver.
+///
+TEST(gtest_dust_dma, overrun)
+{
+    const dust_serialized_t *rx;
+    dust_dma_stats_t stats;
+
+    ASSERT_EQ(dust_dma_start(LL_USART_DMA_INST_USART3, 115200, SIZE), DUST_RESULT_SUCCESS);
+
+    packet_feed(0x11, SIZE);
+    packet_feed(0x22, SIZE);
+    packet_feed(0x33, SIZE);
+
+    dust_dma_get_stats(&stats);
+    EXPECT_EQ(stats.packets, 2u);
+    EXPECT_EQ(stats.overruns, 1u);
+
+    rx = dust_dma_receive();
+    EXPECT_EQ(rx->buffer[0], 0x11);
+    dust_dma_release(rx);
+
+    packet_feed(0x44, SIZE);
+
+    rx = dust_dma_receive();
+    EXPECT_EQ(rx->buffer[0], 0x22);
+    dust_dma_release(rx);
+
+    rx = dust_dma_receive();
+    EXPECT_EQ(rx->buffer[0], 0x44);
+    dust_dma_release(rx);
+
+    dust_dma_stop();
+}
+
+///
+/// \brief This test drops the partial packet on the idle line and resynchronizes.
+///
+TEST(gtest_dust_dma, truncated)
+{
+    const dust_serialized_t *rx;
+    dust_dma_stats_t stats;
+    uint8_t data[SIZE - 1];
+
+    ASSERT_EQ(dust_dma_start(LL_USART_DMA_INST_USART3, 115200, SIZE), DUST_RESULT_SUCCESS);
+
+    memset(data, 0x55, sizeof(data));
+    rx_cb(NULL, data, sizeof(data), true);
+
+    packet_feed(0x66, 16);
+
+    dust_dma_get_stats(&stats);
+    EXPECT_EQ(stats.truncated, 1u);
+    EXPECT_EQ(stats.packets, 1u);
+
+    rx = dust_dma_receive();
+    EXPECT_EQ(rx->buffer[0], 0x66);
+    dust_dma_release(rx);
+
+    dust_dma_stop();
+}
+
+///
+/// \brief This test checks the packet size limits.
+///
+TEST(gtest_dust_dma, size)
+{
+    EXPECT_EQ(dust_dma_set_size(0), DUST_RESULT_SIZE_ERROR);
+    EXPECT_EQ(dust_dma_set_size(sizeof(dust_serialized_t)), DUST_RESULT_SIZE_ERROR);
+    EXPECT_EQ(dust_dma_set_size(SIZE), DUST_RESULT_SUCCESS);
+}
+
+///
+/// \brief This test switches the baud rate, the partial packet is discarded and the large packets follow.
+///
+TEST(gtest_dust_dma, baud)
+{
+    const dust_serialized_t *rx;
+    dust_dma_stats_t stats;
+    uint8_t data[DUST_PACKET_HEADER_SIZE + DUST_PACKET_PAYLOAD_LARGE_MAX_SIZE + DUST_PACKET_CRC16_SIZE];
+
+    EXPECT_EQ(dust_dma_set_baud(921600), DUST_RESULT_ERROR);
+
+    ASSERT_EQ(dust_dma_start(LL_USART_DMA_INST_USART3, 115200, SIZE), DUST_RESULT_SUCCESS);
+    EXPECT_EQ(rx_baud, 115200u);
+
+    packet_feed(0x11, SIZE);
+    rx_cb(NULL, data, 5, false);
+
+    ASSERT_EQ(dust_dma_set_size(sizeof(data)), DUST_RESULT_SUCCESS);
+    ASSERT_EQ(dust_dma_set_baud(921600), DUST_RESULT_SUCCESS);
+    EXPECT_EQ(rx_baud, 921600u);
+
+    memset(data, 0x77, sizeof(data));
+    rx_cb(NULL, data, sizeof(data), false);
+
+    rx = dust_dma_receive();
+    EXPECT_EQ(rx->buffer_size, sizeof(data));
+    EXPECT_EQ(rx->buffer[0], 0x77);
+    EXPECT_EQ(rx->buffer[sizeof(data) - 1], 0x77);
+    dust_dma_release(rx);
+
+    /* The packet received at the previous baud rate was not released, it is gone. */
+    dust_dma_get_stats(&stats);
+    EXPECT_EQ(stats.packets, 2u);
+
+    dust_dma_stop();
+}
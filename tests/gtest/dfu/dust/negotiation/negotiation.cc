@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include "dust.h"
+
+#define PAYLOAD_SIZE    (0x20u)
+
+///
+/// \brief This test serializes the capabilities the way scripts/dfu_updater.py parses them.
+///
+TEST(gtest_dust_negotiation, capabilities)
+{
+    const dust_capabilities_t capabilities =
+    {
+        .payload_size_max = DUST_PACKET_PAYLOAD_LARGE_MAX_SIZE,
+        .bauds            = { 115200u, 921600u, 3000000u },
+        .bauds_count      = 3,
+    };
+    const uint8_t expected[] =
+    {
+        DUST_EXT_OPCODE_CAPABILITIES, 0x08, 0x00, 0x03,
+        0x00, 0x01, 0xc2, 0x00,
+        0x00, 0x0e, 0x10, 0x00,
+        0x00, 0x2d, 0xc6, 0xc0,
+    };
+    uint8_t payload[PAYLOAD_SIZE];
+
+    memset(payload, 0xee, sizeof(payload));
+
+    ASSERT_EQ(dust_capabilities_serialize(&capabilities, payload, sizeof(payload)), DUST_RESULT_SUCCESS);
+    EXPECT_EQ(memcmp(payload, expected, sizeof(expected)), 0);
+
+    /* The rest of the payload is cleared. */
+    for (uint32_t i = sizeof(expected); i < sizeof(payload); i++)
+    {
+        EXPECT_EQ(payload[i], 0x00);
+    }
+}
+
+///
+/// \brief This test refuses the capabilities not fitting the payload.
+///
+TEST(gtest_dust_negotiation, capabilities_size)
+{
+    dust_capabilities_t capabilities = {};
+    uint8_t payload[PAYLOAD_SIZE];
+
+    /* The handshake payload holds all the baud rates. */
+    capabilities.bauds_count = DUST_CAPABILITIES_BAUDS_MAX;
+    EXPECT_EQ(dust_capabilities_serialize(&capabilities, payload, sizeof(payload)), DUST_RESULT_SUCCESS);
+    EXPECT_EQ(dust_capabilities_serialize(&capabilities, payload, sizeof(payload) - 1), DUST_RESULT_SIZE_ERROR);
+
+    capabilities.bauds_count = DUST_CAPABILITIES_BAUDS_MAX + 1;
+    EXPECT_EQ(dust_capabilities_serialize(&capabilities, payload, sizeof(payload)), DUST_RESULT_ERROR);
+    EXPECT_EQ(dust_capabilities_serialize(NULL, payload, sizeof(payload)), DUST_RESULT_ERROR);
+}
+
+///
+/// \brief This test deserializes the settings picked by the host.
+///
+TEST(gtest_dust_negotiation, settings)
+{
+    uint8_t payload[PAYLOAD_SIZE] =
+    {
+        DUST_EXT_OPCODE_SETTINGS, 0x04, 0x00,
+        0x00, 0x0e, 0x10, 0x00,
+        0x00, 0x00, 0x01, 0x23,
+    };
+    dust_settings_t settings;
+
+    ASSERT_EQ(dust_settings_deserialize(&settings, payload, sizeof(payload)), DUST_RESULT_SUCCESS);
+    EXPECT_EQ(settings.payload_size, 0x400u);
+    EXPECT_EQ(settings.baud, 921600u);
+    EXPECT_EQ(settings.number_of_packets, 0x123u);
+
+    EXPECT_EQ(dust_settings_deserialize(&settings, payload, 10), DUST_RESULT_ERROR);
+
+    payload[DUST_EXT_OPCODE_POSITION] = DUST_EXT_OPCODE_MANIFEST;
+    EXPECT_EQ(dust_settings_deserialize(&settings, payload, sizeof(payload)), DUST_RESULT_ERROR);
+}
+
+///
+/// \brief This test frames the negotiated payload larger than the header length field encodes.
+///
+TEST(gtest_dust_negotiation, large_packet)
+{
+    static dust_serialized_t serialized;
+    dust_header_t header;
+    dust_view_t   view;
+    uint32_t      size = DUST_PACKET_HEADER_SIZE + DUST_PACKET_PAYLOAD_LARGE_MAX_SIZE + DUST_PACKET_CRC16_SIZE;
+
+    dust_crc16_generate_lut(0x1021);
+
+    ASSERT_EQ(sizeof(serialized.buffer), size);
+
+    for (uint32_t i = 0; i < DUST_PACKET_PAYLOAD_LARGE_MAX_SIZE; i++)
+    {
+        serialized.buffer[DUST_PACKET_DATA_POSITION + i] = (uint8_t)(i * 13u);
+    }
+
+    (void)dust_header_create(&header, DUST_OPCODE_DATA, DUST_LENGTH_BYTES256, DUST_ACK_UNSET, 0x0042);
+    ASSERT_EQ(dust_view_serialize(&header, &serialized.buffer[0], size, DUST_PACKET_PAYLOAD_LARGE_MAX_SIZE),
+              DUST_RESULT_SUCCESS);
+
+    ASSERT_EQ(dust_view_parse(&view, &serialized.buffer[0], size, DUST_PACKET_PAYLOAD_LARGE_MAX_SIZE),
+              DUST_RESULT_SUCCESS);
+    EXPECT_EQ(view.header.packet_number, 0x0042);
+    EXPECT_EQ(view.payload_size, DUST_PACKET_PAYLOAD_LARGE_MAX_SIZE);
+    EXPECT_EQ(view.payload[DUST_PACKET_PAYLOAD_LARGE_MAX_SIZE - 1], (uint8_t)((DUST_PACKET_PAYLOAD_LARGE_MAX_SIZE - 1) * 13u));
+}
@@ -35,16 +35,11 @@ TEST(gtest_dust_serialization, perform)
         .crc16   = 0
     };
 
-    /* Create a dust protocol instance. */
-    dust_protocol_instance_t instance =
+    /* Create a dust serialized packet. */
+    dust_serialized_t serialized =
     {
-        .options    = { 0 },
-        .packet     = packet,
-        .serialized =
-        {
-            .buffer      = { 0 },
-            .buffer_size = DUST_PACKET_HEADER_SIZE + payload.buffer_size + DUST_PACKET_CRC16_SIZE
-        }
+        .buffer      = { 0 },
+        .buffer_size = DUST_PACKET_HEADER_SIZE + payload.buffer_size + DUST_PACKET_CRC16_SIZE
     };
 
     /* Create an expected buffer. */
@@ -60,10 +55,10 @@ TEST(gtest_dust_serialization, perform)
     /* Generate the crc16 look-up table. */
     dust_crc16_generate_lut(0x1021);
 
-    result = dust_serialize(&instance.packet, &instance.serialized.buffer[0], instance.serialized.buffer_size);
+    result = dust_serialize(&packet, &serialized.buffer[0], serialized.buffer_size);
     EXPECT_EQ(result, DUST_RESULT_SUCCESS);
 
-    EXPECT_TRUE(memcmp(&expected_buffer[0], &instance.serialized.buffer[0], instance.serialized.buffer_size) == 0);
+    EXPECT_TRUE(memcmp(&expected_buffer[0], &serialized.buffer[0], serialized.buffer_size) == 0);
 }
 
 ///
@@ -88,19 +83,14 @@ TEST(gtest_dust_serialization, size_protection)
         .crc16   = 0
     };
 
-    /* Create a dust protocol instance. */
-    dust_protocol_instance_t instance =
+    /* Create a dust serialized packet. */
+    dust_serialized_t serialized =
     {
-        .options    = { 0 },
-        .packet     = packet,
-        .serialized =
-        {
-            .buffer      = { 0 },
-            .buffer_size = DUST_PACKET_HEADER_SIZE + payload.buffer_size + DUST_PACKET_CRC16_SIZE
-        }
+        .buffer      = { 0 },
+        .buffer_size = DUST_PACKET_HEADER_SIZE + payload.buffer_size + DUST_PACKET_CRC16_SIZE
     };
 
-    result = dust_serialize(&instance.packet, &instance.serialized.buffer[0], instance.serialized.buffer_size - 1);
+    result = dust_serialize(&packet, &serialized.buffer[0], serialized.buffer_size - 1);
     EXPECT_EQ(result, DUST_RESULT_SIZE_ERROR);
 }
 
@@ -110,11 +100,12 @@ TEST(gtest_dust_serialization, size_protection)
 TEST(gtest_dust_serialization, null_pointer_protection)
 {
     dust_result_t result;
-    dust_protocol_instance_t instance = { 0 };
+    dust_packet_t packet = { 0 };
+    dust_serialized_t serialized = { 0 };
 
-    result = dust_serialize(NULL, &instance.serialized.buffer[0], instance.serialized.buffer_size);
+    result = dust_serialize(NULL, &serialized.buffer[0], serialized.buffer_size);
     EXPECT_EQ(result, DUST_RESULT_ERROR);
 
-    result = dust_serialize(&instance.packet, NULL, instance.serialized.buffer_size);
+    result = dust_serialize(&packet, NULL, serialized.buffer_size);
     EXPECT_EQ(result, DUST_RESULT_ERROR);
 }
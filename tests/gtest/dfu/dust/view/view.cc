@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include "dust.h"
+
+#define PAYLOAD_SIZE    (0x40u)
+#define SIZE            (DUST_PACKET_HEADER_SIZE + PAYLOAD_SIZE + DUST_PACKET_CRC16_SIZE)
+
+class gtest_dust_view : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        dust_crc16_generate_lut(0x1021);
+
+        for (uint32_t i = 0; i < PAYLOAD_SIZE; i++)
+        {
+            payload[i] = (uint8_t)((i * 7u) + 3u);
+        }
+
+        (void)dust_header_create(&header, DUST_OPCODE_DATA, DUST_LENGTH_BYTES64, DUST_ACK_SET, 0x05a3);
+    }
+
+    uint8_t       payload[PAYLOAD_SIZE];
+    dust_header_t header;
+};
+
+///
+/// \brief This test serializes the payload written in place the same way dust_serialize() does.
+///
+TEST_F(gtest_dust_view, serialize)
+{
+    dust_packet_t packet;
+    uint8_t expected[SIZE];
+    uint8_t data[SIZE + 1];
+
+    packet.header              = header;
+    packet.payload.buffer_size = PAYLOAD_SIZE;
+    memcpy(&packet.payload.buffer[0], payload, PAYLOAD_SIZE);
+    ASSERT_EQ(dust_serialize(&packet, expected, sizeof(expected)), DUST_RESULT_SUCCESS);
+
+    memset(data, 0xee, sizeof(data));
+    memcpy(&data[DUST_PACKET_DATA_POSITION], payload, PAYLOAD_SIZE);
+
+    ASSERT_EQ(dust_view_serialize(&header, data, SIZE, PAYLOAD_SIZE), DUST_RESULT_SUCCESS);
+    EXPECT_EQ(memcmp(data, expected, SIZE), 0);
+
+    /* Nothing is written past the packet. */
+    EXPECT_EQ(data[SIZE], 0xee);
+
+    EXPECT_EQ(dust_view_serialize(&header, data, SIZE - 1, PAYLOAD_SIZE), DUST_RESULT_SIZE_ERROR);
+    EXPECT_EQ(dust_view_serialize(NULL, data, SIZE, PAYLOAD_SIZE), DUST_RESULT_ERROR);
+    EXPECT_EQ(dust_view_serialize(&header, NULL, SIZE, PAYLOAD_SIZE), DUST_RESULT_ERROR);
+}
+
+///
+/// \brief This test parses the packet without copying its payload out.
+///
+TEST_F(gtest_dust_view, parse)
+{
+    dust_view_t view;
+    uint8_t data[SIZE];
+
+    memcpy(&data[DUST_PACKET_DATA_POSITION], payload, PAYLOAD_SIZE);
+    ASSERT_EQ(dust_view_serialize(&header, data, sizeof(data), PAYLOAD_SIZE), DUST_RESULT_SUCCESS);
+
+    ASSERT_EQ(dust_view_parse(&view, data, sizeof(data), PAYLOAD_SIZE), DUST_RESULT_SUCCESS);
+    EXPECT_EQ(view.header.opcode, DUST_OPCODE_DATA);
+    EXPECT_EQ(view.header.length, DUST_LENGTH_BYTES64);
+    EXPECT_EQ(view.header.ack, DUST_ACK_SET);
+    EXPECT_EQ(view.header.packet_number, 0x05a3);
+    EXPECT_EQ(view.payload, &data[DUST_PACKET_DATA_POSITION]);
+    EXPECT_EQ(view.payload_size, PAYLOAD_SIZE);
+
+    /* The packet deserialized through the copies agrees. */
+    dust_packet_t packet;
+    packet.payload.buffer_size = PAYLOAD_SIZE;
+    ASSERT_EQ(dust_deserialize(&packet, data, sizeof(data)), DUST_RESULT_SUCCESS);
+    EXPECT_EQ(memcmp(&packet.payload.buffer[0], view.payload, PAYLOAD_SIZE), 0);
+}
+
+///
+/// \brief This test refuses the corrupted and the short packets, the view is left untouched.
+///
+TEST_F(gtest_dust_view, corrupted)
+{
+    dust_view_t view;
+    uint8_t data[SIZE];
+
+    memcpy(&data[DUST_PACKET_DATA_POSITION], payload, PAYLOAD_SIZE);
+    ASSERT_EQ(dust_view_serialize(&header, data, sizeof(data), PAYLOAD_SIZE), DUST_RESULT_SUCCESS);
+
+    memset(&view, 0, sizeof(view));
+
+    for (uint32_t i = 0; i < SIZE; i++)
+    {
+        data[i] ^= 0x01;
+        EXPECT_EQ(dust_view_parse(&view, data, sizeof(data), PAYLOAD_SIZE), DUST_RESULT_ERROR);
+        data[i] ^= 0x01;
+    }
+
+    EXPECT_EQ(view.payload, nullptr);
+    EXPECT_EQ(view.header.packet_number, 0);
+
+    EXPECT_EQ(dust_view_parse(&view, data, SIZE - 1, PAYLOAD_SIZE), DUST_RESULT_SIZE_ERROR);
+    EXPECT_EQ(dust_view_parse(NULL, data, SIZE, PAYLOAD_SIZE), DUST_RESULT_ERROR);
+    EXPECT_EQ(dust_view_parse(&view, NULL, SIZE, PAYLOAD_SIZE), DUST_RESULT_ERROR);
+}
@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "dust.h"
+extern "C" {
+#include "delta.h"
+}
+
+#define PAYLOAD_SIZE    (0x40u)
+#define SIZE            (DUST_PACKET_HEADER_SIZE + PAYLOAD_SIZE + DUST_PACKET_CRC16_SIZE)
+#define APP_SIZE        (DELTA_BLOCKS_MAX * DELTA_BLOCK_SIZE)
+
+///
+/// \brief The bytes sent in both directions, by the kind of the message.
+///
+typedef struct
+{
+    uint32_t manifest;
+    uint32_t blocks;
+    uint32_t data;
+    uint32_t acks;
+} wire_t;
+
+static std::vector<uint8_t> image(const uint32_t size)
+{
+    std::vector<uint8_t> data(size);
+    uint32_t seed = 7;
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        seed    = (seed * 1103515245u) + 12345u;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+
+    return data;
+}
+
+///
+/// \brief Builds the manifest messages the way scripts/dfu_updater.py does.
+///
+static std::vector<std::vector<uint8_t>> manifest(const std::vector<uint8_t> &data)
+{
+    std::vector<std::vector<uint8_t>> messages;
+    uint32_t blocks = (data.size() + DELTA_BLOCK_SIZE - 1) / DELTA_BLOCK_SIZE;
+    uint32_t count  = (PAYLOAD_SIZE - DELTA_MANIFEST_HEADER) / 4;
+
+    for (uint32_t first = 0; first < blocks; first += count)
+    {
+        std::vector<uint8_t> payload(PAYLOAD_SIZE, 0x00);
+        uint32_t n = std::min(count, blocks - first);
+
+        payload[0] = DUST_EXT_OPCODE_MANIFEST;
+        payload[1] = (uint8_t)(first >> 0x08);
+        payload[2] = (uint8_t)(first >> 0x00);
+        payload[3] = (uint8_t)n;
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            uint32_t offset = (first + i) * DELTA_BLOCK_SIZE;
+            uint32_t size   = std::min<uint32_t>(DELTA_BLOCK_SIZE, data.size() - offset);
+            uint32_t hash   = delta_hash(&data[offset], size);
+
+            payload[DELTA_MANIFEST_HEADER + (i * 4) + 0] = (uint8_t)(hash >> 0x18);
+            payload[DELTA_MANIFEST_HEADER + (i * 4) + 1] = (uint8_t)(hash >> 0x10);
+            payload[DELTA_MANIFEST_HEADER + (i * 4) + 2] = (uint8_t)(hash >> 0x08);
+            payload[DELTA_MANIFEST_HEADER + (i * 4) + 3] = (uint8_t)(hash >> 0x00);
+        }
+
+        messages.push_back(payload);
+    }
+
+    return messages;
+}
+
+///
+/// \brief Passes the payload through a serialized packet, as the link does.
+///
+static void transfer(dust_packet_t *const packet, const dust_opcode_t opcode, const dust_ack_t ack,
+                     const uint8_t *const payload, uint32_t *const bytes)
+{
+    uint8_t data[SIZE];
+
+    packet->payload.buffer_size = PAYLOAD_SIZE;
+    memcpy(&packet->payload.buffer[0], payload, PAYLOAD_SIZE);
+
+    (void)dust_header_create(&packet->header, opcode, DUST_LENGTH_BYTES64, ack, 0x00);
+    ASSERT_EQ(dust_serialize(packet, data, sizeof(data)), DUST_RESULT_SUCCESS);
+    ASSERT_EQ(dust_deserialize(packet, data, sizeof(data)), DUST_RESULT_SUCCESS);
+
+    *bytes += SIZE;
+}
+
+///
+/// \brief Runs the delta update of the installed image to the new one.
+///
+/// \return The installed image afterwards.
+///
+static std::vector<uint8_t> update(const std::vector<uint8_t> &installed, const std::vector<uint8_t> &next,
+                                   wire_t *const wire)
+{
+    std::vector<uint8_t> flash(APP_SIZE, 0xff);
+    std::vector<uint8_t> stream(next);
+    std::vector<std::vector<uint8_t>> messages = manifest(next);
+    std::vector<uint32_t> blocks;
+    delta_t delta;
+    dust_packet_t packet;
+    uint8_t zeros[PAYLOAD_SIZE] = { 0 };
+
+    memcpy(&flash[0], &installed[0], installed.size());
+    stream.resize(((next.size() + DELTA_BLOCK_SIZE - 1) / DELTA_BLOCK_SIZE) * DELTA_BLOCK_SIZE, 0xff);
+
+    EXPECT_EQ(delta_init(&delta, next.size()), DELTA_RES_OK);
+
+    /* The manifest, each message but the last acknowledged. */
+    for (uint32_t i = 0; i < messages.size(); i++)
+    {
+        transfer(&packet, DUST_OPCODE_CONNECT, DUST_ACK_UNSET, &messages[i][0], &wire->manifest);
+        EXPECT_EQ(delta_manifest_process(&delta, &packet.payload.buffer[0], packet.payload.buffer_size), DELTA_RES_OK);
+        EXPECT_EQ(delta_manifest_is_complete(&delta), (i + 1) == messages.size());
+
+        if ((i + 1) != messages.size())
+        {
+            transfer(&packet, DUST_OPCODE_CONNECT, DUST_ACK_SET, zeros, &wire->acks);
+        }
+    }
+
+    delta_compare(&delta, &flash[0]);
+
+    /* The kept blocks are staged, the others erased. */
+    for (uint32_t block = 0; block < delta.blocks; block++)
+    {
+        if (delta_block_differs(&delta, block))
+        {
+            memset(&flash[block * DELTA_BLOCK_SIZE], 0xff, DELTA_BLOCK_SIZE);
+        }
+    }
+
+    uint8_t reply[PAYLOAD_SIZE];
+    EXPECT_EQ(delta_blocks_create(&delta, reply, sizeof(reply)), DELTA_RES_OK);
+    transfer(&packet, DUST_OPCODE_CONNECT, DUST_ACK_SET, reply, &wire->blocks);
+
+    EXPECT_EQ(packet.payload.buffer[0], DUST_EXT_OPCODE_BLOCKS);
+
+    for (uint32_t block = 0; block < delta.blocks; block++)
+    {
+        if ((packet.payload.buffer[DELTA_BLOCKS_HEADER + (block / 8)] >> (block % 8)) & 0x01)
+        {
+            blocks.push_back(block);
+        }
+    }
+
+    EXPECT_EQ(blocks.size(), delta.count);
+
+    /* The data packets carry the differing blocks only. */
+    uint32_t packets = delta_get_packets(&delta, PAYLOAD_SIZE);
+    uint32_t per_block = DELTA_BLOCK_SIZE / PAYLOAD_SIZE;
+
+    for (uint32_t index = 0; index < packets; index++)
+    {
+        uint32_t offset = (blocks[index / per_block] * DELTA_BLOCK_SIZE) + ((index % per_block) * PAYLOAD_SIZE);
+
+        transfer(&packet, DUST_OPCODE_DATA, DUST_ACK_UNSET, &stream[offset], &wire->data);
+        EXPECT_EQ(delta_get_offset(&delta, index, PAYLOAD_SIZE), offset);
+        memcpy(&flash[delta_get_offset(&delta, index, PAYLOAD_SIZE)], &packet.payload.buffer[0], PAYLOAD_SIZE);
+    }
+
+    flash.resize(next.size());
+
+    return flash;
+}
+
+class gtest_delta : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        dust_crc16_generate_lut(0x1021);
+    }
+};
+
+///
+/// \brief This test checks the block hash against the CRC-32 check value zlib.crc32() gives.
+///
+TEST_F(gtest_delta, hash)
+{
+    const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+    EXPECT_EQ(delta_hash(check, sizeof(check)), 0xcbf43926u);
+    EXPECT_EQ(delta_hash(check, 0), 0x00000000u);
+}
+
+///
+/// \brief This test transfers a small code change, the bytes on the wire against the full image.
+///
+TEST_F(gtest_delta, small_change)
+{
+    std::vector<uint8_t> installed = image(40000);
+    std::vector<uint8_t> next(installed);
+    wire_t wire = { 0, 0, 0, 0 };
+
+    /* A constant and a branch target of one function changed. */
+    next[20500] ^= 0x04;
+    next[20900] ^= 0x80;
+
+    std::vector<uint8_t> result = update(installed, next, &wire);
+
+    EXPECT_TRUE(result == next);
+    EXPECT_EQ(wire.data, (DELTA_BLOCK_SIZE / PAYLOAD_SIZE) * SIZE);
+
+    uint32_t total = wire.manifest + wire.acks + wire.blocks + wire.data;
+    uint32_t full  = ((installed.size() + PAYLOAD_SIZE - 1) / PAYLOAD_SIZE) * SIZE;
+
+    printf("[          ] manifest %u, acks %u, blocks %u, data %u: %u of %u bytes on the wire\n",
+           wire.manifest, wire.acks, wire.blocks, wire.data, total, full);
+
+    EXPECT_LT(total * 10, full);
+}
+
+///
+/// \brief This test grows the image, the blocks past the installed one and the shorter last block.
+///
+TEST_F(gtest_delta, grown_image)
+{
+    std::vector<uint8_t> installed = image(5000);
+    std::vector<uint8_t> next = image(7001);
+    wire_t wire = { 0, 0, 0, 0 };
+
+    /* The installed image is a prefix of the new one up to its shorter last block. */
+    std::vector<uint8_t> result = update(installed, next, &wire);
+
+    EXPECT_TRUE(result == next);
+    EXPECT_EQ(wire.data, 3 * (DELTA_BLOCK_SIZE / PAYLOAD_SIZE) * SIZE);
+
+    wire = { 0, 0, 0, 0 };
+    result = update(next, next, &wire);
+
+    EXPECT_TRUE(result == next);
+    EXPECT_EQ(wire.data, 0u);
+}
+
+///
+/// \brief This test refuses the image too large for the region and the corrupted manifest.
+///
+TEST_F(gtest_delta, manifest)
+{
+    delta_t delta;
+    uint8_t payload[PAYLOAD_SIZE] = { DUST_EXT_OPCODE_MANIFEST, 0x00, 0x07, 0x02 };
+
+    EXPECT_EQ(delta_init(&delta, APP_SIZE + 1), DELTA_RES_ERR);
+    EXPECT_EQ(delta_init(&delta, 0), DELTA_RES_ERR);
+
+    ASSERT_EQ(delta_init(&delta, 8 * DELTA_BLOCK_SIZE), DELTA_RES_OK);
+    EXPECT_EQ(delta.blocks, 8u);
+
+    /* The blocks 7 and 8, the latter past the image. */
+    EXPECT_EQ(delta_manifest_process(&delta, payload, sizeof(payload)), DELTA_RES_ERR);
+
+    /* The hashes past the payload. */
+    payload[2] = 0x00;
+    payload[3] = 0x08;
+    EXPECT_EQ(delta_manifest_process(&delta, payload, DELTA_MANIFEST_HEADER + 4), DELTA_RES_ERR);
+
+    payload[0] = DUST_EXT_OPCODE_BLOCKS;
+    EXPECT_EQ(delta_manifest_process(&delta, payload, sizeof(payload)), DELTA_RES_ERR);
+
+    /* The repeated message counts once. */
+    payload[0] = DUST_EXT_OPCODE_MANIFEST;
+    payload[3] = 0x04;
+    EXPECT_EQ(delta_manifest_process(&delta, payload, sizeof(payload)), DELTA_RES_OK);
+    EXPECT_EQ(delta_manifest_process(&delta, payload, sizeof(payload)), DELTA_RES_OK);
+    EXPECT_EQ(delta.received, 4u);
+    EXPECT_FALSE(delta_manifest_is_complete(&delta));
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+extern "C" {
+#include "journal.h"
+}
+
+#define RECORDS         (0x10u)
+#define IMAGE_HASH      (0x1c291ca3u)
+#define IMAGE_SIZE      (40000u)
+
+///
+/// \brief The flash sector holding the records, erased.
+///
+class gtest_journal : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        memset(log, 0xff, sizeof(log));
+        memset(&shared, 0x5a, sizeof(shared));
+    }
+
+    journal_record_t log[RECORDS];
+    journal_record_t shared;
+};
+
+///
+/// \brief This test refuses the torn and the uninitialized records.
+///
+TEST_F(gtest_journal, record)
+{
+    journal_record_t record;
+
+    journal_record_create(&record, IMAGE_HASH, IMAGE_SIZE, 0x1000, 3);
+    EXPECT_TRUE(journal_record_is_valid(&record));
+
+    /* The shared SRAM after the power-on. */
+    EXPECT_FALSE(journal_record_is_valid(&shared));
+    EXPECT_FALSE(journal_record_is_valid(&log[0]));
+    EXPECT_FALSE(journal_record_is_valid(NULL));
+
+    for (uint32_t i = 0; i < sizeof(record); i++)
+    {
+        ((uint8_t *)&record)[i] ^= 0x10;
+        EXPECT_FALSE(journal_record_is_valid(&record));
+        ((uint8_t *)&record)[i] ^= 0x10;
+    }
+}
+
+///
+/// \brief This test finds the newest record and the first erased slot, past a torn record.
+///
+TEST_F(gtest_journal, find)
+{
+    uint32_t free = 0;
+
+    EXPECT_EQ(journal_find(log, RECORDS, &free), nullptr);
+    EXPECT_EQ(free, 0u);
+
+    journal_record_create(&log[0], IMAGE_HASH, IMAGE_SIZE, 0x0000, 0);
+    journal_record_create(&log[1], IMAGE_HASH, IMAGE_SIZE, 0x1000, 1);
+
+    /* The power was lost while the third record was programmed. */
+    journal_record_create(&log[2], IMAGE_HASH, IMAGE_SIZE, 0x2000, 2);
+    memset(&log[2].committed, 0xff, sizeof(log[2].committed));
+
+    EXPECT_EQ(journal_find(log, RECORDS, &free), &log[1]);
+    EXPECT_EQ(free, 3u);
+
+    for (uint32_t i = 3; i < RECORDS; i++)
+    {
+        journal_record_create(&log[i], IMAGE_HASH, IMAGE_SIZE, i * 0x100, i);
+    }
+
+    EXPECT_EQ(journal_find(log, RECORDS, &free), &log[RECORDS - 1]);
+    EXPECT_EQ(free, RECORDS);
+}
+
+///
+/// \brief This test resumes the same image from the newer of the shared and the flash records.
+///
+TEST_F(gtest_journal, resume)
+{
+    const journal_record_t *flash;
+
+    journal_record_create(&log[0], IMAGE_HASH, IMAGE_SIZE, 0x1000, 4);
+    flash = journal_find(log, RECORDS, NULL);
+
+    /* The power loss, the shared SRAM holds garbage. */
+    EXPECT_EQ(journal_resume(&shared, flash, IMAGE_HASH, IMAGE_SIZE), 0x1000u);
+    EXPECT_EQ(journal_next_sequence(&shared, flash), 5u);
+
+    /* The warm reset, the shared copy is ahead of the flash one. */
+    journal_record_create(&shared, IMAGE_HASH, IMAGE_SIZE, 0x1c00, 7);
+    EXPECT_EQ(journal_resume(&shared, flash, IMAGE_HASH, IMAGE_SIZE), 0x1c00u);
+    EXPECT_EQ(journal_next_sequence(&shared, flash), 8u);
+
+    /* Another image, or the image of another size. */
+    EXPECT_EQ(journal_resume(&shared, flash, IMAGE_HASH + 1, IMAGE_SIZE), 0u);
+    EXPECT_EQ(journal_resume(&shared, flash, IMAGE_HASH, IMAGE_SIZE + 4), 0u);
+    EXPECT_EQ(journal_resume(&shared, flash, 0, IMAGE_SIZE), 0u);
+
+    /* The shared copy left by an older updater run loses against the flash record. */
+    journal_record_create(&shared, IMAGE_HASH, IMAGE_SIZE, 0x3000, 2);
+    EXPECT_EQ(journal_resume(&shared, flash, IMAGE_HASH, IMAGE_SIZE), 0x1000u);
+
+    EXPECT_EQ(journal_resume(NULL, NULL, IMAGE_HASH, IMAGE_SIZE), 0u);
+    EXPECT_EQ(journal_next_sequence(NULL, NULL), 0u);
+}
+
+///
+/// \brief This test supersedes the interrupted transfer by the next one, whatever image it carries.
+///
+TEST_F(gtest_journal, supersede)
+{
+    uint32_t free = 0;
+
+    journal_record_create(&log[0], IMAGE_HASH, IMAGE_SIZE, 0x4000, 0);
+    journal_record_create(&shared, IMAGE_HASH, IMAGE_SIZE, 0x4400, 1);
+
+    /* The LZ update writes the record naming no image before it erases the app. */
+    journal_record_create(&log[1], 0, IMAGE_SIZE, 0, journal_next_sequence(&shared, journal_find(log, 1, NULL)));
+    shared = log[1];
+
+    EXPECT_EQ(journal_resume(&shared, journal_find(log, RECORDS, &free), IMAGE_HASH, IMAGE_SIZE), 0u);
+    EXPECT_EQ(free, 2u);
+    EXPECT_EQ(log[1].sequence, 2u);
+}
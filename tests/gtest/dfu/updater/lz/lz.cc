@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+extern "C" {
+#include "lz_decoder.h"
+}
+
+///
+/// \brief The blocks handed over to the sink.
+///
+static std::vector<uint8_t> sink_data;
+static uint32_t sink_blocks;
+static bool sink_fail;
+
+static lz_decoder_res_t sink(const uint8_t *const data, const uint32_t size)
+{
+    EXPECT_EQ(size % 4, 0u);
+    EXPECT_LE(size, LZ_DECODER_FLUSH_SIZE);
+
+    sink_data.insert(sink_data.end(), data, data + size);
+    sink_blocks++;
+
+    return sink_fail ? LZ_DECODER_RES_SINK_ERR : LZ_DECODER_RES_OK;
+}
+
+///
+/// \brief Compresses the data the way scripts/dfu_updater_lz.py does, without the hash chains.
+///
+static std::vector<uint8_t> compress(const std::vector<uint8_t> &data)
+{
+    std::vector<uint8_t> out;
+    uint32_t flags = 0;
+    uint32_t items = 8;
+
+    for (uint32_t pos = 0; pos < data.size();)
+    {
+        uint32_t best_len  = 0;
+        uint32_t best_dist = 0;
+        uint32_t limit     = std::min<uint32_t>(LZ_DECODER_MATCH_MAX, data.size() - pos);
+
+        if (items == 8)
+        {
+            flags = out.size();
+            out.push_back(0);
+            items = 0;
+        }
+
+        for (uint32_t dist = 1; (dist <= LZ_DECODER_WINDOW_SIZE) && (dist <= pos); dist++)
+        {
+            uint32_t len = 0;
+
+            while ((len < limit) && (data[pos - dist + len] == data[pos + len]))
+            {
+                len++;
+            }
+
+            if (len > best_len)
+            {
+                best_len  = len;
+                best_dist = dist;
+            }
+        }
+
+        if (best_len >= LZ_DECODER_MATCH_MIN)
+        {
+            out.push_back((uint8_t)((best_dist - 1) & 0xff));
+            out.push_back((uint8_t)((((best_dist - 1) >> 4) & 0xf0) | (best_len - LZ_DECODER_MATCH_MIN)));
+            pos += best_len;
+        }
+        else
+        {
+            out[flags] |= (uint8_t)(0x01 << items);
+            out.push_back(data[pos]);
+            pos++;
+        }
+
+        items++;
+    }
+
+    return out;
+}
+
+static std::vector<uint8_t> image(const uint32_t size)
+{
+    std::vector<uint8_t> data(size);
+    uint32_t seed = 1;
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        seed = (seed * 1103515245u) + 12345u;
+
+        /* Repeated words with some noise, like machine code. */
+        data[i] = ((seed >> 16) % 8 == 0) ? (uint8_t)(seed >> 24) : (uint8_t)((i % 48) * 5);
+    }
+
+    return data;
+}
+
+class gtest_lz_decoder : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        sink_data.clear();
+        sink_blocks = 0;
+        sink_fail   = false;
+    }
+};
+
+///
+/// \brief This test decodes the stream split at any byte into flushed blocks.
+///
+TEST_F(gtest_lz_decoder, chunks)
+{
+    const uint32_t chunks[] = { 1, 7, 32, 256, 100000 };
+    std::vector<uint8_t> data = image(5001);
+    std::vector<uint8_t> stream = compress(data);
+
+    EXPECT_LT(stream.size(), data.size());
+
+    /* The padding of the last packet follows the stream. */
+    stream.insert(stream.end(), 13, 0xa5);
+
+    for (uint32_t c = 0; c < (sizeof(chunks) / sizeof(chunks[0])); c++)
+    {
+        lz_decoder_stats_t stats;
+
+        sink_data.clear();
+        ASSERT_EQ(lz_decoder_init(data.size(), &sink), LZ_DECODER_RES_OK);
+
+        for (uint32_t i = 0; i < stream.size(); i += chunks[c])
+        {
+            uint32_t size = std::min<uint32_t>(chunks[c], stream.size() - i);
+
+            ASSERT_EQ(lz_decoder_write(&stream[i], size), LZ_DECODER_RES_OK);
+        }
+
+        ASSERT_EQ(lz_decoder_finish(), LZ_DECODER_RES_OK);
+
+        ASSERT_EQ(sink_data.size(), 5004u);
+        EXPECT_TRUE(std::equal(data.begin(), data.end(), sink_data.begin()));
+        EXPECT_EQ(sink_data[5001], 0xff);
+        EXPECT_EQ(sink_data[5003], 0xff);
+
+        lz_decoder_get_stats(&stats);
+        EXPECT_EQ(stats.out, data.size());
+        EXPECT_EQ(stats.in, stream.size() - 13);
+    }
+}
+
+///
+/// \brief This test decodes the match overlapping its own output.
+///
+TEST_F(gtest_lz_decoder, overlap)
+{
+    /* One literal followed by two matches of the distance 1. */
+    const uint8_t stream[] = { 0x01, 'a', 0x00, 0x0f, 0x00, 0x0f };
+
+    ASSERT_EQ(lz_decoder_init(37, &sink), LZ_DECODER_RES_OK);
+    ASSERT_EQ(lz_decoder_write(stream, sizeof(stream)), LZ_DECODER_RES_OK);
+    ASSERT_EQ(lz_decoder_finish(), LZ_DECODER_RES_OK);
+
+    ASSERT_EQ(sink_data.size(), 40u);
+
+    for (uint32_t i = 0; i < 37; i++)
+    {
+        EXPECT_EQ(sink_data[i], 'a');
+    }
+}
+
+///
+/// \brief This test refuses the corrupted and the incomplete streams.
+///
+TEST_F(gtest_lz_decoder, corrupted)
+{
+    /* The match reaches before the start of the image. */
+    const uint8_t before[] = { 0x01, 'a', 0x01, 0x00 };
+
+    /* The match runs past the end of the image. */
+    const uint8_t past[] = { 0x01, 'a', 0x00, 0x0f };
+
+    ASSERT_EQ(lz_decoder_init(16, &sink), LZ_DECODER_RES_OK);
+    EXPECT_EQ(lz_decoder_write(before, sizeof(before)), LZ_DECODER_RES_ERR);
+    EXPECT_EQ(lz_decoder_finish(), LZ_DECODER_RES_ERR);
+
+    ASSERT_EQ(lz_decoder_init(16, &sink), LZ_DECODER_RES_OK);
+    EXPECT_EQ(lz_decoder_write(past, sizeof(past)), LZ_DECODER_RES_ERR);
+
+    ASSERT_EQ(lz_decoder_init(16, &sink), LZ_DECODER_RES_OK);
+    EXPECT_EQ(lz_decoder_write(past, 2), LZ_DECODER_RES_OK);
+    EXPECT_EQ(lz_decoder_finish(), LZ_DECODER_RES_ERR);
+
+    EXPECT_EQ(lz_decoder_init(16, NULL), LZ_DECODER_RES_ERR);
+}
+
+///
+/// \brief This test stops the decoding on the sink error.
+///
+TEST_F(gtest_lz_decoder, sink_error)
+{
+    std::vector<uint8_t> data = image(1024);
+    std::vector<uint8_t> stream = compress(data);
+
+    sink_fail = true;
+
+    ASSERT_EQ(lz_decoder_init(data.size(), &sink), LZ_DECODER_RES_OK);
+    EXPECT_EQ(lz_decoder_write(&stream[0], stream.size()), LZ_DECODER_RES_SINK_ERR);
+    EXPECT_EQ(sink_blocks, 1u);
+    EXPECT_EQ(lz_decoder_finish(), LZ_DECODER_RES_SINK_ERR);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "image_header.h"
+
+#define REGION_SIZE     (0x10000u)
+
+///
+/// \brief The bit-wise CRC-32 zlib.crc32() gives.
+///
+static uint32_t crc32_bitwise(const uint8_t *const data, const uint32_t size, uint32_t crc = 0xffffffff)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+
+        for (uint32_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ ((crc & 0x01) ? 0xedb88320u : 0x00000000u);
+        }
+    }
+
+    return crc;
+}
+
+///
+/// \brief Builds the image and fills in its header the way scripts/image_header.py does.
+///
+static std::vector<uint32_t> image(const uint32_t length)
+{
+    std::vector<uint32_t> words(length / sizeof(uint32_t));
+    uint32_t seed = 5;
+
+    for (uint32_t i = 0; i < words.size(); i++)
+    {
+        seed     = (seed * 1103515245u) + 12345u;
+        words[i] = seed;
+    }
+
+    image_header_t *header = (image_header_t *)&words[IMAGE_HEADER_OFFSET / sizeof(uint32_t)];
+    const uint8_t *data = (const uint8_t *)&words[0];
+
+    header->magic   = IMAGE_HEADER_MAGIC;
+    header->version = IMAGE_HEADER_VERSION(1, 2, 3);
+    header->length  = length;
+
+    uint32_t crc = crc32_bitwise(data, IMAGE_HEADER_CRC32_OFFSET);
+    crc = crc32_bitwise(&data[IMAGE_HEADER_CRC32_OFFSET + 4], length - (IMAGE_HEADER_CRC32_OFFSET + 4), crc);
+    header->crc32 = ~crc;
+
+    return words;
+}
+
+///
+/// \brief This test checks the CRC-32 against the check value zlib.crc32() gives.
+///
+TEST(gtest_image_header, crc32)
+{
+    const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+    EXPECT_EQ(~image_header_crc32_update(0xffffffff, check, sizeof(check)), 0xcbf43926u);
+    EXPECT_EQ(~image_header_crc32_update(0xffffffff, check, 0), 0x00000000u);
+    EXPECT_EQ(IMAGE_HEADER_VERSION(1, 2, 3), 0x00010203u);
+}
+
+///
+/// \brief This test validates the image patched by scripts/image_header.py, a byte changed anywhere
+///        but in the CRC-32 field is caught.
+///
+TEST(gtest_image_header, image)
+{
+    std::vector<uint32_t> words = image(0x0a00);
+    const image_header_t *header = image_header_get(&words[0]);
+    uint8_t *data = (uint8_t *)&words[0];
+
+    EXPECT_EQ((const uint8_t *)header, &data[IMAGE_HEADER_OFFSET]);
+    ASSERT_EQ(image_header_check(header, REGION_SIZE), IMAGE_HEADER_RES_OK);
+    ASSERT_EQ(image_header_crc32(&words[0]), header->crc32);
+
+    for (uint32_t i = 0; i < (words.size() * sizeof(uint32_t)); i++)
+    {
+        if ((i >= IMAGE_HEADER_CRC32_OFFSET) && (i < (IMAGE_HEADER_CRC32_OFFSET + 4)))
+        {
+            continue;
+        }
+
+        /* The changed length is refused by the check or by the CRC-32 calculated up to it. */
+        data[i] ^= 0x01;
+        bool valid = (image_header_check(header, words.size() * sizeof(uint32_t)) == IMAGE_HEADER_RES_OK) &&
+                     (image_header_crc32(&words[0]) == header->crc32);
+        EXPECT_FALSE(valid) << "byte " << i;
+        data[i] ^= 0x01;
+    }
+}
+
+///
+/// \brief This test agrees with scripts/image_header.py on an image it patched: 0x200 bytes 0x5a, the
+///        header of version 1.0.0 and 0x123 words 0x11223344.
+///
+TEST(gtest_image_header, script)
+{
+    std::vector<uint32_t> words((IMAGE_HEADER_OFFSET + sizeof(image_header_t)) / sizeof(uint32_t) + 0x123, 0x11223344);
+    image_header_t *header = (image_header_t *)&words[IMAGE_HEADER_OFFSET / sizeof(uint32_t)];
+
+    memset(&words[0], 0x5a, IMAGE_HEADER_OFFSET);
+    header->magic   = IMAGE_HEADER_MAGIC;
+    header->version = IMAGE_HEADER_VERSION(1, 0, 0);
+    header->length  = 0x069c;
+    header->crc32   = 0xcd6053ff;
+
+    ASSERT_EQ(words.size() * sizeof(uint32_t), header->length);
+    EXPECT_EQ(image_header_check(header, REGION_SIZE), IMAGE_HEADER_RES_OK);
+    EXPECT_EQ(image_header_crc32(&words[0]), header->crc32);
+}
+
+///
+/// \brief This test refuses the erased image and the lengths which do not fit the region.
+///
+TEST(gtest_image_header, check)
+{
+    std::vector<uint32_t> words = image(0x0400);
+    image_header_t *header = (image_header_t *)image_header_get(&words[0]);
+    image_header_t erased;
+
+    memset(&erased, 0xff, sizeof(erased));
+    EXPECT_EQ(image_header_check(&erased, REGION_SIZE), IMAGE_HEADER_RES_ERR_MAGIC);
+    EXPECT_EQ(image_header_check(NULL, REGION_SIZE), IMAGE_HEADER_RES_ERR_MAGIC);
+
+    /* The header left unpatched by the build. */
+    header->length = 0;
+    EXPECT_EQ(image_header_check(header, REGION_SIZE), IMAGE_HEADER_RES_ERR_LENGTH);
+
+    header->length = IMAGE_HEADER_OFFSET + sizeof(image_header_t) - 4;
+    EXPECT_EQ(image_header_check(header, REGION_SIZE), IMAGE_HEADER_RES_ERR_LENGTH);
+
+    header->length = IMAGE_HEADER_OFFSET + sizeof(image_header_t);
+    EXPECT_EQ(image_header_check(header, REGION_SIZE), IMAGE_HEADER_RES_OK);
+
+    header->length = REGION_SIZE + 4;
+    EXPECT_EQ(image_header_check(header, REGION_SIZE), IMAGE_HEADER_RES_ERR_LENGTH);
+
+    header->length = 0x0402;
+    EXPECT_EQ(image_header_check(header, REGION_SIZE), IMAGE_HEADER_RES_ERR_LENGTH);
+}
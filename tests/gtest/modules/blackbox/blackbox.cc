@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "ahrs.h"
+#include "ghf.h"
+#include "pid.h"
+#include "blackbox.h"
+
+#define COMPRESSION_ROUNDS  (0x10000u)
+
+///
+/// \brief Decodes the frames the way scripts/blackbox_decode.py does.
+///
+static std::vector<blackbox_frame_t> decode(const std::vector<uint8_t> &data, uint32_t offset)
+{
+    std::vector<blackbox_frame_t> frames;
+    blackbox_frame_t prev = {};
+
+    while (offset < data.size())
+    {
+        blackbox_frame_t frame = {};
+        uint8_t kind = data[offset++];
+
+        EXPECT_TRUE((kind == BLACKBOX_FRAME_KEY) || (kind == BLACKBOX_FRAME_DELTA));
+
+        for (uint32_t i = 0; i < BLACKBOX_FIELD_TOTAL; i++)
+        {
+            uint32_t value = 0;
+            uint32_t shift = 0;
+            uint8_t byte;
+
+            do
+            {
+                byte   = data[offset++];
+                value |= (uint32_t)(byte & 0x7f) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+
+            uint32_t delta = (value >> 1) ^ (0u - (value & 1u));
+            uint32_t base  = (kind == BLACKBOX_FRAME_KEY) ? 0u : (uint32_t)prev.field[i];
+            frame.field[i] = (int32_t)(base + delta);
+        }
+
+        frames.push_back(frame);
+        prev = frame;
+    }
+
+    return frames;
+}
+
+///
+/// \brief Builds the frame of the slowly changing fields.
+///
+static blackbox_frame_t frame_at(const uint32_t n)
+{
+    blackbox_frame_t frame;
+
+    for (uint32_t i = 0; i < BLACKBOX_FIELD_TOTAL; i++)
+    {
+        frame.field[i] = (int32_t)(((n * (i + 1)) % 7) * ((i & 1) ? -1 : 1)) + (int32_t)(i * 1000);
+    }
+
+    frame.field[BLACKBOX_FIELD_TIME_START] = (int32_t)(0xfffff000u + (n * 27000u));
+
+    return frame;
+}
+
+///
+/// \brief Drains the recorder ring buffer.
+///
+static std::vector<uint8_t> drain(void)
+{
+    std::vector<uint8_t> data;
+    uint8_t buffer[0x100];
+    uint32_t size;
+
+    while ((size = blackbox_read(&buffer[0], sizeof(buffer))) > 0)
+    {
+        data.insert(data.end(), &buffer[0], &buffer[size]);
+    }
+
+    return data;
+}
+
+///
+/// \brief This test decodes the frames the encoder gave, the extremes and the counter wrap included.
+///
+TEST(gtest_blackbox, encode)
+{
+    blackbox_encoder_t encoder;
+    std::vector<blackbox_frame_t> frames;
+    std::vector<uint8_t> data;
+    uint8_t buffer[BLACKBOX_FRAME_SIZE_MAX];
+
+    blackbox_encoder_reset(&encoder);
+
+    for (uint32_t n = 0; n < 100; n++)
+    {
+        blackbox_frame_t frame = frame_at(n);
+
+        if (n == 50)
+        {
+            frame.field[BLACKBOX_FIELD_ROLL]  = INT32_MIN;
+            frame.field[BLACKBOX_FIELD_PITCH] = INT32_MAX;
+        }
+
+        uint32_t size = blackbox_encode(&encoder, &frame, &buffer[0]);
+        ASSERT_LE(size, BLACKBOX_FRAME_SIZE_MAX);
+        EXPECT_EQ(buffer[0], ((n % BLACKBOX_KEY_INTERVAL) == 0) ? BLACKBOX_FRAME_KEY : BLACKBOX_FRAME_DELTA);
+
+        /* The small changes take a byte per field, the timestamp step takes three. */
+        if ((n != 50) && (n != 51) && ((n % BLACKBOX_KEY_INTERVAL) != 0))
+        {
+            EXPECT_EQ(size, 1u + BLACKBOX_FIELD_TOTAL + 2u);
+        }
+
+        data.insert(data.end(), &buffer[0], &buffer[size]);
+        frames.push_back(frame);
+    }
+
+    std::vector<blackbox_frame_t> decoded = decode(data, 0);
+    ASSERT_EQ(decoded.size(), frames.size());
+
+    for (uint32_t n = 0; n < frames.size(); n++)
+    {
+        EXPECT_EQ(memcmp(&decoded[n], &frames[n], sizeof(blackbox_frame_t)), 0) << "frame " << n;
+    }
+}
+
+///
+/// \brief This test logs every divider-th cycle of the ghf data and the PID terms behind the header.
+///
+TEST(gtest_blackbox, update)
+{
+    struct ghf ghf = {};
+
+    ghf.module.pid_roll  = pid_get(PID_INST_ROLL);
+    ghf.module.pid_pitch = pid_get(PID_INST_PITCH);
+    ghf.module.pid_yaw   = pid_get(PID_INST_YAW);
+    pid_init(ghf.module.pid_roll,  0.5f, 1.0f, 0.001f, 1.0f / 4000.0f);
+    pid_init(ghf.module.pid_pitch, 0.5f, 1.0f, 0.001f, 1.0f / 4000.0f);
+    pid_init(ghf.module.pid_yaw,   0.5f, 1.0f, 0.001f, 1.0f / 4000.0f);
+
+    blackbox_init(4);
+    (void)drain();
+    blackbox_init(4);
+
+    for (uint32_t n = 0; n < 40; n++)
+    {
+        ghf.data.time.start  = n * 27000;
+        ghf.data.roll        = pid_update(ghf.module.pid_roll, 0.1f * n, 0.0f);
+        ghf.data.pwm1        = 1000 + n;
+        ghf.data.raw_data.gx = (int16_t)(-3 * (int32_t)n);
+        blackbox_update(&ghf);
+    }
+
+    std::vector<uint8_t> data = drain();
+    ASSERT_GE(data.size(), 8u);
+
+    uint32_t magic;
+    memcpy(&magic, &data[0], sizeof(magic));
+    EXPECT_EQ(magic, BLACKBOX_MAGIC);
+    EXPECT_EQ(data[4], BLACKBOX_VERSION);
+    EXPECT_EQ(data[5], BLACKBOX_FIELD_TOTAL);
+    EXPECT_EQ(data[6], 4);
+
+    std::vector<blackbox_frame_t> frames = decode(data, 8);
+    ASSERT_EQ(frames.size(), 10u);
+    EXPECT_EQ(blackbox_stats_get()->frames, 10u);
+    EXPECT_EQ(blackbox_stats_get()->bytes, data.size());
+
+    /* The last frame is the 40th cycle. */
+    struct pid_terms terms;
+    pid_terms_get(ghf.module.pid_roll, &terms);
+    EXPECT_EQ(frames[9].field[BLACKBOX_FIELD_TIME_START], 39 * 27000);
+    EXPECT_EQ(frames[9].field[BLACKBOX_FIELD_PWM1], 1039);
+    EXPECT_EQ(frames[9].field[BLACKBOX_FIELD_GX], -117);
+    EXPECT_EQ(frames[9].field[BLACKBOX_FIELD_ROLL], (int32_t)(ghf.data.roll * BLACKBOX_FLOAT_SCALE));
+    EXPECT_EQ(frames[9].field[BLACKBOX_FIELD_ROLL_P], (int32_t)(terms.p * BLACKBOX_FLOAT_SCALE));
+    EXPECT_EQ(frames[9].field[BLACKBOX_FIELD_ROLL_I], (int32_t)(terms.i * BLACKBOX_FLOAT_SCALE));
+    EXPECT_NE(frames[9].field[BLACKBOX_FIELD_ROLL_P], 0);
+
+    blackbox_init(0);
+    blackbox_update(&ghf);
+    EXPECT_EQ(drain().size(), 0u);
+}
+
+///
+/// \brief This test drops the frames while the consumer lags, the log stays decodable and goes on
+///        with a key frame.
+///
+TEST(gtest_blackbox, drop)
+{
+    struct ghf ghf = {};
+
+    ghf.module.pid_roll  = pid_get(PID_INST_ROLL);
+    ghf.module.pid_pitch = pid_get(PID_INST_PITCH);
+    ghf.module.pid_yaw   = pid_get(PID_INST_YAW);
+
+    blackbox_init(1);
+
+    for (uint32_t n = 0; n < 1000; n++)
+    {
+        ghf.data.time.start = n;
+        blackbox_update(&ghf);
+    }
+
+    const blackbox_stats_t *stats = blackbox_stats_get();
+    EXPECT_GT(stats->dropped, 0u);
+    EXPECT_EQ(stats->frames + stats->dropped, 1000u);
+    EXPECT_LE(stats->bytes, BLACKBOX_RING_SIZE);
+
+    std::vector<uint8_t> data = drain();
+    ghf.data.time.start = 5000;
+    blackbox_update(&ghf);
+    std::vector<uint8_t> tail = drain();
+    data.insert(data.end(), tail.begin(), tail.end());
+
+    ASSERT_EQ(tail[0], BLACKBOX_FRAME_KEY);
+    std::vector<blackbox_frame_t> frames = decode(data, 8);
+    ASSERT_EQ(frames.size(), stats->frames);
+    EXPECT_EQ(frames.back().field[BLACKBOX_FIELD_TIME_START], 5000);
+    EXPECT_EQ(frames[frames.size() - 2].field[BLACKBOX_FIELD_TIME_START], (int32_t)(frames.size() - 2));
+}
+
+///
+/// \brief This test encodes the slowly changing frames into less than half of their raw size.
+///
+TEST(gtest_blackbox, compression)
+{
+    blackbox_encoder_t encoder;
+    uint8_t buffer[BLACKBOX_FRAME_SIZE_MAX];
+    uint32_t bytes = 0;
+
+    blackbox_encoder_reset(&encoder);
+
+    for (uint32_t n = 0; n < COMPRESSION_ROUNDS; n++)
+    {
+        blackbox_frame_t frame = frame_at(n);
+        bytes += blackbox_encode(&encoder, &frame, &buffer[0]);
+    }
+
+    EXPECT_LT(bytes, COMPRESSION_ROUNDS * sizeof(blackbox_frame_t) / 2);
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include "crsf.h"
+
+///
+/// \brief This test unpacks the channels with all bits set in turn.
+///
+TEST(gtest_crsf_ch_unpack, single_channel)
+{
+    for (uint32_t i = 0; i < CRSF_CH_TOTAL; i++)
+    {
+        uint8_t payload[CRSF_PAYLOAD_SIZE_RC_CH] = {0};
+        uint16_t ch[CRSF_CH_TOTAL];
+        uint32_t bit = i * CRSF_CH_BITS;
+
+        for (uint32_t j = 0; j < CRSF_CH_BITS; j++, bit++)
+        {
+            payload[bit / 8] |= (uint8_t)(0x01 << (bit % 8));
+        }
+
+        crsf_ch_unpack(payload, ch);
+
+        for (uint32_t j = 0; j < CRSF_CH_TOTAL; j++)
+        {
+            EXPECT_EQ(ch[j], (i == j) ? CRSF_CH_MASK : 0);
+        }
+    }
+}
+
+///
+/// \brief This test unpacks the channels of the packed channels frame.
+///
+TEST(gtest_crsf_ch_unpack, payload)
+{
+    const uint8_t payload[CRSF_PAYLOAD_SIZE_RC_CH] =
+    {
+        0x13, 0x67, 0x05, 0xfa, 0xb8, 0x3b, 0x71, 0x56, 0x00, 0xe0, 0xff,
+        0xe0, 0x03, 0x1f, 0xf8, 0xc0, 0x07, 0x3e, 0xf0, 0x81, 0x0f, 0x7c,
+    };
+    const uint16_t expected[CRSF_CH_TOTAL] =
+    {
+        1811, 172, 1000, 1500, 1811, 172, 0, 2047, 992, 992, 992, 992, 992, 992, 992, 992,
+    };
+    uint16_t ch[CRSF_CH_TOTAL];
+
+    crsf_ch_unpack(payload, ch);
+
+    for (uint32_t i = 0; i < CRSF_CH_TOTAL; i++)
+    {
+        EXPECT_EQ(ch[i], expected[i]);
+    }
+}
+
+///
+/// \brief This test checks the channel value to the pulse width conversion.
+///
+TEST(gtest_crsf_ch_unpack, to_us)
+{
+    EXPECT_EQ(crsf_ch_to_us(CRSF_CH_VAL_MIN), 988u);
+    EXPECT_EQ(crsf_ch_to_us(CRSF_CH_VAL_MID), 1500u);
+    EXPECT_EQ(crsf_ch_to_us(CRSF_CH_VAL_MAX), 2011u);
+}
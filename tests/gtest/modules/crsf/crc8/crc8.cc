@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include "crsf.h"
+
+///
+/// \brief This test checks the CRC8 against the DVB-S2 check value.
+///
+TEST(gtest_crsf_crc8, check_value)
+{
+    const uint8_t data[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    EXPECT_EQ(crsf_crc8(data, sizeof(data)), 0xbc);
+}
+
+///
+/// \brief This test checks the CRC8 of the link statistics frame type and payload.
+///
+TEST(gtest_crsf_crc8, frame)
+{
+    const uint8_t data[] = {0x14, 0x32, 0x40, 0x64, 0x0a, 0x01, 0x06, 0x03, 0x3c, 0x62, 0xf6};
+
+    EXPECT_EQ(crsf_crc8(data, sizeof(data)), 0xbc);
+}
+
+///
+/// \brief This test checks the empty and the invalid input.
+///
+TEST(gtest_crsf_crc8, empty)
+{
+    const uint8_t data[] = {0xff};
+
+    EXPECT_EQ(crsf_crc8(data, 0), 0x00);
+    EXPECT_EQ(crsf_crc8(NULL, 1), 0x00);
+}
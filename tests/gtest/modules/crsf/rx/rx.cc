@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include "crsf.h"
+
+///
+/// \brief The channels frame, throttle low and the switches at their extremes.
+///
+static const uint8_t frame_ch_1[] =
+{
+    0xc8, 0x18, 0x16, 0xe0, 0x03, 0x1f, 0x2b, 0xc0, 0xc7, 0x8a, 0x89, 0x83, 0x0f, 0x7c, 0xe0, 0x03,
+    0x1f, 0xf8, 0xc0, 0x07, 0x3e, 0xf0, 0x81, 0x0f, 0x7c, 0xd7,
+};
+
+///
+/// \brief The channels frame, sticks at their extremes.
+///
+static const uint8_t frame_ch_2[] =
+{
+    0xc8, 0x18, 0x16, 0x13, 0x67, 0x05, 0xfa, 0xb8, 0x3b, 0x71, 0x56, 0x00, 0xe0, 0xff, 0xe0, 0x03,
+    0x1f, 0xf8, 0xc0, 0x07, 0x3e, 0xf0, 0x81, 0x0f, 0x7c, 0xcd,
+};
+
+///
+/// \brief The link statistics frame.
+///
+static const uint8_t frame_link[] =
+{
+    0xc8, 0x0c, 0x14, 0x32, 0x40, 0x64, 0x0a, 0x01, 0x06, 0x03, 0x3c, 0x62, 0xf6, 0xbc,
+};
+
+static const uint16_t ch_1[CRSF_CH_TOTAL] =
+{
+    992, 992, 172, 992, 172, 1811, 992, 992, 992, 992, 992, 992, 992, 992, 992, 992,
+};
+
+static const uint16_t ch_2[CRSF_CH_TOTAL] =
+{
+    1811, 172, 1000, 1500, 1811, 172, 0, 2047, 992, 992, 992, 992, 992, 992, 992, 992,
+};
+
+///
+/// \brief The frame callback log.
+///
+struct cb_log
+{
+    uint32_t rc_ch;
+    uint32_t link;
+};
+
+static void cb(void *const arg, const crsf_type_t type)
+{
+    struct cb_log *log = (struct cb_log *)arg;
+
+    if (type == CRSF_TYPE_RC_CH)
+    {
+        log->rc_ch++;
+    }
+    else if (type == CRSF_TYPE_LINK_STATS)
+    {
+        log->link++;
+    }
+}
+
+///
+/// \brief The recorded stream: channels, link statistics, channels.
+///
+static uint32_t stream_get(uint8_t *const buf)
+{
+    uint32_t len = 0;
+
+    memcpy(&buf[len], frame_ch_1, sizeof(frame_ch_1));
+    len += sizeof(frame_ch_1);
+    memcpy(&buf[len], frame_link, sizeof(frame_link));
+    len += sizeof(frame_link);
+    memcpy(&buf[len], frame_ch_2, sizeof(frame_ch_2));
+    len += sizeof(frame_ch_2);
+
+    return len;
+}
+
+static void ch_expect(const struct crsf *const handle, const uint16_t *const ch)
+{
+    for (uint32_t i = 0; i < CRSF_CH_TOTAL; i++)
+    {
+        EXPECT_EQ(handle->ch[i], ch[i]);
+    }
+}
+
+///
+/// \brief This test feeds the whole stream at once.
+///
+TEST(gtest_crsf_rx, stream)
+{
+    struct crsf crsf;
+    struct cb_log log = {};
+    uint8_t buf[128];
+    uint32_t len = stream_get(buf);
+
+    crsf_init(&crsf, &cb, &log);
+    crsf_rx(&crsf, buf, len);
+
+    EXPECT_EQ(log.rc_ch, 2u);
+    EXPECT_EQ(log.link, 1u);
+    EXPECT_EQ(crsf.cnt.rc_ch, 2u);
+    EXPECT_EQ(crsf.cnt.link, 1u);
+    EXPECT_EQ(crsf.cnt.crc_err, 0u);
+    EXPECT_EQ(crsf.cnt.len_err, 0u);
+    ch_expect(&crsf, ch_2);
+
+    EXPECT_EQ(crsf.link.up_rssi_1, 0x32);
+    EXPECT_EQ(crsf.link.up_rssi_2, 0x40);
+    EXPECT_EQ(crsf.link.up_lq, 100);
+    EXPECT_EQ(crsf.link.up_snr, 10);
+    EXPECT_EQ(crsf.link.ant, 1);
+    EXPECT_EQ(crsf.link.rf_mode, 6);
+    EXPECT_EQ(crsf.link.up_tx_pwr, 3);
+    EXPECT_EQ(crsf.link.down_rssi, 0x3c);
+    EXPECT_EQ(crsf.link.down_lq, 98);
+    EXPECT_EQ(crsf.link.down_snr, -10);
+}
+
+///
+/// \brief This test feeds the stream in chunks of every size, as delivered by the DMA interrupts.
+///
+TEST(gtest_crsf_rx, chunks)
+{
+    uint8_t buf[128];
+    uint32_t len = stream_get(buf);
+
+    for (uint32_t size = 1; size <= len; size++)
+    {
+        struct crsf crsf;
+        struct cb_log log = {};
+
+        crsf_init(&crsf, &cb, &log);
+
+        for (uint32_t pos = 0; pos < len; pos += size)
+        {
+            crsf_rx(&crsf, &buf[pos], ((len - pos) < size) ? (len - pos) : size);
+        }
+
+        EXPECT_EQ(log.rc_ch, 2u);
+        EXPECT_EQ(log.link, 1u);
+        ch_expect(&crsf, ch_2);
+    }
+}
+
+///
+/// \brief This test checks the resynchronization after the garbage and the truncated frame.
+///
+TEST(gtest_crsf_rx, resync)
+{
+    struct crsf crsf;
+    struct cb_log log = {};
+    const uint8_t garbage[] = {0x00, 0x55, 0xff, 0x16, 0x7c};
+
+    crsf_init(&crsf, &cb, &log);
+
+    crsf_rx(&crsf, garbage, sizeof(garbage));
+    crsf_rx(&crsf, frame_ch_2, 10);
+    crsf_rx_idle(&crsf);
+    crsf_rx(&crsf, frame_ch_1, sizeof(frame_ch_1));
+    crsf_rx_idle(&crsf);
+
+    EXPECT_EQ(log.rc_ch, 1u);
+    EXPECT_EQ(crsf.cnt.trunc, 1u);
+    ch_expect(&crsf, ch_1);
+}
+
+///
+/// \brief This test checks that the corrupted frame is dropped.
+///
+TEST(gtest_crsf_rx, crc_err)
+{
+    struct crsf crsf;
+    struct cb_log log = {};
+    uint8_t frame[sizeof(frame_ch_2)];
+
+    memcpy(frame, frame_ch_2, sizeof(frame));
+    frame[10] ^= 0x04;
+
+    crsf_init(&crsf, &cb, &log);
+    crsf_rx(&crsf, frame_ch_1, sizeof(frame_ch_1));
+    crsf_rx(&crsf, frame, sizeof(frame));
+
+    EXPECT_EQ(log.rc_ch, 1u);
+    EXPECT_EQ(crsf.cnt.crc_err, 1u);
+    ch_expect(&crsf, ch_1);
+}
+
+///
+/// \brief This test checks the invalid length protection.
+///
+TEST(gtest_crsf_rx, len_err)
+{
+    struct crsf crsf;
+    struct cb_log log = {};
+    const uint8_t frame[] = {0xc8, 0x01, 0xc8, 0x40};
+
+    crsf_init(&crsf, &cb, &log);
+    crsf_rx(&crsf, frame, sizeof(frame));
+    crsf_rx(&crsf, frame_ch_1, sizeof(frame_ch_1));
+
+    EXPECT_EQ(crsf.cnt.len_err, 2u);
+    EXPECT_EQ(log.rc_ch, 1u);
+    ch_expect(&crsf, ch_1);
+}
+
+///
+/// \brief This test checks the channels before any frame has been received.
+///
+TEST(gtest_crsf_rx, init)
+{
+    struct crsf crsf;
+
+    crsf_init(&crsf, NULL, NULL);
+    crsf_rx(&crsf, frame_ch_1, sizeof(frame_ch_1));
+
+    EXPECT_EQ(crsf.cnt.rc_ch, 1u);
+    ch_expect(&crsf, ch_1);
+
+    crsf_init(&crsf, NULL, NULL);
+
+    for (uint32_t i = 0; i < CRSF_CH_TOTAL; i++)
+    {
+        EXPECT_EQ(crsf.ch[i], CRSF_CH_VAL_MID);
+    }
+}
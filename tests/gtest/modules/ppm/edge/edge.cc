@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include "ppm.h"
+
+#define SEP (300u)
+
+static void cb(void *const arg)
+{
+    (*(uint32_t *)arg)++;
+}
+
+///
+/// \brief Feeds one PPM frame as the intervals between both edges.
+///
+static void frame_feed(struct ppm *const handle, const uint16_t *const ch, const uint32_t cnt)
+{
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        ppm_edge(handle, SEP);
+        ppm_edge(handle, ch[i] - SEP);
+    }
+
+    /* The sync slot. */
+    ppm_edge(handle, SEP);
+    ppm_edge(handle, 6000u);
+}
+
+///
+/// \brief This test decodes the eight channel frames.
+///
+TEST(gtest_ppm_edge, frame)
+{
+    struct ppm ppm;
+    uint32_t cnt = 0;
+    const uint16_t ch[8] = {1000, 1500, 2000, 1234, 988, 2012, 1500, 1700};
+
+    ppm_init(&ppm, &cb, &cnt);
+
+    /* Start in the middle of the frame, the decoder waits for the first sync. */
+    ppm_edge(&ppm, 1100u);
+    ppm_edge(&ppm, SEP);
+    ppm_edge(&ppm, 6000u);
+    EXPECT_EQ(cnt, 0u);
+
+    frame_feed(&ppm, ch, 8);
+    frame_feed(&ppm, ch, 8);
+
+    EXPECT_EQ(cnt, 2u);
+    EXPECT_EQ(ppm.ch_cnt, 8u);
+    EXPECT_EQ(ppm.cnt.err, 0u);
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        EXPECT_EQ(ppm.ch[i], ch[i]);
+    }
+}
+
+///
+/// \brief This test checks the frame with too few channels and the invalid slot.
+///
+TEST(gtest_ppm_edge, errors)
+{
+    struct ppm ppm;
+    uint32_t cnt = 0;
+    const uint16_t ch[4] = {1000, 1500, 2000, 1500};
+    const uint16_t bad[4] = {1000, 500, 2000, 1500};
+
+    ppm_init(&ppm, &cb, &cnt);
+    ppm_edge(&ppm, 6000u);
+
+    frame_feed(&ppm, ch, 3);
+    EXPECT_EQ(cnt, 0u);
+
+    frame_feed(&ppm, bad, 4);
+    EXPECT_EQ(cnt, 0u);
+    EXPECT_EQ(ppm.cnt.err, 1u);
+
+    frame_feed(&ppm, ch, 4);
+    EXPECT_EQ(cnt, 1u);
+    EXPECT_EQ(ppm.ch_cnt, 4u);
+}
+
+///
+/// \brief This test checks that the channels above the maximum drop the frame.
+///
+TEST(gtest_ppm_edge, overflow)
+{
+    struct ppm ppm;
+    uint32_t cnt = 0;
+    uint16_t ch[PPM_CH_MAX + 1];
+
+    for (uint32_t i = 0; i < (PPM_CH_MAX + 1); i++)
+    {
+        ch[i] = 1500;
+    }
+
+    ppm_init(&ppm, &cb, &cnt);
+    ppm_edge(&ppm, 6000u);
+
+    frame_feed(&ppm, ch, PPM_CH_MAX + 1);
+    EXPECT_EQ(cnt, 0u);
+
+    frame_feed(&ppm, ch, PPM_CH_MAX);
+    EXPECT_EQ(cnt, 1u);
+    EXPECT_EQ(ppm.ch_cnt, PPM_CH_MAX);
+}
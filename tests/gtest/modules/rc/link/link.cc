@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include "boot_handoff.h"
+#include "rc.h"
+
+#define SYSCLK  (1000000u)  /* One cycle counter tick per microsecond. */
+#define LOOP    (250u)      /* The 4 kHz loop time (us).               */
+#define FRAME   (20000u)    /* The 50 Hz frame interval (us).          */
+
+///
+/// \brief The hand-off block the rc timing reads the clocks from, the linker places __handoff_shared__ on it.
+///
+extern "C" boot_handoff_t gtest_handoff;
+boot_handoff_t gtest_handoff;
+
+///
+/// \brief The simulated cycle counter.
+///
+static uint32_t now;
+
+extern "C" uint32_t timing_cnt_get(void)
+{
+    return now;
+}
+
+///
+/// \brief Runs the control loops for the given time, the frame sent every FRAME microseconds.
+///
+/// \param[in] us   The time (us).
+/// \param[in] send True if the receiver sends the frames.
+///
+/// \return uint32_t The loops which saw the link lost.
+///
+static uint32_t fly(const uint32_t us, const bool send)
+{
+    uint32_t lost = 0;
+
+    for (uint32_t t = 0; t < us; t += LOOP)
+    {
+        now += LOOP;
+
+        if (send && ((now % FRAME) == 0))
+        {
+            const uint32_t raw[4] = {1500, 1500, 1600, 1500};
+
+            rc_publish(raw, 4);
+        }
+
+        lost += (rc_update()->lost != 0) ? 1u : 0u;
+    }
+
+    return lost;
+}
+
+///
+/// \brief The frames are sent before every test, the link is up.
+///
+class gtest_rc_link : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        gtest_handoff.clocks.sysclk = SYSCLK;
+
+        for (uint32_t i = RC_CH_BEGIN; i < RC_CH_TOTAL; i++)
+        {
+            rc_init(rc_get((rc_ch_t)i), RC_NORM_SYM);
+        }
+
+        const struct rc_link link = {};
+
+        rc_publish_link(&link);
+        (void)fly(10 * FRAME, true);
+    }
+};
+
+///
+/// \brief This test keeps the link while the frames arrive.
+///
+TEST_F(gtest_rc_link, frames)
+{
+    EXPECT_EQ(fly(100 * FRAME, true), 0u);
+    EXPECT_EQ(rc_get(RC_CH_3)->sig.raw, 1600u);
+}
+
+///
+/// \brief This test loses the link once the frames stop for RC_LINK_TIMEOUT and gets it back with the
+///        next frame.
+///
+TEST_F(gtest_rc_link, silence)
+{
+    uint32_t timeout = (uint32_t)(RC_LINK_TIMEOUT * 1000000.0f);
+
+    /* Below the timeout nothing is reported. */
+    EXPECT_EQ(fly(timeout - (2 * FRAME), false), 0u);
+    EXPECT_GT(fly(3 * FRAME, false), 0u);
+    EXPECT_NE(rc_update()->lost, 0u);
+
+    /* The silence longer than the cycle counter period stays reported. */
+    now += 0x80000000u;
+    EXPECT_NE(rc_update()->lost, 0u);
+    now += 0x80000000u;
+    EXPECT_NE(rc_update()->lost, 0u);
+
+    /* The first loop receives the frame. */
+    now = ((now / FRAME) * FRAME) + FRAME - LOOP;
+    EXPECT_EQ(fly(2 * FRAME, true), 0u);
+}
+
+///
+/// \brief This test loses the link while the receiver reports the failsafe, even though it keeps
+///        sending the frames.
+///
+TEST_F(gtest_rc_link, failsafe)
+{
+    struct rc_link link = {};
+
+    link.failsafe = 1;
+    rc_publish_link(&link);
+
+    EXPECT_EQ(fly(10 * FRAME, true), 10 * (FRAME / LOOP));
+
+    link.failsafe = 0;
+    rc_publish_link(&link);
+
+    EXPECT_EQ(fly(10 * FRAME, true), 0u);
+}
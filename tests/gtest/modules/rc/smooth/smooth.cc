@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include "rc_smooth.h"
+
+#define FRAME   (0.02f)     /* The 50 Hz frame interval. */
+#define LOOP    (0.00025f)  /* The 4 kHz loop time.      */
+#define LOOPS   (80u)       /* The loops per frame.      */
+
+///
+/// \brief Gets the mean delay of the output behind the stick moving at a constant rate.
+///
+/// \param[in] type The smoothing type.
+///
+/// \return float32_t The delay in seconds, the sample-and-hold included.
+///
+static float32_t ramp_delay(const rc_smooth_type_t type)
+{
+    struct rc_smooth smooth;
+    double sum = 0.0;
+    uint32_t cnt = 0;
+    float32_t t = 0.0f;
+
+    rc_smooth_init(&smooth, type, 0.0f);
+
+    for (uint32_t f = 0; f < 100; f++)
+    {
+        /* The stick moves at one unit per second, the frame samples it. */
+        rc_smooth_frame(&smooth, (float32_t)f * FRAME, FRAME);
+
+        for (uint32_t i = 0; i < LOOPS; i++)
+        {
+            t += LOOP;
+
+            float32_t out = rc_smooth_apply(&smooth, LOOP);
+
+            if (f >= 50)
+            {
+                sum += t - out;
+                cnt++;
+            }
+        }
+    }
+
+    return (float32_t)(sum / cnt);
+}
+
+///
+/// \brief This test passes the frames through until the first interval is measured.
+///
+TEST(gtest_rc_smooth, first_frame)
+{
+    struct rc_smooth smooth;
+
+    rc_smooth_init(&smooth, RC_SMOOTH_LINEAR, 0.0f);
+
+    rc_smooth_frame(&smooth, 0.5f, 0.0f);
+    EXPECT_FLOAT_EQ(rc_smooth_apply(&smooth, LOOP), 0.5f);
+
+    /* Lost frames and the link start are not taken as the frame interval. */
+    rc_smooth_frame(&smooth, 0.6f, 1.0f);
+    EXPECT_FLOAT_EQ(rc_smooth_apply(&smooth, LOOP), 0.6f);
+    EXPECT_FLOAT_EQ(smooth.interval, 0.0f);
+}
+
+///
+/// \brief This test estimates the frame interval.
+///
+TEST(gtest_rc_smooth, interval)
+{
+    struct rc_smooth smooth;
+
+    rc_smooth_init(&smooth, RC_SMOOTH_PT2, 0.0f);
+
+    rc_smooth_frame(&smooth, 0.0f, 0.01f);
+    EXPECT_FLOAT_EQ(smooth.interval, 0.01f);
+
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        rc_smooth_frame(&smooth, 0.0f, FRAME);
+    }
+
+    EXPECT_NEAR(smooth.interval, FRAME, 0.0001f);
+}
+
+///
+/// \brief This test ramps the output to the frame value within one frame interval.
+///
+TEST(gtest_rc_smooth, linear)
+{
+    struct rc_smooth smooth;
+    float32_t prev;
+    float32_t out;
+
+    rc_smooth_init(&smooth, RC_SMOOTH_LINEAR, 0.0f);
+    rc_smooth_frame(&smooth, 0.0f, FRAME);
+    (void)rc_smooth_apply(&smooth, LOOP);
+
+    rc_smooth_frame(&smooth, 1.0f, FRAME);
+
+    /* No extra latency, the output moves on the first loop after the frame. */
+    prev = rc_smooth_apply(&smooth, LOOP);
+    EXPECT_NEAR(prev, 1.0f / LOOPS, 0.0001f);
+
+    for (uint32_t i = 1; i < (LOOPS / 2); i++)
+    {
+        out = rc_smooth_apply(&smooth, LOOP);
+        EXPECT_GT(out, prev);
+        prev = out;
+    }
+
+    EXPECT_NEAR(prev, 0.5f, 0.001f);
+
+    for (uint32_t i = 0; i < LOOPS; i++)
+    {
+        out = rc_smooth_apply(&smooth, LOOP);
+        EXPECT_LE(out, 1.0f);
+    }
+
+    EXPECT_FLOAT_EQ(out, 1.0f);
+
+    /* The next frame starts from the current output. */
+    rc_smooth_frame(&smooth, -1.0f, FRAME);
+
+    for (uint32_t i = 0; i < (LOOPS / 4); i++)
+    {
+        out = rc_smooth_apply(&smooth, LOOP);
+    }
+
+    EXPECT_NEAR(out, 0.5f, 0.001f);
+}
+
+///
+/// \brief This test settles the PT2 output without overshoot.
+///
+TEST(gtest_rc_smooth, pt2)
+{
+    struct rc_smooth smooth;
+    float32_t prev = 0.0f;
+    float32_t out;
+
+    rc_smooth_init(&smooth, RC_SMOOTH_PT2, 0.0f);
+    rc_smooth_frame(&smooth, 0.0f, FRAME);
+
+    rc_smooth_frame(&smooth, 1.0f, FRAME);
+
+    for (uint32_t i = 0; i < (LOOPS * 4); i++)
+    {
+        out = rc_smooth_apply(&smooth, LOOP);
+        EXPECT_GE(out, prev);
+        EXPECT_LE(out, 1.0f);
+        prev = out;
+    }
+
+    EXPECT_GT(out, 0.95f);
+}
+
+///
+/// \brief This test passes the frames through when the smoothing is off.
+///
+TEST(gtest_rc_smooth, off)
+{
+    struct rc_smooth smooth;
+
+    rc_smooth_init(&smooth, RC_SMOOTH_OFF, 0.0f);
+    rc_smooth_frame(&smooth, 0.0f, FRAME);
+
+    rc_smooth_frame(&smooth, 0.7f, FRAME);
+    EXPECT_FLOAT_EQ(rc_smooth_apply(&smooth, LOOP), 0.7f);
+}
+
+///
+/// \brief This test checks the delay the smoothing adds to the stick moving at a constant rate, the
+///        figures documented with rc_smooth_type_t.
+///
+TEST(gtest_rc_smooth, delay)
+{
+    float32_t hold = ramp_delay(RC_SMOOTH_OFF);
+
+    EXPECT_NEAR(hold, 0.5f * FRAME, 0.01f * FRAME);
+    EXPECT_NEAR(ramp_delay(RC_SMOOTH_LINEAR) - hold, 0.5f * FRAME, 0.02f * FRAME);
+    EXPECT_NEAR(ramp_delay(RC_SMOOTH_PT2) - hold, 0.41f * FRAME, 0.02f * FRAME);
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include "sbus.h"
+
+///
+/// \brief The recorded SBUS frame.
+///
+static const uint8_t frame_ch[SBUS_FRAME_SIZE] =
+{
+    0x0f, 0xac, 0x00, 0xdf, 0xc4, 0xd1, 0x07, 0x7d, 0x00, 0xfc, 0x9f, 0xbb, 0xe0, 0x03, 0x1f, 0xf8,
+    0xc0, 0x07, 0x3e, 0xf0, 0xb1, 0x62, 0xe2, 0x00, 0x00,
+};
+
+static const uint16_t ch[SBUS_CH_TOTAL] =
+{
+    172, 992, 1811, 1000, 2000, 0, 2047, 1500, 992, 992, 992, 992, 992, 992, 172, 1811,
+};
+
+static void cb(void *const arg)
+{
+    (*(uint32_t *)arg)++;
+}
+
+static void ch_expect(const struct sbus *const handle, const uint16_t *const expected)
+{
+    for (uint32_t i = 0; i < SBUS_CH_TOTAL; i++)
+    {
+        EXPECT_EQ(handle->ch[i], expected[i]);
+    }
+}
+
+///
+/// \brief This test decodes the frames delivered one per idle line.
+///
+TEST(gtest_sbus_frame, idle)
+{
+    struct sbus sbus;
+    uint32_t cnt = 0;
+
+    sbus_init(&sbus, &cb, &cnt);
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        sbus_rx(&sbus, frame_ch, sizeof(frame_ch));
+        sbus_rx_idle(&sbus);
+    }
+
+    EXPECT_EQ(cnt, 3u);
+    EXPECT_EQ(sbus.cnt.frame, 3u);
+    EXPECT_EQ(sbus.cnt.trunc, 0u);
+    EXPECT_EQ(sbus.flags, 0u);
+    ch_expect(&sbus, ch);
+}
+
+///
+/// \brief This test decodes the frame split into chunks of every size.
+///
+TEST(gtest_sbus_frame, chunks)
+{
+    for (uint32_t size = 1; size <= SBUS_FRAME_SIZE; size++)
+    {
+        struct sbus sbus;
+        uint32_t cnt = 0;
+
+        sbus_init(&sbus, &cb, &cnt);
+
+        for (uint32_t pos = 0; pos < SBUS_FRAME_SIZE; pos += size)
+        {
+            sbus_rx(&sbus, &frame_ch[pos], ((SBUS_FRAME_SIZE - pos) < size) ? (SBUS_FRAME_SIZE - pos) : size);
+        }
+
+        EXPECT_EQ(cnt, 1u);
+        ch_expect(&sbus, ch);
+    }
+}
+
+///
+/// \brief This test checks the truncated frame and the invalid footer.
+///
+TEST(gtest_sbus_frame, errors)
+{
+    struct sbus sbus;
+    uint32_t cnt = 0;
+    uint8_t frame[SBUS_FRAME_SIZE];
+
+    memcpy(frame, frame_ch, sizeof(frame));
+    frame[SBUS_FRAME_SIZE - 1] = 0x55;
+
+    sbus_init(&sbus, &cb, &cnt);
+
+    sbus_rx(&sbus, frame_ch, 12);
+    sbus_rx_idle(&sbus);
+    sbus_rx(&sbus, frame, sizeof(frame));
+    sbus_rx_idle(&sbus);
+
+    EXPECT_EQ(cnt, 0u);
+    EXPECT_EQ(sbus.cnt.trunc, 1u);
+    EXPECT_EQ(sbus.cnt.err, 1u);
+
+    for (uint32_t i = 0; i < SBUS_CH_TOTAL; i++)
+    {
+        EXPECT_EQ(sbus.ch[i], SBUS_CH_VAL_MID);
+    }
+
+    /* The SBUS2 footer carries the telemetry slot in its upper nibble. */
+    frame[SBUS_FRAME_SIZE - 1] = 0x24;
+    sbus_rx(&sbus, frame, sizeof(frame));
+
+    EXPECT_EQ(cnt, 1u);
+    ch_expect(&sbus, ch);
+}
+
+///
+/// \brief This test checks that the failsafe frame passes the receiver failsafe positions through
+///        and reports the flags.
+///
+TEST(gtest_sbus_frame, failsafe)
+{
+    struct sbus sbus;
+    uint32_t cnt = 0;
+    uint8_t frame[SBUS_FRAME_SIZE];
+    const uint16_t zero[SBUS_CH_TOTAL] = {};
+
+    memset(frame, 0, sizeof(frame));
+    frame[0]  = SBUS_HEADER;
+    frame[23] = SBUS_FLAG_FAILSAFE | SBUS_FLAG_FRAME_LOST;
+
+    sbus_init(&sbus, &cb, &cnt);
+    sbus_rx(&sbus, frame_ch, sizeof(frame_ch));
+    sbus_rx(&sbus, frame, sizeof(frame));
+
+    EXPECT_EQ(cnt, 2u);
+    EXPECT_EQ(sbus.cnt.failsafe, 1u);
+    EXPECT_EQ(sbus.cnt.lost, 1u);
+    EXPECT_EQ(sbus.flags, SBUS_FLAG_FAILSAFE | SBUS_FLAG_FRAME_LOST);
+    ch_expect(&sbus, zero);
+}
+
+///
+/// \brief This test checks the channel value to the pulse width conversion.
+///
+TEST(gtest_sbus_frame, to_us)
+{
+    EXPECT_EQ(sbus_ch_to_us(SBUS_CH_VAL_MIN), 988u);
+    EXPECT_EQ(sbus_ch_to_us(SBUS_CH_VAL_MID), 1500u);
+    EXPECT_EQ(sbus_ch_to_us(SBUS_CH_VAL_MAX), 2011u);
+}
@@ -0,0 +1,442 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "ahrs.h"
+#include "ghf.h"
+#include "rc.h"
+#include "telemetry.h"
+#include "data_structure/ring_buffer.h"
+
+#define LOOP_HZ             (1000u)
+#define RING_SIZE           (0x0100u)
+
+///
+/// \brief The decoded frame.
+///
+struct frame
+{
+    uint8_t              id;
+    uint8_t              seq;
+    std::vector<uint8_t> payload;
+};
+
+///
+/// \brief The sink ring, the transmission ring of the USART DMA on the target.
+///
+static uint8_t ring_data[RING_SIZE];
+static ring_buffer_t ring;
+
+static uint32_t sink_space(void)
+{
+    return ring_buffer_space(&ring);
+}
+
+static uint32_t sink_reserve(uint8_t **const data)
+{
+    return ring_buffer_reserve(&ring, (void **)data);
+}
+
+static void sink_commit(const uint32_t len)
+{
+    (void)ring_buffer_commit(&ring, len);
+}
+
+static const struct telemetry_sink sink =
+{
+    .space   = sink_space,
+    .reserve = sink_reserve,
+    .commit  = sink_commit,
+};
+
+///
+/// \brief The module state the messages are serialized from.
+///
+static struct ahrs ahrs;
+static struct rc rc[TELEMETRY_RC_TOTAL];
+static struct ghf ghf;
+
+///
+/// \brief Points ghf to the test module state and starts the sink ring of the size.
+///
+static void setup(const uint32_t size)
+{
+    memset(&ahrs, 0, sizeof(ahrs));
+    memset(&rc[0], 0, sizeof(rc));
+    memset(&ghf, 0, sizeof(ghf));
+
+    ghf.module.ahrs = &ahrs;
+    ghf.module.rc_1 = &rc[0];
+    ghf.module.rc_2 = &rc[1];
+    ghf.module.rc_3 = &rc[2];
+    ghf.module.rc_4 = &rc[3];
+    ghf.module.rc_5 = &rc[4];
+    ghf.module.rc_6 = &rc[5];
+
+    ASSERT_EQ(ring_buffer_init(&ring, &ring_data[0], 1, size), RING_BUFFER_RESULT_SUCCESS);
+}
+
+///
+/// \brief Calculates the CRC-16/CCITT-FALSE bit by bit, the way scripts/telemetry_receive.py does.
+///
+static uint16_t crc16(const uint8_t *data, uint32_t size)
+{
+    uint16_t crc = 0xffff;
+
+    while (size--)
+    {
+        crc ^= (uint16_t)(*data++ << 8);
+
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+///
+/// \brief Drains the sink ring.
+///
+static std::vector<uint8_t> drain(void)
+{
+    std::vector<uint8_t> data(ring_buffer_count(&ring));
+
+    if (data.size() > 0)
+    {
+        EXPECT_EQ(ring_buffer_pop_n(&ring, data.data(), data.size()), data.size());
+    }
+
+    return data;
+}
+
+///
+/// \brief Splits the stream into the frames, every byte belongs to a frame with the right CRC.
+///
+static std::vector<struct frame> decode(const std::vector<uint8_t> &data)
+{
+    std::vector<struct frame> frames;
+    uint32_t offset = 0;
+
+    while (offset < data.size())
+    {
+        EXPECT_GE(data.size() - offset, TELEMETRY_HEADER_SIZE + TELEMETRY_CRC_SIZE);
+        EXPECT_EQ(data[offset + 0], TELEMETRY_SYNC_1);
+        EXPECT_EQ(data[offset + 1], TELEMETRY_SYNC_2);
+
+        struct frame frame;
+        uint32_t len = data[offset + 3];
+        frame.id  = data[offset + 2];
+        frame.seq = data[offset + 4];
+        EXPECT_EQ(len, telemetry_payload_size((telemetry_msg_t)frame.id));
+
+        const uint8_t *payload = &data[offset + TELEMETRY_HEADER_SIZE];
+        frame.payload.assign(payload, payload + len);
+        EXPECT_EQ(crc16(&data[offset + 2], 3 + len), (uint16_t)(payload[len] | (payload[len + 1] << 8)));
+
+        frames.push_back(frame);
+        offset += TELEMETRY_HEADER_SIZE + len + TELEMETRY_CRC_SIZE;
+    }
+
+    EXPECT_EQ(offset, data.size());
+
+    return frames;
+}
+
+///
+/// \brief Counts the frames of the message.
+///
+static uint32_t count(const std::vector<struct frame> &frames, const telemetry_msg_t msg)
+{
+    uint32_t total = 0;
+
+    for (const struct frame &frame : frames)
+    {
+        total += (frame.id == msg) ? 1 : 0;
+    }
+
+    return total;
+}
+
+///
+/// \brief This test sends each message alone and reads the module state back from its payload.
+///
+TEST(gtest_telemetry, frame)
+{
+    struct telemetry_boot boot;
+
+    setup(RING_SIZE);
+
+    for (uint32_t i = 0; i < TIMING_BOOT_STAGE_TOTAL_SIZE; i++)
+    {
+        boot.stage_us[i] = 1000 * (i + 1);
+    }
+
+    boot.reason      = 1;
+    boot.reset_cause = 0x24000000;
+
+    ahrs.out.roll         = 1.5f;
+    ahrs.out.pitch        = -2.25f;
+    ahrs.out.yaw          = 90.0f;
+    ghf.data.raw_data.gx  = -300;
+    ghf.data.raw_data.gy  = 7;
+    ghf.data.raw_data.gz  = 32767;
+    ghf.data.pwm1         = 1000;
+    ghf.data.pwm2         = 1500;
+    ghf.data.pwm3         = 1999;
+    ghf.data.pwm4         = 2000;
+    ghf.data.time.total   = 250;
+
+    for (uint32_t i = 0; i < TELEMETRY_RC_TOTAL; i++)
+    {
+        rc[i].sig.norm = -1.0f + (0.4f * i);
+    }
+
+    for (uint32_t msg = 0; msg < TELEMETRY_MSG_TOTAL; msg++)
+    {
+        telemetry_init(&sink, &boot, LOOP_HZ);
+        telemetry_rate_set((telemetry_msg_t)msg, LOOP_HZ);
+
+        uint32_t bytes = telemetry_update(&ghf);
+        std::vector<uint8_t> data = drain();
+        EXPECT_EQ(bytes, data.size());
+
+        std::vector<struct frame> frames = decode(data);
+        ASSERT_EQ(frames.size(), 1u);
+        ASSERT_EQ(frames[0].id, msg);
+        EXPECT_EQ(frames[0].seq, 0);
+
+        const uint8_t *payload = frames[0].payload.data();
+
+        switch (msg)
+        {
+        case TELEMETRY_MSG_ATTITUDE:
+        {
+            float32_t out[3];
+            memcpy(&out[0], payload, sizeof(out));
+            EXPECT_EQ(out[0], 1.5f);
+            EXPECT_EQ(out[1], -2.25f);
+            EXPECT_EQ(out[2], 90.0f);
+            break;
+        }
+        case TELEMETRY_MSG_RATES:
+        {
+            int16_t gyr[3];
+            memcpy(&gyr[0], payload, sizeof(gyr));
+            EXPECT_EQ(gyr[0], -300);
+            EXPECT_EQ(gyr[1], 7);
+            EXPECT_EQ(gyr[2], 32767);
+            break;
+        }
+        case TELEMETRY_MSG_RC:
+        {
+            int16_t sig[TELEMETRY_RC_TOTAL];
+            memcpy(&sig[0], payload, sizeof(sig));
+            for (uint32_t i = 0; i < TELEMETRY_RC_TOTAL; i++)
+            {
+                EXPECT_NEAR(sig[i], -10000 + (4000 * (int32_t)i), 1) << "channel " << i;
+            }
+            break;
+        }
+        case TELEMETRY_MSG_MOTORS:
+        {
+            uint16_t pwm[4];
+            memcpy(&pwm[0], payload, sizeof(pwm));
+            EXPECT_EQ(pwm[0], 1000);
+            EXPECT_EQ(pwm[1], 1500);
+            EXPECT_EQ(pwm[2], 1999);
+            EXPECT_EQ(pwm[3], 2000);
+            break;
+        }
+        case TELEMETRY_MSG_LOOP:
+        {
+            uint32_t loop[3];
+            memcpy(&loop[0], payload, sizeof(loop));
+            EXPECT_EQ(loop[0], 250u);
+            EXPECT_EQ(loop[1], 1u);
+            EXPECT_EQ(loop[2], 0u);
+            break;
+        }
+        case TELEMETRY_MSG_BOOT:
+            EXPECT_EQ(memcmp(payload, &boot, sizeof(boot)), 0);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+///
+/// \brief This test sends the messages at their rates, the unknown boot statistics never.
+///
+TEST(gtest_telemetry, rate)
+{
+    std::vector<struct frame> frames;
+
+    setup(RING_SIZE);
+    telemetry_init(&sink, NULL, LOOP_HZ);
+    telemetry_rate_set(TELEMETRY_MSG_ATTITUDE, 100);
+    telemetry_rate_set(TELEMETRY_MSG_RC, 30);
+    telemetry_rate_set(TELEMETRY_MSG_LOOP, 1);
+    telemetry_rate_set(TELEMETRY_MSG_BOOT, 1);
+    telemetry_rate_set(TELEMETRY_MSG_TOTAL, 1);
+
+    for (uint32_t n = 0; n < LOOP_HZ; n++)
+    {
+        (void)telemetry_update(&ghf);
+
+        std::vector<struct frame> cycle = decode(drain());
+        frames.insert(frames.end(), cycle.begin(), cycle.end());
+    }
+
+    /* 30 Hz is rounded to every 33rd cycle. */
+    EXPECT_EQ(count(frames, TELEMETRY_MSG_ATTITUDE), 100u);
+    EXPECT_EQ(count(frames, TELEMETRY_MSG_RC), LOOP_HZ / 33);
+    EXPECT_EQ(count(frames, TELEMETRY_MSG_LOOP), 1u);
+    EXPECT_EQ(count(frames, TELEMETRY_MSG_BOOT), 0u);
+    EXPECT_EQ(count(frames, TELEMETRY_MSG_MOTORS), 0u);
+
+    for (uint32_t i = 0; i < frames.size(); i++)
+    {
+        EXPECT_EQ(frames[i].seq, (uint8_t)i);
+    }
+
+    const telemetry_stats_t *stats = telemetry_stats_get();
+    EXPECT_EQ(stats->cycles, LOOP_HZ);
+    EXPECT_EQ(stats->frames, frames.size());
+    EXPECT_EQ(stats->dropped, 0u);
+    EXPECT_EQ(stats->late, 0u);
+
+    telemetry_rate_set(TELEMETRY_MSG_ATTITUDE, 0);
+    telemetry_rate_set(TELEMETRY_MSG_RC, 0);
+    telemetry_rate_set(TELEMETRY_MSG_LOOP, 0);
+
+    for (uint32_t n = 0; n < LOOP_HZ; n++)
+    {
+        EXPECT_EQ(telemetry_update(&ghf), 0u);
+    }
+}
+
+///
+/// \brief This test keeps every update within the budget, the messages past it take turns and none
+///        is starved.
+///
+TEST(gtest_telemetry, budget)
+{
+    struct telemetry_boot boot = {};
+    std::vector<struct frame> frames;
+    uint32_t total = 0;
+
+    setup(RING_SIZE);
+    telemetry_init(&sink, &boot, LOOP_HZ);
+
+    for (uint32_t msg = 0; msg < TELEMETRY_MSG_TOTAL; msg++)
+    {
+        telemetry_rate_set((telemetry_msg_t)msg, LOOP_HZ);
+    }
+
+    for (uint32_t n = 0; n < 600; n++)
+    {
+        uint32_t bytes = telemetry_update(&ghf);
+        EXPECT_LE(bytes, TELEMETRY_BUDGET);
+        EXPECT_GT(bytes, 0u);
+        total += bytes;
+
+        std::vector<struct frame> cycle = decode(drain());
+        frames.insert(frames.end(), cycle.begin(), cycle.end());
+    }
+
+    uint32_t least = UINT32_MAX;
+    uint32_t most  = 0;
+
+    for (uint32_t msg = 0; msg < TELEMETRY_MSG_TOTAL; msg++)
+    {
+        least = std::min(least, count(frames, (telemetry_msg_t)msg));
+        most  = std::max(most, count(frames, (telemetry_msg_t)msg));
+    }
+
+    EXPECT_GT(least, 100u);
+    EXPECT_LE(most - least, 2u);
+    EXPECT_GT(telemetry_stats_get()->late, 0u);
+    EXPECT_EQ(telemetry_stats_get()->dropped, 0u);
+    EXPECT_EQ(telemetry_stats_get()->bytes, total);
+}
+
+///
+/// \brief This test drops the whole frames while the link is behind, the receiver counts them from the
+///        sequence gaps.
+///
+TEST(gtest_telemetry, drop)
+{
+    setup(RING_SIZE);
+    telemetry_init(&sink, NULL, LOOP_HZ);
+    telemetry_rate_set(TELEMETRY_MSG_ATTITUDE, LOOP_HZ);
+    telemetry_rate_set(TELEMETRY_MSG_MOTORS, LOOP_HZ);
+
+    /* The link takes a few bytes per cycle only. */
+    std::vector<uint8_t> data;
+    for (uint32_t n = 0; n < 200; n++)
+    {
+        (void)telemetry_update(&ghf);
+
+        uint8_t byte[8];
+        uint32_t size = ring_buffer_pop_n(&ring, &byte[0], sizeof(byte));
+        data.insert(data.end(), &byte[0], &byte[size]);
+    }
+
+    /* The link caught up, the frames after the gap go out again. */
+    std::vector<uint8_t> tail = drain();
+    data.insert(data.end(), tail.begin(), tail.end());
+    EXPECT_GT(telemetry_update(&ghf), 0u);
+    tail = drain();
+    data.insert(data.end(), tail.begin(), tail.end());
+
+    const telemetry_stats_t *stats = telemetry_stats_get();
+    EXPECT_GT(stats->dropped, 0u);
+    EXPECT_EQ(stats->frames + stats->dropped, 402u);
+
+    std::vector<struct frame> frames = decode(data);
+    ASSERT_EQ(frames.size(), stats->frames);
+
+    uint32_t lost = frames[0].seq;
+    for (uint32_t i = 1; i < frames.size(); i++)
+    {
+        lost += (uint8_t)(frames[i].seq - frames[i - 1].seq - 1);
+    }
+
+    EXPECT_EQ(lost, stats->dropped);
+}
+
+///
+/// \brief This test writes the frames across the ring end in place, they come out whole.
+///
+TEST(gtest_telemetry, wrap)
+{
+    std::vector<struct frame> frames;
+
+    setup(0x40);
+    telemetry_init(&sink, NULL, LOOP_HZ);
+    telemetry_rate_set(TELEMETRY_MSG_ATTITUDE, LOOP_HZ);
+
+    ahrs.out.roll = 12.5f;
+
+    for (uint32_t n = 0; n < 64; n++)
+    {
+        ahrs.out.pitch = (float32_t)n;
+        EXPECT_EQ(telemetry_update(&ghf), TELEMETRY_HEADER_SIZE + 12u + TELEMETRY_CRC_SIZE);
+
+        std::vector<struct frame> cycle = decode(drain());
+        frames.insert(frames.end(), cycle.begin(), cycle.end());
+    }
+
+    ASSERT_EQ(frames.size(), 64u);
+
+    for (uint32_t n = 0; n < frames.size(); n++)
+    {
+        float32_t out[3];
+        memcpy(&out[0], frames[n].payload.data(), sizeof(out));
+        EXPECT_EQ(out[0], 12.5f);
+        EXPECT_EQ(out[1], (float32_t)n);
+    }
+}
@@ -0,0 +1,606 @@
+#include "sitl.h"
+#include "sitl_model.h"
+#include "app.h"
+#include "ahrs.h"
+#include "boot_handoff.h"
+#include "ghf.h"
+#include "ll_spi.h"
+#include "pid.h"
+#include "rc.h"
+#include "timing.h"
+#include "vtol.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SITL_CYCLE_US       (250u)          /*!< The control period, the ghf dt.                        */
+#define SITL_CSV_DIVIDER    (40u)           /*!< The control cycles per CSV row, 100 Hz.                */
+#define SITL_DEG_MAX        (30.0f)         /*!< The stick deflection in degrees, see app.c.            */
+#define SITL_RAD2DEG        (57.2957795f)
+#define SITL_AXIS_TOTAL     (3u)
+
+///***********************************************************************************************************
+/// Private objects - declaration.
+///***********************************************************************************************************
+///
+/// \brief The scenario segment, the stick positions from its start on.
+///
+struct sitl_seg
+{
+    float32_t start;                        /*!< The start time (s).                                    */
+    uint32_t roll;
+    uint32_t pitch;
+    uint32_t throttle;
+    uint32_t yaw;
+};
+
+///
+/// \brief The command line options.
+///
+struct sitl_opt
+{
+    float32_t kp;                           /*!< The PID gains, negative keeps the ghf ones.            */
+    float32_t ki;
+    float32_t kd;
+    float32_t alpha;                        /*!< The complementary filter alpha, 0 keeps the ghf one.   */
+    uint32_t imu_delay;
+    float32_t imu_noise;
+    int16_t gyr_bias;
+    uint32_t seed;
+    const char *csv;
+    float32_t max_rms;                      /*!< The tracking error limit (deg rms), 0 disables it.     */
+    float32_t max_rise;                     /*!< The 90 % rise time limit (ms), 0 disables it.          */
+};
+
+///
+/// \brief The step response of one axis.
+///
+struct sitl_step
+{
+    float32_t start;                        /*!< The time of the running step.                          */
+    float32_t from;                         /*!< The angle at the step (deg).                           */
+    float32_t to;                           /*!< The angle commanded (deg).                             */
+    uint8_t active;                         /*!< 1 while a step away from level runs.                   */
+    uint8_t risen;                          /*!< 1 once the running step reached 90 %.                  */
+    uint32_t timed;                         /*!< The steps which reached 90 %.                          */
+    float32_t rise;                         /*!< The time to 90 % of the step (s), the worst one.       */
+    float32_t overshoot;                    /*!< The overshoot (deg), the worst one.                    */
+};
+
+///
+/// \brief The flight statistics.
+///
+struct sitl_stat
+{
+    uint64_t cycles;
+    uint64_t flight;                        /*!< The cycles armed and in the air.                       */
+    double err_sq[SITL_AXIS_TOTAL];         /*!< The tracking error squared sums.                       */
+    float32_t err_max[SITL_AXIS_TOTAL];
+    double est_sq[SITL_AXIS_TOTAL];         /*!< The AHRS error squared sums.                           */
+    struct sitl_step step[SITL_AXIS_TOTAL];
+    uint8_t armed;
+    uint64_t cpu_ns;
+    uint64_t cpu_ns_max;
+    uint64_t wall_ns;
+};
+
+///***********************************************************************************************************
+/// Private objects - definition.
+///***********************************************************************************************************
+///
+/// \brief The scenario: arm, take off, a roll, a pitch and a yaw step, land and disarm.
+///
+static const struct sitl_seg sitl_scenario[] =
+{
+    {.start =  0.0f, .roll = 1500, .pitch = 1500, .throttle = 1000, .yaw = 1500},
+    {.start =  0.5f, .roll = 1500, .pitch = 1000, .throttle = 1000, .yaw = 1500},
+    {.start =  1.0f, .roll = 1000, .pitch = 1000, .throttle = 1000, .yaw = 1500},
+    {.start =  1.5f, .roll = 1500, .pitch = 1000, .throttle = 1000, .yaw = 1500},
+    {.start =  2.0f, .roll = 1500, .pitch = 1500, .throttle = 1000, .yaw = 1500},
+    {.start =  3.0f, .roll = 1500, .pitch = 1500, .throttle = 1550, .yaw = 1500},
+    {.start =  4.0f, .roll = 1500, .pitch = 1500, .throttle = 1500, .yaw = 1500},
+    {.start =  6.0f, .roll = 1667, .pitch = 1500, .throttle = 1500, .yaw = 1500},
+    {.start =  8.0f, .roll = 1500, .pitch = 1500, .throttle = 1500, .yaw = 1500},
+    {.start = 10.0f, .roll = 1500, .pitch = 1333, .throttle = 1500, .yaw = 1500},
+    {.start = 12.0f, .roll = 1500, .pitch = 1500, .throttle = 1500, .yaw = 1500},
+    {.start = 14.0f, .roll = 1500, .pitch = 1500, .throttle = 1500, .yaw = 1750},
+    {.start = 16.0f, .roll = 1500, .pitch = 1500, .throttle = 1500, .yaw = 1500},
+    {.start = 18.0f, .roll = 1500, .pitch = 1500, .throttle = 1000, .yaw = 1500},
+    {.start = 19.0f, .roll = 1500, .pitch = 1000, .throttle = 1000, .yaw = 1500},
+    {.start = 19.5f, .roll = 1000, .pitch = 1000, .throttle = 1000, .yaw = 1500},
+    {.start = 20.0f, .roll = 1500, .pitch = 1000, .throttle = 1000, .yaw = 1500},
+    {.start = 20.5f, .roll = 1500, .pitch = 1500, .throttle = 1000, .yaw = 1500},
+};
+
+#define SITL_SCENARIO_SIZE  (sizeof(sitl_scenario) / sizeof(sitl_scenario[0]))
+#define SITL_SCENARIO_END   (22.0f)
+
+static const char *const sitl_axis_names[SITL_AXIS_TOTAL] = {"roll", "pitch", "yaw"};
+
+///***********************************************************************************************************
+/// Global objects - definition.
+///***********************************************************************************************************
+///
+/// \brief The hand-off block, the linker places __handoff_shared__ on it.
+///
+boot_handoff_t sitl_handoff;
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief Parses the command line.
+///
+/// \param[in]  argc The argument count.
+/// \param[in]  argv The arguments.
+/// \param[out] opt  The options.
+///
+/// \return int 0 on success, -1 on an unknown option.
+///
+static int opt_parse(int argc, char **argv, struct sitl_opt *const opt);
+
+///
+/// \brief Does what the bootloader does before the app starts: the hand-off block with the clocks
+///        and the boot stamps.
+///
+static void boot_emulate(void);
+
+///
+/// \brief Gets the stick angle of the pulse width, the controller setpoint in steady state.
+///
+/// \param[in] raw The pulse width.
+///
+/// \return float32_t The angle (deg).
+///
+static float32_t stick_deg(const uint32_t raw);
+
+///
+/// \brief Follows the step responses, a step starts when the scenario moves the stick of the axis.
+///
+/// \param[in] stat  The statistics.
+/// \param[in] seg   The segment started now.
+/// \param[in] t     The time (s).
+/// \param[in] truth The true attitude (deg).
+///
+static void step_start(struct sitl_stat *const stat, const struct sitl_seg *const seg, const float32_t t,
+                       const float32_t truth[SITL_AXIS_TOTAL]);
+
+///
+/// \brief Updates the step responses.
+///
+/// \param[in] stat  The statistics.
+/// \param[in] t     The time (s).
+/// \param[in] truth The true attitude (deg).
+///
+static void step_update(struct sitl_stat *const stat, const float32_t t, const float32_t truth[SITL_AXIS_TOTAL]);
+
+///
+/// \brief Prints the statistics.
+///
+/// \param[in] stat The statistics.
+///
+static void stat_print(const struct sitl_stat *const stat);
+
+///
+/// \brief Checks the statistics against the limits of the options.
+///
+/// \param[in] stat The statistics.
+/// \param[in] opt  The options.
+///
+/// \return int 0 within the limits, -1 otherwise.
+///
+static int stat_check(const struct sitl_stat *const stat, const struct sitl_opt *const opt);
+
+///
+/// \brief Gets the monotonic time.
+///
+/// \return uint64_t The time in nanoseconds.
+///
+static uint64_t wall_ns(void);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static int opt_parse(int argc, char **argv, struct sitl_opt *const opt)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char *val = ((i + 1) < argc) ? argv[i + 1] : NULL;
+
+        if (val == NULL)
+        {
+            return -1;
+        }
+        else if (strcmp(argv[i], "--kp") == 0)
+        {
+            opt->kp = strtof(val, NULL);
+        }
+        else if (strcmp(argv[i], "--ki") == 0)
+        {
+            opt->ki = strtof(val, NULL);
+        }
+        else if (strcmp(argv[i], "--kd") == 0)
+        {
+            opt->kd = strtof(val, NULL);
+        }
+        else if (strcmp(argv[i], "--alpha") == 0)
+        {
+            opt->alpha = strtof(val, NULL);
+        }
+        else if (strcmp(argv[i], "--imu-delay") == 0)
+        {
+            opt->imu_delay = (uint32_t)strtoul(val, NULL, 0);
+        }
+        else if (strcmp(argv[i], "--noise") == 0)
+        {
+            opt->imu_noise = strtof(val, NULL);
+        }
+        else if (strcmp(argv[i], "--bias") == 0)
+        {
+            opt->gyr_bias = (int16_t)strtol(val, NULL, 0);
+        }
+        else if (strcmp(argv[i], "--seed") == 0)
+        {
+            opt->seed = (uint32_t)strtoul(val, NULL, 0);
+        }
+        else if (strcmp(argv[i], "--csv") == 0)
+        {
+            opt->csv = val;
+        }
+        else if (strcmp(argv[i], "--max-rms") == 0)
+        {
+            opt->max_rms = strtof(val, NULL);
+        }
+        else if (strcmp(argv[i], "--max-rise") == 0)
+        {
+            opt->max_rise = strtof(val, NULL);
+        }
+        else
+        {
+            return -1;
+        }
+
+        i++;
+    }
+
+    return 0;
+}
+
+static void boot_emulate(void)
+{
+    volatile boot_handoff_t *handoff = BOOT_HANDOFF;
+
+    boot_handoff_create(handoff);
+
+    handoff->clocks.sysclk = SITL_SYSCLK_FREQ;
+    handoff->clocks.apb1   = SITL_APB1_FREQ;
+    handoff->clocks.apb2   = SITL_APB2_FREQ;
+    boot_handoff_seal(handoff);
+
+    timing_boot_start();
+    timing_boot_stamp(TIMING_BOOT_STAGE_BOOTLOADER);
+    timing_boot_stamp(TIMING_BOOT_STAGE_APPLOADER);
+    timing_boot_stamp(TIMING_BOOT_STAGE_IMAGE_CHECKED);
+}
+
+static float32_t stick_deg(const uint32_t raw)
+{
+    return (((float32_t)raw - 1500.0f) / 500.0f) * SITL_DEG_MAX;
+}
+
+static void step_start(struct sitl_stat *const stat, const struct sitl_seg *const seg, const float32_t t,
+                       const float32_t truth[SITL_AXIS_TOTAL])
+{
+    uint32_t raw[SITL_AXIS_TOTAL] = {seg->roll, seg->pitch, seg->yaw};
+
+    /* The steps are flown in the air, the arming sticks are not. */
+    if ((seg->throttle < 1200) || (seg == &sitl_scenario[0]))
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < SITL_AXIS_TOTAL; i++)
+    {
+        const struct sitl_seg *prev = seg - 1;
+        uint32_t prev_raw[SITL_AXIS_TOTAL] = {prev->roll, prev->pitch, prev->yaw};
+
+        if (raw[i] != prev_raw[i])
+        {
+            /* Only the steps away from level are timed, the returns are not. */
+            stat->step[i].start  = t;
+            stat->step[i].from   = truth[i];
+            stat->step[i].to     = stick_deg(raw[i]);
+            stat->step[i].active = (raw[i] != 1500) ? 1 : 0;
+            stat->step[i].risen  = 0;
+        }
+    }
+}
+
+static void step_update(struct sitl_stat *const stat, const float32_t t, const float32_t truth[SITL_AXIS_TOTAL])
+{
+    for (uint32_t i = 0; i < SITL_AXIS_TOTAL; i++)
+    {
+        struct sitl_step *step = &stat->step[i];
+
+        if (step->active == 0)
+        {
+            continue;
+        }
+
+        float32_t progress = (truth[i] - step->from) / (step->to - step->from);
+
+        if ((step->risen == 0) && (progress >= 0.9f))
+        {
+            step->risen = 1;
+            step->rise  = fmaxf(step->rise, t - step->start);
+            step->timed++;
+        }
+
+        step->overshoot = fmaxf(step->overshoot, (progress - 1.0f) * fabsf(step->to - step->from));
+    }
+}
+
+static void stat_print(const struct sitl_stat *const stat)
+{
+    double sim_s = (double)stat->cycles * SITL_CYCLE_US * 1e-6;
+    uint64_t flight = (stat->flight != 0) ? stat->flight : 1;
+
+    printf("sitl:   %llu cycles, %.1f s simulated in %.3f s, %.0fx real time\n",
+           (unsigned long long)stat->cycles, sim_s, (double)stat->wall_ns * 1e-9,
+           sim_s / ((double)stat->wall_ns * 1e-9));
+    printf("sitl:   app_update %.0f ns mean, %llu ns max\n",
+           (double)stat->cpu_ns / (double)stat->cycles, (unsigned long long)stat->cpu_ns_max);
+    printf("sitl:   %.1f s in the air\n", (double)stat->flight * SITL_CYCLE_US * 1e-6);
+
+    for (uint32_t i = 0; i < SITL_AXIS_TOTAL; i++)
+    {
+        const struct sitl_step *step = &stat->step[i];
+
+        printf("sitl:   %-5s tracking %.2f deg rms, %.2f deg max, ahrs %.2f deg rms, ", sitl_axis_names[i],
+               sqrt(stat->err_sq[i] / (double)flight), (double)stat->err_max[i],
+               sqrt(stat->est_sq[i] / (double)flight));
+
+        if (step->timed != 0)
+        {
+            printf("90 %% rise %.0f ms, overshoot %.2f deg\n", (double)step->rise * 1e3, (double)step->overshoot);
+        }
+        else
+        {
+            printf("90 %% rise not reached\n");
+        }
+    }
+}
+
+static int stat_check(const struct sitl_stat *const stat, const struct sitl_opt *const opt)
+{
+    uint64_t flight = (stat->flight != 0) ? stat->flight : 1;
+    int res = 0;
+
+    for (uint32_t i = 0; i < SITL_AXIS_TOTAL; i++)
+    {
+        const struct sitl_step *step = &stat->step[i];
+        double rms = sqrt(stat->err_sq[i] / (double)flight);
+
+        if ((opt->max_rms > 0.0f) && (rms > (double)opt->max_rms))
+        {
+            fprintf(stderr, "sitl:   %s tracking %.2f deg rms over %.2f\n", sitl_axis_names[i], rms,
+                    (double)opt->max_rms);
+            res = -1;
+        }
+
+        /* A step never reaching 90 % is the slowest rise of all. */
+        if ((opt->max_rise > 0.0f) && ((step->timed == 0) || ((step->rise * 1e3f) > opt->max_rise)))
+        {
+            fprintf(stderr, "sitl:   %s rise over %.0f ms\n", sitl_axis_names[i], (double)opt->max_rise);
+            res = -1;
+        }
+    }
+
+    return res;
+}
+
+static uint64_t wall_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+///***********************************************************************************************************
+/// Global functions - definition.
+///***********************************************************************************************************
+ll_spi_res_t ll_spi_dev_init(const ll_spi_inst_t inst)
+{
+    (void)inst;
+
+    return LL_SPI_RES_OK;
+}
+
+int main(int argc, char **argv)
+{
+    struct sitl_opt opt =
+    {
+        .kp        = -1.0f,
+        .ki        = -1.0f,
+        .kd        = -1.0f,
+        .imu_delay = 0,
+        .imu_noise = 4.0f,
+        .gyr_bias  = 12,
+        .seed      = 1,
+        .csv       = NULL,
+        .max_rms   = 0.0f,
+        .max_rise  = 0.0f,
+    };
+    static struct sitl_stat stat;
+    struct sitl_model model;
+    struct ghf *ghf = ghf_get();
+    FILE *csv = NULL;
+    uint32_t seg = 0;
+
+    if (opt_parse(argc, argv, &opt) != 0)
+    {
+        fprintf(stderr, "usage: %s [--kp K] [--ki K] [--kd K] [--alpha A] [--imu-delay CYCLES] [--noise LSB] [--bias LSB] "
+                "[--seed N] [--csv FILE] [--max-rms DEG] [--max-rise MS]\n", argv[0]);
+        return 2;
+    }
+
+    if (opt.csv != NULL)
+    {
+        csv = fopen(opt.csv, "w");
+
+        if (csv == NULL)
+        {
+            perror(opt.csv);
+            return 2;
+        }
+
+        fprintf(csv, "t,armed,z,roll,pitch,yaw,ahrs_roll,ahrs_pitch,ahrs_yaw,sp_roll,sp_pitch,sp_yaw,"
+                "pwm1,pwm2,pwm3,pwm4\n");
+    }
+
+    sitl_model_init(&model);
+    sitl_imu_init(opt.imu_delay, opt.imu_noise, opt.gyr_bias, opt.seed);
+
+    boot_emulate();
+
+    /* Up to the calibration, which reads the IMU at rest. */
+    app_init();
+
+    ghf->config.kp = (opt.kp >= 0.0f) ? opt.kp : ghf->config.kp;
+    ghf->config.ki = (opt.ki >= 0.0f) ? opt.ki : ghf->config.ki;
+    ghf->config.kd = (opt.kd >= 0.0f) ? opt.kd : ghf->config.kd;
+
+    pid_init(ghf->module.pid_roll,  ghf->config.kp, ghf->config.ki, ghf->config.kd, ghf->config.dt);
+    pid_init(ghf->module.pid_pitch, ghf->config.kp, ghf->config.ki, ghf->config.kd, ghf->config.dt);
+    pid_init(ghf->module.pid_yaw,   ghf->config.kp, ghf->config.ki, ghf->config.kd, ghf->config.dt);
+
+    if (opt.alpha != 0.0f)
+    {
+        ghf->config.alpha = opt.alpha;
+
+        ahrs_init(ghf->module.ahrs, ghf->config.acc_scale, ghf->config.gyr_scale, opt.alpha, ghf->config.dt);
+    }
+
+    printf("sitl:   kp %g, ki %g, kd %g, alpha %g, imu delay %u us\n", (double)ghf->config.kp,
+           (double)ghf->config.ki, (double)ghf->config.kd, (double)ghf->config.alpha, opt.imu_delay * SITL_CYCLE_US);
+
+    uint64_t wall_start = wall_ns();
+    uint64_t clock_start = sitl_clock_us();
+
+    while (1)
+    {
+        float32_t t = (float32_t)(sitl_clock_us() - clock_start) * 1e-6f;
+
+        if (t >= SITL_SCENARIO_END)
+        {
+            break;
+        }
+
+        if ((seg < SITL_SCENARIO_SIZE) && (t >= sitl_scenario[seg].start))
+        {
+            float32_t truth[SITL_AXIS_TOTAL] = {model.att[0] * SITL_RAD2DEG, model.att[1] * SITL_RAD2DEG,
+                                                model.att[2] * SITL_RAD2DEG};
+
+            sitl_rc_set(0, sitl_scenario[seg].roll);
+            sitl_rc_set(1, sitl_scenario[seg].pitch);
+            sitl_rc_set(2, sitl_scenario[seg].throttle);
+            sitl_rc_set(3, sitl_scenario[seg].yaw);
+            step_start(&stat, &sitl_scenario[seg], t, truth);
+            seg++;
+        }
+
+        float32_t acc[3], gyr[3];
+
+        sitl_model_imu(&model, acc, gyr);
+        sitl_imu_sample(acc, gyr);
+
+        uint64_t cpu_start = wall_ns();
+
+        app_update();
+
+        uint64_t cpu = wall_ns() - cpu_start;
+
+        stat.cpu_ns    += cpu;
+        stat.cpu_ns_max = (cpu > stat.cpu_ns_max) ? cpu : stat.cpu_ns_max;
+
+        uint32_t pwm[SITL_MODEL_MOTOR_TOTAL] =
+        {
+            sitl_tim_ccr_get(TIM_INST_4, LL_TIM_CCR_CH1),
+            sitl_tim_ccr_get(TIM_INST_4, LL_TIM_CCR_CH2),
+            sitl_tim_ccr_get(TIM_INST_4, LL_TIM_CCR_CH3),
+            sitl_tim_ccr_get(TIM_INST_4, LL_TIM_CCR_CH4),
+        };
+
+        sitl_model_step(&model, pwm, (float32_t)SITL_CYCLE_US * 1e-6f);
+
+        uint8_t armed = (vtol_stat_get() == VTOL_STAT_ON) ? 1 : 0;
+        float32_t truth[SITL_AXIS_TOTAL] = {model.att[0] * SITL_RAD2DEG, model.att[1] * SITL_RAD2DEG,
+                                            model.att[2] * SITL_RAD2DEG};
+        float32_t est[SITL_AXIS_TOTAL] = {ghf->module.ahrs->out.roll, ghf->module.ahrs->out.pitch,
+                                          ghf->module.ahrs->out.yaw};
+        float32_t sp[SITL_AXIS_TOTAL] = {ghf->module.rc_1->sig.norm * SITL_DEG_MAX,
+                                         ghf->module.rc_2->sig.norm * SITL_DEG_MAX,
+                                         ghf->module.rc_4->sig.norm * SITL_DEG_MAX};
+
+        stat.armed |= armed;
+
+        if ((armed == 1) && (model.grounded == 0))
+        {
+            stat.flight++;
+
+            for (uint32_t i = 0; i < SITL_AXIS_TOTAL; i++)
+            {
+                float32_t err = sp[i] - truth[i];
+
+                stat.err_sq[i] += (double)(err * err);
+                stat.err_max[i] = fmaxf(stat.err_max[i], fabsf(err));
+                stat.est_sq[i] += (double)((est[i] - truth[i]) * (est[i] - truth[i]));
+            }
+
+            step_update(&stat, t, truth);
+        }
+
+        if ((csv != NULL) && ((stat.cycles % SITL_CSV_DIVIDER) == 0))
+        {
+            fprintf(csv, "%.4f,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%u,%u,%u,%u\n", (double)t,
+                    armed, (double)model.pos[2], (double)truth[0], (double)truth[1], (double)truth[2],
+                    (double)est[0], (double)est[1], (double)est[2], (double)sp[0], (double)sp[1], (double)sp[2],
+                    pwm[0], pwm[1], pwm[2], pwm[3]);
+        }
+
+        stat.cycles++;
+
+        /* The cycle ends at the control period, as the wait in app_start() makes it. */
+        sitl_clock_advance(SITL_CYCLE_US);
+
+        ghf->data.time.stop  = timing_cnt_get();
+        ghf->data.time.total = ghf->data.time.stop - ghf->data.time.start;
+        ghf->data.time.total = ghf->data.time.total * TIMING_TICK_DURATION * 1000000;
+    }
+
+    stat.wall_ns = wall_ns() - wall_start;
+
+    if (csv != NULL)
+    {
+        fclose(csv);
+    }
+
+    stat_print(&stat);
+
+    if ((stat.armed == 0) || (stat.flight == 0) || (vtol_stat_get() == VTOL_STAT_ON))
+    {
+        fprintf(stderr, "sitl:   the scenario did not arm, fly and disarm\n");
+        return 1;
+    }
+
+    if (stat_check(&stat, &opt) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
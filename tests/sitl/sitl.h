@@ -0,0 +1,97 @@
+#ifndef _SITL_H
+#define _SITL_H
+
+#include "tim.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+#define SITL_SYSCLK_FREQ    (216000000u)    /*!< The simulated system clock, the DWT counter rate (Hz).   */
+#define SITL_APB1_FREQ      (54000000u)     /*!< The simulated APB1 clock (Hz).                           */
+#define SITL_APB2_FREQ      (108000000u)    /*!< The simulated APB2 clock (Hz).                           */
+#define SITL_TIM_CNT_MASK   (0xffffu)       /*!< The simulated timers count microseconds on 16 bits.      */
+#define SITL_RC_FRAME_US    (20000u)        /*!< The receiver sends every channel once per frame.         */
+#define SITL_RC_SLOT_US     (2500u)         /*!< The receiver sends the channels one after the other.     */
+#define SITL_IMU_DELAY_MAX  (64u)           /*!< The longest IMU delay, in control cycles.                */
+
+///
+/// \brief The 32-bit floating-point type.
+///
+typedef float float32_t;
+
+///
+/// \brief Advances the simulated time, the timer edges which fall into it are delivered in order.
+///
+/// \note The busy waits of the firmware, timing_delay_us() included, advance it too.
+///
+/// \param[in] us The time step in microseconds.
+///
+void sitl_clock_advance(const uint32_t us);
+
+///
+/// \brief Gets the simulated time.
+///
+/// \return uint64_t The microseconds since the simulated power-on.
+///
+uint64_t sitl_clock_us(void);
+
+///
+/// \brief Gets the compare value the firmware set, the motor pulse width.
+///
+/// \param[in] inst The TIM instance.
+/// \param[in] ch   The TIM capture/compare channel.
+///
+/// \return uint32_t The pulse width in microseconds, 0 if never set.
+///
+uint32_t sitl_tim_ccr_get(const tim_inst_t inst, const ll_tim_ccr_ch_t ch);
+
+///
+/// \brief Delivers the input capture edge to the callback the firmware registered.
+///
+/// \param[in] inst The TIM instance.
+/// \param[in] ch   The TIM capture/compare channel.
+/// \param[in] us   The simulated time of the edge.
+///
+void sitl_tim_capture(const tim_inst_t inst, const ll_tim_ccr_ch_t ch, const uint64_t us);
+
+///
+/// \brief Sets the stick position the simulated transmitter sends from the next frame on.
+///
+/// \param[in] ch  The RC channel, 0 to 5.
+/// \param[in] raw The pulse width in microseconds.
+///
+void sitl_rc_set(const uint32_t ch, const uint32_t raw);
+
+///
+/// \brief Sends the receiver pulses which start and end up to the simulated time, one input capture
+///        edge each.
+///
+/// \param[in] us The simulated time.
+///
+void sitl_rc_run(const uint64_t us);
+
+///
+/// \brief Sets the IMU errors, the gyroscope bias is removed by the firmware calibration.
+///
+/// \param[in] delay The samples the IMU lags behind the model, in control cycles.
+/// \param[in] noise The standard deviation of the noise in LSB.
+/// \param[in] bias  The gyroscope bias in LSB.
+/// \param[in] seed  The noise seed.
+///
+void sitl_imu_init(const uint32_t delay, const float32_t noise, const int16_t bias, const uint32_t seed);
+
+///
+/// \brief Feeds the IMU with the true specific force and angular rate of the model.
+///
+/// \param[in] acc The specific force in the body frame in g.
+/// \param[in] gyr The angular rate in the body frame in degrees per second.
+///
+void sitl_imu_sample(const float32_t acc[3], const float32_t gyr[3]);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _SITL_H */
@@ -0,0 +1,103 @@
+#include "sitl.h"
+#include "timing.h"
+
+///***********************************************************************************************************
+/// Private objects - definition.
+///***********************************************************************************************************
+///
+/// \brief The simulated time in microseconds.
+///
+static uint64_t sitl_clock;
+
+///
+/// \brief The simulated time the DWT cycle counter was started at.
+///
+static uint64_t sitl_cyccnt_base;
+
+///
+/// \brief 1 while the DWT cycle counter runs, it reads 0 otherwise.
+///
+static uint8_t sitl_cyccnt_run;
+
+///***********************************************************************************************************
+/// Global functions - definition.
+///***********************************************************************************************************
+void sitl_clock_advance(const uint32_t us)
+{
+    sitl_clock += us;
+
+    /* The receiver interrupts run while the firmware waits. */
+    sitl_rc_run(sitl_clock);
+}
+
+uint64_t sitl_clock_us(void)
+{
+    return sitl_clock;
+}
+
+timing_res_t timing_init(void)
+{
+    return TIMING_RES_OK;
+}
+
+void timing_start(void)
+{
+    sitl_cyccnt_base = sitl_clock;
+    sitl_cyccnt_run  = 1;
+}
+
+void timing_stop(void)
+{
+    sitl_cyccnt_run = 0;
+}
+
+uint32_t timing_cnt_get(void)
+{
+    if (sitl_cyccnt_run == 0)
+    {
+        return 0;
+    }
+
+    return (uint32_t)((sitl_clock - sitl_cyccnt_base) * (SITL_SYSCLK_FREQ / 1000000u));
+}
+
+void timing_boot_start(void)
+{
+    timing_start();
+
+    for (uint32_t i = 0; i < TIMING_BOOT_STAGE_TOTAL_SIZE; i++)
+    {
+        timing_boot_stamps[i] = 0;
+    }
+
+    boot_handoff_seal(BOOT_HANDOFF);
+}
+
+void timing_boot_stamp(const timing_boot_stage_t stage)
+{
+    if (stage < TIMING_BOOT_STAGE_TOTAL_SIZE)
+    {
+        timing_boot_stamps[stage] = timing_cnt_get();
+        boot_handoff_seal(BOOT_HANDOFF);
+    }
+}
+
+uint32_t timing_boot_us(const timing_boot_stage_t stage)
+{
+    /* The clock bring-up takes no simulated time. */
+    if ((stage >= TIMING_BOOT_STAGE_TOTAL_SIZE) || (stage == TIMING_BOOT_STAGE_CLOCKS) ||
+        (timing_boot_stamps[stage] == 0))
+    {
+        return 0;
+    }
+
+    uint32_t prev = (stage == TIMING_BOOT_STAGE_BOOTLOADER) ? 0 : timing_boot_stamps[stage - 1];
+
+    return (uint32_t)(((uint64_t)(timing_boot_stamps[stage] - prev) * 1000000u) / timing_sysclk_freq);
+}
+
+void timing_delay_us(const uint32_t us)
+{
+    /* The busy wait would never end, nothing else moves the simulated time on. */
+    sitl_clock_advance(us);
+}
@@ -0,0 +1,201 @@
+#include "sitl.h"
+#include "bmi270.h"
+#include <math.h>
+
+#define SITL_IMU_ACC_LSB    (4096.0f)       /*!< The accelerometer LSB per g, the +-8 g range.            */
+#define SITL_IMU_GYR_LSB    (16.4f)         /*!< The gyroscope LSB per degree per second, +-2000 dps.     */
+
+///***********************************************************************************************************
+/// Private objects - declaration.
+///***********************************************************************************************************
+///
+/// \brief The IMU sample, the true values in LSB.
+///
+struct sitl_imu_sample
+{
+    float32_t acc[3];
+    float32_t gyr[3];
+};
+
+///
+/// \brief The simulated IMU.
+///
+struct sitl_imu
+{
+    struct sitl_imu_sample line[SITL_IMU_DELAY_MAX + 1];    /*!< The delay line of the model samples. */
+    uint32_t head;
+    uint32_t delay;
+    float32_t noise;
+    int16_t bias;
+    uint32_t seed;
+    int16_t acc[3];                         /*!< The last read accelerometer data.                      */
+    int16_t gyr[3];                         /*!< The last read gyroscope data.                          */
+};
+
+///***********************************************************************************************************
+/// Private objects - definition.
+///***********************************************************************************************************
+///
+/// \brief The simulated IMU, level and at rest until the model feeds it.
+///
+static struct sitl_imu sitl_imu =
+{
+    .line = {[0 ... SITL_IMU_DELAY_MAX] = {.acc = {0.0f, 0.0f, SITL_IMU_ACC_LSB}}},
+    .seed = 1,
+};
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief Draws the normally distributed noise, Box-Muller over the xorshift32 generator.
+///
+/// \return float32_t The noise of the configured standard deviation in LSB.
+///
+static float32_t noise_get(void);
+
+///
+/// \brief Turns the value into the saturated 16-bit register value.
+///
+/// \param[in] val The value in LSB.
+///
+/// \return int16_t The register value.
+///
+static int16_t reg_get(const float32_t val);
+
+///
+/// \brief Gets the sample the delay line hands out now.
+///
+/// \return const struct sitl_imu_sample* The sample.
+///
+static const struct sitl_imu_sample* delayed_get(void);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static float32_t noise_get(void)
+{
+    float32_t u[2];
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        sitl_imu.seed ^= sitl_imu.seed << 13;
+        sitl_imu.seed ^= sitl_imu.seed >> 17;
+        sitl_imu.seed ^= sitl_imu.seed << 5;
+
+        u[i] = ((float32_t)(sitl_imu.seed >> 8) + 1.0f) / 16777217.0f;
+    }
+
+    return sitl_imu.noise * sqrtf(-2.0f * logf(u[0])) * cosf(6.2831853f * u[1]);
+}
+
+static int16_t reg_get(const float32_t val)
+{
+    float32_t rounded = roundf(val);
+
+    if (rounded > 32767.0f)
+    {
+        return 32767;
+    }
+
+    if (rounded < -32768.0f)
+    {
+        return -32768;
+    }
+
+    return (int16_t)rounded;
+}
+
+static const struct sitl_imu_sample* delayed_get(void)
+{
+    uint32_t index = (sitl_imu.head + (SITL_IMU_DELAY_MAX + 1) - sitl_imu.delay) % (SITL_IMU_DELAY_MAX + 1);
+
+    return &sitl_imu.line[index];
+}
+
+///***********************************************************************************************************
+/// Global functions - definition.
+///***********************************************************************************************************
+void sitl_imu_init(const uint32_t delay, const float32_t noise, const int16_t bias, const uint32_t seed)
+{
+    sitl_imu.delay = (delay < SITL_IMU_DELAY_MAX) ? delay : SITL_IMU_DELAY_MAX;
+    sitl_imu.noise = noise;
+    sitl_imu.bias  = bias;
+    sitl_imu.seed  = (seed != 0) ? seed : 1;
+}
+
+void sitl_imu_sample(const float32_t acc[3], const float32_t gyr[3])
+{
+    sitl_imu.head = (sitl_imu.head + 1) % (SITL_IMU_DELAY_MAX + 1);
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        sitl_imu.line[sitl_imu.head].acc[i] = acc[i] * SITL_IMU_ACC_LSB;
+        sitl_imu.line[sitl_imu.head].gyr[i] = gyr[i] * SITL_IMU_GYR_LSB;
+    }
+}
+
+bmi270_res_t bmi270_init(void)
+{
+    return BMI270_RES_OK;
+}
+
+bmi270_res_t bmi270_resume(void)
+{
+    return BMI270_RES_OK;
+}
+
+void bmi270_pwr_mode_set(bmi270_pwr_mode_t pwr_mode)
+{
+    (void)pwr_mode;
+}
+
+void bmi270_acc_read(void)
+{
+    const struct sitl_imu_sample *sample = delayed_get();
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        sitl_imu.acc[i] = reg_get(sample->acc[i] + noise_get());
+    }
+}
+
+int16_t bmi270_acc_get_x(void)
+{
+    return sitl_imu.acc[0];
+}
+
+int16_t bmi270_acc_get_y(void)
+{
+    return sitl_imu.acc[1];
+}
+
+int16_t bmi270_acc_get_z(void)
+{
+    return sitl_imu.acc[2];
+}
+
+void bmi270_gyr_read(void)
+{
+    const struct sitl_imu_sample *sample = delayed_get();
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        sitl_imu.gyr[i] = reg_get(sample->gyr[i] + (float32_t)sitl_imu.bias + noise_get());
+    }
+}
+
+int16_t bmi270_gyr_get_x(void)
+{
+    return sitl_imu.gyr[0];
+}
+
+int16_t bmi270_gyr_get_y(void)
+{
+    return sitl_imu.gyr[1];
+}
+
+int16_t bmi270_gyr_get_z(void)
+{
+    return sitl_imu.gyr[2];
+}
@@ -0,0 +1,171 @@
+#include "sitl_model.h"
+#include <math.h>
+#include <string.h>
+
+#define SITL_MODEL_G        (9.80665f)      /*!< The standard gravity (m/s^2).                          */
+#define SITL_MODEL_RAD2DEG  (57.2957795f)
+
+///***********************************************************************************************************
+/// Private objects - definition.
+///***********************************************************************************************************
+///
+/// \brief The motor torque signs, the X frame the app mix is written for: the roll output speeds up
+///        motors 1 and 3, the pitch output motors 3 and 4 and the yaw output motors 1 and 4.
+///
+static const float32_t sitl_model_roll_sign[SITL_MODEL_MOTOR_TOTAL]  = { 1.0f, -1.0f,  1.0f, -1.0f};
+static const float32_t sitl_model_pitch_sign[SITL_MODEL_MOTOR_TOTAL] = {-1.0f, -1.0f,  1.0f,  1.0f};
+static const float32_t sitl_model_yaw_sign[SITL_MODEL_MOTOR_TOTAL]   = { 1.0f, -1.0f, -1.0f,  1.0f};
+
+///
+/// \brief The default parameters, a 600 g 5-inch quadrotor hovering at half throttle.
+///
+static const struct sitl_model_param sitl_model_param_default =
+{
+    .mass       = 0.6f,
+    .arm        = 0.1f,
+    .inertia    = {2.5e-3f, 2.5e-3f, 4.5e-3f},
+    .thrust_max = 6.0f,
+    .yaw_coef   = 0.016f,
+    .motor_tau  = 0.02f,
+    .drag_lin   = 0.3f,
+    .drag_rot   = 5.0e-3f,
+};
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief Gets the rotation from the body frame to the world frame, R = Rz(yaw) Ry(pitch) Rx(roll).
+///
+/// \param[in]  att The roll, pitch and yaw (rad).
+/// \param[out] r   The rotation matrix, row major.
+///
+static void rot_get(const float32_t att[3], float32_t r[3][3]);
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static void rot_get(const float32_t att[3], float32_t r[3][3])
+{
+    float32_t sr = sinf(att[0]), cr = cosf(att[0]);
+    float32_t sp = sinf(att[1]), cp = cosf(att[1]);
+    float32_t sy = sinf(att[2]), cy = cosf(att[2]);
+
+    r[0][0] = cy * cp;
+    r[0][1] = (cy * sp * sr) - (sy * cr);
+    r[0][2] = (cy * sp * cr) + (sy * sr);
+    r[1][0] = sy * cp;
+    r[1][1] = (sy * sp * sr) + (cy * cr);
+    r[1][2] = (sy * sp * cr) - (cy * sr);
+    r[2][0] = -sp;
+    r[2][1] = cp * sr;
+    r[2][2] = cp * cr;
+}
+
+///***********************************************************************************************************
+/// Global functions - definition.
+///***********************************************************************************************************
+void sitl_model_init(struct sitl_model *const model)
+{
+    memset(model, 0, sizeof(struct sitl_model));
+
+    model->param    = sitl_model_param_default;
+    model->grounded = 1;
+}
+
+void sitl_model_step(struct sitl_model *const model, const uint32_t pwm[SITL_MODEL_MOTOR_TOTAL],
+                     const float32_t dt)
+{
+    const struct sitl_model_param *param = &model->param;
+    float32_t d = param->arm * 0.70710678f;
+    float32_t thrust = 0.0f;
+    float32_t torque[3] = {0.0f, 0.0f, 0.0f};
+    float32_t r[3][3];
+
+    /* The motors follow the command with the first-order lag, the thrust goes with the square. */
+    for (uint32_t i = 0; i < SITL_MODEL_MOTOR_TOTAL; i++)
+    {
+        float32_t cmd = (pwm[i] == 0) ? 0.0f : (((float32_t)pwm[i] - 1000.0f) / 1000.0f);
+
+        cmd = (cmd < 0.0f) ? 0.0f : ((cmd > 1.0f) ? 1.0f : cmd);
+
+        model->motor[i] += (cmd - model->motor[i]) * (dt / (param->motor_tau + dt));
+
+        float32_t f = param->thrust_max * model->motor[i] * model->motor[i];
+
+        thrust    += f;
+        torque[0] += sitl_model_roll_sign[i]  * d * f;
+        torque[1] += sitl_model_pitch_sign[i] * d * f;
+        torque[2] += sitl_model_yaw_sign[i]   * param->yaw_coef * f;
+    }
+
+    rot_get(model->att, r);
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        model->acc[i] = ((r[i][2] * thrust) - (param->drag_lin * model->vel[i])) / param->mass;
+    }
+
+    model->acc[2] -= SITL_MODEL_G;
+
+    /* The ground holds the quadrotor level until the thrust lifts it. */
+    if ((model->pos[2] <= 0.0f) && (model->acc[2] <= 0.0f))
+    {
+        model->grounded = 1;
+        model->pos[2]   = 0.0f;
+        model->att[0]   = 0.0f;
+        model->att[1]   = 0.0f;
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            model->vel[i]  = 0.0f;
+            model->acc[i]  = 0.0f;
+            model->rate[i] = 0.0f;
+        }
+
+        return;
+    }
+
+    model->grounded = 0;
+
+    /* Euler's rotation equations, I w' = tau - w x I w - drag w. */
+    const float32_t *in = param->inertia;
+    float32_t p = model->rate[0], q = model->rate[1], w = model->rate[2];
+
+    model->rate[0] += dt * (torque[0] - ((in[2] - in[1]) * q * w) - (param->drag_rot * p)) / in[0];
+    model->rate[1] += dt * (torque[1] - ((in[0] - in[2]) * w * p) - (param->drag_rot * q)) / in[1];
+    model->rate[2] += dt * (torque[2] - ((in[1] - in[0]) * p * q) - (param->drag_rot * w)) / in[2];
+
+    /* The Euler angle rates of the body rates. */
+    float32_t sr = sinf(model->att[0]), cr = cosf(model->att[0]);
+    float32_t cp = cosf(model->att[1]), tp = tanf(model->att[1]);
+
+    p = model->rate[0];
+    q = model->rate[1];
+    w = model->rate[2];
+
+    model->att[0] += dt * (p + (((q * sr) + (w * cr)) * tp));
+    model->att[1] += dt * ((q * cr) - (w * sr));
+    model->att[2] += dt * (((q * sr) + (w * cr)) / cp);
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        model->vel[i] += dt * model->acc[i];
+        model->pos[i] += dt * model->vel[i];
+    }
+}
+
+void sitl_model_imu(const struct sitl_model *const model, float32_t acc[3], float32_t gyr[3])
+{
+    float32_t r[3][3];
+    float32_t f[3] = {model->acc[0], model->acc[1], model->acc[2] + SITL_MODEL_G};
+
+    rot_get(model->att, r);
+
+    /* The accelerometer senses the specific force in the body frame, R^T (a + g). */
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        acc[i] = ((r[0][i] * f[0]) + (r[1][i] * f[1]) + (r[2][i] * f[2])) / SITL_MODEL_G;
+        gyr[i] = model->rate[i] * SITL_MODEL_RAD2DEG;
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef _SITL_MODEL_H
+#define _SITL_MODEL_H
+
+#include "sitl.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+#define SITL_MODEL_MOTOR_TOTAL  (4u)
+
+///
+/// \brief The quadrotor parameters.
+///
+struct sitl_model_param
+{
+    float32_t mass;                         /*!< The mass (kg).                                         */
+    float32_t arm;                          /*!< The motor distance from the center (m), X frame.       */
+    float32_t inertia[3];                   /*!< The principal moments of inertia (kg m^2).             */
+    float32_t thrust_max;                   /*!< The thrust of one motor at the full command (N).       */
+    float32_t yaw_coef;                     /*!< The reaction torque per thrust (m).                    */
+    float32_t motor_tau;                    /*!< The motor time constant (s).                           */
+    float32_t drag_lin;                     /*!< The linear drag, the rotor drag included (N s/m).      */
+    float32_t drag_rot;                     /*!< The rotational drag (N m s/rad).                       */
+};
+
+///
+/// \brief The quadrotor state, the world frame is z-up and the attitude is Z-Y-X Euler angles.
+///
+struct sitl_model
+{
+    struct sitl_model_param param;
+    float32_t pos[3];                       /*!< The position in the world frame (m).                   */
+    float32_t vel[3];                       /*!< The velocity in the world frame (m/s).                 */
+    float32_t acc[3];                       /*!< The acceleration in the world frame (m/s^2).           */
+    float32_t att[3];                       /*!< The roll, pitch and yaw (rad).                         */
+    float32_t rate[3];                      /*!< The body angular rate (rad/s).                         */
+    float32_t motor[SITL_MODEL_MOTOR_TOTAL];    /*!< The motor states, 0 to 1.                          */
+    uint8_t grounded;                       /*!< 1 while the quadrotor rests on the ground.             */
+};
+
+///
+/// \brief Initializes the model at rest on the ground with the default 5-inch class parameters.
+///
+/// \param[in] model The model.
+///
+void sitl_model_init(struct sitl_model *const model);
+
+///
+/// \brief Advances the model.
+///
+/// \param[in] model The model.
+/// \param[in] pwm   The motor pulse widths in microseconds, 1000 to 2000, 0 for the motor off.
+/// \param[in] dt    The time step (s).
+///
+void sitl_model_step(struct sitl_model *const model, const uint32_t pwm[SITL_MODEL_MOTOR_TOTAL],
+                     const float32_t dt);
+
+///
+/// \brief Gets what the IMU senses.
+///
+/// \param[in]  model The model.
+/// \param[out] acc   The specific force in the body frame (g).
+/// \param[out] gyr   The angular rate in the body frame (deg/s).
+///
+void sitl_model_imu(const struct sitl_model *const model, float32_t acc[3], float32_t gyr[3]);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+
+#endif  /* _SITL_MODEL_H */
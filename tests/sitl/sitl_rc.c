@@ -0,0 +1,97 @@
+#include "sitl.h"
+
+#define SITL_RC_CH_TOTAL    (6u)
+
+///***********************************************************************************************************
+/// Private objects - declaration.
+///***********************************************************************************************************
+///
+/// \brief The receiver output, the capture channel the PWM backend measures the channel on.
+///
+struct sitl_rc_out
+{
+    tim_inst_t inst;
+    ll_tim_ccr_ch_t ch;
+};
+
+///
+/// \brief The simulated transmitter and receiver.
+///
+struct sitl_rc
+{
+    uint32_t stick[SITL_RC_CH_TOTAL];       /*!< The stick positions, pulse widths in microseconds.     */
+    uint32_t frame_raw[SITL_RC_CH_TOTAL];   /*!< The pulse widths of the frame being sent.              */
+    uint64_t frame;                         /*!< The start of the frame being sent.                     */
+    uint32_t edge;                          /*!< The next edge in the frame, two per channel.           */
+};
+
+///***********************************************************************************************************
+/// Private objects - definition.
+///***********************************************************************************************************
+///
+/// \brief The receiver outputs, see the timer usage in rc.h.
+///
+static const struct sitl_rc_out sitl_rc_out_arr[SITL_RC_CH_TOTAL] =
+{
+    {.inst = TIM_INST_12, .ch = LL_TIM_CCR_CH1},
+    {.inst = TIM_INST_12, .ch = LL_TIM_CCR_CH2},
+    {.inst = TIM_INST_8,  .ch = LL_TIM_CCR_CH1},
+    {.inst = TIM_INST_8,  .ch = LL_TIM_CCR_CH2},
+    {.inst = TIM_INST_8,  .ch = LL_TIM_CCR_CH3},
+    {.inst = TIM_INST_8,  .ch = LL_TIM_CCR_CH4},
+};
+
+///
+/// \brief The simulated transmitter and receiver, the sticks centered and the throttle low.
+///
+static struct sitl_rc sitl_rc =
+{
+    .stick     = {1500, 1500, 1000, 1500, 1000, 1000},
+    .frame_raw = {1500, 1500, 1000, 1500, 1000, 1000},
+    .frame     = 0,
+    .edge      = 0,
+};
+
+///***********************************************************************************************************
+/// Global functions - definition.
+///***********************************************************************************************************
+void sitl_rc_set(const uint32_t ch, const uint32_t raw)
+{
+    if (ch < SITL_RC_CH_TOTAL)
+    {
+        sitl_rc.stick[ch] = raw;
+    }
+}
+
+void sitl_rc_run(const uint64_t us)
+{
+    while (1)
+    {
+        uint32_t ch = sitl_rc.edge / 2;
+        uint64_t at = sitl_rc.frame + (ch * SITL_RC_SLOT_US);
+
+        /* The pulse starts on the rising edge and ends on the falling one. */
+        if ((sitl_rc.edge & 0x01u) != 0)
+        {
+            at += sitl_rc.frame_raw[ch];
+        }
+
+        if (at > us)
+        {
+            return;
+        }
+
+        sitl_tim_capture(sitl_rc_out_arr[ch].inst, sitl_rc_out_arr[ch].ch, at);
+
+        if (++sitl_rc.edge == (2 * SITL_RC_CH_TOTAL))
+        {
+            sitl_rc.edge   = 0;
+            sitl_rc.frame += SITL_RC_FRAME_US;
+
+            for (uint32_t i = 0; i < SITL_RC_CH_TOTAL; i++)
+            {
+                sitl_rc.frame_raw[i] = sitl_rc.stick[i];
+            }
+        }
+    }
+}
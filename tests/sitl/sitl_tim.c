@@ -0,0 +1,252 @@
+#include "sitl.h"
+#include "tim.h"
+#include <stddef.h>
+
+#define SITL_TIM_CH_TOTAL   (4u)
+
+///***********************************************************************************************************
+/// Private objects - declaration.
+///***********************************************************************************************************
+///
+/// \brief The simulated timer, the compare values and the capture callbacks of its channels.
+///
+struct sitl_tim
+{
+    uint32_t ccr[SITL_TIM_CH_TOTAL];
+    tim_cap_cb_t cb[SITL_TIM_CH_TOTAL];
+    void *arg[SITL_TIM_CH_TOTAL];
+    uint8_t enabled;
+};
+
+///***********************************************************************************************************
+/// Private functions - declaration.
+///***********************************************************************************************************
+///
+/// \brief Initializes the simulated timer.
+///
+/// \param[in] tim The simulated timer.
+///
+/// \return ll_tim_res_t The TIM driver result.
+///
+static ll_tim_res_t sitl_tim_init(void *tim);
+
+///
+/// \brief Deinitializes the simulated timer.
+///
+/// \param[in] tim The simulated timer.
+///
+/// \return ll_tim_res_t The TIM driver result.
+///
+static ll_tim_res_t sitl_tim_deinit(void *tim);
+
+///
+/// \brief Starts the simulated timer.
+///
+/// \param[in] tim The simulated timer.
+///
+/// \return ll_tim_res_t The TIM driver result.
+///
+static ll_tim_res_t sitl_tim_enable(void *tim);
+
+///
+/// \brief Stops the simulated timer.
+///
+/// \param[in] tim The simulated timer.
+///
+/// \return ll_tim_res_t The TIM driver result.
+///
+static ll_tim_res_t sitl_tim_disable(void *tim);
+
+///
+/// \brief Gets the capture data, the simulated timers hand the edges to the callbacks only.
+///
+/// \param[in]  tim The simulated timer.
+/// \param[in]  ch  The capture/compare channel.
+/// \param[out] ccr The capture data.
+///
+/// \return ll_tim_res_t The TIM driver result.
+///
+static ll_tim_res_t sitl_tim_ccr_data_get(void *tim, const ll_tim_ccr_ch_t ch, struct ll_tim_ccr_data *const ccr);
+
+///
+/// \brief Sets the compare value, the pulse width of the PWM output.
+///
+/// \param[in] tim The simulated timer.
+/// \param[in] ch  The capture/compare channel.
+/// \param[in] ccr The compare value.
+///
+/// \return ll_tim_res_t The TIM driver result.
+///
+static ll_tim_res_t sitl_tim_ccr_set(void *tim, const ll_tim_ccr_ch_t ch, const uint32_t ccr);
+
+///***********************************************************************************************************
+/// Private objects - definition.
+///***********************************************************************************************************
+///
+/// \brief The simulated timers, in the TIM instance order.
+///
+static struct sitl_tim sitl_tim_arr[TIM_INST_TOTAL];
+
+///
+/// \brief The TIM devices, the interface the motor and the RC modules use.
+///
+static struct tim_dev tim_dev_arr[TIM_INST_TOTAL] =
+{
+    [TIM_INST_4] =
+    {
+        .tim          = &sitl_tim_arr[TIM_INST_4],
+        .init         = sitl_tim_init,
+        .deinit       = sitl_tim_deinit,
+        .enable       = sitl_tim_enable,
+        .disable      = sitl_tim_disable,
+        .ccr_data_get = sitl_tim_ccr_data_get,
+        .ccr_set      = sitl_tim_ccr_set,
+    },
+
+    [TIM_INST_12] =
+    {
+        .tim          = &sitl_tim_arr[TIM_INST_12],
+        .init         = sitl_tim_init,
+        .deinit       = sitl_tim_deinit,
+        .enable       = sitl_tim_enable,
+        .disable      = sitl_tim_disable,
+        .ccr_data_get = sitl_tim_ccr_data_get,
+        .ccr_set      = sitl_tim_ccr_set,
+    },
+
+    [TIM_INST_8] =
+    {
+        .tim          = &sitl_tim_arr[TIM_INST_8],
+        .init         = sitl_tim_init,
+        .deinit       = sitl_tim_deinit,
+        .enable       = sitl_tim_enable,
+        .disable      = sitl_tim_disable,
+        .ccr_data_get = sitl_tim_ccr_data_get,
+        .ccr_set      = sitl_tim_ccr_set,
+    },
+};
+
+///***********************************************************************************************************
+/// Private functions - definition.
+///***********************************************************************************************************
+static ll_tim_res_t sitl_tim_init(void *tim)
+{
+    struct sitl_tim *sim = (struct sitl_tim *)tim;
+
+    for (uint32_t i = 0; i < SITL_TIM_CH_TOTAL; i++)
+    {
+        sim->ccr[i] = 0;
+    }
+
+    return LL_TIM_RES_OK;
+}
+
+static ll_tim_res_t sitl_tim_deinit(void *tim)
+{
+    ((struct sitl_tim *)tim)->enabled = 0;
+
+    return LL_TIM_RES_OK;
+}
+
+static ll_tim_res_t sitl_tim_enable(void *tim)
+{
+    ((struct sitl_tim *)tim)->enabled = 1;
+
+    return LL_TIM_RES_OK;
+}
+
+static ll_tim_res_t sitl_tim_disable(void *tim)
+{
+    ((struct sitl_tim *)tim)->enabled = 0;
+
+    return LL_TIM_RES_OK;
+}
+
+static ll_tim_res_t sitl_tim_ccr_data_get(void *tim, const ll_tim_ccr_ch_t ch, struct ll_tim_ccr_data *const ccr)
+{
+    (void)tim;
+    (void)ch;
+    (void)ccr;
+
+    return LL_TIM_RES_ERR;
+}
+
+static ll_tim_res_t sitl_tim_ccr_set(void *tim, const ll_tim_ccr_ch_t ch, const uint32_t ccr)
+{
+    if (ch >= (ll_tim_ccr_ch_t)SITL_TIM_CH_TOTAL)
+    {
+        return LL_TIM_RES_ERR;
+    }
+
+    ((struct sitl_tim *)tim)->ccr[ch] = ccr;
+
+    return LL_TIM_RES_OK;
+}
+
+///***********************************************************************************************************
+/// Global functions - definition.
+///***********************************************************************************************************
+struct tim_dev* tim_dev_get(tim_inst_t inst)
+{
+    if ((inst < TIM_INST_BEGIN) || (inst >= TIM_INST_TOTAL))
+    {
+        return NULL;
+    }
+
+    return &tim_dev_arr[inst];
+}
+
+struct tim_dev* tim_dev_arr_get(void)
+{
+    return &tim_dev_arr[0];
+}
+
+void tim_init(void)
+{
+    for (uint32_t i = 0; i < TIM_INST_TOTAL; i++)
+    {
+        tim_dev_arr[i].init(tim_dev_arr[i].tim);
+        tim_dev_arr[i].enable(tim_dev_arr[i].tim);
+    }
+}
+
+tim_res_t tim_cap_cb_set(const tim_inst_t inst, const ll_tim_ccr_ch_t ch, const tim_cap_cb_t cb, void *const arg)
+{
+    if ((inst < TIM_INST_BEGIN) || (inst >= TIM_INST_TOTAL) || (ch < LL_TIM_CCR_CH1) ||
+        (ch >= (ll_tim_ccr_ch_t)SITL_TIM_CH_TOTAL))
+    {
+        return TIM_RES_ERR;
+    }
+
+    sitl_tim_arr[inst].cb[ch]  = NULL;
+    sitl_tim_arr[inst].arg[ch] = arg;
+    sitl_tim_arr[inst].cb[ch]  = cb;
+
+    return TIM_RES_OK;
+}
+
+uint32_t sitl_tim_ccr_get(const tim_inst_t inst, const ll_tim_ccr_ch_t ch)
+{
+    if ((inst < TIM_INST_BEGIN) || (inst >= TIM_INST_TOTAL) || (ch >= (ll_tim_ccr_ch_t)SITL_TIM_CH_TOTAL))
+    {
+        return 0;
+    }
+
+    return sitl_tim_arr[inst].ccr[ch];
+}
+
+void sitl_tim_capture(const tim_inst_t inst, const ll_tim_ccr_ch_t ch, const uint64_t us)
+{
+    if ((inst < TIM_INST_BEGIN) || (inst >= TIM_INST_TOTAL) || (ch >= (ll_tim_ccr_ch_t)SITL_TIM_CH_TOTAL))
+    {
+        return;
+    }
+
+    struct sitl_tim *sim = &sitl_tim_arr[inst];
+
+    /* The timer counts microseconds, the capture register holds the counter at the edge. */
+    if ((sim->enabled == 1) && (sim->cb[ch] != NULL))
+    {
+        sim->cb[ch](sim->arg[ch], (uint32_t)(us & SITL_TIM_CNT_MASK));
+    }
+}